@@ -1,4 +1,4 @@
-from pydantic import BaseModel, Field
+from pydantic import BaseModel, Field, model_validator
 from typing import List, Dict, Optional
 from datetime import date
 
@@ -31,12 +31,24 @@ class AverageData(BaseModel):
     class Config:
         populate_by_name = True
 
+class SpreadLeg(BaseModel):
+    """One weighted leg of a spread, mirroring the engine's SpreadLeg."""
+    commodity: str = Field(..., description="Commodity symbol of this leg")
+    month: str = Field(..., description="Contract month")
+    year_offset: int = Field(0, alias="yearOffset", description="Expiry year relative to the analysis year (engine SpreadLeg.year_offset)")
+    weight: float = Field(1.0, description="Signed ratio weight")
+    multiplier: float = Field(1.0, description="Quote-to-spread unit conversion")
+    
+    class Config:
+        populate_by_name = True
+
 class SpreadAnalysisParams(BaseModel):
     commodity: str = Field(..., description="Commodity symbol")
-    month1: str = Field(..., description="First contract month")
-    month2: str = Field(..., description="Second contract month")
+    month1: Optional[str] = Field(None, description="First contract month")
+    month2: Optional[str] = Field(None, description="Second contract month")
     start_date: str = Field(..., alias="startDate", description="Analysis start date (YYYY-MM-DD)")
     end_date: str = Field(..., alias="endDate", description="Analysis end date (YYYY-MM-DD)")
+    legs: List[SpreadLeg] = Field(default_factory=list, description="Weighted spread legs; derived from month1/month2 when omitted")
     
     class Config:
         populate_by_name = True
@@ -49,6 +61,28 @@ class SpreadAnalysisParams(BaseModel):
                 "endDate": "2023-12-31"
             }
         }
+    
+    @model_validator(mode="after")
+    def _normalize_legs(self) -> "SpreadAnalysisParams":
+        """Express a month1/month2 calendar spread as two legs (+1 / -1).
+
+        Legs alongside month1/month2 are accepted only when they are that
+        calendar, so params echoed back in a response can be re-submitted.
+        """
+        calendar = None
+        if self.month1 and self.month2:
+            calendar = [
+                SpreadLeg(commodity=self.commodity, month=self.month1, weight=1.0),
+                SpreadLeg(commodity=self.commodity, month=self.month2, weight=-1.0),
+            ]
+        if self.legs:
+            if (self.month1 or self.month2) and self.legs != calendar:
+                raise ValueError("Provide either legs or month1 and month2, not both")
+        elif calendar is None:
+            raise ValueError("Either legs or month1 and month2 must be provided")
+        else:
+            self.legs = calendar
+        return self
 
 class AnalysisData(BaseModel):
     params: SpreadAnalysisParams
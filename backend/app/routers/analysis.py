@@ -10,7 +10,7 @@ router = APIRouter(prefix="/analysis", tags=["analysis"])
 async def run_spread_analysis(params: SpreadAnalysisParams):
     """Run spread analysis with given parameters."""
     try:
-        logger.info(f"Received spread analysis request: {params.commodity} {params.month1}-{params.month2}")
+        logger.info(f"Received spread analysis request: {params.commodity} with {len(params.legs)} legs")
         result = await analysis_service.run_spread_analysis(params)
         logger.info(f"Successfully completed spread analysis for {params.commodity}")
         return result
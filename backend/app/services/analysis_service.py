@@ -23,7 +23,7 @@ class AnalysisService:
         Run spread analysis with given parameters.
         This is a mock implementation that will be replaced by C++ engine calls.
         """
-        logger.info(f"Starting spread analysis for {params.commodity} {params.month1}-{params.month2}")
+        logger.info(f"Starting spread analysis for {self._describe_legs(params)}")
         
         # Validate commodity and months
         await self._validate_analysis_params(params)
@@ -64,17 +64,31 @@ class AnalysisService:
         logger.info(f"Completed spread analysis for {params.commodity}")
         return result
     
+    @staticmethod
+    def _describe_legs(params: SpreadAnalysisParams) -> str:
+        """Human-readable spread expression, e.g. '+1 ZC December -1 ZC March +1y'.
+
+        Legs expiring in a later or earlier year than the analysis year carry
+        their year offset. The frontend renders the same format.
+        """
+        return " ".join(
+            f"{leg.weight * leg.multiplier:+g} {leg.commodity} {leg.month}"
+            + (f" {leg.year_offset:+d}y" if leg.year_offset else "")
+            for leg in params.legs
+        )
+    
     async def _validate_analysis_params(self, params: SpreadAnalysisParams):
         """Validate analysis parameters."""
         # Check if commodity exists
         await self.commodity_service.get_commodity_by_symbol(params.commodity)
         
-        # Check if months are valid for this commodity
-        months_valid = await self.commodity_service.validate_commodity_months(
-            params.commodity, [params.month1, params.month2]
-        )
-        if not months_valid:
-            raise ValueError(f"Invalid months {params.month1}, {params.month2} for commodity {params.commodity}")
+        # Check if every leg's month is valid for its commodity
+        for leg in params.legs:
+            months_valid = await self.commodity_service.validate_commodity_months(
+                leg.commodity, [leg.month]
+            )
+            if not months_valid:
+                raise ValueError(f"Invalid month {leg.month} for commodity {leg.commodity}")
         
         # Check date range
         start_date = datetime.strptime(params.start_date, "%Y-%m-%d")
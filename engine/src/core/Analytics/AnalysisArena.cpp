@@ -0,0 +1,36 @@
+/**
+ * @file AnalysisArena.cpp
+ * @brief Implementation of the per-request analysis arena.
+ */
+
+#include "include/AnalysisArena.hpp"
+
+void *AnalysisArena::CountingResource::do_allocate(size_t bytes,
+                                                   size_t alignment) {
+  allocated_ += bytes;
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void AnalysisArena::CountingResource::do_deallocate(void *p, size_t bytes,
+                                                    size_t alignment) {
+  std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+AnalysisArena::AnalysisArena(size_t capacity)
+    : capacity_(capacity), block_(new std::byte[capacity]) {
+  arena_.emplace(block_.get(), capacity_, &upstream_);
+}
+
+void AnalysisArena::Reset() {
+  const size_t spilled = upstream_.Allocated();
+  if (spilled == 0) {
+    arena_->release();
+    return;
+  }
+  // Chunks grow geometrically, so the request needed less than this
+  arena_.reset();
+  capacity_ += spilled;
+  block_.reset(new std::byte[capacity_]);
+  upstream_.ResetCount();
+  arena_.emplace(block_.get(), capacity_, &upstream_);
+}
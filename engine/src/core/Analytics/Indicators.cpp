@@ -0,0 +1,280 @@
+/**
+ * @file Indicators.cpp
+ * @brief Implementation of the fused and batched indicator kernels.
+ */
+
+#include "include/Indicators.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace indicators {
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+void CheckBatch(const std::vector<size_t> &periods, size_t outputs) {
+  if (periods.size() != outputs) {
+    throw std::invalid_argument("Indicator needs one output per parameter");
+  }
+  for (size_t period : periods) {
+    if (period == 0) {
+      throw std::invalid_argument("Indicator period must be positive");
+    }
+  }
+}
+
+void CheckOutput(size_t rows, const OutputColumn &out) {
+  if (out.size < rows) {
+    throw std::invalid_argument("Indicator output is shorter than its input");
+  }
+}
+
+/**
+ * Runs one exponential smoother per period over `value(i)`, i in [0, rows).
+ * Smoother `p` is seeded with the mean of its first `periods[p]` values and
+ * then follows `s += alpha[p] * (v - s)`. After the longest warm-up every
+ * smoother updates unconditionally, a loop the compiler vectorizes across
+ * parameters. `emit(i, state)` sees the states after row `i`.
+ */
+template <typename Value, typename Emit>
+void SmoothBatch(size_t rows, const std::vector<size_t> &periods,
+                 const std::vector<double> &alpha, Value value, Emit emit) {
+  const size_t m = periods.size();
+  std::vector<double> state(m, 0.0);
+  const size_t warm =
+      m == 0 ? 0 : *std::max_element(periods.begin(), periods.end());
+  double *s = state.data();
+  const double *a = alpha.data();
+  for (size_t i = 0; i < rows; ++i) {
+    const double v = value(i);
+    if (i < warm) {
+      for (size_t p = 0; p < m; ++p) {
+        if (i < periods[p]) {
+          s[p] += v;
+          if (i + 1 == periods[p]) s[p] /= static_cast<double>(periods[p]);
+        } else {
+          s[p] += a[p] * (v - s[p]);
+        }
+      }
+    } else {
+      for (size_t p = 0; p < m; ++p) s[p] += a[p] * (v - s[p]);
+    }
+    emit(i, s);
+  }
+}
+
+}  // namespace
+
+void Ema(InputColumn input, size_t period, OutputColumn out) {
+  Ema(input, std::vector<size_t>{period}, std::vector<OutputColumn>{out});
+}
+
+void Ema(InputColumn input, const std::vector<size_t> &periods,
+         const std::vector<OutputColumn> &outs) {
+  CheckBatch(periods, outs.size());
+  std::vector<double> alpha;
+  for (size_t p = 0; p < periods.size(); ++p) {
+    CheckOutput(input.size, outs[p]);
+    alpha.push_back(2.0 / (static_cast<double>(periods[p]) + 1.0));
+  }
+  SmoothBatch(
+      input.size, periods, alpha, [&](size_t i) { return input[i]; },
+      [&](size_t i, const double *s) {
+        for (size_t p = 0; p < periods.size(); ++p) {
+          outs[p][i] = i + 1 >= periods[p] ? s[p] : kNaN;
+        }
+      });
+}
+
+void Atr(InputColumn high, InputColumn low, InputColumn close, size_t period,
+         OutputColumn out) {
+  Atr(high, low, close, std::vector<size_t>{period},
+      std::vector<OutputColumn>{out});
+}
+
+void Atr(InputColumn high, InputColumn low, InputColumn close,
+         const std::vector<size_t> &periods,
+         const std::vector<OutputColumn> &outs) {
+  if (low.size != high.size || close.size != high.size) {
+    throw std::invalid_argument("ATR columns differ in length");
+  }
+  CheckBatch(periods, outs.size());
+  std::vector<double> alpha;
+  for (size_t p = 0; p < periods.size(); ++p) {
+    CheckOutput(high.size, outs[p]);
+    alpha.push_back(1.0 / static_cast<double>(periods[p]));
+  }
+  auto true_range = [&](size_t i) {
+    const double range = high[i] - low[i];
+    if (i == 0) return range;
+    const double prev = close[i - 1];
+    return std::max({range, std::fabs(high[i] - prev),
+                     std::fabs(low[i] - prev)});
+  };
+  SmoothBatch(high.size, periods, alpha, true_range,
+              [&](size_t i, const double *s) {
+                for (size_t p = 0; p < periods.size(); ++p) {
+                  outs[p][i] = i + 1 >= periods[p] ? s[p] : kNaN;
+                }
+              });
+}
+
+void Bollinger(InputColumn input, const BollingerSpec &spec,
+               const BollingerOutput &out) {
+  Bollinger(input, std::vector<BollingerSpec>{spec},
+            std::vector<BollingerOutput>{out});
+}
+
+void Bollinger(InputColumn input, const std::vector<BollingerSpec> &specs,
+               const std::vector<BollingerOutput> &outs) {
+  std::vector<size_t> periods;
+  for (const auto &spec : specs) periods.push_back(spec.period);
+  CheckBatch(periods, outs.size());
+  for (const auto &out : outs) {
+    CheckOutput(input.size, out.middle);
+    CheckOutput(input.size, out.upper);
+    CheckOutput(input.size, out.lower);
+  }
+
+  // Welford running mean and squared deviations. Once a window is full, a
+  // row replaces its oldest value in one update:
+  // M2 += (new - old) * (new - mean' + old - mean)
+  // The sliding update drifts by an ulp of the price per row, which over a
+  // long history swamps a narrow spread far from zero. Every `period` rows
+  // the window is therefore recomputed in two passes, an amortized two
+  // extra reads per row that bounds the drift to one window.
+  const size_t m = specs.size();
+  std::vector<double> mean(m, 0.0);
+  std::vector<double> m2(m, 0.0);
+  for (size_t i = 0; i < input.size; ++i) {
+    const double x = input[i];
+    for (size_t p = 0; p < m; ++p) {
+      const size_t period = periods[p];
+      if (i < period) {
+        const double delta = x - mean[p];
+        mean[p] += delta / static_cast<double>(i + 1);
+        m2[p] += delta * (x - mean[p]);
+      } else {
+        const double old = input[i - period];
+        const double previous = mean[p];
+        mean[p] += (x - old) / static_cast<double>(period);
+        m2[p] += (x - old) * (x - mean[p] + old - previous);
+        if ((i + 1) % period == 0) {
+          const size_t first = i + 1 - period;
+          double sum = 0.0;
+          for (size_t k = first; k <= i; ++k) sum += input[k];
+          mean[p] = sum / static_cast<double>(period);
+          m2[p] = 0.0;
+          for (size_t k = first; k <= i; ++k) {
+            m2[p] += (input[k] - mean[p]) * (input[k] - mean[p]);
+          }
+        }
+      }
+
+      const BollingerOutput &out = outs[p];
+      if (i + 1 < period) {
+        out.middle[i] = out.upper[i] = out.lower[i] = kNaN;
+        continue;
+      }
+      const double deviation =
+          std::sqrt(std::max(0.0, m2[p] / static_cast<double>(period)));
+      out.middle[i] = mean[p];
+      out.upper[i] = mean[p] + specs[p].width * deviation;
+      out.lower[i] = mean[p] - specs[p].width * deviation;
+    }
+  }
+}
+
+void Rsi(InputColumn input, size_t period, OutputColumn out) {
+  Rsi(input, std::vector<size_t>{period}, std::vector<OutputColumn>{out});
+}
+
+void Rsi(InputColumn input, const std::vector<size_t> &periods,
+         const std::vector<OutputColumn> &outs) {
+  CheckBatch(periods, outs.size());
+  const size_t m = periods.size();
+  std::vector<double> alpha;
+  for (size_t p = 0; p < m; ++p) {
+    CheckOutput(input.size, outs[p]);
+    if (input.size > 0) outs[p][0] = kNaN;
+    alpha.push_back(1.0 / static_cast<double>(periods[p]));
+  }
+  if (input.size < 2) return;
+
+  // Change `j` is row `j + 1`; gains and losses are smoothed side by side
+  std::vector<double> gain(m, 0.0);
+  std::vector<double> loss(m, 0.0);
+  const size_t changes = input.size - 1;
+  for (size_t j = 0; j < changes; ++j) {
+    const double change = input[j + 1] - input[j];
+    const double up = std::max(0.0, change);
+    const double down = std::max(0.0, -change);
+    for (size_t p = 0; p < m; ++p) {
+      const size_t period = periods[p];
+      if (j < period) {
+        gain[p] += up;
+        loss[p] += down;
+        if (j + 1 == period) {
+          gain[p] /= static_cast<double>(period);
+          loss[p] /= static_cast<double>(period);
+        }
+      } else {
+        gain[p] += alpha[p] * (up - gain[p]);
+        loss[p] += alpha[p] * (down - loss[p]);
+      }
+
+      double rsi = kNaN;
+      if (j + 1 >= period) {
+        if (loss[p] > 0.0) {
+          rsi = 100.0 - 100.0 / (1.0 + gain[p] / loss[p]);
+        } else {
+          rsi = gain[p] > 0.0 ? 100.0 : 50.0;
+        }
+      }
+      outs[p][j + 1] = rsi;
+    }
+  }
+}
+
+void PercentileRank(InputColumn input, size_t window, OutputColumn out) {
+  PercentileRank(input, std::vector<size_t>{window},
+                 std::vector<OutputColumn>{out});
+}
+
+void PercentileRank(InputColumn input, const std::vector<size_t> &windows,
+                    const std::vector<OutputColumn> &outs) {
+  CheckBatch(windows, outs.size());
+  for (const auto &out : outs) CheckOutput(input.size, out);
+
+  const size_t m = windows.size();
+  std::vector<std::vector<double>> sorted(m);
+  for (size_t p = 0; p < m; ++p) sorted[p].reserve(windows[p] + 1);
+
+  // NaNs never enter the sorted windows, which they would unorder; a NaN
+  // row ranks as NaN and counts as neither at nor below any other row
+  for (size_t i = 0; i < input.size; ++i) {
+    const double x = input[i];
+    const bool valid = !std::isnan(x);
+    for (size_t p = 0; p < m; ++p) {
+      std::vector<double> &w = sorted[p];
+      const size_t window = windows[p];
+      if (i >= window && valid) {
+        const size_t at_or_below =
+            std::upper_bound(w.begin(), w.end(), x) - w.begin();
+        outs[p][i] = 100.0 * static_cast<double>(at_or_below) /
+                     static_cast<double>(window);
+      } else {
+        outs[p][i] = kNaN;
+      }
+      if (i >= window && !std::isnan(input[i - window])) {
+        w.erase(std::lower_bound(w.begin(), w.end(), input[i - window]));
+      }
+      if (valid) w.insert(std::upper_bound(w.begin(), w.end(), x), x);
+    }
+  }
+}
+
+}  // namespace indicators
@@ -0,0 +1,389 @@
+/**
+ * @file PairScreener.cpp
+ * @brief Implementation of the blocked correlation kernel and the batched
+ * Engle-Granger tests.
+ */
+
+#include "include/PairScreener.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "DataManager.hpp"
+#include "JobRegistry.hpp"
+#include "TaskScheduler.hpp"
+
+namespace {
+
+// Columns per side of a Gram tile, and rows streamed per pass over a tile.
+// Two tiles of one chunk (2 x 32 x 256 doubles) stay in L2.
+constexpr size_t kTile = 32;
+constexpr size_t kRowChunk = 256;
+constexpr size_t kMaxLags = 8;
+
+/**
+ * Accumulates the `BI x BJ` block of `X^T X` at columns (i, j) over rows
+ * [r0, r1) in registers.
+ */
+template <size_t BI, size_t BJ>
+void GramBlock(const double *const *cols, size_t r0, size_t r1, size_t i,
+               size_t j, size_t n, double *out) {
+  const double *a[BI];
+  const double *b[BJ];
+  for (size_t x = 0; x < BI; ++x) a[x] = cols[i + x];
+  for (size_t y = 0; y < BJ; ++y) b[y] = cols[j + y];
+  double acc[BI][BJ] = {};
+  for (size_t r = r0; r < r1; ++r) {
+    double bv[BJ];
+    for (size_t y = 0; y < BJ; ++y) bv[y] = b[y][r];
+    for (size_t x = 0; x < BI; ++x) {
+      const double av = a[x][r];
+      for (size_t y = 0; y < BJ; ++y) acc[x][y] += av * bv[y];
+    }
+  }
+  for (size_t x = 0; x < BI; ++x) {
+    for (size_t y = 0; y < BJ; ++y) out[(i + x) * n + j + y] += acc[x][y];
+  }
+}
+
+// Edge blocks of fewer than four columns
+void GramEdge(const double *const *cols, size_t r0, size_t r1, size_t i,
+              size_t bi, size_t j, size_t bj, size_t n, double *out) {
+  for (size_t x = 0; x < bi; ++x) {
+    for (size_t y = 0; y < bj; ++y) {
+      const double *a = cols[i + x];
+      const double *b = cols[j + y];
+      double acc = 0.0;
+      for (size_t r = r0; r < r1; ++r) acc += a[r] * b[r];
+      out[(i + x) * n + j + y] += acc;
+    }
+  }
+}
+
+/**
+ * Symmetric `X^T X` of `n` columns of `rows` values, row-major into `out`.
+ */
+std::vector<double> Gram(const std::vector<const double *> &cols,
+                         size_t rows, size_t num_threads) {
+  const size_t n = cols.size();
+  std::vector<double> out(n * n, 0.0);
+  const size_t side = (n + kTile - 1) / kTile;
+  std::vector<std::pair<size_t, size_t>> tiles;
+  for (size_t ti = 0; ti < side; ++ti) {
+    for (size_t tj = ti; tj < side; ++tj) tiles.emplace_back(ti, tj);
+  }
+
+  // Tiles own disjoint entries of the upper triangle
+  auto run = [&](size_t begin, size_t end) {
+    for (size_t t = begin; t < end; ++t) {
+      const size_t i0 = tiles[t].first * kTile;
+      const size_t j0 = tiles[t].second * kTile;
+      const size_t i1 = std::min(n, i0 + kTile);
+      const size_t j1 = std::min(n, j0 + kTile);
+      for (size_t r0 = 0; r0 < rows; r0 += kRowChunk) {
+        const size_t r1 = std::min(rows, r0 + kRowChunk);
+        for (size_t i = i0; i < i1; i += 4) {
+          const size_t bi = std::min<size_t>(4, i1 - i);
+          for (size_t j = j0; j < j1; j += 4) {
+            const size_t bj = std::min<size_t>(4, j1 - j);
+            if (bi == 4 && bj == 4) {
+              GramBlock<4, 4>(cols.data(), r0, r1, i, j, n, out.data());
+            } else {
+              GramEdge(cols.data(), r0, r1, i, bi, j, bj, n, out.data());
+            }
+          }
+        }
+      }
+    }
+  };
+  ParallelFor(0, tiles.size(), run, TaskCount{num_threads});
+
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < i; ++j) out[i * n + j] = out[j * n + i];
+  }
+  return out;
+}
+
+struct AdfFit {
+  double statistic = 0.0;
+  double gamma = 0.0;
+  bool valid = false;
+};
+
+/**
+ * ADF regression on the residuals `e = y - intercept - slope * x`, without
+ * a constant. One pass accumulates the normal equations, which are solved
+ * by Cholesky; everything lives on the stack.
+ */
+AdfFit ResidualAdf(const double *y, const double *x, size_t rows,
+                   double intercept, double slope, size_t lags) {
+  constexpr size_t kMax = kMaxLags + 1;
+  const size_t k = lags + 1;
+  double xtx[kMax][kMax] = {};
+  double xty[kMax] = {};
+  double yty = 0.0;
+  double recent[kMaxLags] = {};  // de_{t-1}, de_{t-2}, ...
+  size_t observations = 0;
+
+  double prev = y[0] - intercept - slope * x[0];
+  for (size_t t = 1; t < rows; ++t) {
+    const double e = y[t] - intercept - slope * x[t];
+    const double de = e - prev;
+    if (t > lags) {
+      double z[kMax];
+      z[0] = prev;
+      for (size_t l = 0; l < lags; ++l) z[l + 1] = recent[l];
+      for (size_t a = 0; a < k; ++a) {
+        for (size_t b = a; b < k; ++b) xtx[a][b] += z[a] * z[b];
+        xty[a] += z[a] * de;
+      }
+      yty += de * de;
+      ++observations;
+    }
+    for (size_t l = lags; l-- > 1;) recent[l] = recent[l - 1];
+    if (lags > 0) recent[0] = de;
+    prev = e;
+  }
+
+  AdfFit fit;
+  if (observations <= k) return fit;
+
+  // xtx = L L^T
+  double chol[kMax][kMax] = {};
+  for (size_t a = 0; a < k; ++a) {
+    for (size_t b = 0; b <= a; ++b) {
+      double sum = xtx[b][a];
+      for (size_t c = 0; c < b; ++c) sum -= chol[a][c] * chol[b][c];
+      if (a == b) {
+        if (!(sum > 1e-300)) return fit;
+        chol[a][a] = std::sqrt(sum);
+      } else {
+        chol[a][b] = sum / chol[b][b];
+      }
+    }
+  }
+  auto solve = [&](const double *rhs, double *out) {
+    double w[kMax];
+    for (size_t a = 0; a < k; ++a) {
+      double sum = rhs[a];
+      for (size_t c = 0; c < a; ++c) sum -= chol[a][c] * w[c];
+      w[a] = sum / chol[a][a];
+    }
+    for (size_t a = k; a-- > 0;) {
+      double sum = w[a];
+      for (size_t c = a + 1; c < k; ++c) sum -= chol[c][a] * out[c];
+      out[a] = sum / chol[a][a];
+    }
+  };
+
+  double beta[kMax];
+  solve(xty, beta);
+  double unit[kMax] = {1.0};
+  double inverse[kMax];
+  solve(unit, inverse);
+
+  double explained = 0.0;
+  for (size_t a = 0; a < k; ++a) explained += beta[a] * xty[a];
+  const double ssr = std::max(0.0, yty - explained);
+  const double variance = ssr / static_cast<double>(observations - k);
+  const double se = std::sqrt(variance * inverse[0]);
+  if (!(se > 0.0)) return fit;
+
+  fit.gamma = beta[0];
+  fit.statistic = beta[0] / se;
+  fit.valid = true;
+  return fit;
+}
+
+double HalfLife(double gamma) {
+  if (gamma >= 0.0) return std::numeric_limits<double>::infinity();
+  if (gamma <= -1.0) return 0.0;
+  return -std::log(2.0) / std::log1p(gamma);
+}
+
+void KeepTop(std::vector<PairStatistics> &pairs, size_t top_k,
+             bool (*better)(const PairStatistics &, const PairStatistics &)) {
+  const size_t keep = top_k == 0 ? pairs.size() : std::min(top_k, pairs.size());
+  std::partial_sort(pairs.begin(), pairs.begin() + keep, pairs.end(), better);
+  pairs.resize(keep);
+}
+
+}  // namespace
+
+std::vector<double> ReturnCorrelationMatrix(const AlignedMatrix &prices,
+                                            size_t num_threads) {
+  const size_t n = prices.Legs();
+  const size_t rows = prices.Rows();
+  if (rows < 3) {
+    throw std::invalid_argument("Correlation requires at least 3 rows");
+  }
+
+  // Centred changes scaled to unit norm, one contiguous column per leg
+  const size_t changes = rows - 1;
+  std::vector<double> z(n * changes);
+  std::vector<const double *> cols(n);
+  std::vector<bool> constant(n, false);
+  for (size_t k = 0; k < n; ++k) {
+    const double *p = prices.Leg(k);
+    double *c = z.data() + k * changes;
+    double mean = 0.0;
+    for (size_t t = 0; t < changes; ++t) {
+      c[t] = p[t + 1] - p[t];
+      mean += c[t];
+    }
+    mean /= static_cast<double>(changes);
+    double norm = 0.0;
+    for (size_t t = 0; t < changes; ++t) {
+      c[t] -= mean;
+      norm += c[t] * c[t];
+    }
+    constant[k] = !(norm > 0.0);
+    const double scale = constant[k] ? 0.0 : 1.0 / std::sqrt(norm);
+    for (size_t t = 0; t < changes; ++t) c[t] *= scale;
+    cols[k] = c;
+  }
+
+  std::vector<double> corr = Gram(cols, changes, num_threads);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      double &c = corr[i * n + j];
+      c = i == j ? 1.0 : std::clamp(c, -1.0, 1.0);
+    }
+  }
+  return corr;
+}
+
+double EngleGrangerCriticalValue(double significance, size_t observations) {
+  // tau_inf, b1, b2 of c(T) = tau_inf + b1 / T + b2 / T^2
+  static const double kSurface[3][4] = {{0.01, -3.89644, -10.9519, -22.527},
+                                        {0.05, -3.33613, -6.1101, -6.823},
+                                        {0.10, -3.04445, -4.2412, -2.720}};
+  const double t = static_cast<double>(std::max<size_t>(observations, 1));
+  for (const auto &row : kSurface) {
+    if (std::fabs(row[0] - significance) < 1e-9) {
+      return row[1] + row[2] / t + row[3] / (t * t);
+    }
+  }
+  throw std::invalid_argument(
+      "Critical values exist for the 0.01, 0.05 and 0.10 levels only");
+}
+
+PairScreenResult ScreenPairs(const AlignedMatrix &prices,
+                             const PairScreenConfig &config) {
+  const size_t n = prices.Legs();
+  const size_t rows = prices.Rows();
+  const size_t lags = config.adf_lags;
+  if (n < 2) {
+    throw std::invalid_argument("Pair screen requires at least 2 columns");
+  }
+  if (lags > kMaxLags) {
+    throw std::invalid_argument("ADF lag order is limited to 8");
+  }
+  if (rows < 2 * lags + 4) {
+    throw std::invalid_argument("Too few rows for the ADF lag order");
+  }
+  const double critical =
+      EngleGrangerCriticalValue(config.significance, rows - 1 - lags);
+
+  PairScreenResult result;
+  result.columns = n;
+  result.correlation = ReturnCorrelationMatrix(prices, config.num_threads);
+
+  // Centred prices give every pair's OLS slope: cov(x, y) / var(x)
+  std::vector<double> means(n, 0.0);
+  std::vector<double> centred(n * rows);
+  std::vector<const double *> cols(n);
+  for (size_t k = 0; k < n; ++k) {
+    const double *p = prices.Leg(k);
+    for (size_t t = 0; t < rows; ++t) means[k] += p[t];
+    means[k] /= static_cast<double>(rows);
+    double *c = centred.data() + k * rows;
+    for (size_t t = 0; t < rows; ++t) c[t] = p[t] - means[k];
+    cols[k] = c;
+  }
+  const std::vector<double> gram = Gram(cols, rows, config.num_threads);
+  centred = std::vector<double>();
+
+  std::vector<PairStatistics> pairs;
+  pairs.reserve(n * (n - 1) / 2);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = i + 1; j < n; ++j) {
+      PairStatistics s;
+      s.dependent = i;
+      s.independent = j;
+      s.correlation = result.Correlation(i, j);
+      s.tested = s.correlation >= config.min_correlation;
+      pairs.push_back(s);
+    }
+  }
+
+  JobContext *job = config.job;
+  if (job) job->AddWork(JobContext::kPairsTested, pairs.size());
+
+  auto run = [&](size_t begin, size_t end) {
+    if (job) job->Checkpoint();
+    for (size_t p = begin; p < end; ++p) {
+      PairStatistics &s = pairs[p];
+      if (!s.tested) continue;
+      const size_t a = s.dependent;
+      const size_t b = s.independent;
+      AdfFit best;
+      for (const auto &[y, x] : {std::make_pair(a, b), std::make_pair(b, a)}) {
+        const double var_x = gram[x * n + x];
+        if (!(var_x > 0.0)) continue;
+        const double slope = gram[y * n + x] / var_x;
+        const double intercept = means[y] - slope * means[x];
+        const AdfFit fit = ResidualAdf(prices.Leg(y), prices.Leg(x), rows,
+                                       intercept, slope, lags);
+        if (fit.valid && (!best.valid || fit.statistic < best.statistic)) {
+          best = fit;
+          s.dependent = y;
+          s.independent = x;
+          s.hedge_ratio = slope;
+          s.intercept = intercept;
+        }
+      }
+      s.tested = best.valid;
+      s.adf_statistic = best.statistic;
+      s.half_life = best.valid ? HalfLife(best.gamma) : 0.0;
+      s.cointegrated = best.valid && best.statistic < critical;
+    }
+    if (job) job->Advance(JobContext::kPairsTested, end - begin);
+  };
+  ParallelFor(0, pairs.size(), run, TaskCount{config.num_threads});
+
+  for (const auto &s : pairs) {
+    if (s.tested) result.by_cointegration.push_back(s);
+  }
+  KeepTop(result.by_cointegration, config.top_k,
+          [](const PairStatistics &x, const PairStatistics &y) {
+            return x.adf_statistic < y.adf_statistic;
+          });
+  result.by_correlation = std::move(pairs);
+  KeepTop(result.by_correlation, config.top_k,
+          [](const PairStatistics &x, const PairStatistics &y) {
+            return x.correlation > y.correlation;
+          });
+  return result;
+}
+
+PairScreenResult ScreenContracts(const std::vector<Contract> &contracts,
+                                 const BarBucket &bucket,
+                                 const PairScreenConfig &config) {
+  std::vector<TimeSeries> data;
+  data.reserve(contracts.size());
+  for (const auto &contract : contracts) {
+    data.push_back(DataManager::loadResampledData(contract, bucket));
+  }
+
+  std::vector<JoinColumn> columns;
+  columns.reserve(data.size());
+  for (const auto &series : data) columns.push_back(JoinColumn::Closes(series));
+  if (columns.empty()) {
+    throw std::invalid_argument("Pair screen requires at least 2 columns");
+  }
+  return ScreenPairs(JoinTimestamps(columns, JoinMode::kInner), config);
+}
@@ -0,0 +1,147 @@
+/**
+ * @file SeasonalBootstrap.cpp
+ * @brief Implementation of the seasonal bootstrap and permutation tests.
+ */
+
+#include "include/SeasonalBootstrap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "JobRegistry.hpp"
+#include "TaskScheduler.hpp"
+#include "include/Philox.hpp"
+
+namespace {
+
+// Flattened daily changes of all usable years.
+struct ReturnPool {
+  std::vector<double> returns;      // Concatenated per-year changes
+  std::vector<size_t> year_end;     // For every change, end of its year
+  std::vector<double> yearly_pnl;   // Exit minus entry per year
+  size_t path_length = 0;           // Changes per synthetic path
+};
+
+ReturnPool BuildPool(const std::vector<std::vector<double>> &paths) {
+  ReturnPool pool;
+  size_t total = 0;
+  for (const auto &path : paths) {
+    if (path.size() >= 2) total += path.size() - 1;
+  }
+  pool.returns.reserve(total);
+  pool.year_end.reserve(total);
+
+  for (const auto &path : paths) {
+    if (path.size() < 2) continue;
+    const size_t end = pool.returns.size() + path.size() - 1;
+    for (size_t i = 1; i < path.size(); ++i) {
+      pool.returns.push_back(path[i] - path[i - 1]);
+      pool.year_end.push_back(end);
+    }
+    pool.yearly_pnl.push_back(path.back() - path.front());
+  }
+  if (!pool.yearly_pnl.empty()) {
+    pool.path_length = static_cast<size_t>(std::lround(
+        static_cast<double>(total) / pool.yearly_pnl.size()));
+  }
+  return pool;
+}
+
+ConfidenceInterval Percentiles(std::vector<double> &samples,
+                               double confidence) {
+  const double tail = (1.0 - confidence) / 2.0;
+  const double last = static_cast<double>(samples.size() - 1);
+  const size_t lo = static_cast<size_t>(std::floor(tail * last));
+  const size_t hi = static_cast<size_t>(std::ceil((1.0 - tail) * last));
+
+  ConfidenceInterval ci;
+  std::nth_element(samples.begin(), samples.begin() + lo, samples.end());
+  ci.lower = samples[lo];
+  std::nth_element(samples.begin(), samples.begin() + hi, samples.end());
+  ci.upper = samples[hi];
+  return ci;
+}
+
+}  // namespace
+
+BootstrapResult RunSeasonalBootstrap(
+    const std::vector<std::vector<double>> &yearly_paths,
+    const BootstrapConfig &config) {
+  if (!(config.confidence > 0.0 && config.confidence < 1.0)) {
+    throw std::invalid_argument("Bootstrap confidence must be in (0, 1)");
+  }
+  const ReturnPool pool = BuildPool(yearly_paths);
+  if (pool.yearly_pnl.empty()) {
+    throw std::invalid_argument("Bootstrap requires at least one trade path");
+  }
+
+  const size_t years = pool.yearly_pnl.size();
+  const uint32_t pool_size = static_cast<uint32_t>(pool.returns.size());
+  const size_t block = std::max<size_t>(1, config.block_length);
+  const size_t resamples = std::max<size_t>(1, config.resamples);
+
+  BootstrapResult result;
+  result.resamples = resamples;
+  for (double pnl : pool.yearly_pnl) result.mean_pnl += pnl;
+  result.mean_pnl /= years;
+  const double observed = std::fabs(result.mean_pnl);
+
+  std::vector<double> mean_pnl(resamples);
+  std::vector<double> path_pnl(resamples);
+  std::vector<double> drawdown(resamples);
+  std::vector<unsigned char> extreme(resamples);
+
+  JobContext *job = config.job;
+  if (job) job->AddWork(JobContext::kResamples, resamples);
+
+  auto run = [&](size_t begin, size_t end) {
+    for (size_t r = begin; r < end; ++r) {
+      if (job) job->Checkpoint();
+      Philox4x32 rng(config.seed, r);
+
+      double sum = 0.0;
+      for (size_t y = 0; y < years; ++y) {
+        sum += pool.yearly_pnl[rng.Uniform(static_cast<uint32_t>(years))];
+      }
+      mean_pnl[r] = sum / years;
+
+      double level = 0.0;
+      double peak = 0.0;
+      double worst = 0.0;
+      for (size_t filled = 0; filled < pool.path_length;) {
+        size_t i = rng.Uniform(pool_size);
+        const size_t stop = std::min({pool.year_end[i], i + block,
+                                      i + pool.path_length - filled});
+        for (; i < stop; ++i, ++filled) {
+          level += pool.returns[i];
+          peak = std::max(peak, level);
+          worst = std::min(worst, level - peak);
+        }
+      }
+      path_pnl[r] = level;
+      drawdown[r] = worst;
+
+      double flipped = 0.0;
+      for (size_t y = 0; y < years; y += 32) {
+        uint32_t signs = rng.NextU32();
+        for (size_t b = y; b < std::min(years, y + 32); ++b, signs >>= 1) {
+          flipped += (signs & 1u) ? pool.yearly_pnl[b] : -pool.yearly_pnl[b];
+        }
+      }
+      extreme[r] = std::fabs(flipped / years) >= observed;
+    }
+    if (job) job->Advance(JobContext::kResamples, end - begin);
+  };
+
+  // Each resample has its own stream, so chunking never changes the result
+  ParallelFor(0, resamples, run, TaskCount{config.num_threads});
+
+  size_t count = 0;
+  for (unsigned char e : extreme) count += e;
+  result.p_value = static_cast<double>(count + 1) / (resamples + 1);
+  result.mean_pnl_ci = Percentiles(mean_pnl, config.confidence);
+  result.pnl_ci = Percentiles(path_pnl, config.confidence);
+  result.drawdown_ci = Percentiles(drawdown, config.confidence);
+  return result;
+}
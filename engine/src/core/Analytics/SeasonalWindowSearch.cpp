@@ -0,0 +1,246 @@
+/**
+ * @file SeasonalWindowSearch.cpp
+ * @brief Implementation of the tiled, parallel seasonal window search.
+ */
+
+#include "include/SeasonalWindowSearch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#include "JobRegistry.hpp"
+#include "TaskScheduler.hpp"
+
+namespace {
+
+// Entries swept together; their per-year state stays in L1.
+constexpr size_t kEntryTile = 16;
+
+using Better = bool (*)(const SeasonalWindow &, const SeasonalWindow &);
+
+// Final tie-break so the ranking never depends on task scheduling.
+bool Earlier(const SeasonalWindow &a, const SeasonalWindow &b) {
+  if (a.entry_day != b.entry_day) return a.entry_day < b.entry_day;
+  if (a.exit_day != b.exit_day) return a.exit_day < b.exit_day;
+  return a.direction > b.direction;
+}
+
+bool BetterWinRate(const SeasonalWindow &a, const SeasonalWindow &b) {
+  if (a.win_rate != b.win_rate) return a.win_rate > b.win_rate;
+  if (a.average_pnl != b.average_pnl) return a.average_pnl > b.average_pnl;
+  return Earlier(a, b);
+}
+
+bool BetterPnl(const SeasonalWindow &a, const SeasonalWindow &b) {
+  if (a.average_pnl != b.average_pnl) return a.average_pnl > b.average_pnl;
+  return Earlier(a, b);
+}
+
+bool BetterDrawdown(const SeasonalWindow &a, const SeasonalWindow &b) {
+  if (a.worst_drawdown != b.worst_drawdown) {
+    return a.worst_drawdown > b.worst_drawdown;
+  }
+  if (a.average_pnl != b.average_pnl) return a.average_pnl > b.average_pnl;
+  return Earlier(a, b);
+}
+
+/**
+ * Bounded heap whose front is the worst kept window, so a candidate only
+ * costs a comparison unless it displaces that window.
+ */
+class TopK {
+ public:
+  TopK(size_t k, Better better) : k_(k), better_(better) {}
+
+  void Offer(const SeasonalWindow &w) {
+    if (k_ == 0) return;
+    if (heap_.size() < k_) {
+      heap_.push_back(w);
+      std::push_heap(heap_.begin(), heap_.end(), better_);
+    } else if (better_(w, heap_.front())) {
+      std::pop_heap(heap_.begin(), heap_.end(), better_);
+      heap_.back() = w;
+      std::push_heap(heap_.begin(), heap_.end(), better_);
+    }
+  }
+
+  void Merge(const TopK &other) {
+    for (const auto &w : other.heap_) Offer(w);
+  }
+
+  std::vector<SeasonalWindow> Sorted() const {
+    std::vector<SeasonalWindow> sorted = heap_;
+    std::sort(sorted.begin(), sorted.end(), better_);
+    return sorted;
+  }
+
+ private:
+  size_t k_;
+  Better better_;
+  std::vector<SeasonalWindow> heap_;
+};
+
+struct Rankings {
+  TopK win_rate;
+  TopK pnl;
+  TopK drawdown;
+
+  explicit Rankings(size_t k)
+      : win_rate(k, BetterWinRate), pnl(k, BetterPnl),
+        drawdown(k, BetterDrawdown) {}
+
+  void Offer(const SeasonalWindow &w) {
+    win_rate.Offer(w);
+    pnl.Offer(w);
+    if (w.average_pnl > 0.0) drawdown.Offer(w);
+  }
+
+  void Merge(const Rankings &other) {
+    win_rate.Merge(other.win_rate);
+    pnl.Merge(other.pnl);
+    drawdown.Merge(other.drawdown);
+  }
+};
+
+void SearchTile(const SeasonalMatrix &m, const WindowSearchConfig &config,
+                size_t e0, size_t e1, Rankings &out) {
+  const size_t years = m.Years();
+  const size_t days = m.Days();
+  const size_t max_hold = config.max_hold_days ? config.max_hold_days : days;
+  const size_t min_hold = std::max<size_t>(1, config.min_hold_days);
+  const size_t tile = e1 - e0;
+
+  std::vector<double> state(5 * tile * years);
+  double *base = state.data();
+  double *peak = base + tile * years;
+  double *trough = peak + tile * years;
+  double *dd_long = trough + tile * years;
+  double *dd_short = dd_long + tile * years;
+
+  for (size_t t = 0; t < tile; ++t) {
+    const double *row = m.Row(e0 + t);
+    std::copy(row, row + years, base + t * years);
+    std::copy(row, row + years, peak + t * years);
+    std::copy(row, row + years, trough + t * years);
+    std::fill(dd_long + t * years, dd_long + (t + 1) * years, 0.0);
+    std::fill(dd_short + t * years, dd_short + (t + 1) * years, 0.0);
+  }
+
+  const size_t last_exit = std::min(days - 1, e1 - 1 + max_hold);
+  const double inv_years = 1.0 / static_cast<double>(years);
+
+  for (size_t x = e0 + 1; x <= last_exit; ++x) {
+    const double *row = m.Row(x);
+    for (size_t t = 0; t < tile; ++t) {
+      const size_t e = e0 + t;
+      if (e >= x || x - e > max_hold) continue;
+
+      double *b = base + t * years;
+      double *pk = peak + t * years;
+      double *tr = trough + t * years;
+      double *dl = dd_long + t * years;
+      double *ds = dd_short + t * years;
+
+      size_t wins = 0;
+      size_t losses = 0;
+      double sum = 0.0;
+      double worst_long = 0.0;
+      double worst_short = 0.0;
+      for (size_t y = 0; y < years; ++y) {
+        const double level = row[y];
+        pk[y] = std::max(pk[y], level);
+        tr[y] = std::min(tr[y], level);
+        dl[y] = std::min(dl[y], level - pk[y]);
+        ds[y] = std::min(ds[y], tr[y] - level);
+        const double pnl = level - b[y];
+        wins += pnl > 0.0;
+        losses += pnl < 0.0;
+        sum += pnl;
+        worst_long = std::min(worst_long, dl[y]);
+        worst_short = std::min(worst_short, ds[y]);
+      }
+      if (x - e < min_hold) continue;
+
+      SeasonalWindow w;
+      w.entry_day = e;
+      w.exit_day = x;
+      w.direction = 1;
+      w.win_rate = wins * inv_years;
+      w.average_pnl = sum * inv_years;
+      w.worst_drawdown = worst_long;
+      out.Offer(w);
+
+      if (config.allow_short) {
+        w.direction = -1;
+        w.win_rate = losses * inv_years;
+        w.average_pnl = -sum * inv_years;
+        w.worst_drawdown = worst_short;
+        out.Offer(w);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+SeasonalMatrix SeasonalMatrix::FromYears(
+    const std::vector<std::vector<double>> &yearly_levels) {
+  SeasonalMatrix m;
+  if (yearly_levels.empty()) return m;
+
+  m.years_ = yearly_levels.size();
+  m.days_ = std::numeric_limits<size_t>::max();
+  for (const auto &year : yearly_levels) m.days_ = std::min(m.days_, year.size());
+  m.levels_.resize(m.days_ * m.years_);
+
+  for (size_t y = 0; y < m.years_; ++y) {
+    double last = 0.0;
+    for (size_t d = 0; d < m.days_; ++d) {
+      const double v = yearly_levels[y][d];
+      if (!std::isnan(v)) last = v;
+      m.levels_[d * m.years_ + y] = last;
+    }
+  }
+  return m;
+}
+
+WindowSearchResult SearchSeasonalWindows(const SeasonalMatrix &matrix,
+                                         const WindowSearchConfig &config) {
+  WindowSearchResult result;
+  if (matrix.Days() < 2 || matrix.Years() == 0) return result;
+
+  const size_t tiles = (matrix.Days() + kEntryTile - 1) / kEntryTile;
+  size_t num_threads = config.num_threads;
+  if (num_threads == 0) num_threads = TaskScheduler::Instance().NumWorkers();
+  num_threads = std::min(num_threads, tiles);
+
+  JobContext *job = config.job;
+  if (job) job->AddWork(JobContext::kWindowTiles, tiles);
+
+  // Early tiles have the most exits; dynamic hand-out balances the triangle.
+  std::atomic<size_t> next_tile{0};
+  std::vector<Rankings> partial(num_threads, Rankings(config.top_k));
+  auto work = [&](size_t t) {
+    for (size_t i = next_tile++; i < tiles; i = next_tile++) {
+      if (job) job->Checkpoint();
+      const size_t e0 = i * kEntryTile;
+      const size_t e1 = std::min(matrix.Days(), e0 + kEntryTile);
+      SearchTile(matrix, config, e0, e1, partial[t]);
+      if (job) job->Advance(JobContext::kWindowTiles);
+    }
+  };
+
+  TaskGroup group;
+  for (size_t t = 1; t < num_threads; ++t) group.Run([&work, t] { work(t); });
+  work(0);
+  group.Wait();
+
+  Rankings merged(config.top_k);
+  for (const auto &p : partial) merged.Merge(p);
+  result.by_win_rate = merged.win_rate.Sorted();
+  result.by_average_pnl = merged.pnl.Sorted();
+  result.by_worst_drawdown = merged.drawdown.Sorted();
+  return result;
+}
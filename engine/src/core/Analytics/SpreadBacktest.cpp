@@ -0,0 +1,213 @@
+/**
+ * @file SpreadBacktest.cpp
+ * @brief Implementation of the shared z-scores and the per-variant event
+ * loop.
+ */
+
+#include "include/SpreadBacktest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "Indicators.hpp"
+#include "JobRegistry.hpp"
+#include "TaskScheduler.hpp"
+
+namespace {
+
+// A window whose deviation is this small relative to its mean is treated
+// as flat; its z-score would only amplify rounding noise
+constexpr double kFlatWindow = 1e-12;
+
+/**
+ * Rolling z-scores of every lookback, from one batched Bollinger pass with
+ * unit width. Column `k` belongs to `lookbacks[k]`; rows without a full or
+ * with a flat window are NaN.
+ */
+std::vector<std::vector<double>> ZScores(const std::vector<double> &values,
+                                         const std::vector<size_t> &lookbacks) {
+  const size_t rows = values.size();
+  std::vector<std::vector<double>> middle(lookbacks.size(),
+                                          std::vector<double>(rows));
+  std::vector<std::vector<double>> upper = middle;
+  std::vector<std::vector<double>> lower = middle;
+  std::vector<indicators::BollingerSpec> specs;
+  std::vector<indicators::BollingerOutput> outs;
+  for (size_t k = 0; k < lookbacks.size(); ++k) {
+    specs.push_back({lookbacks[k], 1.0});
+    outs.push_back({indicators::OutputColumn::Of(middle[k]),
+                    indicators::OutputColumn::Of(upper[k]),
+                    indicators::OutputColumn::Of(lower[k])});
+  }
+  indicators::Bollinger(indicators::InputColumn::Of(values), specs, outs);
+
+  for (size_t k = 0; k < lookbacks.size(); ++k) {
+    for (size_t i = 0; i < rows; ++i) {
+      const double mean = middle[k][i];
+      const double deviation = upper[k][i] - mean;
+      middle[k][i] = deviation > kFlatWindow * std::fabs(mean)
+                         ? (values[i] - mean) / deviation
+                         : std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+  return middle;
+}
+
+/**
+ * Flat state of one variant while it walks the rows.
+ */
+struct Position {
+  int direction = 0;
+  size_t entry_row = 0;
+  double entry_price = 0.0;
+};
+
+void RunRule(const SpreadSeries &spread, const double *z,
+             const std::pmr::vector<YearSlice> &slices,
+             const BacktestRule &rule, const BacktestConfig &config,
+             BacktestResult &result) {
+  const std::vector<double> &values = spread.values;
+  const std::vector<uint64_t> &timestamps = spread.timestamps;
+  const size_t rows = values.size();
+  const double commission = config.costs.commission;
+  const double slippage =
+      config.costs.slippage_ticks * config.costs.tick_size;
+
+  Position position;
+  double realized = 0.0;
+  double equity = 0.0;
+  MetricsAccumulator total;
+  total.Push(equity);
+
+  for (const auto &slice : slices) {
+    MetricsAccumulator year;
+    year.Push(equity);
+    for (size_t i = slice.begin; i < slice.end; ++i) {
+      const double value = values[i];
+      bool filled = false;
+
+      if (position.direction != 0) {
+        const int d = position.direction;
+        const double mark = d * (value - position.entry_price);
+        ExitReason reason = ExitReason::kSignal;
+        bool exit = true;
+        if (mark <= -rule.stop_loss) {
+          reason = ExitReason::kStopLoss;
+        } else if (mark >= rule.profit_target) {
+          reason = ExitReason::kProfitTarget;
+        } else if (rule.max_holding > 0 &&
+                   i - position.entry_row >= rule.max_holding) {
+          reason = ExitReason::kTimeStop;
+        } else if (d > 0 ? z[i] >= -rule.exit_z : z[i] <= rule.exit_z) {
+          reason = ExitReason::kSignal;
+        } else if (i + 1 == rows) {
+          reason = ExitReason::kEndOfData;
+        } else {
+          exit = false;
+        }
+
+        if (exit) {
+          const double fill = value - d * slippage;
+          const double pnl = d * (fill - position.entry_price) - commission;
+          realized += pnl;
+          ++result.trade_count;
+          if (config.keep_trades) {
+            BacktestTrade trade;
+            trade.direction = d;
+            trade.entry_row = position.entry_row;
+            trade.exit_row = i;
+            trade.entry_time = timestamps[position.entry_row];
+            trade.exit_time = timestamps[i];
+            trade.entry_price = position.entry_price;
+            trade.exit_price = fill;
+            trade.profit_loss = pnl - commission;
+            trade.costs = 2.0 * (commission + slippage);
+            trade.reason = reason;
+            result.trades.push_back(trade);
+          }
+          position = Position();
+          filled = true;
+        }
+      }
+
+      if (!filled && position.direction == 0 && i + 1 < rows) {
+        int d = 0;
+        if (rule.allow_long && z[i] <= -rule.entry_z) {
+          d = 1;
+        } else if (rule.allow_short && z[i] >= rule.entry_z) {
+          d = -1;
+        }
+        if (d != 0) {
+          position.direction = d;
+          position.entry_row = i;
+          position.entry_price = value + d * slippage;
+          realized -= commission;
+        }
+      }
+
+      equity = realized;
+      if (position.direction != 0) {
+        equity += position.direction * (value - position.entry_price);
+      }
+      year.Push(equity);
+      total.Push(equity);
+    }
+    result.yearly.push_back(year.Metrics(slice.year));
+  }
+  result.total = total.Metrics(0);
+}
+
+}  // namespace
+
+std::vector<BacktestResult> RunBacktests(const SpreadSeries &spread,
+                                         const std::vector<BacktestRule> &rules,
+                                         const BacktestConfig &config) {
+  if (spread.timestamps.size() != spread.values.size()) {
+    throw std::invalid_argument("Spread timestamps and values differ");
+  }
+  std::vector<size_t> lookbacks;
+  for (const auto &rule : rules) {
+    if (rule.lookback < 2) {
+      throw std::invalid_argument("Backtest lookback must be at least 2");
+    }
+    if (!(rule.entry_z > 0.0)) {
+      throw std::invalid_argument("Backtest entry_z must be positive");
+    }
+    lookbacks.push_back(rule.lookback);
+  }
+  std::sort(lookbacks.begin(), lookbacks.end());
+  lookbacks.erase(std::unique(lookbacks.begin(), lookbacks.end()),
+                  lookbacks.end());
+
+  const std::vector<std::vector<double>> z = ZScores(spread.values, lookbacks);
+  const std::pmr::vector<YearSlice> slices =
+      SliceByYear(spread.timestamps.data(), spread.timestamps.size());
+
+  std::vector<BacktestResult> results(rules.size());
+  JobContext *job = config.job;
+  if (job) job->AddWork(JobContext::kBacktestsRun, rules.size());
+
+  auto run = [&](size_t begin, size_t end) {
+    if (job) job->Checkpoint();
+    for (size_t r = begin; r < end; ++r) {
+      const size_t k =
+          std::lower_bound(lookbacks.begin(), lookbacks.end(),
+                           rules[r].lookback) -
+          lookbacks.begin();
+      results[r].rule = r;
+      RunRule(spread, z[k].data(), slices, rules[r], config, results[r]);
+    }
+    if (job) job->Advance(JobContext::kBacktestsRun, end - begin);
+  };
+  ParallelFor(0, rules.size(), run, TaskCount{config.num_threads});
+  return results;
+}
+
+BacktestResult RunBacktest(const SpreadSeries &spread,
+                           const BacktestRule &rule,
+                           const BacktestConfig &config) {
+  return std::move(RunBacktests(spread, {rule}, config).front());
+}
@@ -0,0 +1,428 @@
+/**
+ * @file SpreadCache.cpp
+ * @brief Implementation of the spread memoization cache.
+ */
+
+#include "include/SpreadCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+
+#include "ColumnCodecs.hpp"
+#include "DataManager.hpp"
+
+namespace {
+
+constexpr char kBlobMagic[4] = {'A', 'S', 'P', 'C'};
+constexpr char kSpillMagic[4] = {'A', 'S', 'P', 'S'};
+constexpr uint8_t kFormatVersion = 1;
+
+/**
+ * Fixed-size prefix of an encoded series.
+ */
+struct BlobHeader {
+  char magic[4];
+  uint8_t format;
+  uint8_t value_codec;  // ColumnCodec of the values
+  uint16_t reserved;
+  uint64_t rows;
+  double scale;              // Tick scale for kTickDelta, else 0
+  uint64_t timestamp_bytes;  // Encoded timestamp column size
+};
+
+template <typename T>
+void Put(std::string &out, T value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+std::string WorkspaceKey(const std::string &key) { return "spread/" + key; }
+
+std::atomic<uint64_t> spill_sequence{0};  // Unique spill temp file names
+
+}  // namespace
+
+SpreadCache::SpreadCache(SpreadCacheOptions options)
+    : options_(std::move(options)) {
+  if (!options_.spill_dir.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(options_.spill_dir, ec);
+  }
+}
+
+SpreadCache &SpreadCache::Instance() {
+  static SpreadCache cache([] {
+    SpreadCacheOptions options;
+    const char *mb = std::getenv("ALCHEMATH_SPREAD_CACHE_MB");
+    if (mb && std::atoi(mb) > 0) {
+      options.max_memory_bytes = static_cast<size_t>(std::atoi(mb)) << 20;
+    }
+    const char *dir = std::getenv("ALCHEMATH_SPREAD_CACHE_DIR");
+    if (dir) options.spill_dir = dir;
+    return options;
+  }());
+  return cache;
+}
+
+SpreadDefinition SpreadCache::Canonicalize(const SpreadQuery &query) {
+  // Merge legs on the same contract, keeping the first occurrence's place
+  std::vector<SpreadLeg> legs;
+  for (const auto &leg : query.definition.Legs()) {
+    const Contract &c = leg.contract;
+    auto same = std::find_if(legs.begin(), legs.end(), [&](const auto &l) {
+      return l.contract.symbol == c.symbol &&
+             l.contract.expirationMonth == c.expirationMonth &&
+             l.contract.expirationYear == c.expirationYear;
+    });
+    if (same == legs.end()) {
+      legs.push_back({c, leg.weight * leg.multiplier, 1.0});
+    } else {
+      same->weight += leg.weight * leg.multiplier;
+    }
+  }
+
+  // Leg order only matters for the anchor of an as-of join
+  const size_t fixed = query.mode == JoinMode::kAsof && !legs.empty() ? 1 : 0;
+  std::sort(legs.begin() + fixed, legs.end(),
+            [](const SpreadLeg &a, const SpreadLeg &b) {
+              return std::tie(a.contract.symbol, a.contract.expirationYear,
+                              a.contract.expirationMonth) <
+                     std::tie(b.contract.symbol, b.contract.expirationYear,
+                              b.contract.expirationMonth);
+            });
+  return SpreadDefinition(std::move(legs));
+}
+
+std::string SpreadCache::CanonicalKey(const SpreadQuery &query) {
+  const SpreadDefinition canonical = Canonicalize(query);
+  std::string key;
+  Put(key, static_cast<uint8_t>(query.mode));
+  Put(key, query.bucket.width_ms);
+  Put(key, query.bucket.session_start_ms);
+  Put(key, static_cast<uint8_t>(query.bucket.session_aligned));
+  Put(key, query.start_ms);
+  Put(key, query.end_ms);
+  Put(key, static_cast<uint32_t>(canonical.Legs().size()));
+  for (const auto &leg : canonical.Legs()) {
+    // Symbols by name: interned indices differ between processes
+    Put(key, static_cast<uint16_t>(leg.contract.symbol.size()));
+    key += leg.contract.symbol;
+    Put(key, static_cast<int32_t>(leg.contract.expirationYear));
+    Put(key, static_cast<uint8_t>(leg.contract.expirationMonth));
+    Put(key, leg.weight);
+  }
+  return key;
+}
+
+std::string SpreadCache::Versions(const SpreadDefinition &canonical) {
+  std::string versions;
+  for (const auto &leg : canonical.Legs()) {
+    Put(versions, DataManager::contractDataVersion(leg.contract));
+  }
+  return versions;
+}
+
+std::vector<uint8_t> SpreadCache::Encode(const SpreadSeries &series) {
+  const size_t rows = std::min(series.timestamps.size(), series.values.size());
+  BlobHeader header{};
+  std::memcpy(header.magic, kBlobMagic, sizeof(kBlobMagic));
+  header.format = kFormatVersion;
+  header.rows = rows;
+
+  std::vector<uint8_t> timestamps;
+  std::vector<uint8_t> values;
+  if (rows > 0) {
+    EncodeDeltaOfDelta(series.timestamps.data(), rows, timestamps);
+    header.scale = FindTickScale(series.values.data(), rows);
+    if (header.scale > 0.0) {
+      header.value_codec = static_cast<uint8_t>(ColumnCodec::kTickDelta);
+      EncodeTickDelta(series.values.data(), rows, header.scale, values);
+    } else {
+      header.value_codec = static_cast<uint8_t>(ColumnCodec::kXor);
+      EncodeXor(series.values.data(), rows, values);
+    }
+  }
+  header.timestamp_bytes = timestamps.size();
+
+  std::vector<uint8_t> blob(sizeof(header));
+  std::memcpy(blob.data(), &header, sizeof(header));
+  blob.insert(blob.end(), timestamps.begin(), timestamps.end());
+  blob.insert(blob.end(), values.begin(), values.end());
+  return blob;
+}
+
+bool SpreadCache::Decode(const uint8_t *data, size_t size,
+                         SpreadSeries &series) {
+  BlobHeader header;
+  if (size < sizeof(header)) return false;
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, kBlobMagic, sizeof(kBlobMagic)) != 0 ||
+      header.format != kFormatVersion) {
+    return false;
+  }
+  data += sizeof(header);
+  size -= sizeof(header);
+  if (header.timestamp_bytes > size) return false;
+
+  series.timestamps.resize(header.rows);
+  series.values.resize(header.rows);
+  if (header.rows == 0) return true;
+
+  if (DecodeDeltaOfDelta(data, header.timestamp_bytes, header.rows,
+                         series.timestamps.data()) != header.timestamp_bytes) {
+    return false;
+  }
+  data += header.timestamp_bytes;
+  size -= header.timestamp_bytes;
+  switch (static_cast<ColumnCodec>(header.value_codec)) {
+    case ColumnCodec::kTickDelta:
+      return DecodeTickDelta(data, size, header.rows, header.scale,
+                             series.values.data()) == size;
+    case ColumnCodec::kXor:
+      return DecodeXor(data, size, header.rows, series.values.data()) == size;
+    default:
+      return false;
+  }
+}
+
+SpreadSeries SpreadCache::Load(const SpreadQuery &query) {
+  const SpreadDefinition canonical = Canonicalize(query);
+  const std::string key = CanonicalKey(query);
+  std::string versions = Versions(canonical);
+  if (auto cached = Lookup(key, versions)) return std::move(*cached);
+
+  SpreadSeries full = LoadSpread(canonical, query.bucket, query.mode);
+  const auto first = std::lower_bound(full.timestamps.begin(),
+                                      full.timestamps.end(), query.start_ms);
+  const auto last =
+      std::upper_bound(first, full.timestamps.end(), query.end_ms);
+  const size_t lo = first - full.timestamps.begin();
+  const size_t hi = last - full.timestamps.begin();
+  SpreadSeries spread;
+  spread.timestamps.assign(first, last);
+  spread.values.assign(full.values.begin() + lo, full.values.begin() + hi);
+
+  Insert(key, std::move(versions), Encode(spread));
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.misses;
+  return spread;
+}
+
+std::optional<SpreadSeries> SpreadCache::Find(const SpreadQuery &query) {
+  return Lookup(CanonicalKey(query), Versions(Canonicalize(query)));
+}
+
+std::optional<SpreadSeries> SpreadCache::Lookup(const std::string &key,
+                                                const std::string &versions) {
+  std::vector<uint8_t> blob;
+  bool in_memory = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      if (it->second.versions == versions) {
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+        ++stats_.hits;
+        blob = it->second.blob;
+        in_memory = true;
+      } else {
+        EraseLocked(key);
+        ++stats_.invalidated;
+        if (!options_.spill_dir.empty()) {
+          std::error_code ec;
+          std::filesystem::remove(SpillPath(key), ec);
+        }
+        return std::nullopt;
+      }
+    }
+  }
+
+  std::shared_ptr<const Workspace> workspace;
+  if (!in_memory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workspace = workspace_;
+  }
+  if (!in_memory && workspace &&
+      workspace->ReadBlob(WorkspaceKey(key), Fnv1a(versions), blob)) {
+    Insert(key, versions, blob);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.workspace_hits;
+  } else if (!in_memory) {
+    if (options_.spill_dir.empty()) return std::nullopt;
+    std::string stored;
+    if (!ReadSpill(key, stored, blob)) return std::nullopt;
+    if (stored != versions) {
+      std::error_code ec;
+      std::filesystem::remove(SpillPath(key), ec);
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++stats_.invalidated;
+      return std::nullopt;
+    }
+    Insert(key, stored, blob);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.disk_hits;
+  }
+
+  SpreadSeries series;
+  if (!Decode(blob.data(), blob.size(), series)) return std::nullopt;
+  return series;
+}
+
+void SpreadCache::Insert(const std::string &key, std::string versions,
+                         std::vector<uint8_t> blob) {
+  std::vector<std::pair<std::string, Entry>> evicted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EraseLocked(key);
+    lru_.push_front(key);
+    Entry &entry = entries_[key];
+    entry.versions = std::move(versions);
+    entry.blob = std::move(blob);
+    entry.lru = lru_.begin();
+    stats_.memory_bytes += Footprint(key, entry);
+    evicted = EvictLocked();
+  }
+
+  // Disk writes happen unlocked so they never stall other lookups
+  size_t spilled = 0;
+  for (const auto &[spill_key, spill_entry] : evicted) {
+    spilled += WriteSpill(spill_key, spill_entry);
+  }
+  if (spilled > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.spills += spilled;
+  }
+}
+
+size_t SpreadCache::Footprint(const std::string &key, const Entry &entry) {
+  return key.size() + entry.versions.size() + entry.blob.size();
+}
+
+void SpreadCache::EraseLocked(const std::string &key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return;
+  stats_.memory_bytes -= Footprint(key, it->second);
+  lru_.erase(it->second.lru);
+  entries_.erase(it);
+}
+
+std::vector<std::pair<std::string, SpreadCache::Entry>>
+SpreadCache::EvictLocked() {
+  std::vector<std::pair<std::string, Entry>> evicted;
+  while (stats_.memory_bytes > options_.max_memory_bytes && !lru_.empty()) {
+    auto it = entries_.find(lru_.back());
+    stats_.memory_bytes -= Footprint(it->first, it->second);
+    lru_.pop_back();
+    if (!options_.spill_dir.empty()) {
+      evicted.emplace_back(it->first, std::move(it->second));
+    }
+    entries_.erase(it);
+    ++stats_.evictions;
+  }
+  stats_.entries = entries_.size();
+  return evicted;
+}
+
+void SpreadCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  lru_.clear();
+  stats_ = SpreadCacheStats();
+}
+
+SpreadCacheStats SpreadCache::Stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SpreadCacheStats stats = stats_;
+  stats.entries = entries_.size();
+  return stats;
+}
+
+size_t SpreadCache::Snapshot(WorkspaceWriter &writer) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t written = 0;
+  for (const auto &[key, entry] : entries_) {
+    if (writer.AddBlob(WorkspaceKey(key), Fnv1a(entry.versions),
+                       entry.blob.data(), entry.blob.size())) {
+      ++written;
+    }
+  }
+  return written;
+}
+
+void SpreadCache::Attach(std::shared_ptr<const Workspace> workspace) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  workspace_ = std::move(workspace);
+}
+
+std::string SpreadCache::SpillPath(const std::string &key) const {
+  static const char kHex[] = "0123456789abcdef";
+  uint64_t hash = Fnv1a(key);
+  std::string name(16, '0');
+  for (int i = 15; i >= 0; --i, hash >>= 4) name[i] = kHex[hash & 0xF];
+  return (std::filesystem::path(options_.spill_dir) / (name + ".spc"))
+      .string();
+}
+
+bool SpreadCache::WriteSpill(const std::string &key,
+                             const Entry &entry) const {
+  std::string header(kSpillMagic, sizeof(kSpillMagic));
+  Put(header, static_cast<uint32_t>(key.size()));
+  header += key;
+  Put(header, static_cast<uint32_t>(entry.versions.size()));
+  header += entry.versions;
+  Put(header, static_cast<uint64_t>(entry.blob.size()));
+
+  // Write-then-rename, so readers never see a partial file; temp names are
+  // unique because evictions of the same key may spill concurrently
+  const std::string path = SpillPath(key);
+  const std::string temp =
+      path + "." + std::to_string(spill_sequence.fetch_add(1)) + ".tmp";
+  bool written;
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    out.write(header.data(), header.size());
+    out.write(reinterpret_cast<const char *>(entry.blob.data()),
+              entry.blob.size());
+    written = static_cast<bool>(out);
+  }
+  std::error_code ec;
+  if (written) {
+    std::filesystem::rename(temp, path, ec);
+    written = !ec;
+  }
+  if (!written) std::filesystem::remove(temp, ec);
+  return written;
+}
+
+bool SpreadCache::ReadSpill(const std::string &key, std::string &versions,
+                            std::vector<uint8_t> &blob) const {
+  std::ifstream in(SpillPath(key), std::ios::binary);
+  if (!in) return false;
+
+  auto read_string = [&in](std::string &out) {
+    uint32_t length = 0;
+    if (!in.read(reinterpret_cast<char *>(&length), sizeof(length))) {
+      return false;
+    }
+    out.resize(length);
+    return static_cast<bool>(in.read(out.data(), length));
+  };
+
+  char magic[sizeof(kSpillMagic)];
+  std::string stored_key;
+  uint64_t size = 0;
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, kSpillMagic, sizeof(magic)) != 0 ||
+      !read_string(stored_key) || stored_key != key ||
+      !read_string(versions) ||
+      !in.read(reinterpret_cast<char *>(&size), sizeof(size))) {
+    return false;  // Unreadable, or a different key with the same hash
+  }
+  blob.resize(size);
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char *>(blob.data()), size));
+}
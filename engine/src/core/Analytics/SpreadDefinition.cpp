@@ -0,0 +1,146 @@
+/**
+ * @file SpreadDefinition.cpp
+ * @brief Implementation of spread expressions and the fused evaluator.
+ */
+
+#include "include/SpreadDefinition.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "DataManager.hpp"
+
+namespace {
+
+// Rows per block in the generic kernel; keeps the output block in L1 while
+// every leg streams through it.
+constexpr size_t kBlockRows = 512;
+
+double Coefficient(const SpreadLeg &leg) {
+  return leg.weight * leg.multiplier;
+}
+
+template <size_t K>
+void CombineFixed(const AlignedMatrix &m, const std::vector<SpreadLeg> &legs,
+                  double *out) {
+  const double *leg[K];
+  double c[K];
+  for (size_t k = 0; k < K; ++k) {
+    leg[k] = m.Leg(k);
+    c[k] = Coefficient(legs[k]);
+  }
+  const size_t rows = m.Rows();
+  for (size_t i = 0; i < rows; ++i) {
+    double acc = c[0] * leg[0][i];
+    for (size_t k = 1; k < K; ++k) acc += c[k] * leg[k][i];
+    out[i] = acc;
+  }
+}
+
+void CombineBlocked(const AlignedMatrix &m,
+                    const std::vector<SpreadLeg> &legs, double *out) {
+  const size_t rows = m.Rows();
+  for (size_t begin = 0; begin < rows; begin += kBlockRows) {
+    const size_t end = std::min(rows, begin + kBlockRows);
+    const double *first = m.Leg(0);
+    const double c0 = Coefficient(legs[0]);
+    for (size_t i = begin; i < end; ++i) out[i] = c0 * first[i];
+    for (size_t k = 1; k < legs.size(); ++k) {
+      const double *leg = m.Leg(k);
+      const double c = Coefficient(legs[k]);
+      for (size_t i = begin; i < end; ++i) out[i] += c * leg[i];
+    }
+  }
+}
+
+}  // namespace
+
+SpreadDefinition::SpreadDefinition(std::vector<SpreadLeg> legs)
+    : legs_(std::move(legs)) {}
+
+SpreadDefinition SpreadDefinition::Calendar(const std::string &symbol,
+                                            ExpirationMonth near,
+                                            ExpirationMonth far, int year,
+                                            int far_year_offset) {
+  return SpreadDefinition(
+      {{{symbol, near, year}, 1.0, 1.0, 0},
+       {{symbol, far, year + far_year_offset}, -1.0, 1.0, far_year_offset}});
+}
+
+SpreadDefinition SpreadDefinition::Butterfly(const std::string &symbol,
+                                             ExpirationMonth wing1,
+                                             ExpirationMonth body,
+                                             ExpirationMonth wing2, int year) {
+  return SpreadDefinition({{{symbol, wing1, year}, 1.0, 1.0},
+                           {{symbol, body, year}, -2.0, 1.0},
+                           {{symbol, wing2, year}, 1.0, 1.0}});
+}
+
+SpreadDefinition SpreadDefinition::SoybeanCrush(ExpirationMonth month,
+                                                int year) {
+  // 44 lb of meal (0.022 st) and 11 lb of oil per 60 lb bushel of beans
+  return SpreadDefinition({{{"ZM", month, year}, 1.0, 0.022},
+                           {{"ZL", month, year}, 1.0, 0.11},
+                           {{"ZS", month, year}, -1.0, 0.01}});
+}
+
+SpreadDefinition SpreadDefinition::ShiftedYears(int years) const {
+  SpreadDefinition shifted = *this;
+  for (auto &leg : shifted.legs_) leg.contract.expirationYear += years;
+  return shifted;
+}
+
+SpreadDefinition SpreadDefinition::ForYear(int base_year) const {
+  SpreadDefinition rebased = *this;
+  for (auto &leg : rebased.legs_) {
+    leg.contract.expirationYear = base_year + leg.year_offset;
+  }
+  return rebased;
+}
+
+std::vector<double> SpreadDefinition::Coefficients() const {
+  std::vector<double> coeff;
+  coeff.reserve(legs_.size());
+  for (const auto &leg : legs_) coeff.push_back(Coefficient(leg));
+  return coeff;
+}
+
+void EvaluateSpread(const SpreadDefinition &definition,
+                    const AlignedMatrix &legs, double *out) {
+  if (definition.Legs().size() != legs.Legs() || legs.Legs() == 0) {
+    throw std::invalid_argument("Spread legs do not match aligned matrix");
+  }
+
+  // Coefficients are formed in the kernels, which keeps evaluation free of
+  // heap allocations
+  const std::vector<SpreadLeg> &terms = definition.Legs();
+  switch (legs.Legs()) {
+    case 1: CombineFixed<1>(legs, terms, out); break;
+    case 2: CombineFixed<2>(legs, terms, out); break;
+    case 3: CombineFixed<3>(legs, terms, out); break;
+    case 4: CombineFixed<4>(legs, terms, out); break;
+    default: CombineBlocked(legs, terms, out); break;
+  }
+}
+
+SpreadSeries LoadSpread(const SpreadDefinition &definition,
+                        const BarBucket &bucket, JoinMode mode) {
+  std::vector<TimeSeries> data;
+  data.reserve(definition.Legs().size());
+  for (const auto &leg : definition.Legs()) {
+    data.push_back(DataManager::loadResampledData(leg.contract, bucket));
+  }
+
+  std::vector<JoinColumn> columns;
+  columns.reserve(data.size());
+  for (const auto &series : data) columns.push_back(JoinColumn::Closes(series));
+
+  AlignedMatrix aligned = JoinTimestamps(columns, mode);
+
+  SpreadSeries spread;
+  spread.timestamps.assign(aligned.Timestamps().begin(),
+                           aligned.Timestamps().end());
+  spread.values.resize(aligned.Rows());
+  EvaluateSpread(definition, aligned, spread.values.data());
+  return spread;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file SpreadMetrics.cpp
+ * @brief Implementation of the metric accumulators and incremental study.
+ */
+
+#include "include/SpreadMetrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "CivilDate.hpp"
+
+void MetricsAccumulator::Push(double value) {
+  if (count_ == 0) {
+    first_ = value;
+  } else {
+    const double r = value - last_;
+    ++returns_;
+    const double delta = r - mean_;
+    mean_ += delta / returns_;
+    m2_ += delta * (r - mean_);
+    if (r > 0.0) {
+      ++wins_;
+      win_sum_ += r;
+    } else if (r < 0.0) {
+      ++losses_;
+      loss_sum_ += r;
+    }
+  }
+  ++count_;
+  last_ = value;
+
+  peak_ = std::max(peak_, value);
+  trough_ = std::min(trough_, value);
+  max_drawdown_ = std::min(max_drawdown_, value - peak_);
+  max_runup_ = std::max(max_runup_, value - trough_);
+}
+
+YearlyMetrics MetricsAccumulator::Metrics(int year) const {
+  YearlyMetrics m;
+  m.year = year;
+  m.rows = count_;
+  if (count_ == 0) return m;
+  m.profit_loss = last_ - first_;
+  m.total_return = m.profit_loss;
+  m.max_drawdown = max_drawdown_;
+  m.max_profit = max_runup_;
+  if (returns_ > 0) {
+    m.standard_deviation = std::sqrt(m2_ / returns_);
+    m.sharpe_ratio =
+        m.standard_deviation > 0.0 ? mean_ / m.standard_deviation : 0.0;
+    m.win_rate = static_cast<double>(wins_) / returns_;
+  }
+  if (wins_ > 0) m.avg_win = win_sum_ / wins_;
+  if (losses_ > 0) m.avg_loss = loss_sum_ / losses_;
+  return m;
+}
+
+std::pmr::vector<YearSlice> SliceByYear(const uint64_t *timestamps,
+                                        size_t rows,
+                                        std::pmr::memory_resource *resource) {
+  std::pmr::vector<YearSlice> slices(resource);
+  size_t begin = 0;
+  while (begin < rows) {
+    const int year = CivilFromDays(DayFromTimestamp(timestamps[begin])).year;
+    const uint64_t next_year =
+        static_cast<uint64_t>(DaysFromCivil(year + 1, 1, 1)) * 86400000ULL;
+    const size_t end =
+        std::lower_bound(timestamps + begin, timestamps + rows, next_year) -
+        timestamps;
+    slices.push_back({year, begin, end});
+    begin = end;
+  }
+  return slices;
+}
+
+std::pmr::vector<YearlyMetrics> MetricsByYear(
+    const uint64_t *timestamps, const double *values, size_t rows,
+    std::pmr::memory_resource *resource) {
+  const std::pmr::vector<YearSlice> slices =
+      SliceByYear(timestamps, rows, resource);
+  std::pmr::vector<YearlyMetrics> metrics(resource);
+  metrics.reserve(slices.size());
+  for (const auto &slice : slices) {
+    MetricsAccumulator acc;
+    acc.Push(values + slice.begin, slice.end - slice.begin);
+    metrics.push_back(acc.Metrics(slice.year));
+  }
+  return metrics;
+}
+
+IncrementalSpreadAnalysis::IncrementalSpreadAnalysis(
+    std::vector<SpreadYear> history, SpreadYear current,
+    std::vector<size_t> average_windows, std::pmr::memory_resource *scratch)
+    : history_(std::move(history)),
+      average_windows_(std::move(average_windows)) {
+  std::sort(history_.begin(), history_.end(),
+            [](const SpreadYear &a, const SpreadYear &b) {
+              return a.year < b.year;
+            });
+
+  historical_metrics_.reserve(history_.size());
+  for (const auto &year : history_) {
+    MetricsAccumulator acc;
+    acc.Push(year.series.values.data(), year.series.values.size());
+    historical_metrics_.push_back(acc.Metrics(year.year));
+  }
+
+  // One running sum per row, extended year by year from the most recent,
+  // snapshotted whenever the year count reaches a window
+  std::pmr::vector<double> sum(scratch);
+  std::pmr::vector<size_t> count(scratch);
+  averages_.resize(average_windows_.size());
+  for (size_t n = 1; n <= history_.size(); ++n) {
+    const auto &values = history_[history_.size() - n].series.values;
+    if (values.size() > sum.size()) {
+      sum.resize(values.size(), 0.0);
+      count.resize(values.size(), 0);
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+      sum[i] += values[i];
+      ++count[i];
+    }
+    for (size_t w = 0; w < average_windows_.size(); ++w) {
+      // Fewer years than the window: average what there is, as the API did
+      if (average_windows_[w] == n ||
+          (n == history_.size() && average_windows_[w] > n)) {
+        auto &average = averages_[w];
+        average.resize(sum.size());
+        for (size_t i = 0; i < sum.size(); ++i) {
+          average[i] = sum[i] / count[i];
+        }
+      }
+    }
+  }
+
+  current_.year = current.year;
+  Append(current.series);
+}
+
+size_t IncrementalSpreadAnalysis::Append(const SpreadSeries &rows) {
+  const size_t n = std::min(rows.timestamps.size(), rows.values.size());
+  auto &ts = current_.series.timestamps;
+  auto &values = current_.series.values;
+  size_t applied = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const uint64_t t = rows.timestamps[i];
+    if (!ts.empty() && t < ts.back()) continue;
+    if (!ts.empty() && t == ts.back()) {
+      values.back() = rows.values[i];
+      metrics_ = before_last_;
+    } else {
+      ts.push_back(t);
+      values.push_back(rows.values[i]);
+      before_last_ = metrics_;
+    }
+    metrics_.Push(rows.values[i]);
+    ++applied;
+  }
+  return applied;
+}
+
+YearlyMetrics IncrementalSpreadAnalysis::CurrentMetrics() const {
+  return metrics_.Metrics(current_.year);
+}
+
+const std::vector<double> &IncrementalSpreadAnalysis::Average(
+    size_t years) const {
+  for (size_t w = 0; w < average_windows_.size(); ++w) {
+    if (average_windows_[w] == years) return averages_[w];
+  }
+  throw std::out_of_range("No " + std::to_string(years) +
+                          "-year average configured");
+}
@@ -0,0 +1,178 @@
+/**
+ * @file TimestampJoin.cpp
+ * @brief Implementation of the k-way timestamp merge-join.
+ */
+
+#include "include/TimestampJoin.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * Returns the first index in [lo, n) whose timestamp is >= target, probing
+ * lo + 1, lo + 2, lo + 4, ... before a binary search over the last gap.
+ */
+size_t Gallop(const uint64_t *ts, size_t lo, size_t n, uint64_t target) {
+  size_t hi = lo;
+  size_t step = 1;
+  while (hi < n && ts[hi] < target) {
+    lo = hi + 1;
+    hi += step;
+    step <<= 1;
+  }
+  hi = std::min(hi, n);
+  return std::lower_bound(ts + lo, ts + hi, target) - ts;
+}
+
+AlignedMatrix InnerJoin(const JoinColumn *legs, size_t k,
+                        std::pmr::memory_resource *resource) {
+  size_t capacity = legs[0].size;
+  for (size_t j = 1; j < k; ++j) capacity = std::min(capacity, legs[j].size);
+
+  AlignedMatrix out(k, capacity, resource);
+  std::pmr::vector<size_t> pos(k, 0, resource);
+  if (capacity == 0) return out;
+
+  uint64_t candidate = legs[0].timestamps[0];
+  for (;;) {
+    bool aligned = true;
+    for (size_t j = 0; j < k; ++j) {
+      pos[j] = Gallop(legs[j].timestamps, pos[j], legs[j].size, candidate);
+      if (pos[j] == legs[j].size) return out;
+      if (legs[j].timestamps[pos[j]] != candidate) {
+        candidate = legs[j].timestamps[pos[j]];
+        aligned = false;
+      }
+    }
+    if (!aligned) continue;
+
+    const size_t row = out.Rows();
+    out.PushRow(candidate);
+    for (size_t j = 0; j < k; ++j) {
+      out.Leg(j)[row] = legs[j].values[pos[j]];
+      ++pos[j];
+    }
+    if (pos[0] == legs[0].size) return out;
+    candidate = legs[0].timestamps[pos[0]];
+  }
+}
+
+AlignedMatrix OuterJoin(const JoinColumn *legs, size_t k,
+                        std::pmr::memory_resource *resource) {
+  size_t capacity = 0;
+  for (size_t j = 0; j < k; ++j) capacity += legs[j].size;
+
+  AlignedMatrix out(k, capacity, resource);
+  std::pmr::vector<size_t> pos(k, 0, resource);
+  std::pmr::vector<double> last(k, 0.0, resource);
+  size_t seen = 0;
+
+  for (;;) {
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    bool any = false;
+    for (size_t j = 0; j < k; ++j) {
+      if (pos[j] < legs[j].size) {
+        next = std::min(next, legs[j].timestamps[pos[j]]);
+        any = true;
+      }
+    }
+    if (!any) break;
+
+    for (size_t j = 0; j < k; ++j) {
+      if (pos[j] < legs[j].size && legs[j].timestamps[pos[j]] == next) {
+        if (pos[j] == 0) ++seen;
+        last[j] = legs[j].values[pos[j]++];
+      }
+    }
+    if (seen < k) continue;
+
+    const size_t row = out.Rows();
+    out.PushRow(next);
+    for (size_t j = 0; j < k; ++j) out.Leg(j)[row] = last[j];
+  }
+  return out;
+}
+
+AlignedMatrix AsofJoin(const JoinColumn *legs, size_t k,
+                       uint64_t tolerance_ms,
+                       std::pmr::memory_resource *resource) {
+  const JoinColumn &ref = legs[0];
+
+  AlignedMatrix out(k, ref.size, resource);
+  std::pmr::vector<size_t> pos(k, 0, resource);
+
+  for (size_t i = 0; i < ref.size; ++i) {
+    const uint64_t t = ref.timestamps[i];
+    bool matched = true;
+    for (size_t j = 1; j < k && matched; ++j) {
+      // pos[j] becomes the first row after t; the match is the row before
+      pos[j] = Gallop(legs[j].timestamps, pos[j], legs[j].size, t + 1);
+      matched = pos[j] > 0 &&
+                t - legs[j].timestamps[pos[j] - 1] <= tolerance_ms;
+    }
+    if (!matched) continue;
+
+    const size_t row = out.Rows();
+    out.PushRow(t);
+    out.Leg(0)[row] = ref.values[i];
+    for (size_t j = 1; j < k; ++j) {
+      out.Leg(j)[row] = legs[j].values[pos[j] - 1];
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+AlignedMatrix::AlignedMatrix(size_t legs, size_t capacity,
+                             std::pmr::memory_resource *resource)
+    : legs_(legs),
+      capacity_(capacity),
+      timestamps_(resource),
+      values_(legs * capacity, resource) {
+  timestamps_.reserve(capacity);
+}
+
+void AlignedMatrix::ShrinkToFit() {
+  const size_t rows = Rows();
+  if (rows == capacity_) return;
+  for (size_t k = 1; k < legs_; ++k) {
+    std::memmove(values_.data() + k * rows, values_.data() + k * capacity_,
+                 rows * sizeof(double));
+  }
+  capacity_ = rows;
+  values_.resize(legs_ * rows);
+  // An arena only reclaims memory at the end of the request; a tighter
+  // copy would just use more of it
+  if (values_.get_allocator().resource() == std::pmr::get_default_resource()) {
+    values_.shrink_to_fit();
+    timestamps_.shrink_to_fit();
+  }
+}
+
+AlignedMatrix JoinTimestamps(const std::vector<JoinColumn> &legs,
+                             JoinMode mode, uint64_t tolerance_ms) {
+  return JoinTimestamps(legs.data(), legs.size(), mode,
+                        std::pmr::get_default_resource(), tolerance_ms);
+}
+
+AlignedMatrix JoinTimestamps(const JoinColumn *legs, size_t count,
+                             JoinMode mode,
+                             std::pmr::memory_resource *resource,
+                             uint64_t tolerance_ms) {
+  if (count == 0) {
+    throw std::invalid_argument("Join requires at least one leg");
+  }
+
+  // Constructed, not assigned: assigning between resources would copy
+  AlignedMatrix out =
+      mode == JoinMode::kInner ? InnerJoin(legs, count, resource)
+      : mode == JoinMode::kOuterForwardFill
+          ? OuterJoin(legs, count, resource)
+          : AsofJoin(legs, count, tolerance_ms, resource);
+  out.ShrinkToFit();
+  return out;
+}
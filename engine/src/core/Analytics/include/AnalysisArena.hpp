@@ -0,0 +1,102 @@
+/**
+ * @file AnalysisArena.hpp
+ * @brief Per-request monotonic arena for analysis temporaries.
+ *
+ * One analysis builds many short-lived buffers: aligned legs, spread values,
+ * per-year slices and metric scratch. Taking each from the global heap costs
+ * a malloc (and under load, allocator contention and fresh page faults) for
+ * memory that is all dead by the end of the request. An arena hands them out
+ * by bumping a pointer and frees them together.
+ */
+
+#ifndef ANALYSIS_ARENA_HPP
+#define ANALYSIS_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+/**
+ * @class AnalysisArena
+ * @brief Monotonic `std::pmr` resource over a block kept between requests.
+ *
+ * Allocations are served from one retained block; deallocation is a no-op.
+ * A request that needs more spills into heap chunks, and the next Reset()
+ * replaces the block with one large enough for that request, so an arena
+ * reused for similar requests stops touching the global heap after the
+ * first one.
+ *
+ * Pass Resource() to the `std::pmr::memory_resource *` parameters of the
+ * join, spread and metrics functions. Nothing allocated from the arena may
+ * outlive the next Reset(). An arena is not thread-safe; give every worker
+ * or request its own.
+ *
+ * @example
+ * ```cpp
+ * AnalysisArena arena;
+ * for (const auto &request : requests) {
+ *   AlignedMatrix legs = JoinTimestamps(columns.data(), columns.size(),
+ *                                       JoinMode::kInner, arena.Resource());
+ *   ...
+ *   arena.Reset();  // Frees every temporary of the request at once
+ * }
+ * ```
+ */
+class AnalysisArena {
+ public:
+  /// Default size of the retained block.
+  static constexpr size_t kDefaultCapacity = size_t{1} << 20;
+
+  explicit AnalysisArena(size_t capacity = kDefaultCapacity);
+
+  AnalysisArena(const AnalysisArena &) = delete;
+  AnalysisArena &operator=(const AnalysisArena &) = delete;
+
+  std::pmr::memory_resource *Resource() { return &*arena_; }
+
+  /**
+   * @brief Frees everything allocated since the last reset.
+   *
+   * O(1) unless the request spilled, in which case the retained block is
+   * regrown to cover it.
+   */
+  void Reset();
+
+  /**
+   * @brief Size of the retained block in bytes.
+   */
+  size_t Capacity() const { return capacity_; }
+
+  /**
+   * @brief Bytes taken from the heap beyond the block since the last reset.
+   */
+  size_t Spilled() const { return upstream_.Allocated(); }
+
+ private:
+  /**
+   * Forwards to the heap and counts what it hands out.
+   */
+  class CountingResource : public std::pmr::memory_resource {
+   public:
+    size_t Allocated() const { return allocated_; }
+    void ResetCount() { allocated_ = 0; }
+
+   private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(
+        const std::pmr::memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+
+    size_t allocated_ = 0;
+  };
+
+  size_t capacity_;
+  std::unique_ptr<std::byte[]> block_;
+  CountingResource upstream_;
+  std::optional<std::pmr::monotonic_buffer_resource> arena_;
+};
+
+#endif /* ANALYSIS_ARENA_HPP */
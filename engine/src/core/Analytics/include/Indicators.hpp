@@ -0,0 +1,177 @@
+/**
+ * @file Indicators.hpp
+ * @brief Technical indicators over strided column views.
+ *
+ * EMA, ATR, Bollinger bands, RSI and percentile rank of spreads and legs.
+ * Every indicator reads its inputs through non-owning views and writes into
+ * columns the caller allocated, so it runs directly on TimeSeries columns,
+ * aligned legs, OHLCV row arrays or any foreign buffer with a stride, without
+ * copies.
+ *
+ * The recurrences (EMA, Wilder smoothing) cannot be vectorized along time.
+ * Their batched forms take many parameter values instead and keep the state
+ * of every parameter in one contiguous array, so each row is read once and
+ * the per-row update runs across parameters.
+ *
+ * Rows before an indicator's warm-up period are NaN. Inputs are expected to
+ * be finite.
+ *
+ * @example
+ * ```cpp
+ * using namespace indicators;
+ * std::vector<double> fast(series.size()), slow(series.size());
+ * Ema(InputColumn::Of(series.Closes()), {12, 26},
+ *     {OutputColumn::Of(fast), OutputColumn::Of(slow)});
+ * ```
+ */
+
+#ifndef INDICATORS_HPP
+#define INDICATORS_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "TimeSeries.hpp"
+
+namespace indicators {
+
+/**
+ * @struct StridedColumn
+ * @brief `size` values, `stride` elements apart.
+ */
+template <typename T>
+struct StridedColumn {
+  T *data = nullptr;
+  size_t size = 0;
+  size_t stride = 1;  ///< Distance between values, in elements
+
+  T &operator[](size_t i) const { return data[i * stride]; }
+
+  /**
+   * @brief Views a contiguous vector.
+   */
+  template <typename V>
+  static StridedColumn Of(V &values) {
+    return {values.data(), values.size(), 1};
+  }
+};
+
+using InputColumn = StridedColumn<const double>;
+using OutputColumn = StridedColumn<double>;
+
+/**
+ * @brief Views one price field of OHLCV rows, e.g. `&OHLCV::close`.
+ */
+inline InputColumn RowField(const OHLCV *rows, size_t count,
+                            double OHLCV::*field) {
+  static_assert(sizeof(OHLCV) % sizeof(double) == 0,
+                "OHLCV rows must be a whole number of doubles");
+  return {count ? &(rows->*field) : nullptr, count,
+          sizeof(OHLCV) / sizeof(double)};
+}
+
+/**
+ * @brief Exponential moving average, `alpha = 2 / (period + 1)`.
+ *
+ * Seeded with the simple average of the first `period` values; the first
+ * value is at row `period - 1`.
+ *
+ * @throws std::invalid_argument if `period` is 0 or `out` is shorter than
+ *         `input`
+ */
+void Ema(InputColumn input, size_t period, OutputColumn out);
+
+/**
+ * @brief EMA of every period in one pass; `outs[p]` receives `periods[p]`.
+ */
+void Ema(InputColumn input, const std::vector<size_t> &periods,
+         const std::vector<OutputColumn> &outs);
+
+/**
+ * @brief Wilder's average true range.
+ *
+ * The true range is read from the three columns in the same pass that
+ * smooths it. The first row's range is `high - low`; the first value is at
+ * row `period - 1`, the mean of the first `period` ranges.
+ */
+void Atr(InputColumn high, InputColumn low, InputColumn close, size_t period,
+         OutputColumn out);
+
+/**
+ * @brief ATR of every period in one pass.
+ */
+void Atr(InputColumn high, InputColumn low, InputColumn close,
+         const std::vector<size_t> &periods,
+         const std::vector<OutputColumn> &outs);
+
+/**
+ * @struct BollingerSpec
+ * @brief Window and band width, in population standard deviations.
+ */
+struct BollingerSpec {
+  size_t period = 20;
+  double width = 2.0;
+};
+
+/**
+ * @struct BollingerOutput
+ * @brief Destination of the middle, upper and lower bands.
+ */
+struct BollingerOutput {
+  OutputColumn middle;
+  OutputColumn upper;
+  OutputColumn lower;
+};
+
+/**
+ * @brief Rolling mean plus and minus `width` rolling deviations.
+ *
+ * Mean and squared deviations follow Welford's update, sliding the window
+ * by one value per row, and are recomputed exactly once every `period`
+ * rows, so prices far from zero with a small spread do not lose their
+ * variance to cancellation or drift. The first value is at row
+ * `period - 1`.
+ */
+void Bollinger(InputColumn input, const BollingerSpec &spec,
+               const BollingerOutput &out);
+
+/**
+ * @brief Bollinger bands of every spec in one pass.
+ */
+void Bollinger(InputColumn input, const std::vector<BollingerSpec> &specs,
+               const std::vector<BollingerOutput> &outs);
+
+/**
+ * @brief Wilder's relative strength index, 0 to 100.
+ *
+ * Average gains and losses are seeded with the mean of the first `period`
+ * changes; the first value is at row `period`. A window without losses is
+ * 100, one without any change 50.
+ */
+void Rsi(InputColumn input, size_t period, OutputColumn out);
+
+/**
+ * @brief RSI of every period in one pass.
+ */
+void Rsi(InputColumn input, const std::vector<size_t> &periods,
+         const std::vector<OutputColumn> &outs);
+
+/**
+ * @brief Percentage of the `window` preceding values at or below the
+ * current one, 0 to 100.
+ *
+ * The window is kept sorted, so each row costs a binary search and one
+ * shift of at most `window` values. The first value is at row `window`.
+ * NaN rows rank as NaN and are left out of later windows' counts.
+ */
+void PercentileRank(InputColumn input, size_t window, OutputColumn out);
+
+/**
+ * @brief Percentile rank for every window in one pass.
+ */
+void PercentileRank(InputColumn input, const std::vector<size_t> &windows,
+                    const std::vector<OutputColumn> &outs);
+
+}  // namespace indicators
+
+#endif /* INDICATORS_HPP */
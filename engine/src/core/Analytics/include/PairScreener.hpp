@@ -0,0 +1,143 @@
+/**
+ * @file PairScreener.hpp
+ * @brief Correlation and Engle-Granger cointegration screen over contract
+ * pairs.
+ *
+ * Finding spread candidates means testing every expiry pair of a commodity,
+ * and pairs across commodities, for co-movement. With a few hundred columns
+ * that is tens of thousands of pairs, so the screen computes the pairwise
+ * statistics as blocked matrix products over aligned columns and runs the
+ * per-pair unit-root regressions in parallel batches.
+ */
+
+#ifndef PAIR_SCREENER_HPP
+#define PAIR_SCREENER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Contract.hpp"
+#include "Resampler.hpp"
+#include "TimestampJoin.hpp"
+
+class JobContext;
+
+/**
+ * @struct PairScreenConfig
+ * @brief Parameters of a pair screen.
+ */
+struct PairScreenConfig {
+  size_t top_k = 50;              ///< Pairs kept per ranking; 0 keeps all
+  size_t adf_lags = 1;            ///< Lagged differences in the ADF test
+  double min_correlation = -1.0;  ///< Pairs below skip the ADF test
+  double significance = 0.05;     ///< 0.01, 0.05 or 0.10
+  size_t num_threads = 0;         ///< Parallel tasks; 0 sizes them itself
+  JobContext *job = nullptr;      ///< Progress and cancellation; optional
+};
+
+/**
+ * @struct PairStatistics
+ * @brief Co-movement statistics of one pair of columns.
+ *
+ * The cointegrating regression is `y = intercept + hedge_ratio * x`, where
+ * `y` is column `dependent`. Both orderings are tested and the one with the
+ * more negative ADF statistic is reported.
+ */
+struct PairStatistics {
+  size_t dependent = 0;         ///< Column regressed on the other
+  size_t independent = 0;       ///< Regressor column
+  double correlation = 0.0;     ///< Correlation of price changes
+  double hedge_ratio = 0.0;     ///< OLS slope of the cointegrating fit
+  double intercept = 0.0;       ///< OLS intercept of the cointegrating fit
+  double adf_statistic = 0.0;   ///< t-statistic of the residual unit root
+  double half_life = 0.0;       ///< Rows for a residual shock to halve
+  bool tested = false;          ///< False if skipped by min_correlation
+  bool cointegrated = false;    ///< ADF statistic below the critical value
+};
+
+/**
+ * @struct PairScreenResult
+ * @brief Full correlation matrix and the best pairs under each ranking.
+ */
+struct PairScreenResult {
+  size_t columns = 0;
+  std::vector<double> correlation;  ///< columns x columns, row-major
+  /// Tested pairs by ascending ADF statistic (strongest first)
+  std::vector<PairStatistics> by_cointegration;
+  /// All pairs by descending correlation
+  std::vector<PairStatistics> by_correlation;
+
+  double Correlation(size_t i, size_t j) const {
+    return correlation[i * columns + j];
+  }
+};
+
+/**
+ * @brief Correlation matrix of the row-to-row changes of every column.
+ *
+ * @param prices Aligned price columns
+ * @param num_threads Parallel tasks; 0 sizes them automatically
+ * @return std::vector<double> `Legs() x Legs()` row-major, unit diagonal.
+ *         Columns without variation correlate 0 with every other column.
+ *
+ * Changes are centred and scaled to unit norm, which turns the matrix into
+ * their Gram product `Z^T Z`. It is computed GEMM-style: the upper triangle
+ * is cut into column tiles handed out to scheduler tasks, each tile streams
+ * row chunks that stay in cache and accumulates 4x4 register blocks. The
+ * summation order of every entry is fixed, so the result does not depend on
+ * the thread count.
+ *
+ * @throws std::invalid_argument if there are fewer than 3 rows
+ */
+std::vector<double> ReturnCorrelationMatrix(const AlignedMatrix &prices,
+                                            size_t num_threads = 0);
+
+/**
+ * @brief Engle-Granger critical value of the residual ADF statistic.
+ *
+ * MacKinnon (2010) response surface for two variables with a constant.
+ *
+ * @param significance 0.01, 0.05 or 0.10
+ * @param observations Rows of the ADF regression
+ * @throws std::invalid_argument for any other significance level
+ */
+double EngleGrangerCriticalValue(double significance, size_t observations);
+
+/**
+ * @brief Screens every pair of aligned price columns.
+ *
+ * @param prices Aligned price columns, e.g. every expiry of a commodity
+ * @param config Lag order, prefilter, significance and result size
+ * @return PairScreenResult Correlation matrix and ranked pairs
+ *
+ * Hedge ratios of all pairs come from a second Gram product over the
+ * centred prices. Each ADF regression (`de_t = g * e_{t-1} + sum of lagged
+ * de + noise`, no constant) is then a single pass over the two columns that
+ * builds its normal equations on the stack, so batches of pairs run on
+ * scheduler tasks without allocating.
+ *
+ * With a job, every batch is a cancellation checkpoint and tested pairs are
+ * counted on JobContext::kPairsTested.
+ *
+ * @throws std::invalid_argument if there are fewer than 2 columns, too few
+ *         rows for the lag order, or more than 8 lags
+ * @throws JobCancelled if the job is cancelled
+ */
+PairScreenResult ScreenPairs(const AlignedMatrix &prices,
+                             const PairScreenConfig &config = {});
+
+/**
+ * @brief Loads, aligns and screens the close prices of contracts.
+ *
+ * @param contracts Contracts to screen, of one or several commodities
+ * @param bucket Bar size each contract is resampled to before joining
+ * @param config Screen parameters
+ * @return PairScreenResult Column `k` is `contracts[k]`
+ *
+ * @throws std::runtime_error if a contract cannot be loaded
+ */
+PairScreenResult ScreenContracts(const std::vector<Contract> &contracts,
+                                 const BarBucket &bucket,
+                                 const PairScreenConfig &config = {});
+
+#endif /* PAIR_SCREENER_HPP */
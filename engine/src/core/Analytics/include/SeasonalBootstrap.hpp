@@ -0,0 +1,83 @@
+/**
+ * @file SeasonalBootstrap.hpp
+ * @brief Bootstrap and permutation significance tests for seasonal trades.
+ *
+ * A seasonal study yields one spread path per historical year between the
+ * entry and exit dates. With only ~15 years, the raw average P&L says little
+ * about whether the edge is real. This file resamples those paths to attach
+ * a p-value and confidence intervals to the trade.
+ */
+
+#ifndef SEASONAL_BOOTSTRAP_HPP
+#define SEASONAL_BOOTSTRAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobContext;
+
+/**
+ * @struct BootstrapConfig
+ * @brief Parameters of a bootstrap run.
+ */
+struct BootstrapConfig {
+  size_t resamples = 20000;  ///< Number of bootstrap / permutation draws
+  size_t block_length = 5;   ///< Rows per block in the path bootstrap
+  double confidence = 0.95;  ///< Two-sided confidence level of intervals
+  uint64_t seed = 0;         ///< RNG seed; same seed, same result
+  size_t num_threads = 0;    ///< Parallel chunks; 0 sizes them automatically
+  JobContext *job = nullptr; ///< Progress and cancellation; optional
+};
+
+/**
+ * @struct ConfidenceInterval
+ * @brief Percentile interval of a bootstrap distribution.
+ */
+struct ConfidenceInterval {
+  double lower = 0.0;
+  double upper = 0.0;
+};
+
+/**
+ * @struct BootstrapResult
+ * @brief Significance summary of a seasonal entry/exit window.
+ */
+struct BootstrapResult {
+  double mean_pnl = 0.0;  ///< Observed mean P&L over years
+  double p_value = 1.0;   ///< Two-sided sign-permutation p-value of the mean
+  ConfidenceInterval mean_pnl_ci;  ///< Years resampled with replacement
+  ConfidenceInterval pnl_ci;       ///< P&L of block-bootstrapped paths
+  ConfidenceInterval drawdown_ci;  ///< Max drawdown (<= 0) of those paths
+  size_t resamples = 0;            ///< Draws actually performed
+};
+
+/**
+ * @brief Runs the bootstrap and permutation tests over yearly trade paths.
+ *
+ * @param yearly_paths Spread values from entry to exit, one path per year
+ * @param config Resample count, block length, confidence and seed
+ * @return BootstrapResult p-value and confidence intervals
+ *
+ * Three distributions are drawn per resample:
+ * - the mean P&L of years sampled with replacement;
+ * - a synthetic path stitched from random blocks of daily changes (blocks
+ *   never straddle two years), giving P&L and max drawdown;
+ * - the mean P&L with each year's sign flipped at random, the null
+ *   distribution of a window without edge.
+ *
+ * Resample `r` draws from Philox stream `r`, so the result depends only on
+ * the inputs and the seed, never on the thread count.
+ *
+ * With a job, every resample is a cancellation checkpoint and finished
+ * resamples are counted on JobContext::kResamples.
+ *
+ * @throws std::invalid_argument if no path has at least two values or the
+ *         confidence is not in (0, 1)
+ * @throws JobCancelled if the job is cancelled
+ */
+BootstrapResult RunSeasonalBootstrap(
+    const std::vector<std::vector<double>> &yearly_paths,
+    const BootstrapConfig &config = {});
+
+#endif /* SEASONAL_BOOTSTRAP_HPP */
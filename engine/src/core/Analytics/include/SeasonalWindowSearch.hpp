@@ -0,0 +1,116 @@
+/**
+ * @file SeasonalWindowSearch.hpp
+ * @brief Exhaustive search for the best seasonal entry/exit window.
+ *
+ * Instead of picking entry and exit dates by hand, this search evaluates
+ * every (entry day, exit day) pair of a seasonal calendar over all historical
+ * years and ranks the windows by win rate, average P&L and worst drawdown.
+ */
+
+#ifndef SEASONAL_WINDOW_SEARCH_HPP
+#define SEASONAL_WINDOW_SEARCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+class JobContext;
+
+/**
+ * @class SeasonalMatrix
+ * @brief Spread levels indexed by (seasonal day, year), day-major.
+ *
+ * Row `d` holds the spread level of every year on seasonal day `d`, so the
+ * years of one day are contiguous. A spread level is the running sum of its
+ * daily changes, i.e. the prefix sum, which makes the P&L of any window one
+ * subtraction: `At(exit, y) - At(entry, y)`.
+ */
+class SeasonalMatrix {
+ public:
+  SeasonalMatrix() = default;
+
+  /**
+   * @brief Builds the matrix from one level path per year.
+   *
+   * @param yearly_levels Spread levels per seasonal day, one vector per year
+   *
+   * Paths are truncated to the shortest year. NaN gaps are forward-filled
+   * from the previous day of the same year.
+   */
+  static SeasonalMatrix FromYears(
+      const std::vector<std::vector<double>> &yearly_levels);
+
+  size_t Days() const { return days_; }
+  size_t Years() const { return years_; }
+
+  double At(size_t day, size_t year) const {
+    return levels_[day * years_ + year];
+  }
+  const double *Row(size_t day) const { return levels_.data() + day * years_; }
+
+ private:
+  size_t days_ = 0;
+  size_t years_ = 0;
+  std::vector<double> levels_;
+};
+
+/**
+ * @struct WindowSearchConfig
+ * @brief Constraints and output size of a window search.
+ */
+struct WindowSearchConfig {
+  size_t top_k = 10;         ///< Windows kept per ranking
+  size_t min_hold_days = 5;  ///< Shortest entry-to-exit distance
+  size_t max_hold_days = 0;  ///< Longest distance; 0 means unbounded
+  bool allow_short = true;   ///< Also evaluate selling the spread
+  size_t num_threads = 0;    ///< Parallel tasks; 0 = one per scheduler worker
+  JobContext *job = nullptr; ///< Progress and cancellation; optional
+};
+
+/**
+ * @struct SeasonalWindow
+ * @brief Cross-year statistics of one entry/exit window.
+ */
+struct SeasonalWindow {
+  size_t entry_day = 0;         ///< Seasonal day of entry
+  size_t exit_day = 0;          ///< Seasonal day of exit
+  int direction = 1;            ///< +1 long the spread, -1 short
+  double win_rate = 0.0;        ///< Fraction of years with positive P&L
+  double average_pnl = 0.0;     ///< Mean P&L over years
+  double worst_drawdown = 0.0;  ///< Deepest in-window drawdown (<= 0)
+};
+
+/**
+ * @struct WindowSearchResult
+ * @brief Best windows under each ranking, best first.
+ *
+ * Win-rate ties are broken by average P&L. The drawdown ranking only
+ * considers windows with positive average P&L.
+ */
+struct WindowSearchResult {
+  std::vector<SeasonalWindow> by_win_rate;
+  std::vector<SeasonalWindow> by_average_pnl;
+  std::vector<SeasonalWindow> by_worst_drawdown;
+};
+
+/**
+ * @brief Evaluates every admissible (entry, exit) pair of the matrix.
+ *
+ * @param matrix Seasonal spread levels
+ * @param config Hold-length bounds, direction and result size
+ * @return WindowSearchResult Top-K windows for each ranking
+ *
+ * Entries are processed in tiles that sweep the exit day together, so each
+ * matrix row is loaded once per tile while the per-year running peak,
+ * trough and drawdown of every entry in the tile are updated. Tiles are
+ * handed out dynamically to scheduler tasks, which keep private top-K lists
+ * merged at the end. Total cost is O(days^2 * years).
+ *
+ * With a job, every tile is a cancellation checkpoint and finished tiles
+ * are counted on JobContext::kWindowTiles.
+ *
+ * @throws JobCancelled if the job is cancelled
+ */
+WindowSearchResult SearchSeasonalWindows(const SeasonalMatrix &matrix,
+                                         const WindowSearchConfig &config = {});
+
+#endif /* SEASONAL_WINDOW_SEARCH_HPP */
@@ -0,0 +1,150 @@
+/**
+ * @file SpreadBacktest.hpp
+ * @brief Event-driven backtests of mean-reversion rules on a spread.
+ *
+ * The seasonal metrics assume the spread is bought on the first row and
+ * sold on the last. A backtest instead trades a rule: enter when the
+ * spread's rolling z-score is stretched, leave when it reverts or when a
+ * stop-loss, profit target or time stop fires, paying commission and
+ * slippage on every fill.
+ *
+ * Rule searches run thousands of variants over one spread, so the z-score
+ * of every distinct lookback is computed once and shared, and each variant
+ * is a single pass over the rows with a few scalars of state.
+ */
+
+#ifndef SPREAD_BACKTEST_HPP
+#define SPREAD_BACKTEST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SpreadDefinition.hpp"
+#include "SpreadMetrics.hpp"
+
+class JobContext;
+
+/**
+ * @struct BacktestRule
+ * @brief One variant of the z-score reversion rule.
+ *
+ * The z-score of row `i` is the spread's distance from the mean of the
+ * `lookback` rows ending at `i`, in population standard deviations. A
+ * z-score at or below `-entry_z` buys one spread, at or above `entry_z`
+ * sells one. A long exits once the z-score is back at or above `-exit_z`,
+ * a short once it is at or below `exit_z`; a negative `exit_z` holds the
+ * trade past the mean. Stop-loss and profit target are in spread price
+ * units against the entry fill.
+ */
+struct BacktestRule {
+  size_t lookback = 20;   ///< Rows in the z-score window, at least 2
+  double entry_z = 2.0;   ///< Entry threshold, positive
+  double exit_z = 0.0;    ///< Reversion threshold
+  double stop_loss = std::numeric_limits<double>::infinity();
+  double profit_target = std::numeric_limits<double>::infinity();
+  size_t max_holding = 0;  ///< Rows a trade may stay open; 0 for no limit
+  bool allow_long = true;
+  bool allow_short = true;
+};
+
+/**
+ * @struct BacktestCosts
+ * @brief Costs charged per unit of spread and per fill.
+ *
+ * Buys fill `slippage_ticks * tick_size` above the spread value and sells
+ * the same distance below it.
+ */
+struct BacktestCosts {
+  double commission = 0.0;      ///< Per fill, in spread price units
+  double tick_size = 0.0;       ///< Spread price increment
+  double slippage_ticks = 0.0;  ///< Ticks lost on every fill
+};
+
+/**
+ * @struct BacktestConfig
+ * @brief Costs and execution settings shared by all variants of a run.
+ */
+struct BacktestConfig {
+  BacktestCosts costs;
+  bool keep_trades = true;    ///< False keeps only counts and metrics
+  size_t num_threads = 0;     ///< Parallel tasks; 0 sizes them itself
+  JobContext *job = nullptr;  ///< Progress and cancellation; optional
+};
+
+/**
+ * @brief Why a trade was closed.
+ */
+enum class ExitReason {
+  kSignal,        ///< The z-score reverted
+  kStopLoss,      ///< Loss reached the stop
+  kProfitTarget,  ///< Gain reached the target
+  kTimeStop,      ///< Held for `max_holding` rows
+  kEndOfData      ///< Still open on the last row
+};
+
+/**
+ * @struct BacktestTrade
+ * @brief One round trip of one spread unit.
+ */
+struct BacktestTrade {
+  int direction = 0;          ///< +1 long, -1 short
+  size_t entry_row = 0;
+  size_t exit_row = 0;
+  uint64_t entry_time = 0;    ///< Milliseconds since epoch
+  uint64_t exit_time = 0;
+  double entry_price = 0.0;   ///< Fill, after slippage
+  double exit_price = 0.0;    ///< Fill, after slippage
+  double profit_loss = 0.0;   ///< Net of commission and slippage
+  double costs = 0.0;         ///< Commission and slippage paid
+  ExitReason reason = ExitReason::kSignal;
+};
+
+/**
+ * @struct BacktestResult
+ * @brief Trades and equity metrics of one rule variant.
+ *
+ * Metrics describe the marked-to-market equity curve, which starts at 0
+ * and closes every row at realized profit plus the open trade's mark.
+ * Each year's path starts at the previous year's closing equity, so the
+ * yearly profits add up to the total. The total carries year 0.
+ */
+struct BacktestResult {
+  size_t rule = 0;                    ///< Index into the rule list
+  size_t trade_count = 0;             ///< Kept even without keep_trades
+  std::vector<BacktestTrade> trades;  ///< Oldest first
+  std::vector<YearlyMetrics> yearly;  ///< One per calendar year
+  YearlyMetrics total;
+};
+
+/**
+ * @brief Backtests every rule over one spread.
+ *
+ * @param spread Spread values on ascending timestamps
+ * @param rules Rule variants; result `k` belongs to `rules[k]`
+ * @param config Costs, trade retention and parallelism
+ * @return std::vector<BacktestResult> One result per rule
+ *
+ * Rows are events processed at their close, one fill per row at most: an
+ * open trade checks stop-loss, profit target, time stop and reversion in
+ * that order; a flat rule then checks for an entry. A trade still open on
+ * the last row is closed there. Variants run on scheduler tasks and, with
+ * a job, are counted on JobContext::kBacktestsRun.
+ *
+ * @throws std::invalid_argument if timestamps and values differ in length,
+ *         or a rule has a lookback below 2 or a non-positive entry_z
+ * @throws JobCancelled if the job is cancelled
+ */
+std::vector<BacktestResult> RunBacktests(const SpreadSeries &spread,
+                                         const std::vector<BacktestRule> &rules,
+                                         const BacktestConfig &config = {});
+
+/**
+ * @brief Backtests a single rule.
+ */
+BacktestResult RunBacktest(const SpreadSeries &spread,
+                           const BacktestRule &rule,
+                           const BacktestConfig &config = {});
+
+#endif /* SPREAD_BACKTEST_HPP */
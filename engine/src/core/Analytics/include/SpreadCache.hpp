@@ -0,0 +1,203 @@
+/**
+ * @file SpreadCache.hpp
+ * @brief Memoization of evaluated spreads across requests.
+ *
+ * The same popular spreads (a ZC March/May calendar over the last fifteen
+ * years, say) are requested again and again, and every request would
+ * otherwise reload, resample, join and evaluate every leg. The SpreadCache
+ * keeps evaluated spreads in a compact binary form, keyed by a canonical
+ * form of the request and the version of every leg's source file, so a
+ * repeated request costs one decode.
+ */
+
+#ifndef SPREAD_CACHE_HPP
+#define SPREAD_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SpreadDefinition.hpp"
+#include "Workspace.hpp"
+
+/**
+ * @struct SpreadQuery
+ * @brief A spread request: expression, bar size, join mode and date window.
+ */
+struct SpreadQuery {
+  SpreadDefinition definition;
+  BarBucket bucket;
+  JoinMode mode = JoinMode::kInner;
+  uint64_t start_ms = 0;  ///< First timestamp kept (inclusive)
+  uint64_t end_ms = std::numeric_limits<uint64_t>::max();  ///< Inclusive
+};
+
+/**
+ * @struct SpreadCacheOptions
+ * @brief Memory bound and spill location of a SpreadCache.
+ */
+struct SpreadCacheOptions {
+  size_t max_memory_bytes = 256u << 20;  ///< Encoded bytes kept in memory
+  std::string spill_dir;  ///< Evicted entries are written here; "" = drop
+};
+
+/**
+ * @struct SpreadCacheStats
+ * @brief Counters since construction or the last Clear().
+ */
+struct SpreadCacheStats {
+  size_t hits = 0;            ///< Served from memory
+  size_t disk_hits = 0;       ///< Served from a spill file
+  size_t workspace_hits = 0;  ///< Served from the attached workspace
+  size_t misses = 0;          ///< Computed
+  size_t invalidated = 0;     ///< Entries dropped because a leg file changed
+  size_t evictions = 0;       ///< Entries pushed out by the memory bound
+  size_t spills = 0;          ///< Evicted entries written to disk
+  size_t entries = 0;         ///< Entries currently in memory
+  size_t memory_bytes = 0;    ///< Bytes currently held in memory
+};
+
+/**
+ * @class SpreadCache
+ * @brief Memory-bounded LRU of evaluated spreads with optional disk spill.
+ *
+ * Requests are canonicalized before lookup: legs on the same contract are
+ * merged, legs are ordered by contract (except the anchor leg of an as-of
+ * join) and each leg is reduced to its coefficient `weight * multiplier`,
+ * so equivalent expressions share one entry. Every lookup stats the legs'
+ * source files (DataManager::contractDataVersion()); an entry built from
+ * older files is discarded, in memory and on disk, and recomputed.
+ *
+ * Entries are stored with the ColumnCodecs encodings (delta-of-delta
+ * timestamps, tick-delta or XOR values), usually a few bytes per row.
+ * When the memory bound is exceeded the least recently used entries are
+ * evicted, to `spill_dir` if one is set, from where a later miss reloads
+ * them. Spill files stay valid across processes.
+ *
+ * All members are thread-safe. Concurrent misses on the same request may
+ * both compute it.
+ *
+ * @example
+ * ```cpp
+ * SpreadQuery query{SpreadDefinition::Calendar("ZC", H, K, 2025),
+ *                   BarBucket::Days(1)};
+ * SpreadSeries spread = SpreadCache::Instance().Load(query);
+ * ```
+ */
+class SpreadCache {
+ public:
+  explicit SpreadCache(SpreadCacheOptions options = {});
+
+  SpreadCache(const SpreadCache &) = delete;
+  SpreadCache &operator=(const SpreadCache &) = delete;
+
+  /**
+   * @brief Returns the cache shared by the whole engine.
+   *
+   * Sized by `ALCHEMATH_SPREAD_CACHE_MB` (default 256) and spilling to
+   * `ALCHEMATH_SPREAD_CACHE_DIR` if set.
+   */
+  static SpreadCache &Instance();
+
+  /**
+   * @brief Returns the spread for `query`, computing it on a miss.
+   *
+   * A miss evaluates the canonical spread with LoadSpread() and keeps the
+   * rows inside the query's date window.
+   *
+   * @throws std::runtime_error if a leg cannot be loaded
+   */
+  SpreadSeries Load(const SpreadQuery &query);
+
+  /**
+   * @brief Returns the cached spread for `query` without computing it.
+   */
+  std::optional<SpreadSeries> Find(const SpreadQuery &query);
+
+  /**
+   * @brief Drops every in-memory entry and resets the statistics.
+   *
+   * Spill files are kept; they are validated when next loaded.
+   */
+  void Clear();
+
+  SpreadCacheStats Stats() const;
+
+  /**
+   * @brief Writes every in-memory entry into a workspace snapshot.
+   * @return size_t Number of entries written
+   */
+  size_t Snapshot(WorkspaceWriter &writer) const;
+
+  /**
+   * @brief Consults a workspace snapshot on memory misses.
+   *
+   * @param workspace Opened snapshot, or nullptr to detach
+   *
+   * Workspace entries are validated against the current leg file versions
+   * like spill files, and are looked up before them.
+   */
+  void Attach(std::shared_ptr<const Workspace> workspace);
+
+  /**
+   * @brief Canonical binary form of a query, without data versions.
+   */
+  static std::string CanonicalKey(const SpreadQuery &query);
+
+  /**
+   * @brief The query's spread expression in canonical form.
+   */
+  static SpreadDefinition Canonicalize(const SpreadQuery &query);
+
+  /**
+   * @brief Encodes a spread series into the cache's binary form.
+   */
+  static std::vector<uint8_t> Encode(const SpreadSeries &series);
+
+  /**
+   * @brief Decodes Encode() output; returns false on malformed input.
+   */
+  static bool Decode(const uint8_t *data, size_t size, SpreadSeries &series);
+
+ private:
+  struct Entry {
+    std::string versions;  ///< Leg data versions the blob was built from
+    std::vector<uint8_t> blob;
+    std::list<std::string>::iterator lru;
+  };
+
+  static std::string Versions(const SpreadDefinition &canonical);
+  static size_t Footprint(const std::string &key, const Entry &entry);
+
+  std::optional<SpreadSeries> Lookup(const std::string &key,
+                                     const std::string &versions);
+  void Insert(const std::string &key, std::string versions,
+              std::vector<uint8_t> blob);
+  void EraseLocked(const std::string &key);
+  /**
+   * @brief Evicts LRU entries over the memory bound; returns the ones to
+   *        spill, which the caller writes after releasing the mutex.
+   */
+  std::vector<std::pair<std::string, Entry>> EvictLocked();
+  std::string SpillPath(const std::string &key) const;
+  bool WriteSpill(const std::string &key, const Entry &entry) const;
+  bool ReadSpill(const std::string &key, std::string &versions,
+                 std::vector<uint8_t> &blob) const;
+
+  SpreadCacheOptions options_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<std::string> lru_;  ///< Keys, most recently used first
+  SpreadCacheStats stats_;
+  std::shared_ptr<const Workspace> workspace_;
+};
+
+#endif /* SPREAD_CACHE_HPP */
@@ -0,0 +1,146 @@
+/**
+ * @file SpreadDefinition.hpp
+ * @brief Generic multi-leg spread expressions and their fused evaluation.
+ *
+ * A spread is a weighted sum of contract prices. This covers calendar
+ * spreads, butterflies, condors and inter-commodity spreads such as the
+ * soybean crush, where legs are quoted in different units and combined with
+ * ratio weights.
+ */
+
+#ifndef SPREAD_DEFINITION_HPP
+#define SPREAD_DEFINITION_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Contract.hpp"
+#include "Resampler.hpp"
+#include "TimestampJoin.hpp"
+
+/**
+ * @struct SpreadLeg
+ * @brief One term of a spread: `weight * multiplier * price(contract)`.
+ *
+ * The weight carries the trade ratio and direction (e.g. +1 / -2 / +1 for a
+ * butterfly); the multiplier converts the quote into the spread's unit
+ * (e.g. soybean meal $/short ton into $/bushel). The year offset places the
+ * contract relative to the spread's base year, so cross-year spreads such
+ * as a December/March calendar keep their shape when moved to another year.
+ */
+struct SpreadLeg {
+  Contract contract;        ///< Leg contract
+  double weight = 1.0;      ///< Signed ratio weight
+  double multiplier = 1.0;  ///< Quote-to-spread unit conversion
+  int year_offset = 0;      ///< Expiry year minus the spread's base year
+};
+
+/**
+ * @class SpreadDefinition
+ * @brief Ordered list of weighted legs forming a spread expression.
+ *
+ * @example
+ * ```cpp
+ * // ZC March/May calendar for the 2025 crop
+ * SpreadDefinition hk = SpreadDefinition::Calendar("ZC", H, K, 2025);
+ * SpreadSeries spread = LoadSpread(hk, BarBucket::Days(1));
+ * ```
+ */
+class SpreadDefinition {
+ public:
+  SpreadDefinition() = default;
+  explicit SpreadDefinition(std::vector<SpreadLeg> legs);
+
+  /**
+   * @brief Long `near` expiring in `year`, short `far` expiring
+   * `far_year_offset` years later.
+   *
+   * A December/March calendar is `Calendar(symbol, Z, H, year, 1)`.
+   */
+  static SpreadDefinition Calendar(const std::string &symbol,
+                                   ExpirationMonth near, ExpirationMonth far,
+                                   int year, int far_year_offset = 0);
+
+  /**
+   * @brief +1 / -2 / +1 butterfly over three expiries of `year`.
+   */
+  static SpreadDefinition Butterfly(const std::string &symbol,
+                                    ExpirationMonth wing1,
+                                    ExpirationMonth body, ExpirationMonth wing2,
+                                    int year);
+
+  /**
+   * @brief Board crush in $/bushel: 0.022 * ZM + 0.11 * ZL - 0.01 * ZS.
+   *
+   * Assumes meal in $/short ton, oil in cents/lb and beans in cents/bushel.
+   */
+  static SpreadDefinition SoybeanCrush(ExpirationMonth month, int year);
+
+  const std::vector<SpreadLeg> &Legs() const { return legs_; }
+
+  /**
+   * @brief Returns a copy with every leg's expiration year shifted.
+   *
+   * Seasonal studies evaluate the same spread in earlier years.
+   */
+  SpreadDefinition ShiftedYears(int years) const;
+
+  /**
+   * @brief Returns a copy whose leg `k` expires in
+   * `base_year + Legs()[k].year_offset`.
+   *
+   * Builds a spread from leg templates given relative to an analysis year,
+   * as the API sends them.
+   */
+  SpreadDefinition ForYear(int base_year) const;
+
+  /**
+   * @brief Combined per-leg coefficients, `weight * multiplier`.
+   */
+  std::vector<double> Coefficients() const;
+
+ private:
+  std::vector<SpreadLeg> legs_;
+};
+
+/**
+ * @struct SpreadSeries
+ * @brief Evaluated spread values on their aligned timestamps.
+ */
+struct SpreadSeries {
+  std::vector<uint64_t> timestamps;  ///< Milliseconds since epoch
+  std::vector<double> values;        ///< Spread value per timestamp
+};
+
+/**
+ * @brief Evaluates a spread over aligned legs in one fused pass.
+ *
+ * @param definition Spread expression; leg `k` maps to matrix leg `k`
+ * @param legs Aligned leg prices
+ * @param out Destination of `legs.Rows()` values
+ *
+ * Every output value is produced once from all legs, without per-leg
+ * temporaries or heap allocations. Two, three and four-leg spreads use
+ * unrolled kernels.
+ *
+ * @throws std::invalid_argument if leg counts differ
+ */
+void EvaluateSpread(const SpreadDefinition &definition,
+                    const AlignedMatrix &legs, double *out);
+
+/**
+ * @brief Loads, aligns and evaluates a spread.
+ *
+ * @param definition Spread expression
+ * @param bucket Bar size each leg is resampled to before joining
+ * @param mode Join semantics used to align the legs
+ * @return SpreadSeries The spread on the joined timestamps
+ *
+ * @throws std::runtime_error if a leg cannot be loaded
+ */
+SpreadSeries LoadSpread(const SpreadDefinition &definition,
+                        const BarBucket &bucket,
+                        JoinMode mode = JoinMode::kInner);
+
+#endif /* SPREAD_DEFINITION_HPP */
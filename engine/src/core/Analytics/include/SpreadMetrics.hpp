@@ -0,0 +1,199 @@
+/**
+ * @file SpreadMetrics.hpp
+ * @brief Per-year spread metrics with incremental updates.
+ *
+ * A seasonal analysis shows the current year's spread against fifteen
+ * historical years, their trailing averages and one row of metrics per
+ * year. Only the current year changes during the day, so the historical
+ * state is computed once and every refresh folds just the new bars into
+ * running accumulators.
+ */
+
+#ifndef SPREAD_METRICS_HPP
+#define SPREAD_METRICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+#include "SpreadDefinition.hpp"
+
+/**
+ * @struct YearlyMetrics
+ * @brief Summary of one year's spread path, as reported to the API.
+ *
+ * Returns are the changes between consecutive spread values.
+ */
+struct YearlyMetrics {
+  int year = 0;
+  size_t rows = 0;                  ///< Spread values seen
+  double profit_loss = 0.0;         ///< Last value minus first value
+  double max_drawdown = 0.0;        ///< Largest fall from a peak (<= 0)
+  double max_profit = 0.0;          ///< Largest rise from a running trough
+  double standard_deviation = 0.0;  ///< Population deviation of returns
+  double sharpe_ratio = 0.0;        ///< Mean return over its deviation
+  double total_return = 0.0;        ///< Same as profit_loss
+  double win_rate = 0.0;            ///< Share of positive returns
+  double avg_win = 0.0;             ///< Mean positive return
+  double avg_loss = 0.0;            ///< Mean negative return (<= 0)
+};
+
+/**
+ * @class MetricsAccumulator
+ * @brief Running state behind YearlyMetrics, updated in O(1) per value.
+ *
+ * Return moments use Welford's algorithm, which stays accurate over long
+ * series where the textbook sum-of-squares formula cancels catastrophically.
+ * Drawdown and run-up track the running peak and trough.
+ */
+class MetricsAccumulator {
+ public:
+  void Push(double value);
+
+  void Push(const double *values, size_t count) {
+    for (size_t i = 0; i < count; ++i) Push(values[i]);
+  }
+
+  size_t Count() const { return count_; }
+
+  YearlyMetrics Metrics(int year) const;
+
+ private:
+  size_t count_ = 0;
+  double first_ = 0.0;
+  double last_ = 0.0;
+  double peak_ = -std::numeric_limits<double>::infinity();
+  double trough_ = std::numeric_limits<double>::infinity();
+  double max_drawdown_ = 0.0;
+  double max_runup_ = 0.0;
+
+  // Welford state over returns
+  size_t returns_ = 0;
+  double mean_ = 0.0;
+  double m2_ = 0.0;
+
+  size_t wins_ = 0;
+  size_t losses_ = 0;
+  double win_sum_ = 0.0;
+  double loss_sum_ = 0.0;
+};
+
+/**
+ * @struct YearSlice
+ * @brief Rows `[begin, end)` of a series that fall in one calendar year.
+ */
+struct YearSlice {
+  int year = 0;
+  size_t begin = 0;
+  size_t end = 0;
+};
+
+/**
+ * @brief Splits ascending timestamps at UTC calendar-year boundaries.
+ *
+ * @param timestamps Ascending timestamps (milliseconds)
+ * @param rows Number of timestamps
+ * @param resource Source of the returned slices
+ * @return std::pmr::vector<YearSlice> One slice per year present, oldest
+ *         first
+ */
+std::pmr::vector<YearSlice> SliceByYear(
+    const uint64_t *timestamps, size_t rows,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+/**
+ * @brief Metrics of every calendar year of a spread.
+ *
+ * Slices and metrics are allocated from `resource`; with an AnalysisArena
+ * the whole computation stays off the global heap.
+ *
+ * @return std::pmr::vector<YearlyMetrics> One entry per year, oldest first
+ */
+std::pmr::vector<YearlyMetrics> MetricsByYear(
+    const uint64_t *timestamps, const double *values, size_t rows,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+/**
+ * @struct SpreadYear
+ * @brief The spread path of one year of a seasonal study.
+ */
+struct SpreadYear {
+  int year = 0;
+  SpreadSeries series;
+};
+
+/**
+ * @class IncrementalSpreadAnalysis
+ * @brief Seasonal study whose current year is updated in O(new rows).
+ *
+ * Historical metrics and the trailing N-year averages are computed once on
+ * construction. Averages are aligned by row index, row `i` being the mean
+ * of row `i` over the N most recent historical years that have it.
+ *
+ * @example
+ * ```cpp
+ * IncrementalSpreadAnalysis study(std::move(history), std::move(current));
+ * // On every refresh:
+ * study.Append(new_bars);
+ * Publish(study.CurrentYear(), study.CurrentMetrics());
+ * ```
+ */
+class IncrementalSpreadAnalysis {
+ public:
+  /**
+   * @param history Completed years, in any order
+   * @param current The year being traded, possibly empty so far
+   * @param average_windows Trailing year counts to average over
+   * @param scratch Source of the temporaries used to build the averages
+   */
+  IncrementalSpreadAnalysis(
+      std::vector<SpreadYear> history, SpreadYear current,
+      std::vector<size_t> average_windows = {3, 5, 10, 15},
+      std::pmr::memory_resource *scratch = std::pmr::get_default_resource());
+
+  /**
+   * @brief Folds new current-year bars into the series and its metrics.
+   *
+   * @param rows New spread values, by ascending timestamp
+   * @return size_t Rows applied
+   *
+   * A row at the current last timestamp replaces the last value (the bar
+   * is still forming); rows older than that are ignored.
+   */
+  size_t Append(const SpreadSeries &rows);
+
+  const SpreadSeries &CurrentYear() const { return current_.series; }
+  YearlyMetrics CurrentMetrics() const;
+
+  /**
+   * @brief Metrics of every historical year, oldest first.
+   */
+  const std::vector<YearlyMetrics> &HistoricalMetrics() const {
+    return historical_metrics_;
+  }
+
+  /**
+   * @brief Row-aligned average of the `years` most recent historical years.
+   * @throws std::out_of_range if `years` was not one of the average windows
+   */
+  const std::vector<double> &Average(size_t years) const;
+
+  /**
+   * @brief Historical years, oldest first.
+   */
+  const std::vector<SpreadYear> &History() const { return history_; }
+
+ private:
+  std::vector<SpreadYear> history_;
+  std::vector<YearlyMetrics> historical_metrics_;
+  std::vector<size_t> average_windows_;
+  std::vector<std::vector<double>> averages_;
+
+  SpreadYear current_;
+  MetricsAccumulator metrics_;
+  MetricsAccumulator before_last_;  ///< State before the last row
+};
+
+#endif /* SPREAD_METRICS_HPP */
@@ -0,0 +1,136 @@
+/**
+ * @file TimestampJoin.hpp
+ * @brief K-way timestamp join that aligns contract legs into a dense matrix.
+ *
+ * Multi-leg spreads (calendars, butterflies, condors) need the prices of every
+ * leg on a common time axis. This file provides the aligned Structure of
+ * Arrays matrix and the merge-join that builds it from sorted leg columns.
+ */
+
+#ifndef TIMESTAMP_JOIN_HPP
+#define TIMESTAMP_JOIN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+#include "TimeSeries.hpp"
+
+/**
+ * @enum JoinMode
+ * @brief Selects how legs with different timestamps are aligned.
+ */
+enum class JoinMode {
+  kInner,             ///< Keep timestamps present in every leg
+  kOuterForwardFill,  ///< Union of timestamps, gaps filled with last value
+  kAsof               ///< Timestamps of leg 0, others take last value <= t
+};
+
+/**
+ * @struct JoinColumn
+ * @brief Non-owning view of one leg: a sorted timestamp column and values.
+ */
+struct JoinColumn {
+  const uint64_t *timestamps;  ///< Ascending timestamps (milliseconds)
+  const double *values;        ///< Values, one per timestamp
+  size_t size;                 ///< Number of rows
+
+  /**
+   * @brief Views the close prices of a time series.
+   */
+  static JoinColumn Closes(const TimeSeries &series) {
+    return {series.Timestamps().data(), series.Closes().data(),
+            series.Timestamps().size()};
+  }
+};
+
+/**
+ * @class AlignedMatrix
+ * @brief Dense SoA matrix of legs sharing a single timestamp column.
+ *
+ * Leg values are stored column-major in one contiguous buffer, so every leg
+ * is a contiguous `double` array of `Rows()` elements that kernels can stream
+ * through without indirection.
+ *
+ * Storage comes from a `std::pmr` resource, the heap unless the matrix is
+ * built for a request with an AnalysisArena.
+ */
+class AlignedMatrix {
+ public:
+  AlignedMatrix() = default;
+
+  /**
+   * @brief Creates an empty matrix with capacity for the given rows.
+   */
+  AlignedMatrix(
+      size_t legs, size_t capacity,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  size_t Rows() const { return timestamps_.size(); }
+  size_t Legs() const { return legs_; }
+
+  const std::pmr::vector<uint64_t> &Timestamps() const { return timestamps_; }
+
+  /**
+   * @brief Returns a pointer to the contiguous values of leg `k`.
+   */
+  const double *Leg(size_t k) const { return values_.data() + k * capacity_; }
+  double *Leg(size_t k) { return values_.data() + k * capacity_; }
+
+  /**
+   * @brief Appends a timestamp; leg values must be written at `Rows() - 1`.
+   */
+  void PushRow(uint64_t timestamp) { timestamps_.push_back(timestamp); }
+
+  /**
+   * @brief Packs the legs so every one is exactly `Rows()` long.
+   *
+   * Heap-backed matrices also release the unused capacity.
+   */
+  void ShrinkToFit();
+
+ private:
+  size_t legs_ = 0;
+  size_t capacity_ = 0;
+  std::pmr::vector<uint64_t> timestamps_;
+  std::pmr::vector<double> values_;
+};
+
+/**
+ * @brief Aligns N sorted legs on a common timestamp axis.
+ *
+ * @param legs Leg columns, each sorted by ascending timestamp
+ * @param mode Join semantics
+ * @param tolerance_ms For kAsof, the maximum age of a matched value; older
+ *        matches drop the row. Ignored by the other modes.
+ * @return AlignedMatrix One timestamp column plus one value column per leg
+ *
+ * The inner join leapfrogs between legs with galloping (exponential then
+ * binary) search, so a sparse leg skips over a dense one in logarithmic
+ * steps. The as-of join gallops each leg forward from its previous match.
+ * The outer join is a linear k-way merge; rows before every leg has produced
+ * a first value are dropped so the result stays dense.
+ *
+ * @throws std::invalid_argument if `legs` is empty
+ */
+AlignedMatrix JoinTimestamps(
+    const std::vector<JoinColumn> &legs, JoinMode mode,
+    uint64_t tolerance_ms = std::numeric_limits<uint64_t>::max());
+
+/**
+ * @brief Aligns `count` legs into a matrix allocated from `resource`.
+ *
+ * Same semantics as the vector overload. The merge state and the result are
+ * the only allocations, both taken from `resource`, so a join inside an
+ * AnalysisArena does not touch the global heap.
+ *
+ * @throws std::invalid_argument if `count` is 0
+ */
+AlignedMatrix JoinTimestamps(
+    const JoinColumn *legs, size_t count, JoinMode mode,
+    std::pmr::memory_resource *resource,
+    uint64_t tolerance_ms = std::numeric_limits<uint64_t>::max());
+
+#endif /* TIMESTAMP_JOIN_HPP */
@@ -0,0 +1,247 @@
+/**
+ * @file TradingCalendar.cpp
+ * @brief Construction of the trading-day tables, holiday files and expiry
+ * rules.
+ */
+
+#include "include/TradingCalendar.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+std::string_view Trim(std::string_view s) {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() &&
+         (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+// Strict `YYYY-MM-DD`
+bool ParseDate(std::string_view s, int64_t &day) {
+  if (s.size() != 10 || s[4] != '-' || s[7] != '-') return false;
+  for (size_t i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+    if (s[i] < '0' || s[i] > '9') return false;
+  }
+  const int year = (s[0] - '0') * 1000 + (s[1] - '0') * 100 +
+                   (s[2] - '0') * 10 + (s[3] - '0');
+  const unsigned month = (s[5] - '0') * 10 + (s[6] - '0');
+  const unsigned dom = (s[8] - '0') * 10 + (s[9] - '0');
+  if (month < 1 || month > 12 || dom < 1 || dom > DaysInMonth(year, month)) {
+    return false;
+  }
+  day = DaysFromCivil(year, month, dom);
+  return true;
+}
+
+}  // namespace
+
+TradingCalendar::TradingCalendar(std::string exchange, int first_year,
+                                 int last_year,
+                                 const std::vector<int64_t> &holidays)
+    : exchange_(std::move(exchange)), first_year_(first_year) {
+  if (last_year < first_year) {
+    throw std::invalid_argument("Calendar span ends before it starts");
+  }
+  for (int year = first_year; year <= last_year + 1; ++year) {
+    year_start_.push_back(DaysFromCivil(year, 1, 1));
+  }
+
+  std::vector<int64_t> closed = holidays;
+  std::sort(closed.begin(), closed.end());
+  auto holiday = closed.begin();
+
+  const size_t years = year_start_.size() - 1;
+  bits_.assign(years * kWordsPerYear, 0);
+  rank_.resize(bits_.size());
+  for (size_t y = 0; y < years; ++y) {
+    for (int64_t day = year_start_[y]; day < year_start_[y + 1]; ++day) {
+      while (holiday != closed.end() && *holiday < day) ++holiday;
+      const unsigned weekday = Weekday(day);
+      if (weekday == 0 || weekday == 6) continue;
+      if (holiday != closed.end() && *holiday == day) continue;
+      const size_t doy = static_cast<size_t>(day - year_start_[y]);
+      bits_[y * kWordsPerYear + doy / 64] |= uint64_t{1} << (doy % 64);
+      days_.push_back(static_cast<int32_t>(day - FirstDay()));
+    }
+  }
+  uint32_t before = 0;
+  for (size_t w = 0; w < bits_.size(); ++w) {
+    rank_[w] = before;
+    before += static_cast<uint32_t>(__builtin_popcountll(bits_[w]));
+  }
+}
+
+int64_t TradingCalendar::TradingDayIndex(int64_t day) const {
+  if (day < FirstDay() || day > EndDay()) {
+    throw std::out_of_range("Day outside the " + exchange_ + " calendar");
+  }
+  if (day == EndDay()) return TradingDays();
+  const size_t year = YearIndex(day);
+  const size_t doy = static_cast<size_t>(day - year_start_[year]);
+  const size_t word = year * kWordsPerYear + doy / 64;
+  const uint64_t below = (uint64_t{1} << (doy % 64)) - 1;
+  return rank_[word] + __builtin_popcountll(bits_[word] & below);
+}
+
+int64_t TradingCalendar::TradingDay(int64_t index) const {
+  if (index < 0 || index >= TradingDays()) {
+    throw std::out_of_range("Trading day outside the " + exchange_ +
+                            " calendar");
+  }
+  return FirstDay() + days_[static_cast<size_t>(index)];
+}
+
+int TradingCalendar::TradingDayOfYear(int64_t day) const {
+  if (day < FirstDay() || day >= EndDay()) {
+    throw std::out_of_range("Day outside the " + exchange_ + " calendar");
+  }
+  const size_t year = YearIndex(day);
+  return static_cast<int>(TradingDayIndex(day) -
+                          rank_[year * kWordsPerYear]);
+}
+
+int TradingCalendar::TradingDaysInYear(int year) const {
+  const int index = year - first_year_;
+  if (index < 0 || index >= Years()) {
+    throw std::out_of_range("Year outside the " + exchange_ + " calendar");
+  }
+  const int64_t end = index + 1 < Years()
+                          ? rank_[(index + 1) * kWordsPerYear]
+                          : TradingDays();
+  return static_cast<int>(end - rank_[index * kWordsPerYear]);
+}
+
+int64_t TradingCalendar::AddBusinessDays(int64_t day, int64_t n) const {
+  // The index of a closed day already names the next trading day
+  const int64_t skip = n > 0 && !IsTradingDay(day) ? 1 : 0;
+  return TradingDay(TradingDayIndex(day) + n - skip);
+}
+
+int64_t TradingCalendar::ApplyRule(const ExpiryRule &rule, int year,
+                                   ExpirationMonth month) const {
+  const int64_t months =
+      int64_t{year} * 12 + static_cast<int>(month) + rule.month_offset;
+  const int64_t anchor_year = months >= 0 ? months / 12 : (months - 11) / 12;
+  const unsigned anchor_month =
+      static_cast<unsigned>(months - anchor_year * 12) + 1;
+  const unsigned dom = std::min(
+      std::max(rule.anchor_day, 1u), DaysInMonth(anchor_year, anchor_month));
+  const int64_t anchor = DaysFromCivil(anchor_year, anchor_month, dom);
+  const int offset = IsTradingDay(anchor) ? rule.offset : rule.offset_if_closed;
+  return TradingDay(TradingDayIndex(anchor) + offset);
+}
+
+const uint64_t *TradingCalendar::YearBits(int year) const {
+  const int index = year - first_year_;
+  if (index < 0 || index >= Years()) {
+    throw std::out_of_range("Year outside the " + exchange_ + " calendar");
+  }
+  return bits_.data() + static_cast<size_t>(index) * kWordsPerYear;
+}
+
+ExchangeCalendars::ExchangeCalendars(int first_year, int last_year)
+    : first_year_(first_year), last_year_(last_year) {
+  // Business day prior to the 15th calendar day of the contract month
+  for (const char *symbol : {"ZC", "ZS", "ZW", "KE", "ZM", "ZL", "ZO"}) {
+    rules_[symbol] = ExpiryRule{"CBOT", 0, 15, -1, -1};
+  }
+  // Last business day of the contract month
+  rules_["LE"] = ExpiryRule{"CME", 1, 1, -1, -1};
+  // 10th business day of the contract month
+  rules_["HE"] = ExpiryRule{"CME", 0, 1, 9, 9};
+  // 3 business days before the 25th of the prior month, 4 if it is closed
+  rules_["CL"] = ExpiryRule{"NYMEX", -1, 25, -3, -4};
+  // 3 business days before the first day of the contract month
+  rules_["NG"] = ExpiryRule{"NYMEX", 0, 1, -3, -3};
+  // Last business day of the month prior to the contract month
+  rules_["HO"] = ExpiryRule{"NYMEX", 0, 1, -1, -1};
+  rules_["RB"] = ExpiryRule{"NYMEX", 0, 1, -1, -1};
+}
+
+ExchangeCalendars &ExchangeCalendars::Instance() {
+  static ExchangeCalendars calendars;
+  static std::once_flag loaded;
+  std::call_once(loaded, [] {
+    const char *path = std::getenv("ALCHEMATH_HOLIDAYS_FILE");
+    if (path) calendars.LoadHolidays(path);
+  });
+  return calendars;
+}
+
+bool ExchangeCalendars::LoadHolidays(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) return false;
+
+  std::map<std::string, std::vector<int64_t>> parsed;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::string_view rest = Trim(line);
+    if (rest.empty() || rest.front() == '#') continue;
+    const size_t comma = rest.find(',');
+    if (comma == std::string_view::npos) continue;
+    const std::string_view exchange = Trim(rest.substr(0, comma));
+    std::string_view date = rest.substr(comma + 1);
+    date = Trim(date.substr(0, date.find(',')));
+    int64_t day = 0;
+    if (exchange.empty() || !ParseDate(date, day)) continue;
+    parsed[std::string(exchange)].push_back(day);
+  }
+  for (const auto &[exchange, days] : parsed) AddHolidays(exchange, days);
+  return true;
+}
+
+void ExchangeCalendars::AddHolidays(const std::string &exchange,
+                                    const std::vector<int64_t> &days) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &holidays = holidays_[exchange];
+  holidays.insert(holidays.end(), days.begin(), days.end());
+  calendars_.erase(exchange);
+}
+
+std::shared_ptr<const TradingCalendar> ExchangeCalendars::Calendar(
+    const std::string &exchange) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = calendars_.find(exchange);
+  if (it != calendars_.end()) return it->second;
+  return BuildLocked(exchange);
+}
+
+std::shared_ptr<const TradingCalendar> ExchangeCalendars::BuildLocked(
+    const std::string &exchange) {
+  auto holidays = holidays_.find(exchange);
+  auto calendar = std::make_shared<const TradingCalendar>(
+      exchange, first_year_, last_year_,
+      holidays != holidays_.end() ? holidays->second
+                                  : std::vector<int64_t>{});
+  calendars_[exchange] = calendar;
+  return calendar;
+}
+
+void ExchangeCalendars::SetRule(const std::string &symbol, ExpiryRule rule) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  rules_[symbol] = std::move(rule);
+}
+
+ExpiryRule ExchangeCalendars::Rule(const std::string &symbol) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = rules_.find(symbol);
+  if (it == rules_.end()) {
+    throw std::out_of_range("No expiry rule for symbol " + symbol);
+  }
+  return it->second;
+}
+
+int64_t ExchangeCalendars::LastTradeDate(const Contract &contract) {
+  const ExpiryRule rule = Rule(contract.symbol);
+  return Calendar(rule.exchange)
+      ->ApplyRule(rule, contract.expirationYear, contract.expirationMonth);
+}
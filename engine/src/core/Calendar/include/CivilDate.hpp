@@ -0,0 +1,77 @@
+/**
+ * @file CivilDate.hpp
+ * @brief Branch-light conversions between civil dates and day numbers.
+ *
+ * Day numbers count days since 1970-01-01 in the proleptic Gregorian
+ * calendar. The conversions are H. Hinnant's era-based algorithms; they are
+ * constexpr and never call into <ctime>, so parsers and analysis loops can
+ * use them freely.
+ */
+
+#ifndef CIVIL_DATE_HPP
+#define CIVIL_DATE_HPP
+
+#include <cstdint>
+
+/**
+ * @struct CivilDate
+ * @brief A year, month (1-12) and day of month (1-31).
+ */
+struct CivilDate {
+  int year = 1970;
+  unsigned month = 1;
+  unsigned day = 1;
+};
+
+/**
+ * @brief Days since 1970-01-01 for a proleptic Gregorian date.
+ */
+constexpr int64_t DaysFromCivil(int64_t y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(y - era * 400);
+  const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+/**
+ * @brief Inverse of DaysFromCivil().
+ */
+constexpr CivilDate CivilFromDays(int64_t days) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(days - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+  const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+  const int64_t y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+  return CivilDate{static_cast<int>(y), m, d};
+}
+
+/**
+ * @brief Day of the week, 0 = Sunday ... 6 = Saturday.
+ */
+constexpr unsigned Weekday(int64_t days) {
+  return static_cast<unsigned>(days >= -4 ? (days + 4) % 7
+                                          : (days + 5) % 7 + 6);
+}
+
+/**
+ * @brief Day number containing a timestamp in milliseconds since epoch.
+ */
+constexpr int64_t DayFromTimestamp(uint64_t timestamp_ms) {
+  return static_cast<int64_t>(timestamp_ms / 86400000ULL);
+}
+
+/**
+ * @brief Number of days in a month of a year.
+ */
+constexpr unsigned DaysInMonth(int64_t y, unsigned m) {
+  return m == 2 ? ((y % 4 == 0 && y % 100 != 0) || y % 400 == 0 ? 29 : 28)
+                : (m == 4 || m == 6 || m == 9 || m == 11 ? 30 : 31);
+}
+
+#endif /* CIVIL_DATE_HPP */
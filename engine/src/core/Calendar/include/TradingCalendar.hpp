@@ -0,0 +1,282 @@
+/**
+ * @file TradingCalendar.hpp
+ * @brief Exchange trading calendars with precomputed trading-day tables.
+ *
+ * Seasonal alignment, roll rules and "days to expiry" all count trading
+ * days. A TradingCalendar precomputes, for every year of its span, a bitset
+ * of the exchange's trading days together with rank and select tables, so
+ * every query is a few loads and a popcount. Holidays come from a local
+ * file; weekends are always closed.
+ */
+
+#ifndef TRADING_CALENDAR_HPP
+#define TRADING_CALENDAR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "CivilDate.hpp"
+#include "Contract.hpp"
+
+/**
+ * @struct ExpiryRule
+ * @brief How a symbol's last trade date follows from its contract month.
+ *
+ * The last trade date is found from an anchor day. The anchor is calendar
+ * day `anchor_day` of the month `month_offset` months from the contract
+ * month. From there the rule counts `offset` trading days: 0 is the anchor
+ * itself, or the next trading day if it is closed, and -1 is the last
+ * trading day before the anchor.
+ *
+ * ```cpp
+ * // CBOT grains: the business day prior to the 15th of the contract month
+ * ExpiryRule grains{"CBOT", 0, 15, -1, -1};
+ * ```
+ */
+struct ExpiryRule {
+  std::string exchange;       ///< Calendar the rule counts on
+  int month_offset = 0;       ///< Anchor month relative to the contract month
+  unsigned anchor_day = 1;    ///< Calendar day of the anchor month
+  int offset = -1;            ///< Trading days from the anchor
+  int offset_if_closed = -1;  ///< Used instead when the anchor is closed
+};
+
+/**
+ * @class TradingCalendar
+ * @brief Immutable trading-day tables of one exchange over a span of years.
+ *
+ * Days are day numbers (days since 1970-01-01, see CivilDate.hpp). Each year
+ * owns a 366-bit bitset indexed by day of year. A running count of trading
+ * days before every 64-bit word gives the rank of any day. A sorted list of
+ * trading days answers the inverse. Lookups are O(1) and lock-free, so a
+ * calendar can be shared by any number of threads.
+ *
+ * @example
+ * ```cpp
+ * auto cbot = ExchangeCalendars::Instance().Calendar("CBOT");
+ * const int64_t day = DayFromTimestamp(bar.timestamp);
+ * const int64_t to_expiry = cbot->BusinessDaysBetween(day, expiry);
+ * ```
+ */
+class TradingCalendar {
+ public:
+  /// Words in the bitset of one year.
+  static constexpr size_t kWordsPerYear = 6;
+
+  /**
+   * @param exchange Exchange name
+   * @param first_year First year covered
+   * @param last_year Last year covered (inclusive)
+   * @param holidays Day numbers of weekday closures; others are ignored
+   */
+  TradingCalendar(std::string exchange, int first_year, int last_year,
+                  const std::vector<int64_t> &holidays);
+
+  const std::string &Exchange() const { return exchange_; }
+  int FirstYear() const { return first_year_; }
+  int LastYear() const { return first_year_ + Years() - 1; }
+
+  /**
+   * @brief First day covered.
+   */
+  int64_t FirstDay() const { return year_start_.front(); }
+
+  /**
+   * @brief One past the last day covered.
+   */
+  int64_t EndDay() const { return year_start_.back(); }
+
+  /**
+   * @brief True for an open weekday inside the span.
+   */
+  bool IsTradingDay(int64_t day) const {
+    if (day < FirstDay() || day >= EndDay()) return false;
+    const size_t year = YearIndex(day);
+    const size_t doy = static_cast<size_t>(day - year_start_[year]);
+    return (bits_[year * kWordsPerYear + doy / 64] >> (doy % 64)) & 1;
+  }
+
+  /**
+   * @brief Number of trading days from FirstDay() up to, not including,
+   * `day`; the index of `day` if it is a trading day.
+   * @throws std::out_of_range if `day` is outside [FirstDay(), EndDay()]
+   */
+  int64_t TradingDayIndex(int64_t day) const;
+
+  /**
+   * @brief The trading day with a given index; inverse of TradingDayIndex().
+   * @throws std::out_of_range if there is no such trading day in the span
+   */
+  int64_t TradingDay(int64_t index) const;
+
+  /**
+   * @brief Number of trading days in the span.
+   */
+  int64_t TradingDays() const {
+    return static_cast<int64_t>(days_.size());
+  }
+
+  /**
+   * @brief Trading days of the year before `day`.
+   *
+   * Aligns seasonal series: the n-th session of every year has index n.
+   *
+   * @throws std::out_of_range if `day` is outside the span
+   */
+  int TradingDayOfYear(int64_t day) const;
+
+  /**
+   * @brief Number of trading days in a year of the span.
+   * @throws std::out_of_range if the year is not covered
+   */
+  int TradingDaysInYear(int year) const;
+
+  /**
+   * @brief Moves `n` trading days from `day`.
+   *
+   * For n > 0 the n-th trading day after `day`; for n < 0 the |n|-th before
+   * it. For n == 0, `day` itself, or the next trading day if it is closed.
+   *
+   * @throws std::out_of_range if the result leaves the span
+   */
+  int64_t AddBusinessDays(int64_t day, int64_t n) const;
+
+  /**
+   * @brief Trading days in [from, to); negative if `to` precedes `from`.
+   * @throws std::out_of_range if either day is outside the span
+   */
+  int64_t BusinessDaysBetween(int64_t from, int64_t to) const {
+    return TradingDayIndex(to) - TradingDayIndex(from);
+  }
+
+  /**
+   * @brief The day `rule` selects for a contract month.
+   * @throws std::out_of_range if the result is outside the span
+   */
+  int64_t ApplyRule(const ExpiryRule &rule, int year,
+                    ExpirationMonth month) const;
+
+  /**
+   * @brief The trading-day bitset of a year; bit d is day of year d.
+   * @return Pointer to kWordsPerYear words
+   * @throws std::out_of_range if the year is not covered
+   */
+  const uint64_t *YearBits(int year) const;
+
+ private:
+  int Years() const { return static_cast<int>(year_start_.size()) - 1; }
+
+  size_t YearIndex(int64_t day) const {
+    // The mean Gregorian year under- or overshoots by at most one year
+    size_t year =
+        static_cast<size_t>((day - FirstDay()) * 400 / 146097);
+    if (year >= static_cast<size_t>(Years())) year = Years() - 1;
+    if (day < year_start_[year]) {
+      --year;
+    } else if (day >= year_start_[year + 1]) {
+      ++year;
+    }
+    return year;
+  }
+
+  std::string exchange_;
+  int first_year_;
+  std::vector<int64_t> year_start_;  ///< January 1st of every year, + end
+  std::vector<uint64_t> bits_;       ///< kWordsPerYear words per year
+  std::vector<uint32_t> rank_;       ///< Trading days before each word
+  std::vector<int32_t> days_;        ///< Trading days, minus FirstDay()
+};
+
+/**
+ * @class ExchangeCalendars
+ * @brief Trading calendars by exchange, and expiry rules by symbol.
+ *
+ * Exchanges without loaded holidays trade every weekday. Calendars are
+ * built once per exchange and handed out as shared immutable snapshots;
+ * loading more holidays replaces the affected calendars without disturbing
+ * readers of the old ones.
+ *
+ * Holiday files are CSV lines `exchange,YYYY-MM-DD[,description]`. Blank
+ * lines, lines starting with `#` and a header line are skipped.
+ *
+ * Built-in expiry rules cover the CBOT grains and oilseeds (ZC, ZS, ZW, KE,
+ * ZM, ZL, ZO), CME livestock (LE, HE) and NYMEX energy (CL, NG, HO, RB).
+ */
+class ExchangeCalendars {
+ public:
+  /**
+   * @param first_year First year every calendar covers
+   * @param last_year Last year every calendar covers (inclusive)
+   */
+  explicit ExchangeCalendars(int first_year = 1970, int last_year = 2069);
+
+  ExchangeCalendars(const ExchangeCalendars &) = delete;
+  ExchangeCalendars &operator=(const ExchangeCalendars &) = delete;
+
+  /**
+   * @brief Returns the calendars shared by the whole engine.
+   *
+   * Loads the holiday file named by `ALCHEMATH_HOLIDAYS_FILE`, if set.
+   */
+  static ExchangeCalendars &Instance();
+
+  /**
+   * @brief Adds the holidays listed in a file.
+   *
+   * @param path Holiday file
+   * @return bool False if the file cannot be read; malformed lines are
+   *         skipped
+   */
+  bool LoadHolidays(const std::string &path);
+
+  /**
+   * @brief Adds holidays of one exchange.
+   */
+  void AddHolidays(const std::string &exchange,
+                   const std::vector<int64_t> &days);
+
+  /**
+   * @brief The calendar of an exchange; built on first use.
+   */
+  std::shared_ptr<const TradingCalendar> Calendar(
+      const std::string &exchange);
+
+  /**
+   * @brief Sets or replaces the expiry rule of a symbol.
+   */
+  void SetRule(const std::string &symbol, ExpiryRule rule);
+
+  /**
+   * @brief The expiry rule of a symbol.
+   * @throws std::out_of_range if no rule is known for the symbol
+   */
+  ExpiryRule Rule(const std::string &symbol) const;
+
+  /**
+   * @brief The last trade date (day number) of a contract.
+   * @throws std::out_of_range if the symbol has no rule or the date falls
+   *         outside the calendar span
+   */
+  int64_t LastTradeDate(const Contract &contract);
+
+ private:
+  std::shared_ptr<const TradingCalendar> BuildLocked(
+      const std::string &exchange);
+
+  int first_year_;
+  int last_year_;
+  mutable std::mutex mutex_;
+  std::map<std::string, std::vector<int64_t>> holidays_;
+  std::unordered_map<std::string, std::shared_ptr<const TradingCalendar>>
+      calendars_;
+  std::unordered_map<std::string, ExpiryRule> rules_;
+};
+
+#endif /* TRADING_CALENDAR_HPP */
@@ -0,0 +1,185 @@
+/**
+ * @file JobRegistry.cpp
+ * @brief Implementation of job contexts and the job registry.
+ */
+
+#include "include/JobRegistry.hpp"
+
+const char *JobStateToString(JobState state) {
+  switch (state) {
+    case JobState::kQueued:
+      return "queued";
+    case JobState::kRunning:
+      return "running";
+    case JobState::kSucceeded:
+      return "succeeded";
+    case JobState::kFailed:
+      return "failed";
+    case JobState::kCancelled:
+      return "cancelled";
+  }
+  return "unknown";
+}
+
+JobContext::Counter &JobContext::Find(std::string_view name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &counter : counters_) {
+    if (counter.name == name) return counter;
+  }
+  return counters_.emplace_back(name);
+}
+
+void JobContext::AddWork(std::string_view counter, size_t units) {
+  Find(counter).total.fetch_add(units, std::memory_order_relaxed);
+}
+
+void JobContext::Advance(std::string_view counter, size_t units) {
+  Find(counter).done.fetch_add(units, std::memory_order_relaxed);
+}
+
+std::vector<JobCounter> JobContext::Progress() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<JobCounter> progress;
+  progress.reserve(counters_.size());
+  for (const auto &counter : counters_) {
+    progress.push_back({counter.name, counter.done.load(),
+                        counter.total.load()});
+  }
+  return progress;
+}
+
+void JobContext::Publish(std::string kind, std::any value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  partials_.push_back({next_sequence_++, std::move(kind), std::move(value)});
+}
+
+std::vector<PartialResult> JobContext::TakePartials() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<PartialResult> taken;
+  taken.swap(partials_);
+  return taken;
+}
+
+JobRegistry &JobRegistry::Instance() {
+  static JobRegistry registry;
+  return registry;
+}
+
+JobId JobRegistry::Start(std::string name, Body body) {
+  auto job = std::make_shared<Job>();
+  job->name = std::move(name);
+  JobId id;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    id = next_id_++;
+    jobs_.emplace(id, job);
+  }
+  // The task owns the job, so it may outlive a Remove() or the registry
+  scheduler_.Submit([job, body = std::move(body)] { Execute(*job, body); });
+  return id;
+}
+
+void JobRegistry::Execute(Job &job, const Body &body) {
+  {
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (job.context.IsCancelled()) {
+      job.state = JobState::kCancelled;
+      job.done_cv.notify_all();
+      return;
+    }
+    job.state = JobState::kRunning;
+  }
+
+  JobState state = JobState::kSucceeded;
+  std::string error;
+  try {
+    body(job.context);
+  } catch (const JobCancelled &) {
+    state = JobState::kCancelled;
+  } catch (const std::exception &e) {
+    state = JobState::kFailed;
+    error = e.what();
+  } catch (...) {
+    state = JobState::kFailed;
+    error = "unknown exception";
+  }
+  // A body that ignores cancellation still only produced partial output
+  if (state == JobState::kSucceeded && job.context.IsCancelled()) {
+    state = JobState::kCancelled;
+  }
+
+  std::lock_guard<std::mutex> lock(job.mutex);
+  job.state = state;
+  job.error = std::move(error);
+  job.done_cv.notify_all();
+}
+
+std::shared_ptr<JobRegistry::Job> JobRegistry::Find(JobId id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = jobs_.find(id);
+  return it == jobs_.end() ? nullptr : it->second;
+}
+
+bool JobRegistry::Cancel(JobId id) {
+  auto job = Find(id);
+  if (!job) return false;
+  std::lock_guard<std::mutex> lock(job->mutex);
+  if (job->state != JobState::kQueued && job->state != JobState::kRunning) {
+    return false;
+  }
+  job->context.Cancel();
+  return true;
+}
+
+std::optional<JobStatus> JobRegistry::Status(JobId id) const {
+  auto job = Find(id);
+  if (!job) return std::nullopt;
+  JobStatus status;
+  status.id = id;
+  status.name = job->name;
+  status.progress = job->context.Progress();
+  std::lock_guard<std::mutex> lock(job->mutex);
+  status.state = job->state;
+  status.error = job->error;
+  return status;
+}
+
+std::vector<PartialResult> JobRegistry::TakePartials(JobId id) {
+  auto job = Find(id);
+  if (!job) return {};
+  return job->context.TakePartials();
+}
+
+JobState JobRegistry::Wait(JobId id) {
+  auto job = Find(id);
+  if (!job) throw std::out_of_range("Unknown job " + std::to_string(id));
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->done_cv.wait(lock, [&] {
+    return job->state != JobState::kQueued &&
+           job->state != JobState::kRunning;
+  });
+  return job->state;
+}
+
+bool JobRegistry::Remove(JobId id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = jobs_.find(id);
+  if (it == jobs_.end()) return false;
+  {
+    std::lock_guard<std::mutex> job_lock(it->second->mutex);
+    const JobState state = it->second->state;
+    if (state == JobState::kQueued || state == JobState::kRunning) {
+      return false;
+    }
+  }
+  jobs_.erase(it);
+  return true;
+}
+
+std::vector<JobId> JobRegistry::Jobs() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<JobId> ids;
+  ids.reserve(jobs_.size());
+  for (const auto &entry : jobs_) ids.push_back(entry.first);
+  return ids;
+}
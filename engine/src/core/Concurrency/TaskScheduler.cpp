@@ -0,0 +1,259 @@
+/**
+ * @file TaskScheduler.cpp
+ * @brief Implementation of the work-stealing scheduler and task groups.
+ */
+
+#include "include/TaskScheduler.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// Scheduler and worker index of the current thread, if it is a worker.
+thread_local const TaskScheduler *tls_scheduler = nullptr;
+thread_local size_t tls_worker = 0;
+
+// Chunks per worker handed out by automatic grain sizing; enough for
+// stealing to even out uneven chunks without drowning in task overhead.
+constexpr size_t kChunksPerWorker = 8;
+
+// Parses a sysfs CPU list such as "0-3,8-11".
+std::vector<int> ParseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || range == "\n") continue;
+    const size_t dash = range.find('-');
+    const int first = std::atoi(range.c_str());
+    const int last =
+        dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+    for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+void PinToCpus(std::thread &thread, const std::vector<int> &cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+  }
+  // Best effort: a restricted cpuset simply leaves the thread unpinned
+  pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+}
+
+size_t DefaultThreads() {
+  const char *env = std::getenv("ALCHEMATH_THREADS");
+  if (env && std::atoi(env) > 0) return static_cast<size_t>(std::atoi(env));
+  return 0;
+}
+
+}  // namespace
+
+TaskScheduler::TaskScheduler(SchedulerOptions options) {
+  size_t threads = options.num_threads;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  const auto topology = NumaTopology();
+  const bool numa = options.numa_aware && topology.size() > 1;
+
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    workers_[i]->node = numa ? static_cast<int>(i % topology.size()) : 0;
+    all_workers_.push_back(i);
+  }
+
+  // Steal from workers on the same node first, nearest index first
+  for (size_t i = 0; i < threads; ++i) {
+    auto &victims = workers_[i]->victims;
+    for (int pass = 0; pass < 2; ++pass) {
+      for (size_t k = 1; k < threads; ++k) {
+        const size_t v = (i + k) % threads;
+        const bool local = workers_[v]->node == workers_[i]->node;
+        if (local == (pass == 0)) victims.push_back(v);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < threads; ++i) {
+    workers_[i]->thread = std::thread(&TaskScheduler::WorkerLoop, this, i);
+    if (numa) PinToCpus(workers_[i]->thread, topology[workers_[i]->node]);
+  }
+}
+
+TaskScheduler::~TaskScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_.store(true);
+  }
+  sleep_cv_.notify_all();
+  for (auto &worker : workers_) worker->thread.join();
+}
+
+TaskScheduler &TaskScheduler::Instance() {
+  static TaskScheduler scheduler([] {
+    SchedulerOptions options;
+    options.num_threads = DefaultThreads();
+    const char *numa = std::getenv("ALCHEMATH_NUMA");
+    options.numa_aware = numa && std::string(numa) == "1";
+    return options;
+  }());
+  return scheduler;
+}
+
+void TaskScheduler::Submit(Task task) {
+  const size_t target = OnWorkerThread()
+                            ? tls_worker
+                            : next_worker_.fetch_add(1) % workers_.size();
+  {
+    std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+    workers_[target]->tasks.push_back(std::move(task));
+  }
+  queued_.fetch_add(1, std::memory_order_release);
+  {
+    // Orders the increment with a worker about to sleep
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  sleep_cv_.notify_one();
+}
+
+bool TaskScheduler::RunOne() {
+  Task task;
+  bool found;
+  if (OnWorkerThread()) {
+    found = TryPop(tls_worker, task) ||
+            TrySteal(workers_[tls_worker]->victims, task);
+  } else {
+    found = TrySteal(all_workers_, task);
+  }
+  if (!found) return false;
+  task();
+  return true;
+}
+
+bool TaskScheduler::OnWorkerThread() const { return tls_scheduler == this; }
+
+bool TaskScheduler::TryPop(size_t index, Task &task) {
+  Worker &worker = *workers_[index];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (worker.tasks.empty()) return false;
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  queued_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool TaskScheduler::TrySteal(const std::vector<size_t> &victims, Task &task) {
+  if (queued_.load(std::memory_order_acquire) == 0) return false;
+  for (size_t v : victims) {
+    Worker &victim = *workers_[v];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.tasks.empty()) continue;
+    task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+void TaskScheduler::WorkerLoop(size_t index) {
+  tls_scheduler = this;
+  tls_worker = index;
+  Task task;
+  for (;;) {
+    if (TryPop(index, task) || TrySteal(workers_[index]->victims, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.wait(lock, [this] {
+      return stopping_.load() || queued_.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping_.load() && queued_.load() == 0) return;
+  }
+}
+
+std::vector<std::vector<int>> TaskScheduler::NumaTopology() {
+  std::vector<std::vector<int>> nodes;
+  std::error_code ec;
+  const std::filesystem::path root("/sys/devices/system/node");
+  for (int node = 0;; ++node) {
+    const auto dir = root / ("node" + std::to_string(node));
+    if (!std::filesystem::exists(dir, ec)) break;
+    std::ifstream file(dir / "cpulist");
+    std::string list;
+    std::getline(file, list);
+    auto cpus = ParseCpuList(list);
+    if (!cpus.empty()) nodes.push_back(std::move(cpus));
+  }
+  if (nodes.empty()) {
+    std::vector<int> all;
+    const unsigned count = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned cpu = 0; cpu < count; ++cpu) all.push_back(cpu);
+    nodes.push_back(std::move(all));
+  }
+  return nodes;
+}
+
+TaskGroup::~TaskGroup() { WaitQuietly(); }
+
+void TaskGroup::Wait() {
+  WaitQuietly();
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(error, error_);
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+void TaskGroup::WaitQuietly() {
+  while (pending_.load(std::memory_order_acquire) != 0) {
+    if (scheduler_.RunOne()) continue;
+    if (scheduler_.OnWorkerThread()) {
+      // The group's remaining tasks run elsewhere and may still spawn
+      // work this worker should help with, so keep polling
+      std::this_thread::yield();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] {
+      return pending_.load(std::memory_order_acquire) == 0;
+    });
+  }
+  // Finish() decrements under the mutex; taking it once more guarantees
+  // the last task has let go of the group before it can be destroyed
+  std::lock_guard<std::mutex> lock(mutex_);
+}
+
+void TaskGroup::Fail(std::exception_ptr error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!error_) error_ = error;
+  cancelled_.store(true, std::memory_order_relaxed);
+}
+
+void TaskGroup::Finish() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    done_cv_.notify_all();
+  }
+}
+
+size_t TaskGroup::GrainFor(size_t n, size_t grain) const {
+  if (grain > 0) return grain;
+  const size_t chunks = kChunksPerWorker * scheduler_.NumWorkers();
+  return std::max<size_t>(1, (n + chunks - 1) / chunks);
+}
@@ -0,0 +1,279 @@
+/**
+ * @file JobRegistry.hpp
+ * @brief Long-running analyses as cancellable, observable jobs.
+ *
+ * A spread analysis loads a commodity's history and runs several kernels
+ * over it; the API layer gives up on a request long before that finishes,
+ * and an abandoned computation would otherwise keep its cores busy. Jobs
+ * give every analysis an ID through which the caller can poll progress,
+ * collect partial results as they are produced and cancel the work.
+ *
+ * Cancellation is cooperative: loaders and kernels that receive a
+ * JobContext call Checkpoint() inside their loops, which unwinds the job
+ * with JobCancelled once cancellation was requested.
+ */
+
+#ifndef JOB_REGISTRY_HPP
+#define JOB_REGISTRY_HPP
+
+#include <any>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TaskScheduler.hpp"
+
+/**
+ * @class JobCancelled
+ * @brief Thrown by JobContext::Checkpoint() to unwind a cancelled job.
+ */
+class JobCancelled : public std::runtime_error {
+ public:
+  JobCancelled() : std::runtime_error("job cancelled") {}
+};
+
+/**
+ * @enum JobState
+ * @brief Lifecycle of a job.
+ */
+enum class JobState {
+  kQueued,     ///< Waiting for a worker
+  kRunning,    ///< Body is executing
+  kSucceeded,  ///< Body returned normally
+  kFailed,     ///< Body threw; see JobStatus::error
+  kCancelled   ///< Cancelled before or while running
+};
+
+/**
+ * @brief Lower-case name of a job state, e.g. "running".
+ */
+const char *JobStateToString(JobState state);
+
+/**
+ * @struct JobCounter
+ * @brief Snapshot of one progress counter.
+ */
+struct JobCounter {
+  std::string name;
+  size_t done = 0;
+  size_t total = 0;  ///< Expected units of work; 0 if unknown
+};
+
+/**
+ * @struct PartialResult
+ * @brief A piece of output published before the job has finished.
+ */
+struct PartialResult {
+  uint64_t sequence = 0;  ///< Publication order within the job, from 0
+  std::string kind;       ///< What `value` holds, chosen by the publisher
+  std::any value;
+};
+
+/**
+ * @class JobContext
+ * @brief Cancellation flag, progress counters and partial-result queue of
+ *        one job.
+ *
+ * Every member is thread-safe, so the tasks of a job can report progress
+ * and hit checkpoints from any worker.
+ *
+ * @example
+ * ```cpp
+ * job.AddWork(JobContext::kYearsComputed, years.size());
+ * for (const auto &year : years) {
+ *   job.Checkpoint();
+ *   job.Publish("year", ComputeYear(year));
+ *   job.Advance(JobContext::kYearsComputed);
+ * }
+ * ```
+ */
+class JobContext {
+ public:
+  /// Counter names reported by the engine's loaders and kernels
+  static constexpr const char *kContractsLoaded = "contracts_loaded";
+  static constexpr const char *kYearsComputed = "years_computed";
+  static constexpr const char *kResamples = "resamples";
+  static constexpr const char *kWindowTiles = "window_tiles";
+  static constexpr const char *kPairsTested = "pairs_tested";
+  static constexpr const char *kBacktestsRun = "backtests_run";
+
+  JobContext() = default;
+  JobContext(const JobContext &) = delete;
+  JobContext &operator=(const JobContext &) = delete;
+
+  /**
+   * @brief Requests cancellation; the job stops at its next checkpoint.
+   */
+  void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+  bool IsCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Cancellation point.
+   * @throws JobCancelled if cancellation was requested
+   */
+  void Checkpoint() const {
+    if (IsCancelled()) throw JobCancelled();
+  }
+
+  /**
+   * @brief Adds `units` to the expected total of a counter.
+   */
+  void AddWork(std::string_view counter, size_t units);
+
+  /**
+   * @brief Records `units` of finished work on a counter.
+   */
+  void Advance(std::string_view counter, size_t units = 1);
+
+  /**
+   * @brief Returns every counter, in order of first use.
+   */
+  std::vector<JobCounter> Progress() const;
+
+  /**
+   * @brief Queues a partial result for the caller to collect.
+   */
+  void Publish(std::string kind, std::any value);
+
+  /**
+   * @brief Removes and returns the partial results queued so far.
+   */
+  std::vector<PartialResult> TakePartials();
+
+ private:
+  struct Counter {
+    explicit Counter(std::string_view n) : name(n) {}
+    std::string name;
+    std::atomic<size_t> done{0};
+    std::atomic<size_t> total{0};
+  };
+
+  Counter &Find(std::string_view name);
+
+  std::atomic<bool> cancelled_{false};
+  mutable std::mutex mutex_;
+  std::deque<Counter> counters_;  ///< Deque: references stay valid
+  std::vector<PartialResult> partials_;
+  uint64_t next_sequence_ = 0;
+};
+
+using JobId = uint64_t;
+
+/**
+ * @struct JobStatus
+ * @brief Point-in-time view of a job.
+ */
+struct JobStatus {
+  JobId id = 0;
+  std::string name;
+  JobState state = JobState::kQueued;
+  std::vector<JobCounter> progress;
+  std::string error;  ///< Exception message of a failed job
+};
+
+/**
+ * @class JobRegistry
+ * @brief Starts jobs on the TaskScheduler and tracks them by ID.
+ *
+ * Finished jobs stay registered, with their status and any uncollected
+ * partial results, until Remove() is called.
+ *
+ * @example
+ * ```cpp
+ * auto &jobs = JobRegistry::Instance();
+ * JobId id = jobs.Start("ZC H/K", [=](JobContext &job) {
+ *   auto series = DataManager::loadContractsBulk(contracts, &job);
+ *   job.Publish("analysis", Analyze(series, job));
+ * });
+ * // On client disconnect:
+ * jobs.Cancel(id);
+ * ```
+ */
+class JobRegistry {
+ public:
+  using Body = std::function<void(JobContext &)>;
+
+  explicit JobRegistry(TaskScheduler &scheduler = TaskScheduler::Instance())
+      : scheduler_(scheduler) {}
+
+  JobRegistry(const JobRegistry &) = delete;
+  JobRegistry &operator=(const JobRegistry &) = delete;
+
+  /**
+   * @brief Returns the registry shared by the whole engine.
+   */
+  static JobRegistry &Instance();
+
+  /**
+   * @brief Queues `body` as a new job.
+   * @return JobId Identifier for the other calls, never 0
+   */
+  JobId Start(std::string name, Body body);
+
+  /**
+   * @brief Requests cancellation of a job.
+   * @return bool False if the job is unknown or already finished
+   */
+  bool Cancel(JobId id);
+
+  /**
+   * @brief Returns the job's state and progress, or nothing if unknown.
+   */
+  std::optional<JobStatus> Status(JobId id) const;
+
+  /**
+   * @brief Removes and returns the job's queued partial results.
+   */
+  std::vector<PartialResult> TakePartials(JobId id);
+
+  /**
+   * @brief Blocks until the job has finished.
+   * @return JobState Final state
+   * @throws std::out_of_range if the job is unknown
+   */
+  JobState Wait(JobId id);
+
+  /**
+   * @brief Forgets a finished job.
+   * @return bool False if the job is unknown or still queued or running
+   */
+  bool Remove(JobId id);
+
+  /**
+   * @brief IDs of all registered jobs, oldest first.
+   */
+  std::vector<JobId> Jobs() const;
+
+ private:
+  struct Job {
+    std::string name;
+    JobContext context;
+    mutable std::mutex mutex;
+    std::condition_variable done_cv;
+    JobState state = JobState::kQueued;
+    std::string error;
+  };
+
+  static void Execute(Job &job, const Body &body);
+  std::shared_ptr<Job> Find(JobId id) const;
+
+  TaskScheduler &scheduler_;
+  mutable std::mutex mutex_;
+  std::map<JobId, std::shared_ptr<Job>> jobs_;
+  JobId next_id_ = 1;
+};
+
+#endif /* JOB_REGISTRY_HPP */
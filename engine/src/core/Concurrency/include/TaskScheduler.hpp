@@ -0,0 +1,280 @@
+/**
+ * @file TaskScheduler.hpp
+ * @brief Work-stealing task scheduler shared by every engine subsystem.
+ *
+ * Parsing, resampling, bootstraps and parameter sweeps all run their
+ * parallel work as tasks on one pool of workers, one per core, instead of
+ * each starting its own threads. Every worker owns a deque: it pushes and
+ * pops its own tasks at the back (newest first, cache-warm) while idle
+ * workers steal from the front of other deques (oldest first, usually the
+ * largest pieces of work).
+ */
+
+#ifndef TASK_SCHEDULER_HPP
+#define TASK_SCHEDULER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct SchedulerOptions
+ * @brief Configuration of a TaskScheduler.
+ */
+struct SchedulerOptions {
+  size_t num_threads = 0;   ///< Workers; 0 selects hardware concurrency
+  bool numa_aware = false;  ///< Pin workers to NUMA nodes, steal locally first
+};
+
+/**
+ * @class TaskScheduler
+ * @brief Pool of workers with per-worker deques and work stealing.
+ *
+ * Most code does not submit tasks directly but uses TaskGroup or
+ * ParallelFor(), which add waiting, exceptions and cancellation.
+ *
+ * The process-wide instance is sized by the `ALCHEMATH_THREADS` environment
+ * variable (default: hardware concurrency); `ALCHEMATH_NUMA=1` enables
+ * NUMA-aware placement.
+ */
+class TaskScheduler {
+ public:
+  using Task = std::function<void()>;
+
+  explicit TaskScheduler(SchedulerOptions options = {});
+
+  /**
+   * @brief Runs every queued task, then joins the workers.
+   */
+  ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler &) = delete;
+  TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+  /**
+   * @brief Returns the scheduler shared by the whole engine.
+   */
+  static TaskScheduler &Instance();
+
+  size_t NumWorkers() const { return workers_.size(); }
+
+  /**
+   * @brief Queues a task; it must not throw.
+   *
+   * From a worker of this scheduler the task goes to that worker's own
+   * deque; from any other thread the deques are filled round-robin.
+   */
+  void Submit(Task task);
+
+  /**
+   * @brief Runs one queued task on the calling thread, if there is one.
+   * @return bool False if every deque was empty
+   *
+   * Lets threads that wait for tasks help instead of blocking.
+   */
+  bool RunOne();
+
+  /**
+   * @brief Returns true on a worker thread of this scheduler.
+   */
+  bool OnWorkerThread() const;
+
+  /**
+   * @brief NUMA node a worker is placed on (0 unless numa_aware).
+   */
+  int WorkerNode(size_t worker) const { return workers_[worker]->node; }
+
+  /**
+   * @brief CPUs of each NUMA node, from /sys/devices/system/node.
+   *
+   * Returns a single node with every CPU if the topology is unavailable.
+   */
+  static std::vector<std::vector<int>> NumaTopology();
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::vector<size_t> victims;  ///< Steal order: same node first
+    int node = 0;
+    std::thread thread;
+  };
+
+  void WorkerLoop(size_t index);
+  bool TryPop(size_t index, Task &task);
+  bool TrySteal(const std::vector<size_t> &victims, Task &task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<size_t> all_workers_;  ///< Steal order for outside threads
+  std::atomic<size_t> queued_{0};
+  std::atomic<size_t> next_worker_{0};
+  std::atomic<bool> stopping_{false};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+};
+
+/**
+ * @class TaskGroup
+ * @brief Tasks that are waited for together and can be cancelled together.
+ *
+ * Wait() runs queued tasks while it waits, so groups can be nested freely:
+ * a task may start its own group and wait for it without tying up a worker.
+ * The first exception thrown by a task cancels the group and is rethrown by
+ * Wait(). Cancellation skips tasks that have not started; running tasks can
+ * poll IsCancelled() to stop early.
+ *
+ * @example
+ * ```cpp
+ * TaskGroup group;
+ * for (const auto &path : paths) {
+ *   group.Run([&, path] { Parse(path); });
+ * }
+ * group.Wait();
+ * ```
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(TaskScheduler &scheduler = TaskScheduler::Instance())
+      : scheduler_(scheduler) {}
+
+  /**
+   * @brief Waits for the remaining tasks; exceptions are discarded.
+   */
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  /**
+   * @brief Queues `task` as part of the group.
+   */
+  template <typename F>
+  void Run(F &&task) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    scheduler_.Submit([this, task = std::forward<F>(task)]() mutable {
+      if (!IsCancelled()) {
+        try {
+          task();
+        } catch (...) {
+          Fail(std::current_exception());
+        }
+      }
+      Finish();
+    });
+  }
+
+  /**
+   * @brief Splits [begin, end) into chunks and runs `body(lo, hi)` on each.
+   *
+   * @param grain Chunk size; 0 picks one giving every worker several chunks
+   *
+   * Returns immediately; call Wait() before `body`'s captures go away.
+   */
+  template <typename Body>
+  void ParallelFor(size_t begin, size_t end, Body body, size_t grain = 0) {
+    if (begin >= end) return;
+    grain = GrainFor(end - begin, grain);
+    auto shared = std::make_shared<Body>(std::move(body));
+    for (size_t lo = begin; lo < end; lo += std::min(grain, end - lo)) {
+      const size_t hi = lo + std::min(grain, end - lo);
+      Run([shared, lo, hi] { (*shared)(lo, hi); });
+    }
+  }
+
+  /**
+   * @brief Blocks until every task has finished, helping to run tasks.
+   * @throws The first exception thrown by a task of the group
+   */
+  void Wait();
+
+  /**
+   * @brief Skips every task of the group that has not started yet.
+   */
+  void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+  bool IsCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Chunk size for `n` items: `grain` if non-zero, otherwise about
+   *        eight chunks per worker.
+   */
+  size_t GrainFor(size_t n, size_t grain) const;
+
+ private:
+  void Fail(std::exception_ptr error);
+  void Finish();
+  void WaitQuietly();
+
+  TaskScheduler &scheduler_;
+  std::atomic<size_t> pending_{0};
+  std::atomic<bool> cancelled_{false};
+  std::mutex mutex_;
+  std::condition_variable done_cv_;
+  std::exception_ptr error_;
+};
+
+/**
+ * @brief Runs `body(lo, hi)` over chunks of [begin, end) and waits.
+ *
+ * @param grain Chunk size; 0 selects it automatically
+ *
+ * A range that fits in one chunk runs on the calling thread.
+ *
+ * @example
+ * ```cpp
+ * ParallelFor(0, rows, [&](size_t lo, size_t hi) {
+ *   for (size_t i = lo; i < hi; ++i) out[i] = a[i] - b[i];
+ * });
+ * ```
+ */
+template <typename Body>
+void ParallelFor(size_t begin, size_t end, Body &&body, size_t grain = 0,
+                 TaskScheduler &scheduler = TaskScheduler::Instance()) {
+  if (begin >= end) return;
+  TaskGroup group(scheduler);
+  if (group.GrainFor(end - begin, grain) >= end - begin) {
+    body(begin, end);
+    return;
+  }
+  group.ParallelFor(
+      begin, end, [&body](size_t lo, size_t hi) { body(lo, hi); }, grain);
+  group.Wait();
+}
+
+/**
+ * @struct TaskCount
+ * @brief Number of tasks to split a ParallelFor range into; 0 lets the
+ * scheduler size the chunks.
+ */
+struct TaskCount {
+  size_t tasks = 0;
+};
+
+/**
+ * @brief Runs `body(lo, hi)` over `tasks.tasks` chunks of nearly equal size
+ * and waits.
+ *
+ * For kernels whose configuration asks for a number of parallel tasks
+ * rather than a chunk size.
+ */
+template <typename Body>
+void ParallelFor(size_t begin, size_t end, Body &&body, TaskCount tasks,
+                 TaskScheduler &scheduler = TaskScheduler::Instance()) {
+  const size_t n = end > begin ? end - begin : 0;
+  const size_t grain =
+      tasks.tasks == 0 ? 0 : (n + tasks.tasks - 1) / tasks.tasks;
+  ParallelFor(begin, end, std::forward<Body>(body), grain, scheduler);
+}
+
+#endif /* TASK_SCHEDULER_HPP */
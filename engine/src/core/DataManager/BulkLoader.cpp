@@ -0,0 +1,520 @@
+/**
+ * @file BulkLoader.cpp
+ * @brief io_uring and thread-pool implementations of the bulk file loader.
+ *
+ * The io_uring backend talks to the kernel directly through the raw
+ * syscalls and ring layout from <linux/io_uring.h>, so no liburing is
+ * required at build or run time.
+ */
+
+#include "include/BulkLoader.hpp"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "JobRegistry.hpp"
+#include "TaskScheduler.hpp"
+#include "include/CompressedContractFile.hpp"
+#include "include/ContractCsvReader.hpp"
+
+namespace {
+
+// Largest single read; bigger files are read in several requests.
+constexpr size_t kMaxReadChunk = 1u << 30;
+
+/**
+ * A file whose bytes are being read.
+ */
+struct FileJob {
+  const std::string *path = nullptr;
+  int fd = -1;
+  bool opened = false;
+  bool stated = false;
+  bool failed = false;
+  struct statx stx {};
+  std::unique_ptr<char[]> buffer;
+  size_t size = 0;
+  size_t done = 0;
+};
+
+/**
+ * Parses finished buffers on the shared TaskScheduler in arrival order.
+ */
+class ParsePool {
+ public:
+  ParsePool(std::vector<FileJob> &jobs, std::vector<BulkLoadResult> &results,
+            JobContext *context)
+      : jobs_(jobs), results_(results), context_(context) {}
+
+  void Push(size_t job) {
+    group_.Run([this, job] { Parse(job); });
+  }
+
+  void Finish() { group_.Wait(); }
+
+ private:
+  void Parse(size_t i) {
+    FileJob &job = jobs_[i];
+    BulkLoadResult &result = results_[i];
+    if (context_ && context_->IsCancelled()) {
+      // Left with ok == false
+    } else if (job.size == 0) {
+      result.ok = true;
+    } else if (CompressedContractFile::IsCompressedPath(result.path)) {
+      result.ok = CompressedContractFile::Decode(
+          reinterpret_cast<const uint8_t *>(job.buffer.get()), job.done,
+          result.data);
+    } else {
+      ContractCsvReader reader;
+      result.ok =
+          reader.parse_csv_detect(job.buffer.get(), job.done, result.data);
+    }
+    job.buffer.reset();
+    if (context_ && result.ok) {
+      context_->Advance(JobContext::kContractsLoaded);
+    }
+  }
+
+  std::vector<FileJob> &jobs_;
+  std::vector<BulkLoadResult> &results_;
+  JobContext *context_;
+  TaskGroup group_;
+};
+
+/**
+ * Minimal io_uring: one submission and one completion ring.
+ */
+class Uring {
+ public:
+  ~Uring() {
+    if (sqes_) munmap(sqes_, sqes_size_);
+    if (cq_ptr_ && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_size_);
+    if (sq_ptr_) munmap(sq_ptr_, sq_size_);
+    if (fd_ >= 0) close(fd_);
+  }
+
+  bool Init(unsigned entries) {
+    io_uring_params p{};
+    fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &p));
+    if (fd_ < 0) return false;
+
+    sq_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+    if (single) sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+
+    sq_ptr_ = Map(sq_size_, IORING_OFF_SQ_RING);
+    if (!sq_ptr_) return false;
+    cq_ptr_ = single ? sq_ptr_ : Map(cq_size_, IORING_OFF_CQ_RING);
+    if (!cq_ptr_) return false;
+    sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe *>(Map(sqes_size_, IORING_OFF_SQES));
+    if (!sqes_) return false;
+
+    char *sq = static_cast<char *>(sq_ptr_);
+    char *cq = static_cast<char *>(cq_ptr_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + p.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + p.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + p.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + p.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + p.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + p.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + p.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + p.cq_off.cqes);
+    entries_ = p.sq_entries;
+    local_tail_ = *sq_tail_;
+    return Supports({IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ,
+                     IORING_OP_CLOSE});
+  }
+
+  unsigned Entries() const { return entries_; }
+
+  /**
+   * Submission slots that GetSqe() can still hand out.
+   */
+  unsigned FreeSqes() const {
+    const unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    return entries_ - (local_tail_ - head);
+  }
+
+  io_uring_sqe *GetSqe() {
+    const unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (local_tail_ - head >= entries_) return nullptr;
+    const unsigned index = local_tail_ & sq_mask_;
+    io_uring_sqe *sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    ++local_tail_;
+    return sqe;
+  }
+
+  /**
+   * Submits queued entries and waits for at least `wait_nr` completions.
+   * Returns a negative errno on failure.
+   */
+  int Submit(unsigned wait_nr) {
+    __atomic_store_n(sq_tail_, local_tail_, __ATOMIC_RELEASE);
+    for (;;) {
+      const unsigned to_submit = local_tail_ - submitted_;
+      const long ret =
+          syscall(__NR_io_uring_enter, fd_, to_submit, wait_nr,
+                  wait_nr ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+      if (ret >= 0) {
+        submitted_ += static_cast<unsigned>(ret);
+        return 0;
+      }
+      if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return -errno;
+    }
+  }
+
+  bool PopCqe(io_uring_cqe &out) {
+    const unsigned head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) return false;
+    out = cqes_[head & cq_mask_];
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+ private:
+  void *Map(size_t size, off_t offset) {
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd_, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  bool Supports(std::initializer_list<int> ops) {
+    const size_t len =
+        sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+    std::unique_ptr<char[]> storage(new char[len]());
+    auto *probe = reinterpret_cast<io_uring_probe *>(storage.get());
+    if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe,
+                256) < 0) {
+      return false;
+    }
+    for (int op : ops) {
+      if (op > probe->last_op ||
+          !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  int fd_ = -1;
+  void *sq_ptr_ = nullptr;
+  void *cq_ptr_ = nullptr;
+  io_uring_sqe *sqes_ = nullptr;
+  size_t sq_size_ = 0;
+  size_t cq_size_ = 0;
+  size_t sqes_size_ = 0;
+  unsigned *sq_head_ = nullptr;
+  unsigned *sq_tail_ = nullptr;
+  unsigned *sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned *cq_head_ = nullptr;
+  unsigned *cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe *cqes_ = nullptr;
+  unsigned entries_ = 0;
+  unsigned local_tail_ = 0;
+  unsigned submitted_ = 0;
+};
+
+enum Op : uint64_t { kOpen = 0, kStat = 1, kRead = 2, kClose = 3 };
+
+inline uint64_t Tag(size_t job, Op op) { return job << 2 | op; }
+
+/**
+ * Drives all jobs through open+statx -> read* -> close on the ring.
+ * Returns false if the ring fails. Whatever was already submitted is then
+ * reaped where possible, closing the files it opened; jobs not yet handed
+ * to the parser are left for the fallback to retry. Their buffers may
+ * still be targets of unreaped reads and must outlive the ring.
+ *
+ * Once `context` is cancelled no file is admitted and no read is queued;
+ * only the operations already in flight are drained.
+ */
+bool LoadWithUring(Uring &ring, std::vector<FileJob> &jobs,
+                   std::vector<BulkLoadResult> &results, ParsePool &parser,
+                   std::vector<bool> &handed_off, JobContext *context) {
+  size_t next = 0;
+  size_t in_flight = 0;
+  size_t remaining = jobs.size();
+  auto cancelled = [context] { return context && context->IsCancelled(); };
+
+  // Waits for the operations already submitted after the ring failed
+  auto abandon = [&] {
+    io_uring_cqe cqe;
+    for (;;) {
+      while (ring.PopCqe(cqe)) {
+        --in_flight;
+        if ((cqe.user_data & 3) == kOpen && cqe.res >= 0) close(cqe.res);
+      }
+      if (in_flight == 0 || ring.Submit(1) < 0) return false;
+    }
+  };
+
+  auto queue_read = [&](size_t i) {
+    FileJob &job = jobs[i];
+    io_uring_sqe *sqe = ring.GetSqe();
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = job.fd;
+    sqe->addr = reinterpret_cast<uint64_t>(job.buffer.get() + job.done);
+    sqe->len =
+        static_cast<uint32_t>(std::min(job.size - job.done, kMaxReadChunk));
+    sqe->off = job.done;
+    sqe->user_data = Tag(i, kRead);
+    ++in_flight;
+    return true;
+  };
+
+  // Closes the file (via the ring) and hands the job on.
+  auto finish = [&](size_t i) {
+    FileJob &job = jobs[i];
+    if (job.fd >= 0) {
+      io_uring_sqe *sqe = ring.GetSqe();
+      if (sqe) {
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = job.fd;
+        sqe->user_data = Tag(i, kClose);
+        ++in_flight;
+      } else {
+        close(job.fd);
+      }
+      job.fd = -1;
+    }
+    --remaining;
+    handed_off[i] = true;
+    if (job.failed) {
+      job.buffer.reset();
+    } else {
+      parser.Push(i);
+    }
+  };
+
+  // Returns false if the first read could not be queued
+  auto both_ready = [&](size_t i) {
+    FileJob &job = jobs[i];
+    if (!job.opened || !job.stated) return true;
+    if (!job.failed && cancelled()) job.failed = true;
+    if (job.failed || job.size == 0) {
+      finish(i);
+      return true;
+    }
+    job.buffer.reset(new char[job.size]);
+    return queue_read(i);
+  };
+
+  while (remaining > 0) {
+    if (next < jobs.size() && cancelled()) {
+      // Files never admitted are left with ok == false
+      remaining -= jobs.size() - next;
+      for (; next < jobs.size(); ++next) handed_off[next] = true;
+      if (remaining == 0) break;
+    }
+    // Every admitted file needs at most two entries at a time
+    while (next < jobs.size() && in_flight + 2 <= ring.Entries() &&
+           ring.FreeSqes() >= 2) {
+      FileJob &job = jobs[next];
+      io_uring_sqe *open_sqe = ring.GetSqe();
+      io_uring_sqe *stat_sqe = ring.GetSqe();
+      if (!open_sqe || !stat_sqe) {
+        // A zeroed entry taken without its pair goes out as a no-op
+        if (open_sqe) {
+          open_sqe->user_data = Tag(next, kClose);
+          ++in_flight;
+        }
+        return abandon();
+      }
+      open_sqe->opcode = IORING_OP_OPENAT;
+      open_sqe->fd = AT_FDCWD;
+      open_sqe->addr = reinterpret_cast<uint64_t>(job.path->c_str());
+      open_sqe->open_flags = O_RDONLY | O_CLOEXEC;
+      open_sqe->user_data = Tag(next, kOpen);
+      stat_sqe->opcode = IORING_OP_STATX;
+      stat_sqe->fd = AT_FDCWD;
+      stat_sqe->addr = reinterpret_cast<uint64_t>(job.path->c_str());
+      stat_sqe->len = STATX_SIZE;
+      stat_sqe->off = reinterpret_cast<uint64_t>(&job.stx);
+      stat_sqe->user_data = Tag(next, kStat);
+      in_flight += 2;
+      ++next;
+    }
+
+    if (ring.Submit(1) < 0) return abandon();
+
+    io_uring_cqe cqe;
+    while (ring.PopCqe(cqe)) {
+      --in_flight;
+      const size_t i = cqe.user_data >> 2;
+      FileJob &job = jobs[i];
+      switch (static_cast<Op>(cqe.user_data & 3)) {
+        case kOpen:
+          job.opened = true;
+          if (cqe.res < 0) {
+            job.failed = true;
+            results[i].error = -cqe.res;
+          } else {
+            job.fd = cqe.res;
+          }
+          if (!both_ready(i)) return abandon();
+          break;
+        case kStat:
+          job.stated = true;
+          if (cqe.res < 0) {
+            job.failed = true;
+            if (!results[i].error) results[i].error = -cqe.res;
+          } else {
+            job.size = job.stx.stx_size;
+          }
+          if (!both_ready(i)) return abandon();
+          break;
+        case kRead:
+          if (cqe.res < 0) {
+            job.failed = true;
+            results[i].error = -cqe.res;
+            finish(i);
+          } else if (cqe.res == 0 || (job.done += cqe.res) == job.size) {
+            // A zero read means the file shrank; parse what was read
+            finish(i);
+          } else if (cancelled()) {
+            job.failed = true;
+            finish(i);
+          } else if (!queue_read(i)) {
+            return abandon();
+          }
+          break;
+        case kClose:
+          break;
+      }
+    }
+  }
+
+  // Reap outstanding closes
+  while (in_flight > 0) {
+    if (ring.Submit(1) < 0) return abandon();
+    io_uring_cqe cqe;
+    while (ring.PopCqe(cqe)) --in_flight;
+  }
+  return true;
+}
+
+void ReadBlocking(FileJob &job, BulkLoadResult &result) {
+  int fd = open(job.path->c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    job.failed = true;
+    result.error = errno;
+    return;
+  }
+  struct stat sb;
+  if (fstat(fd, &sb) == -1) {
+    job.failed = true;
+    result.error = errno;
+    close(fd);
+    return;
+  }
+  job.size = static_cast<size_t>(sb.st_size);
+  job.buffer.reset(new char[std::max<size_t>(job.size, 1)]);
+  while (job.done < job.size) {
+    const ssize_t n = pread(fd, job.buffer.get() + job.done,
+                            job.size - job.done, job.done);
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) {
+      job.failed = true;
+      result.error = errno;
+      break;
+    }
+    if (n == 0) break;
+    job.done += n;
+  }
+  close(fd);
+}
+
+}  // namespace
+
+BulkLoader::BulkLoader(BulkLoadOptions options) : options_(options) {}
+
+bool BulkLoader::IoUringAvailable() {
+  Uring ring;
+  return ring.Init(4);
+}
+
+std::vector<BulkLoadResult> BulkLoader::Load(
+    const std::vector<std::string> &paths, JobContext *context) {
+  std::vector<BulkLoadResult> results(paths.size());
+  std::vector<FileJob> jobs(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    results[i].path = paths[i];
+    jobs[i].path = &results[i].path;
+  }
+  if (paths.empty()) return results;
+
+  if (context) context->AddWork(JobContext::kContractsLoaded, paths.size());
+  ParsePool parser(jobs, results, context);
+  std::vector<bool> handed_off(paths.size(), false);
+
+  // Buffers of jobs a failed ring gave up on. Declared before the ring so
+  // that they are freed only after it is torn down, in case a read it never
+  // reported still lands in them.
+  std::vector<std::unique_ptr<char[]>> retired;
+  Uring ring;
+
+  last_backend_ = BulkLoadBackend::kThreadPool;
+  if (options_.backend != BulkLoadBackend::kThreadPool) {
+    if (ring.Init(std::max(4u, options_.queue_depth))) {
+      last_backend_ = BulkLoadBackend::kIoUring;
+      if (!LoadWithUring(ring, jobs, results, parser, handed_off,
+                         context)) {
+        last_backend_ = BulkLoadBackend::kThreadPool;
+      }
+    }
+  }
+
+  // Thread-pool path, also picking up whatever a failed ring left behind
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    if (handed_off[i]) continue;
+    if (jobs[i].fd >= 0) close(jobs[i].fd);
+    if (jobs[i].buffer) retired.push_back(std::move(jobs[i].buffer));
+    jobs[i] = FileJob();
+    jobs[i].path = &results[i].path;
+    results[i].error = 0;
+    pending.push_back(i);
+  }
+  if (!pending.empty()) {
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+      for (size_t k = next++; k < pending.size(); k = next++) {
+        if (context && context->IsCancelled()) break;
+        const size_t i = pending[k];
+        ReadBlocking(jobs[i], results[i]);
+        if (jobs[i].failed) {
+          jobs[i].buffer.reset();
+        } else {
+          parser.Push(i);
+        }
+      }
+    };
+    const size_t io_threads =
+        std::min(std::max<size_t>(1, options_.io_threads), pending.size());
+    std::vector<std::thread> readers;
+    readers.reserve(io_threads);
+    for (size_t t = 0; t < io_threads; ++t) readers.emplace_back(work);
+    for (auto &reader : readers) reader.join();
+  }
+
+  parser.Finish();
+  return results;
+}
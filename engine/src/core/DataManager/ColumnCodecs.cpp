@@ -0,0 +1,370 @@
+/**
+ * @file ColumnCodecs.cpp
+ * @brief Implementation of the time series column codecs.
+ */
+
+#include "include/ColumnCodecs.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+inline void PutVarint(uint64_t v, std::vector<uint8_t> &out) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<uint8_t>(v) | 0x80);
+    v >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(v));
+}
+
+/**
+ * Reads one varint; returns false on truncated or overlong input.
+ */
+inline bool GetVarint(const uint8_t *&p, const uint8_t *end, uint64_t &v) {
+  if (p < end && *p < 0x80) {
+    v = *p++;
+    return true;
+  }
+  v = 0;
+  for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+    const uint8_t byte = *p++;
+    v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) return true;
+  }
+  return false;
+}
+
+// Continuation bits of eight varint bytes loaded as one word.
+constexpr uint64_t kContinuation = 0x8080808080808080ULL;
+
+// Reads eight bytes as a little-endian word; they must be in bounds.
+inline uint64_t Load64(const uint8_t *p) {
+  uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+// Gathers the continuation bit of byte `k` of `word` into bit `k`.
+inline unsigned ContinuationMask(uint64_t word) {
+  return static_cast<unsigned>(((word & kContinuation) >> 7) *
+                                   0x0102040810204080ULL >>
+                               56);
+}
+
+/**
+ * Layout of the one- and two-byte varints that end inside an 8-byte word,
+ * keyed by the word's continuation mask. Small volumes and tick moves fill
+ * a word with four to eight of them; the table lets all of them be decoded
+ * with independent shifts instead of a byte loop whose every step depends
+ * on the previous one. A word starting with a longer varint has count 0.
+ */
+struct VarintGroup {
+  uint8_t count = 0;     ///< Varints that end inside the word
+  uint8_t consumed = 0;  ///< Bytes they occupy
+  uint8_t start[8] = {};
+};
+
+std::array<VarintGroup, 256> MakeVarintGroups() {
+  std::array<VarintGroup, 256> groups;
+  for (unsigned mask = 0; mask < 256; ++mask) {
+    VarintGroup &group = groups[mask];
+    unsigned at = 0;
+    while (at < 8) {
+      const bool continues = mask >> at & 1;
+      if (continues && (at == 7 || mask >> (at + 1) & 1)) break;
+      group.start[group.count++] = static_cast<uint8_t>(at);
+      at += continues ? 2 : 1;
+    }
+    group.consumed = static_cast<uint8_t>(at);
+  }
+  return groups;
+}
+
+const std::array<VarintGroup, 256> kVarintGroups = MakeVarintGroups();
+
+// Value of the one- or two-byte varint in the low bytes of `x`.
+inline uint64_t ShortVarint(uint64_t x) {
+  const uint64_t high = (x >> 1) & 0x3F80 & (0 - (x >> 7 & 1));
+  return (x & 0x7F) | high;
+}
+
+inline uint64_t ZigZag(int64_t v) {
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t UnZigZag(uint64_t v) {
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+inline uint64_t Bits(double v) {
+  uint64_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+inline double FromBits(uint64_t bits) {
+  double v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+// Largest magnitude of `value * scale` kept exact by the double mantissa.
+constexpr double kMaxTicks = 9007199254740992.0;  // 2^53
+
+bool RoundTrips(const double *values, size_t count, double scale) {
+  for (size_t i = 0; i < count; ++i) {
+    const double ticks = std::nearbyint(values[i] * scale);
+    if (!(std::fabs(ticks) < kMaxTicks) ||
+        Bits(ticks / scale) != Bits(values[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * DecodeTickDelta() for one way of scaling ticks: `factor` is `1 / scale`
+ * when kMultiply is set, else `scale` itself.
+ */
+template <bool kMultiply>
+size_t DecodeTicks(const uint8_t *data, size_t size, size_t count,
+                   double factor, double *out) {
+  auto price = [factor](uint64_t ticks) {
+    const double t = static_cast<double>(static_cast<int64_t>(ticks));
+    return kMultiply ? t * factor : t / factor;
+  };
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  // Summed unsigned so that forged deltas wrap instead of overflowing
+  uint64_t ticks = 0;
+  size_t i = 0;
+  // Rows past a group's count get scratch values that the next word
+  // overwrites
+  while (count - i >= 8 && end - p >= 8) {
+    const uint64_t word = Load64(p);
+    if ((word & kContinuation) == 0) {
+      for (unsigned k = 0; k < 8; ++k) {
+        ticks += UnZigZag(word >> 8 * k & 0xFF);
+        out[i + k] = price(ticks);
+      }
+      i += 8;
+      p += 8;
+      continue;
+    }
+    const VarintGroup &group = kVarintGroups[ContinuationMask(word)];
+    if (group.count == 0) {
+      uint64_t v;
+      if (!GetVarint(p, end, v)) return 0;
+      ticks += UnZigZag(v);
+      out[i++] = price(ticks);
+      continue;
+    }
+    uint64_t sum = ticks;
+    for (unsigned k = 0; k < 8; ++k) {
+      sum += UnZigZag(ShortVarint(word >> 8 * group.start[k]));
+      out[i + k] = price(sum);
+      if (k + 1 == group.count) ticks = sum;
+    }
+    i += group.count;
+    p += group.consumed;
+  }
+  for (; i < count; ++i) {
+    uint64_t v;
+    if (!GetVarint(p, end, v)) return 0;
+    ticks += UnZigZag(v);
+    out[i] = price(ticks);
+  }
+  return p - data;
+}
+
+}  // namespace
+
+void EncodeDeltaOfDelta(const uint64_t *values, size_t count,
+                        std::vector<uint8_t> &out) {
+  if (count == 0) return;
+  PutVarint(values[0], out);
+  if (count == 1) return;
+
+  int64_t prev_delta = static_cast<int64_t>(values[1] - values[0]);
+  PutVarint(ZigZag(prev_delta), out);
+
+  for (size_t i = 2; i < count;) {
+    const int64_t delta = static_cast<int64_t>(values[i] - values[i - 1]);
+    const int64_t dod = delta - prev_delta;
+    prev_delta = delta;
+    PutVarint(ZigZag(dod), out);
+    ++i;
+    if (dod != 0) continue;
+
+    // A zero is followed by the number of further zeros in the run
+    size_t run = 0;
+    while (i < count &&
+           static_cast<int64_t>(values[i] - values[i - 1]) == prev_delta) {
+      ++run;
+      ++i;
+    }
+    PutVarint(run, out);
+  }
+}
+
+size_t DecodeDeltaOfDelta(const uint8_t *data, size_t size, size_t count,
+                          uint64_t *out) {
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  if (count == 0) return 0;
+
+  uint64_t v;
+  if (!GetVarint(p, end, v)) return 0;
+  out[0] = v;
+  if (count == 1) return p - data;
+
+  if (!GetVarint(p, end, v)) return 0;
+  uint64_t delta = UnZigZag(v);
+  out[1] = out[0] + delta;
+
+  for (size_t i = 2; i < count;) {
+    if (!GetVarint(p, end, v)) return 0;
+    delta += UnZigZag(v);
+    out[i] = out[i - 1] + delta;
+    ++i;
+    if (v != 0) continue;
+
+    uint64_t run;
+    if (!GetVarint(p, end, run) || run > count - i) return 0;
+    for (const size_t stop = i + run; i < stop; ++i) {
+      out[i] = out[i - 1] + delta;
+    }
+  }
+  return p - data;
+}
+
+double FindTickScale(const double *values, size_t count) {
+  static constexpr double kScales[] = {1,   2,   4,    8,     16,     32,
+                                       64,  128, 256,  10,    100,    1000,
+                                       1e4, 1e5, 1e6,  1e7,   1e8};
+  for (double scale : kScales) {
+    if (RoundTrips(values, count, scale)) return scale;
+  }
+  return 0.0;
+}
+
+void EncodeTickDelta(const double *values, size_t count, double scale,
+                     std::vector<uint8_t> &out) {
+  int64_t prev = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const int64_t ticks =
+        static_cast<int64_t>(std::nearbyint(values[i] * scale));
+    PutVarint(ZigZag(ticks - prev), out);
+    prev = ticks;
+  }
+}
+
+size_t DecodeTickDelta(const uint8_t *data, size_t size, size_t count,
+                       double scale, double *out) {
+  // Dividing by a power of two equals multiplying by its exact reciprocal,
+  // which avoids a division per row for fractional ticks like 1/4 or 1/32
+  int exponent;
+  if (std::frexp(scale, &exponent) == 0.5 && std::isfinite(1.0 / scale)) {
+    return DecodeTicks<true>(data, size, count, 1.0 / scale, out);
+  }
+  return DecodeTicks<false>(data, size, count, scale, out);
+}
+
+void EncodeXor(const double *values, size_t count, std::vector<uint8_t> &out) {
+  uint64_t prev = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t bits = Bits(values[i]);
+    const uint64_t x = bits ^ prev;
+    prev = bits;
+    if (x == 0) {
+      out.push_back(0);
+      continue;
+    }
+
+    // Header: high nibble trailing zero bytes, low nibble meaningful bytes
+    const unsigned trailing = __builtin_ctzll(x) / 8;
+    const unsigned leading = __builtin_clzll(x) / 8;
+    const unsigned width = 8 - trailing - leading;
+    out.push_back(static_cast<uint8_t>(trailing << 4 | width));
+    const uint64_t payload = x >> (trailing * 8);
+    for (unsigned b = 0; b < width; ++b) {
+      out.push_back(static_cast<uint8_t>(payload >> (b * 8)));
+    }
+  }
+}
+
+size_t DecodeXor(const uint8_t *data, size_t size, size_t count, double *out) {
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  uint64_t prev = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (p >= end) return 0;
+    const uint8_t header = *p++;
+    const unsigned trailing = header >> 4;
+    const unsigned width = header & 0x0F;
+    if (trailing + width > 8 || width > static_cast<size_t>(end - p)) return 0;
+
+    uint64_t payload = 0;
+    if (end - p >= 8) {
+      // One load instead of a byte loop whose length varies per value
+      payload = Load64(p) & (width == 8 ? ~0ULL : (1ULL << 8 * width) - 1);
+    } else {
+      for (unsigned b = 0; b < width; ++b) {
+        payload |= static_cast<uint64_t>(p[b]) << (b * 8);
+      }
+    }
+    p += width;
+    if (width) prev ^= payload << (trailing * 8);
+    out[i] = FromBits(prev);
+  }
+  return p - data;
+}
+
+bool IsVarintCompatible(const double *values, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const double v = values[i];
+    if (!(v >= 0.0 && v < kMaxTicks) || std::trunc(v) != v ||
+        std::signbit(v)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void EncodeVarint(const double *values, size_t count,
+                  std::vector<uint8_t> &out) {
+  for (size_t i = 0; i < count; ++i) {
+    PutVarint(static_cast<uint64_t>(values[i]), out);
+  }
+}
+
+size_t DecodeVarint(const uint8_t *data, size_t size, size_t count,
+                    double *out) {
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  size_t i = 0;
+  while (count - i >= 8 && end - p >= 8) {
+    const uint64_t word = Load64(p);
+    const VarintGroup &group = kVarintGroups[ContinuationMask(word)];
+    if (group.count == 0) {
+      uint64_t v;
+      if (!GetVarint(p, end, v)) return 0;
+      out[i++] = static_cast<double>(v);
+      continue;
+    }
+    for (unsigned k = 0; k < 8; ++k) {
+      const uint64_t v = ShortVarint(word >> 8 * group.start[k]);
+      out[i + k] = static_cast<double>(static_cast<int64_t>(v));
+    }
+    i += group.count;
+    p += group.consumed;
+  }
+  for (; i < count; ++i) {
+    uint64_t v;
+    if (!GetVarint(p, end, v)) return 0;
+    out[i] = static_cast<double>(v);
+  }
+  return p - data;
+}
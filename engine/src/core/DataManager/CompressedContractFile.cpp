@@ -0,0 +1,221 @@
+/**
+ * @file CompressedContractFile.cpp
+ * @brief Implementation of the compressed columnar contract file format.
+ */
+
+#include "include/CompressedContractFile.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "include/ContractCsvReader.hpp"
+
+namespace {
+
+struct FileHeader {
+  char magic[4];
+  uint16_t version;
+  uint16_t columns;
+  uint64_t rows;
+};
+
+constexpr char kMagic[4] = {'A', 'C', 'Z', '1'};
+
+static_assert(sizeof(FileHeader) == 16, "FileHeader must be packed");
+static_assert(sizeof(CompressedContractFile::ColumnHeader) == 24,
+              "ColumnHeader must be packed");
+
+using ColumnHeader = CompressedContractFile::ColumnHeader;
+
+ColumnHeader EncodePrices(const double *values, size_t rows,
+                          std::vector<uint8_t> &out) {
+  ColumnHeader header{};
+  const size_t start = out.size();
+  const double scale = FindTickScale(values, rows);
+  if (scale != 0.0) {
+    header.codec = ColumnCodec::kTickDelta;
+    header.scale = scale;
+    EncodeTickDelta(values, rows, scale, out);
+  } else {
+    header.codec = ColumnCodec::kXor;
+    EncodeXor(values, rows, out);
+  }
+  header.bytes = out.size() - start;
+  return header;
+}
+
+ColumnHeader EncodeVolumes(const double *values, size_t rows,
+                           std::vector<uint8_t> &out) {
+  if (!IsVarintCompatible(values, rows)) {
+    return EncodePrices(values, rows, out);
+  }
+  ColumnHeader header{};
+  const size_t start = out.size();
+  header.codec = ColumnCodec::kVarint;
+  EncodeVarint(values, rows, out);
+  header.bytes = out.size() - start;
+  return header;
+}
+
+bool DecodeDoubles(const ColumnHeader &header, const uint8_t *payload,
+                   size_t rows, double *out) {
+  size_t consumed = 0;
+  switch (header.codec) {
+    case ColumnCodec::kRaw:
+      if (header.bytes != rows * sizeof(double)) return false;
+      std::memcpy(out, payload, header.bytes);
+      return true;
+    case ColumnCodec::kTickDelta:
+      if (!(header.scale > 0.0)) return false;
+      consumed =
+          DecodeTickDelta(payload, header.bytes, rows, header.scale, out);
+      break;
+    case ColumnCodec::kXor:
+      consumed = DecodeXor(payload, header.bytes, rows, out);
+      break;
+    case ColumnCodec::kVarint:
+      consumed = DecodeVarint(payload, header.bytes, rows, out);
+      break;
+    default:
+      return false;
+  }
+  return consumed == header.bytes;
+}
+
+}  // namespace
+
+std::vector<uint8_t> CompressedContractFile::Encode(const TimeSeries &data) {
+  // A malformed trailing CSV row can leave columns one short; store the rows
+  // that are complete in every column.
+  size_t rows = data.Timestamps().size();
+  for (const auto *column : {&data.Opens(), &data.Highs(), &data.Lows(),
+                             &data.Closes(), &data.Volumes()}) {
+    rows = std::min(rows, column->size());
+  }
+  const size_t headers_size =
+      sizeof(FileHeader) + kColumns * sizeof(ColumnHeader);
+
+  std::vector<uint8_t> payload;
+  payload.reserve(rows * 8);
+  ColumnHeader columns[kColumns] = {};
+
+  columns[0].codec = ColumnCodec::kDeltaOfDelta;
+  EncodeDeltaOfDelta(data.Timestamps().data(), rows, payload);
+  columns[0].bytes = payload.size();
+  columns[1] = EncodePrices(data.Opens().data(), rows, payload);
+  columns[2] = EncodePrices(data.Highs().data(), rows, payload);
+  columns[3] = EncodePrices(data.Lows().data(), rows, payload);
+  columns[4] = EncodePrices(data.Closes().data(), rows, payload);
+  columns[5] = EncodeVolumes(data.Volumes().data(), rows, payload);
+
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.columns = kColumns;
+  header.rows = rows;
+
+  std::vector<uint8_t> image(headers_size + payload.size());
+  std::memcpy(image.data(), &header, sizeof(header));
+  std::memcpy(image.data() + sizeof(header), columns, sizeof(columns));
+  std::memcpy(image.data() + headers_size, payload.data(), payload.size());
+  return image;
+}
+
+bool CompressedContractFile::Decode(const uint8_t *bytes, size_t size,
+                                    TimeSeries &data) {
+  data.clear();
+  const size_t headers_size =
+      sizeof(FileHeader) + kColumns * sizeof(ColumnHeader);
+  if (size < headers_size) return false;
+
+  FileHeader header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.columns != kColumns) {
+    return false;
+  }
+
+  ColumnHeader columns[kColumns];
+  std::memcpy(columns, bytes + sizeof(header), sizeof(columns));
+  size_t offset = headers_size;
+  const uint8_t *payloads[kColumns];
+  for (size_t c = 0; c < kColumns; ++c) {
+    if (columns[c].bytes > size - offset) return false;
+    payloads[c] = bytes + offset;
+    offset += columns[c].bytes;
+  }
+
+  // Price codecs spend at least one byte per row, which bounds the row
+  // count before anything is allocated
+  const size_t rows = header.rows;
+  if (rows > columns[1].bytes) return false;
+  if (columns[0].codec != ColumnCodec::kDeltaOfDelta) return false;
+
+  data.Timestamps().resize(rows);
+  std::vector<double> *targets[kColumns] = {nullptr,       &data.Opens(),
+                                            &data.Highs(), &data.Lows(),
+                                            &data.Closes(), &data.Volumes()};
+  bool ok = DecodeDeltaOfDelta(payloads[0], columns[0].bytes, rows,
+                               data.Timestamps().data()) == columns[0].bytes;
+  for (size_t c = 1; ok && c < kColumns; ++c) {
+    targets[c]->resize(rows);
+    ok = DecodeDoubles(columns[c], payloads[c], rows, targets[c]->data());
+  }
+  if (!ok) data.clear();
+  return ok;
+}
+
+bool CompressedContractFile::Write(const std::string &filename,
+                                   const TimeSeries &data) {
+  const std::vector<uint8_t> image = Encode(data);
+  const std::string tmp = filename + ".tmp";
+  {
+    std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      std::cerr << "Error opening file: " << tmp << std::endl;
+      return false;
+    }
+    file.write(reinterpret_cast<const char *>(image.data()), image.size());
+    if (!file) {
+      std::cerr << "Error writing file: " << tmp << std::endl;
+      std::remove(tmp.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+    std::cerr << "Error renaming " << tmp << " to " << filename << std::endl;
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool CompressedContractFile::Read(const std::string &filename,
+                                  TimeSeries &data, ReadaheadPolicy policy) {
+  MappedFile file;
+  if (!file.Open(filename, policy)) {
+    data.clear();
+    return false;
+  }
+  const bool ok = Decode(reinterpret_cast<const uint8_t *>(file.Data()),
+                         file.Size(), data);
+  if (!ok) std::cerr << "Corrupt compressed file: " << filename << std::endl;
+  return ok;
+}
+
+bool CompressedContractFile::ConvertCsv(const std::string &csv_filename,
+                                        const std::string &filename) {
+  TimeSeries data;
+  ContractCsvReader reader;
+  if (!reader.read_csv_mmap(csv_filename, data, true)) return false;
+  return Write(filename, data);
+}
+
+bool CompressedContractFile::IsCompressedPath(const std::string &path) {
+  const size_t n = std::strlen(kExtension);
+  return path.size() >= n &&
+         path.compare(path.size() - n, n, kExtension) == 0;
+}
@@ -1,206 +1,151 @@
 #include "include/ContractCsvReader.hpp"
 
-#include <fcntl.h>
-#include <sys/mman.h>
-#include <sys/stat.h>
-#include <unistd.h>
-
 #include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 /**
  * PathFinder implementation
  * Generates standardized paths for contract CSV files.
  */
-std::string PathFinder::find_contract_csv(const Contract &contract) {
-  std::string path = "/home/ruben/Development/SA/alchemath/data/contracts/" + contract.symbol + "/" +
-                     ExpirationMonthToString(contract.expirationMonth) + "/" +
-                     std::to_string(contract.expirationYear) + ".csv";
-  return path;
+namespace {
+
+constexpr const char *kDefaultDataRoot =
+    "/home/ruben/Development/SA/alchemath/data/contracts/";
+
+std::shared_mutex path_mutex;
+std::string configured_root;
+// Resolved paths; the deque keeps strings alive across root changes so
+// references handed out earlier never dangle.
+std::deque<std::string> path_storage;
+std::unordered_map<ContractId, const std::string *> path_table;
+
+std::string InitialDataRoot() {
+  const char *env = std::getenv("ALCHEMATH_DATA_ROOT");
+  std::string root = (env && *env) ? env : kDefaultDataRoot;
+  if (root.back() != '/') root += '/';
+  return root;
 }
 
-/**
- * ContractCsvReader implementation
- * High-performance CSV parsing optimized for financial data.
- */
-inline double ContractCsvReader::fast_stod(const char *start,
-                                           const char *end) {
-  double result = 0.0;
-  double sign = 1.0;
-  bool decimal = false;
-  double decimal_factor = 0.1;
-
-  if (*start == '-') {
-    sign = -1.0;
-    start++;
-  }
-
-  while (start < end) {
-    if (*start == '.') {
-      decimal = true;
-    } else if (*start >= '0' && *start <= '9') {
-      if (decimal) {
-        result += (*start - '0') * decimal_factor;
-        decimal_factor *= 0.1;
-      } else {
-        result = result * 10.0 + (*start - '0');
-      }
-    }
-    start++;
-  }
-
-  return result * sign;
+const std::string &DataRootLocked() {
+  if (configured_root.empty()) configured_root = InitialDataRoot();
+  return configured_root;
 }
 
-inline long long ContractCsvReader::fast_stoll(const char *start,
-                                               const char *end) {
-  long long result = 0;
-  long long sign = 1;
-
-  if (*start == '-') {
-    sign = -1;
-    start++;
-  }
-
-  while (start < end && *start >= '0' && *start <= '9') {
-    result = result * 10 + (*start - '0');
-    start++;
-  }
+}  // namespace
 
-  return result * sign;
+void PathFinder::set_data_root(const std::string &root) {
+  std::unique_lock<std::shared_mutex> lock(path_mutex);
+  configured_root = root.empty() ? InitialDataRoot() : root;
+  if (configured_root.back() != '/') configured_root += '/';
+  path_table.clear();
 }
 
-inline std::time_t ContractCsvReader::parse_timestamp(const char *start,
-                                                      const char *end) {
-  // Parse "2025-06-15 18:00:00"
-  int year = (start[0] - '0') * 1000 + (start[1] - '0') * 100 +
-             (start[2] - '0') * 10 + (start[3] - '0');
-  int month = (start[5] - '0') * 10 + (start[6] - '0');
-  int day = (start[8] - '0') * 10 + (start[9] - '0');
-  int hour = (start[11] - '0') * 10 + (start[12] - '0');
-  int minute = (start[14] - '0') * 10 + (start[15] - '0');
-  int second = (start[17] - '0') * 10 + (start[18] - '0');
-
-  std::tm tm = {};
-  tm.tm_year = year - 1900;
-  tm.tm_mon = month - 1;
-  tm.tm_mday = day;
-  tm.tm_hour = hour;
-  tm.tm_min = minute;
-  tm.tm_sec = second;
-  tm.tm_isdst = -1;
-
-  return std::mktime(&tm);
+std::string PathFinder::data_root() {
+  std::unique_lock<std::shared_mutex> lock(path_mutex);
+  return DataRootLocked();
 }
 
-inline const char *ContractCsvReader::find_delimiter(const char *start,
-                                                     const char *end,
-                                                     char delimiter) {
-  while (start < end && *start != delimiter) {
-    start++;
-  }
-  return start;
+std::string PathFinder::find_contract_csv(const Contract &contract) {
+  std::string path = data_root() + contract.symbol + "/" +
+                     ExpirationMonthToString(contract.expirationMonth) + "/" +
+                     std::to_string(contract.expirationYear) + ".csv";
+  return path;
 }
 
-inline const char *ContractCsvReader::skip_header(const char *data,
-                                                  const char *end) {
-  return find_delimiter(data, end, '\n') + 1;
+const std::string &PathFinder::find_contract_csv(ContractId id) {
+  {
+    std::shared_lock<std::shared_mutex> lock(path_mutex);
+    auto it = path_table.find(id);
+    if (it != path_table.end()) return *it->second;
+  }
+  std::string path = find_contract_csv(id.ToContract());
+  std::unique_lock<std::shared_mutex> lock(path_mutex);
+  auto it = path_table.find(id);
+  if (it != path_table.end()) return *it->second;
+  path_storage.push_back(std::move(path));
+  return *path_table.emplace(id, &path_storage.back()).first->second;
 }
 
+/**
+ * ContractCsvReader implementation
+ * Parsing itself is generated from csv::Schema layouts (CsvSchema.hpp).
+ */
+template <ParseMode Mode>
 bool ContractCsvReader::read_csv_mmap(const std::string &filename,
-                                      TimeSeries &data, bool has_header) {
-  int fd = open(filename.c_str(), O_RDONLY);
-  if (fd == -1) {
-    std::cerr << "Error opening file: " << filename << std::endl;
-    return false;
-  }
-
-  struct stat sb;
-  if (fstat(fd, &sb) == -1) {
-    close(fd);
-    std::cerr << "Error reading file information" << std::endl;
-    return false;
-  }
-
-  const char *file_data = static_cast<const char *>(
-      mmap(nullptr, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0));
-
-  if (file_data == MAP_FAILED) {
-    close(fd);
-    std::cerr << "Error in memory mapping" << std::endl;
-    return false;
-  }
-
-  const char *current = file_data;
-  const char *end = file_data + sb.st_size;
-
-  // Skip header if present
-  if (has_header) {
-    current = skip_header(current, end);
+                                      TimeSeries &data, bool has_header,
+                                      ReadaheadPolicy policy,
+                                      std::vector<ParseError> *errors,
+                                      ColumnMask columns) {
+  auto file = std::make_shared<MappedFile>();
+  if (!file->Open(filename, policy)) return false;
+  if (columns == SeriesColumn::kAll) {
+    return parse_csv_buffer<Mode>(file->Data(), file->Size(), data,
+                                  has_header, errors);
   }
+  // The series keeps the mapping for its deferred columns
+  return csv::DefaultSchema::Parse<Mode>(file->Data(), file->Size(), data,
+                                         has_header, errors, columns, file);
+}
 
-  // Rough estimate of number of rows for pre-allocation
-  size_t estimated_rows = sb.st_size / 60;  // Estimate about 60 chars per row
-  data.reserve(estimated_rows);
-  data.clear();
-
-  while (current < end) {
-    // Parse timestamp
-    const char *field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) break;
-
-    std::time_t timestamp = parse_timestamp(current, field_end);
-    data.Timestamps().push_back(timestamp);
-    current = field_end + 1;
-
-    // Parse close (second column in our data)
-    field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) break;
-    double close_val = fast_stod(current, field_end);
-    data.Closes().push_back(close_val);
-    current = field_end + 1;
-
-    // Parse open (third column in our data)
-    field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) break;
-    double open_val = fast_stod(current, field_end);
-    data.Opens().push_back(open_val);
-    current = field_end + 1;
-
-    // Parse high (fourth column in our data)
-    field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) break;
-    double high_val = fast_stod(current, field_end);
-    data.Highs().push_back(high_val);
-    current = field_end + 1;
-
-    // Parse low (fifth column in our data)
-    field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) break;
-    double low_val = fast_stod(current, field_end);
-    data.Lows().push_back(low_val);
-    current = field_end + 1;
-
-    // Parse volume (last field, ends with \n or \r\n)
-    field_end = find_delimiter(current, end, '\n');
-    if (field_end > current && *(field_end - 1) == '\r') {
-      field_end--;  // Handle \r\n
-    }
-    long long volume_val = fast_stoll(current, field_end);
-    data.Volumes().push_back(volume_val);
+template <ParseMode Mode>
+bool ContractCsvReader::parse_csv_buffer(const char *file_data,
+                                         size_t file_size, TimeSeries &data,
+                                         bool has_header,
+                                         std::vector<ParseError> *errors) {
+  return csv::DefaultSchema::Parse<Mode>(file_data, file_size, data,
+                                         has_header, errors);
+}
 
-    // Go to next row
-    current = find_delimiter(current, end, '\n') + 1;
+template bool ContractCsvReader::read_csv_mmap<ParseMode::kFast>(
+    const std::string &, TimeSeries &, bool, ReadaheadPolicy,
+    std::vector<ParseError> *, ColumnMask);
+template bool ContractCsvReader::read_csv_mmap<ParseMode::kValidate>(
+    const std::string &, TimeSeries &, bool, ReadaheadPolicy,
+    std::vector<ParseError> *, ColumnMask);
+template bool ContractCsvReader::parse_csv_buffer<ParseMode::kFast>(
+    const char *, size_t, TimeSeries &, bool, std::vector<ParseError> *);
+template bool ContractCsvReader::parse_csv_buffer<ParseMode::kValidate>(
+    const char *, size_t, TimeSeries &, bool, std::vector<ParseError> *);
+
+bool ContractCsvReader::parse_csv_detect(const char *file_data,
+                                         size_t file_size, TimeSeries &data,
+                                         ParseMode mode,
+                                         std::vector<ParseError> *errors,
+                                         ColumnMask columns,
+                                         std::shared_ptr<const void> owner) {
+  const auto &registry = CsvSchemaRegistry::Instance();
+  if (registry.Parse(file_data, file_size, data, mode, errors, columns,
+                     owner)) {
+    return true;
   }
+  return mode == ParseMode::kValidate
+             ? csv::DefaultSchema::Parse<ParseMode::kValidate>(
+                   file_data, file_size, data, true, errors, columns,
+                   std::move(owner))
+             : csv::DefaultSchema::Parse<ParseMode::kFast>(
+                   file_data, file_size, data, true, errors, columns,
+                   std::move(owner));
+}
 
-  munmap(const_cast<char *>(file_data), sb.st_size);
-  close(fd);
-
-  return true;
+bool ContractCsvReader::read_csv_detect(const std::string &filename,
+                                        TimeSeries &data, ParseMode mode,
+                                        ReadaheadPolicy policy,
+                                        std::vector<ParseError> *errors,
+                                        ColumnMask columns) {
+  auto file = std::make_shared<MappedFile>();
+  if (!file->Open(filename, policy)) return false;
+  return parse_csv_detect(file->Data(), file->Size(), data, mode, errors,
+                          columns, file);
 }
 
 bool ContractCsvReader::read_csv_stream(const std::string &filename,
@@ -218,8 +163,7 @@ bool ContractCsvReader::read_csv_stream(const std::string &filename,
 
   // Pre-allocate vectors
   size_t estimated_rows = file_size / 60;
-  data.reserve(estimated_rows);
-  data.clear();
+  const auto target = csv::DefaultSchema::Prepare(data, estimated_rows);
 
   std::string line;
   line.reserve(128);  // Pre-allocate string to avoid reallocations
@@ -229,47 +173,19 @@ bool ContractCsvReader::read_csv_stream(const std::string &filename,
     // Header skipped
   }
 
+  csv::Row row;
+  ParseErrorReason reason;
   while (std::getline(file, line)) {
-    if (line.empty()) continue;
-
     const char *current = line.c_str();
     const char *end = current + line.length();
+    if (end > current && *(end - 1) == '\r') end--;  // Handle \r\n
+    if (end == current) continue;
 
-    // Parse timestamp
-    const char *field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) continue;
-
-    std::time_t timestamp = parse_timestamp(current, field_end);
-    data.Timestamps().push_back(timestamp);
-    current = field_end + 1;
-
-    // Parse close (second column in our data)
-    field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) continue;
-    data.Closes().push_back(fast_stod(current, field_end));
-    current = field_end + 1;
-
-    // Parse open (third column in our data)
-    field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) continue;
-    data.Opens().push_back(fast_stod(current, field_end));
-    current = field_end + 1;
-
-    // Parse high (fourth column in our data)
-    field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) continue;
-    data.Highs().push_back(fast_stod(current, field_end));
-    current = field_end + 1;
-
-    // Parse low (fifth column in our data)
-    field_end = find_delimiter(current, end, ',');
-    if (field_end >= end) continue;
-    data.Lows().push_back(fast_stod(current, field_end));
-    current = field_end + 1;
-
-    // Parse volume
-    data.Volumes().push_back(fast_stoll(current, end));
+    if (csv::DefaultSchema::ParseRow<ParseMode::kFast>(current, end, row,
+                                                       reason)) {
+      csv::DefaultSchema::Append(row, target);
+    }
   }
 
   return true;
-}
\ No newline at end of file
+}
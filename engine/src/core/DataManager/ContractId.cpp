@@ -0,0 +1,53 @@
+/**
+ * @file ContractId.cpp
+ * @brief Implementation of the process-wide symbol interning table.
+ */
+
+#include "include/ContractId.hpp"
+
+#include <limits>
+#include <mutex>
+
+SymbolTable &SymbolTable::Instance() {
+  static SymbolTable table;
+  return table;
+}
+
+uint16_t SymbolTable::Intern(std::string_view symbol) {
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = index_.find(symbol);
+    if (it != index_.end()) return it->second;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto it = index_.find(symbol);
+  if (it != index_.end()) return it->second;
+  if (symbols_.size() > std::numeric_limits<uint16_t>::max()) {
+    throw std::length_error("Symbol table is full");
+  }
+  const uint16_t index = static_cast<uint16_t>(symbols_.size());
+  symbols_.emplace_back(symbol);
+  index_.emplace(symbols_.back(), index);
+  return index;
+}
+
+std::optional<uint16_t> SymbolTable::Find(std::string_view symbol) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = index_.find(symbol);
+  if (it == index_.end()) return std::nullopt;
+  return it->second;
+}
+
+const std::string &SymbolTable::Symbol(uint16_t index) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (index >= symbols_.size()) {
+    throw std::out_of_range("Unknown symbol index");
+  }
+  return symbols_[index];
+}
+
+size_t SymbolTable::Size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return symbols_.size();
+}
@@ -0,0 +1,91 @@
+#include "include/CsvSchema.hpp"
+
+#include <cstring>
+
+const char *ParseErrorReasonToString(ParseErrorReason reason) {
+  switch (reason) {
+    case ParseErrorReason::kMissingField:
+      return "missing field";
+    case ParseErrorReason::kExtraField:
+      return "extra field";
+    case ParseErrorReason::kBadTimestamp:
+      return "bad timestamp";
+    case ParseErrorReason::kBadNumber:
+      return "bad number";
+  }
+  return "unknown";
+}
+
+namespace csv {
+
+std::vector<std::string_view> SplitHeader(std::string_view header) {
+  auto is_trimmed = [](char c) {
+    return c == ' ' || c == '\t' || c == '"' || c == '\r' || c == '\xEF' ||
+           c == '\xBB' || c == '\xBF';  // Includes a UTF-8 byte order mark
+  };
+  std::vector<std::string_view> tokens;
+  size_t start = 0;
+  while (start <= header.size()) {
+    size_t comma = header.find(',', start);
+    if (comma == std::string_view::npos) comma = header.size();
+    std::string_view token = header.substr(start, comma - start);
+    while (!token.empty() && is_trimmed(token.front())) token.remove_prefix(1);
+    while (!token.empty() && is_trimmed(token.back())) token.remove_suffix(1);
+    tokens.push_back(token);
+    start = comma + 1;
+  }
+  return tokens;
+}
+
+}  // namespace csv
+
+CsvSchemaRegistry &CsvSchemaRegistry::Instance() {
+  static CsvSchemaRegistry registry;
+  return registry;
+}
+
+CsvSchemaRegistry::CsvSchemaRegistry() {
+  using namespace csv;
+  // Later registrations are tried first
+  Register<Schema<Timestamp, Open, High, Low, Close, Settlement, Volume,
+                  OpenInterest>>("ohlcv_settle_oi");
+  Register<Schema<Timestamp, Open, High, Low, Close, Volume, OpenInterest>>(
+      "ohlcv_oi");
+  Register<Schema<Timestamp, Open, High, Low, Close, Volume>>("ohlcv");
+  Register<Schema<Timestamp, Close, Open, High, Low, Volume, OpenInterest>>(
+      "alchemath_oi");
+  Register<DefaultSchema>("alchemath");
+}
+
+const CsvSchemaRegistry::Layout *CsvSchemaRegistry::Match(
+    std::string_view header) const {
+  const auto tokens = csv::SplitHeader(header);
+  for (const auto &layout : layouts_) {
+    if (layout.matches(tokens)) return &layout;
+  }
+  return nullptr;
+}
+
+const CsvSchemaRegistry::Layout *CsvSchemaRegistry::Find(
+    std::string_view name) const {
+  for (const auto &layout : layouts_) {
+    if (layout.name == name) return &layout;
+  }
+  return nullptr;
+}
+
+bool CsvSchemaRegistry::Parse(const char *data, size_t size,
+                              TimeSeries &series, ParseMode mode,
+                              std::vector<ParseError> *errors,
+                              ColumnMask columns,
+                              std::shared_ptr<const void> owner) const {
+  if (size == 0) return false;
+  const char *newline =
+      static_cast<const char *>(std::memchr(data, '\n', size));
+  const size_t header_size = newline ? newline - data : size;
+  const Layout *layout = Match(std::string_view(data, header_size));
+  if (!layout) return false;
+  const ParseFn parse =
+      mode == ParseMode::kValidate ? layout->parse_validate : layout->parse_fast;
+  return parse(data, size, series, true, errors, columns, std::move(owner));
+}
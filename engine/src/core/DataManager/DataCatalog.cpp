@@ -0,0 +1,297 @@
+/**
+ * @file DataCatalog.cpp
+ * @brief Implementation of the contract file index and its inotify watcher.
+ */
+
+#include "include/DataCatalog.hpp"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <mutex>
+
+#include "include/CompressedContractFile.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t kWatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO |
+                                IN_MOVED_FROM | IN_DELETE;
+
+/**
+ * Parses `.../{symbol}/{month_letter}/{year}.{csv,acz}` into a ContractId.
+ */
+std::optional<ContractId> ParseContractPath(const fs::path &path) {
+  if (path.extension() != ".csv" &&
+      path.extension() != CompressedContractFile::kExtension) {
+    return std::nullopt;
+  }
+
+  const std::string year_str = path.stem().string();
+  if (year_str.empty() || year_str.size() > 4) return std::nullopt;
+  int year = 0;
+  for (char c : year_str) {
+    if (c < '0' || c > '9') return std::nullopt;
+    year = year * 10 + (c - '0');
+  }
+  if (year < ContractId::kBaseYear || year > ContractId::kMaxYear) {
+    return std::nullopt;
+  }
+
+  ExpirationMonth month;
+  if (!ExpirationMonthFromString(path.parent_path().filename().string(),
+                                 month)) {
+    return std::nullopt;
+  }
+
+  const std::string symbol =
+      path.parent_path().parent_path().filename().string();
+  if (symbol.empty()) return std::nullopt;
+  return ContractId::Encode(SymbolTable::Instance().Intern(symbol), month,
+                            year);
+}
+
+std::optional<CatalogEntry> StatEntry(const std::string &path) {
+  auto id = ParseContractPath(path);
+  if (!id) return std::nullopt;
+
+  struct stat sb;
+  if (stat(path.c_str(), &sb) == -1 || !S_ISREG(sb.st_mode)) {
+    return std::nullopt;
+  }
+  CatalogEntry entry;
+  entry.id = *id;
+  entry.path = path;
+  entry.size_bytes = static_cast<uint64_t>(sb.st_size);
+  entry.mtime_ns = static_cast<int64_t>(sb.st_mtim.tv_sec) * 1000000000 +
+                   sb.st_mtim.tv_nsec;
+  return entry;
+}
+
+// Roots rank first; within a root a compressed file shadows its CSV.
+size_t Priority(const std::string &path, size_t root_rank) {
+  const bool compressed = CompressedContractFile::IsCompressedPath(path);
+  return root_rank * 2 + (compressed ? 0 : 1);
+}
+
+}  // namespace
+
+DataCatalog::DataCatalog(std::vector<std::string> roots)
+    : roots_(std::move(roots)) {
+  Rescan();
+}
+
+DataCatalog::~DataCatalog() { StopWatching(); }
+
+void DataCatalog::Rescan() {
+  std::lock_guard<std::mutex> refresh(refresh_mutex_);
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.clear();
+    rank_.clear();
+  }
+  for (size_t rank = 0; rank < roots_.size(); ++rank) ScanRoot(rank);
+}
+
+void DataCatalog::ScanRoot(size_t rank) {
+  std::error_code ec;
+  if (!fs::is_directory(roots_[rank], ec)) return;
+  AddWatch(roots_[rank], 0, rank);
+  ScanDir(roots_[rank], 0, rank);
+}
+
+void DataCatalog::ScanDir(const std::string &dir, int depth, size_t rank) {
+  std::error_code ec;
+  for (const auto &item : fs::directory_iterator(dir, ec)) {
+    const std::string path = item.path().string();
+    if (depth < 2) {
+      if (!item.is_directory(ec)) continue;
+      AddWatch(path, depth + 1, rank);
+      ScanDir(path, depth + 1, rank);
+    } else if (item.is_regular_file(ec)) {
+      IndexFile(path, rank);
+    }
+  }
+}
+
+bool DataCatalog::IndexFile(const std::string &path, size_t rank) {
+  auto entry = StatEntry(path);
+  if (!entry) return false;
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  const size_t priority = Priority(path, rank);
+  auto it = rank_.find(entry->id);
+  if (it != rank_.end() && it->second < priority) return false;
+  rank_[entry->id] = priority;
+  index_[entry->id] = std::move(*entry);
+  return true;
+}
+
+bool DataCatalog::RemoveFile(const std::string &path) {
+  auto id = ParseContractPath(path);
+  if (!id) return false;
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = index_.find(*id);
+    if (it == index_.end() || it->second.path != path) return false;
+    index_.erase(it);
+    rank_.erase(*id);
+  }
+
+  // Fall back to the other format or a lower-priority root
+  fs::path relative =
+      fs::path(path).lexically_relative(fs::path(path).parent_path()
+                                            .parent_path()
+                                            .parent_path());
+  for (size_t rank = 0; rank < roots_.size(); ++rank) {
+    for (const char *ext : {CompressedContractFile::kExtension, ".csv"}) {
+      relative.replace_extension(ext);
+      const std::string candidate =
+          (fs::path(roots_[rank]) / relative).string();
+      if (candidate != path && IndexFile(candidate, rank)) return true;
+    }
+  }
+  return true;
+}
+
+std::optional<CatalogEntry> DataCatalog::Find(ContractId id) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = index_.find(id);
+  if (it == index_.end()) return std::nullopt;
+  return it->second;
+}
+
+std::vector<ContractId> DataCatalog::Expiries(std::string_view symbol) const {
+  // A read query must not grow the process-wide table
+  const std::optional<uint16_t> index = SymbolTable::Instance().Find(symbol);
+  std::vector<ContractId> ids;
+  if (!index) return ids;
+  const ContractId first =
+      ContractId::Encode(*index, ExpirationMonth::F, ContractId::kBaseYear);
+  const ContractId last =
+      ContractId::Encode(*index, ExpirationMonth::Z, ContractId::kMaxYear);
+
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  for (auto it = index_.lower_bound(first);
+       it != index_.end() && it->first <= last; ++it) {
+    ids.push_back(it->first);
+  }
+  return ids;
+}
+
+size_t DataCatalog::Size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return index_.size();
+}
+
+void DataCatalog::AddWatch(const std::string &dir, int depth, size_t rank) {
+  if (inotify_fd_ < 0) return;
+  int wd = inotify_add_watch(inotify_fd_, dir.c_str(), kWatchMask);
+  if (wd >= 0) watches_[wd] = {dir, depth, rank};
+}
+
+bool DataCatalog::StartWatching() {
+  if (watching_) return true;
+  if (inotify_fd_ < 0) inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (inotify_fd_ < 0 || wake_fd_ < 0) {
+    StopWatching();
+    return false;
+  }
+
+  // Rescan after the watches exist so nothing written meanwhile is missed
+  Rescan();
+  watching_ = true;
+  watcher_ = std::thread(&DataCatalog::WatchLoop, this);
+  return true;
+}
+
+void DataCatalog::StopWatching() {
+  if (watching_.exchange(false)) {
+    uint64_t one = 1;
+    (void)!write(wake_fd_, &one, sizeof(one));
+    watcher_.join();
+  }
+  if (inotify_fd_ >= 0) close(inotify_fd_);
+  if (wake_fd_ >= 0) close(wake_fd_);
+  inotify_fd_ = -1;
+  wake_fd_ = -1;
+  watches_.clear();
+}
+
+size_t DataCatalog::PollChanges() {
+  if (inotify_fd_ < 0) {
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) return 0;
+    Rescan();
+    return 0;
+  }
+  return DrainEvents();
+}
+
+void DataCatalog::WatchLoop() {
+  pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+  while (watching_) {
+    if (poll(fds, 2, -1) <= 0) continue;
+    if (fds[1].revents & POLLIN) break;
+    if (fds[0].revents & POLLIN) DrainEvents();
+  }
+}
+
+size_t DataCatalog::DrainEvents() {
+  std::lock_guard<std::mutex> refresh(refresh_mutex_);
+  alignas(inotify_event) char buffer[16 * 1024];
+  size_t changes = 0;
+  bool overflow = false;
+
+  for (;;) {
+    ssize_t n = read(inotify_fd_, buffer, sizeof(buffer));
+    if (n <= 0) break;
+    for (char *p = buffer; p < buffer + n;) {
+      const auto *event = reinterpret_cast<const inotify_event *>(p);
+      p += sizeof(inotify_event) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        overflow = true;
+        continue;
+      }
+      auto it = watches_.find(event->wd);
+      if (it == watches_.end()) continue;
+      if (event->mask & IN_IGNORED) {
+        watches_.erase(it);
+        continue;
+      }
+      if (event->len == 0) continue;
+
+      const Watch watch = it->second;
+      const std::string path = watch.dir + "/" + event->name;
+      if (watch.depth < 2) {
+        if ((event->mask & IN_ISDIR) &&
+            (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+          AddWatch(path, watch.depth + 1, watch.root_rank);
+          ScanDir(path, watch.depth + 1, watch.root_rank);
+          ++changes;
+        }
+      } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+        changes += IndexFile(path, watch.root_rank);
+      } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+        changes += RemoveFile(path);
+      }
+    }
+  }
+
+  if (overflow) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.clear();
+    rank_.clear();
+    lock.unlock();
+    for (size_t rank = 0; rank < roots_.size(); ++rank) ScanRoot(rank);
+    ++changes;
+  }
+  return changes;
+}
@@ -8,14 +8,231 @@
 
 #include "include/DataManager.hpp"
 
+#include <sys/stat.h>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+
+#include "JobRegistry.hpp"
+#include "include/BulkLoader.hpp"
+#include "include/CompressedContractFile.hpp"
 #include "include/ContractCsvReader.hpp"
+#include "include/FilePrefetcher.hpp"
+
+namespace {
+
+// Resampled bars keyed by (contract, bucket width, session start, aligned).
+using ResampleKey = std::tuple<ContractId, uint64_t, uint64_t, bool>;
+
+struct ResampledBars {
+  uint64_t version = 0;  // contractDataVersion() the bars were built from
+  TimeSeries bars;
+};
+
+std::mutex cache_mutex;
+std::map<ResampleKey, ResampledBars> resample_cache;
+std::shared_ptr<const Workspace> active_workspace;
+
+// Workspace keys name the symbol, not its interned index, which differs
+// between processes.
+std::string WorkspaceKey(const ResampleKey& key) {
+  const ContractId id = std::get<0>(key);
+  return "bars/" + SymbolTable::Instance().Symbol(id.SymbolIndex()) + "/" +
+         ExpirationMonthToString(id.Month()) + "/" +
+         std::to_string(id.Year()) + "/" +
+         std::to_string(std::get<1>(key)) + "/" +
+         std::to_string(std::get<2>(key)) + "/" +
+         (std::get<3>(key) ? "1" : "0");
+}
+
+std::mutex catalog_mutex;
+std::shared_ptr<DataCatalog> active_catalog;
+
+/**
+ * Resolves a contract's file through the active catalog or PathFinder.
+ * Returns nullopt if a catalog is configured and does not know the contract.
+ */
+std::optional<std::string> ResolvePath(ContractId id) {
+  if (auto index = DataManager::catalog()) {
+    auto entry = index->Find(id);
+    if (!entry) return std::nullopt;
+    return std::move(entry->path);
+  }
+  return PathFinder::find_contract_csv(id);
+}
+
+std::string NotInCatalog(ContractId id) {
+  return "Failed to load contract data: " +
+         SymbolTable::Instance().Symbol(id.SymbolIndex()) + " " +
+         ExpirationMonthToString(id.Month()) + " " +
+         std::to_string(id.Year()) + " not in catalog";
+}
+
+/**
+ * Mixes a file's path, modification time and size into a version that is
+ * never 0, which means "no file".
+ */
+uint64_t FileVersion(const std::string& path, uint64_t mtime_ns,
+                     uint64_t size) {
+  uint64_t version = Fnv1a(path);
+  for (uint64_t v : {mtime_ns, size}) {
+    version = (version ^ v) * 0x100000001B3ULL;  // FNV-1a style mixing
+  }
+  return version | 1;
+}
+
+FilePrefetcher &Prefetcher() {
+  static FilePrefetcher prefetcher(2);
+  return prefetcher;
+}
+
+}  // namespace
+
+TimeSeries DataManager::loadContractData(const Contract& contract,
+                                         ColumnMask columns) {
+  const ContractId id = ContractId::FromContract(contract);
+  auto resolved = ResolvePath(id);
+  if (!resolved) throw std::runtime_error(NotInCatalog(id));
+  const std::string& path = *resolved;
 
-TimeSeries DataManager::loadContractData(const Contract& contract) {
-  std::string path = PathFinder::find_contract_csv(contract);
   TimeSeries data;
   ContractCsvReader reader;
-  if (!reader.read_csv_stream(path, data, true)) {
+  const bool loaded = CompressedContractFile::IsCompressedPath(path)
+                          ? CompressedContractFile::Read(path, data)
+                          : reader.read_csv_detect(path, data, ParseMode::kFast,
+                                                   ReadaheadPolicy::kAuto,
+                                                   nullptr, columns);
+  if (!loaded) {
     throw std::runtime_error("Failed to load contract data from " + path);
   }
   return data;
-}
\ No newline at end of file
+}
+
+TimeSeries DataManager::loadResampledData(const Contract& contract,
+                                          const BarBucket& bucket) {
+  ResampleKey key{ContractId::FromContract(contract), bucket.width_ms,
+                  bucket.session_start_ms, bucket.session_aligned};
+  const uint64_t version = contractDataVersion(contract);
+  std::shared_ptr<const Workspace> workspace;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = resample_cache.find(key);
+    if (it != resample_cache.end() && it->second.version == version) {
+      return it->second.bars;
+    }
+    workspace = active_workspace;
+  }
+
+  TimeSeries bars;
+  if (!workspace || version == 0 ||
+      !workspace->ReadSeries(WorkspaceKey(key), version, bars)) {
+    bars = Resample(loadContractData(contract), bucket);
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  ResampledBars &cached = resample_cache[key];
+  cached.version = version;
+  cached.bars = std::move(bars);
+  return cached.bars;
+}
+
+uint64_t DataManager::contractDataVersion(const Contract& contract) {
+  const ContractId id = ContractId::FromContract(contract);
+  if (auto index = catalog()) {
+    // The catalog already tracks size and mtime; no filesystem call
+    auto entry = index->Find(id);
+    if (!entry) return 0;
+    return FileVersion(entry->path, static_cast<uint64_t>(entry->mtime_ns),
+                       entry->size_bytes);
+  }
+  const std::string& path = PathFinder::find_contract_csv(id);
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) return 0;
+  const uint64_t mtime_ns = static_cast<uint64_t>(st.st_mtim.tv_sec) *
+                                1000000000ULL +
+                            static_cast<uint64_t>(st.st_mtim.tv_nsec);
+  return FileVersion(path, mtime_ns, static_cast<uint64_t>(st.st_size));
+}
+
+size_t DataManager::snapshotWorkspace(WorkspaceWriter& writer) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  size_t written = 0;
+  for (const auto& [key, cached] : resample_cache) {
+    if (writer.AddSeries(WorkspaceKey(key), cached.version, cached.bars)) {
+      ++written;
+    }
+  }
+  return written;
+}
+
+void DataManager::attachWorkspace(std::shared_ptr<const Workspace> workspace) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  active_workspace = std::move(workspace);
+}
+
+void DataManager::clearCache() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  resample_cache.clear();
+}
+
+void DataManager::configureDataRoots(const std::vector<std::string>& roots,
+                                     bool watch) {
+  std::shared_ptr<DataCatalog> next;
+  if (!roots.empty()) {
+    next = std::make_shared<DataCatalog>(roots);
+    if (watch) next->StartWatching();
+  }
+  {
+    std::lock_guard<std::mutex> lock(catalog_mutex);
+    active_catalog.swap(next);
+  }
+  clearCache();
+}
+
+std::vector<TimeSeries> DataManager::loadContractsBulk(
+    const std::vector<Contract>& contracts, JobContext* job) {
+  std::vector<std::string> paths;
+  paths.reserve(contracts.size());
+  for (const auto& contract : contracts) {
+    const ContractId id = ContractId::FromContract(contract);
+    auto path = ResolvePath(id);
+    if (!path) throw std::runtime_error(NotInCatalog(id));
+    paths.push_back(std::move(*path));
+  }
+
+  BulkLoader loader;
+  std::vector<BulkLoadResult> results = loader.Load(paths, job);
+  // Files skipped after a cancellation are not load failures
+  if (job) job->Checkpoint();
+  std::vector<TimeSeries> series;
+  series.reserve(results.size());
+  for (auto& result : results) {
+    if (!result.ok) {
+      throw std::runtime_error("Failed to load contract data from " +
+                               result.path);
+    }
+    series.push_back(std::move(result.data));
+  }
+  return series;
+}
+
+size_t DataManager::prefetchContracts(const std::vector<Contract>& contracts) {
+  std::vector<std::string> paths;
+  paths.reserve(contracts.size());
+  for (const auto& contract : contracts) {
+    auto path = ResolvePath(ContractId::FromContract(contract));
+    if (path) paths.push_back(std::move(*path));
+  }
+  Prefetcher().Enqueue(paths);
+  return paths.size();
+}
+
+void DataManager::waitForPrefetch() { Prefetcher().Wait(); }
+
+std::shared_ptr<DataCatalog> DataManager::catalog() {
+  std::lock_guard<std::mutex> lock(catalog_mutex);
+  return active_catalog;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file FilePrefetcher.cpp
+ * @brief Implementation of the background page-cache prefetcher.
+ */
+
+#include "include/FilePrefetcher.hpp"
+
+#include <algorithm>
+
+#include "include/MappedFile.hpp"
+
+FilePrefetcher::FilePrefetcher(size_t num_threads) {
+  num_threads = std::max<size_t>(1, num_threads);
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(&FilePrefetcher::WorkerLoop, this);
+  }
+}
+
+FilePrefetcher::~FilePrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    queue_.clear();
+  }
+  work_cv_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+void FilePrefetcher::Enqueue(const std::vector<std::string> &paths) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &path : paths) {
+      if (seen_.insert(path).second) queue_.push_back(path);
+    }
+  }
+  work_cv_.notify_all();
+}
+
+void FilePrefetcher::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_cv_.wait(lock, [this] { return queue_.empty() && in_flight_ == 0; });
+}
+
+size_t FilePrefetcher::Pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size() + in_flight_;
+}
+
+size_t FilePrefetcher::Warmed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return warmed_;
+}
+
+void FilePrefetcher::Forget() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  seen_.clear();
+  // Keep queued paths deduplicated against later Enqueue calls
+  seen_.insert(queue_.begin(), queue_.end());
+}
+
+void FilePrefetcher::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    work_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+    if (stopping_) return;
+
+    std::string path = std::move(queue_.front());
+    queue_.pop_front();
+    ++in_flight_;
+    lock.unlock();
+
+    const bool ok = MappedFile::WarmPageCache(path);
+
+    lock.lock();
+    --in_flight_;
+    warmed_ += ok;
+    if (queue_.empty() && in_flight_ == 0) idle_cv_.notify_all();
+  }
+}
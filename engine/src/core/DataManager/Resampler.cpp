@@ -0,0 +1,160 @@
+/**
+ * @file Resampler.cpp
+ * @brief Implementation of the OHLCV bar aggregation kernel.
+ */
+
+#include "include/Resampler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "TaskScheduler.hpp"
+
+namespace {
+
+// Inputs below this size are reduced on the calling thread; scheduling
+// tasks costs more than the pass itself.
+constexpr size_t kParallelThreshold = 1 << 16;
+
+// 1970-01-05 was a Monday; weekly buckets are counted from there.
+constexpr int64_t kWeekOriginMs = 4 * static_cast<int64_t>(BarBucket::kDayMs);
+
+/**
+ * Maps timestamps to bucket ids and bucket ids back to bar labels. The
+ * session shift moves the session open to midnight so that daily and weekly
+ * buckets become plain integer divisions.
+ */
+struct BucketKey {
+  int64_t shift;
+  int64_t origin;
+  int64_t width;
+
+  explicit BucketKey(const BarBucket &bucket)
+      : shift(0), origin(0), width(static_cast<int64_t>(bucket.width_ms)) {
+    if (bucket.session_aligned) {
+      const int64_t day = static_cast<int64_t>(BarBucket::kDayMs);
+      shift = (day - static_cast<int64_t>(bucket.session_start_ms)) % day;
+      if (bucket.width_ms % BarBucket::kWeekMs == 0) origin = kWeekOriginMs;
+    }
+  }
+
+  int64_t Id(uint64_t timestamp) const {
+    int64_t t = static_cast<int64_t>(timestamp) + shift - origin;
+    int64_t q = t / width;
+    return (t % width < 0) ? q - 1 : q;
+  }
+
+  uint64_t Label(int64_t id) const {
+    return static_cast<uint64_t>(id * width + origin);
+  }
+};
+
+void ReduceRange(const TimeSeries &series, size_t begin, size_t end,
+                 const BucketKey &key, TimeSeries &out) {
+  const uint64_t *ts = series.Timestamps().data();
+  const double *open = series.Opens().data();
+  const double *high = series.Highs().data();
+  const double *low = series.Lows().data();
+  const double *close = series.Closes().data();
+  const double *volume = series.Volumes().data();
+
+  // Optional columns (open interest, settlement) are end-of-period values,
+  // so each bar takes the last one
+  std::vector<std::pair<const double *, std::vector<double> *>> optional;
+  for (auto name : series.OptionalColumns()) out.AddColumn(std::string(name));
+  for (auto name : series.OptionalColumns()) {
+    optional.emplace_back(series.FindColumn(name)->data(),
+                          out.FindColumn(name));
+  }
+
+  size_t i = begin;
+  while (i < end) {
+    const int64_t id = key.Id(ts[i]);
+    double bar_open = open[i];
+    double bar_high = high[i];
+    double bar_low = low[i];
+    double bar_close = close[i];
+    double bar_volume = volume[i];
+    for (++i; i < end && key.Id(ts[i]) == id; ++i) {
+      bar_high = std::max(bar_high, high[i]);
+      bar_low = std::min(bar_low, low[i]);
+      bar_close = close[i];
+      bar_volume += volume[i];
+    }
+    out.Timestamps().push_back(key.Label(id));
+    out.Opens().push_back(bar_open);
+    out.Highs().push_back(bar_high);
+    out.Lows().push_back(bar_low);
+    out.Closes().push_back(bar_close);
+    out.Volumes().push_back(bar_volume);
+    for (auto &[src, dst] : optional) dst->push_back(src[i - 1]);
+  }
+}
+
+void Append(TimeSeries &dst, const TimeSeries &src) {
+  auto append = [](auto &d, const auto &s) {
+    d.insert(d.end(), s.begin(), s.end());
+  };
+  // Optional columns first: AddColumn() sizes a new column to the rows
+  // already in dst
+  for (auto name : src.OptionalColumns()) {
+    append(dst.AddColumn(std::string(name)), *src.FindColumn(name));
+  }
+  append(dst.Timestamps(), src.Timestamps());
+  append(dst.Opens(), src.Opens());
+  append(dst.Highs(), src.Highs());
+  append(dst.Lows(), src.Lows());
+  append(dst.Closes(), src.Closes());
+  append(dst.Volumes(), src.Volumes());
+}
+
+}  // namespace
+
+TimeSeries Resample(const TimeSeries &series, const BarBucket &bucket,
+                    size_t num_threads) {
+  if (bucket.width_ms == 0) {
+    throw std::invalid_argument("Bar bucket width must be positive");
+  }
+
+  const BucketKey key(bucket);
+  const size_t n = series.Timestamps().size();
+  TimeSeries result;
+
+  if (num_threads == 0) num_threads = TaskScheduler::Instance().NumWorkers();
+  num_threads = std::min(num_threads, n / kParallelThreshold + 1);
+
+  if (num_threads <= 1) {
+    ReduceRange(series, 0, n, key, result);
+    return result;
+  }
+
+  // Move every chunk border forward to the next bucket change so no bar is
+  // split between two workers.
+  const std::vector<uint64_t> &ts = series.Timestamps();
+  std::vector<size_t> bounds(num_threads + 1, n);
+  bounds[0] = 0;
+  for (size_t t = 1; t < num_threads; ++t) {
+    size_t pos = std::max(bounds[t - 1], n * t / num_threads);
+    while (pos > 0 && pos < n && key.Id(ts[pos]) == key.Id(ts[pos - 1])) {
+      ++pos;
+    }
+    bounds[t] = pos;
+  }
+
+  std::vector<TimeSeries> partials(num_threads);
+  ParallelFor(
+      0, num_threads,
+      [&](size_t lo, size_t hi) {
+        for (size_t t = lo; t < hi; ++t) {
+          ReduceRange(series, bounds[t], bounds[t + 1], key, partials[t]);
+        }
+      },
+      1);
+
+  size_t bars = 0;
+  for (const auto &part : partials) bars += part.Timestamps().size();
+  result.reserve(bars);
+  for (const auto &part : partials) Append(result, part);
+  return result;
+}
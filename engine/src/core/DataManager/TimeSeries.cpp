@@ -9,7 +9,88 @@
 #include "include/TimeSeries.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+static_assert(std::is_standard_layout_v<OHLCV> &&
+                  sizeof(OHLCV) == 6 * sizeof(double) &&
+                  offsetof(OHLCV, volume) == 5 * sizeof(double),
+              "Row kernels treat OHLCV as six packed 8-byte fields");
+
+/**
+ * @brief Interleaves six columns into `count` rows of six 8-byte fields.
+ *
+ * Fields are moved as raw 8-byte values (timestamps travel through the
+ * double lanes), never through floating-point arithmetic.
+ *
+ * Two rows per step: one 16-byte load from each column and an unpack per
+ * column pair give the 96 contiguous bytes of the two rows, so columns and
+ * rows are both streamed in order.
+ */
+void InterleaveRows(const double *const columns[6], size_t count,
+                    double *rows) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 2 <= count; i += 2, rows += 12) {
+    const __m128d a = _mm_loadu_pd(columns[0] + i);
+    const __m128d b = _mm_loadu_pd(columns[1] + i);
+    const __m128d c = _mm_loadu_pd(columns[2] + i);
+    const __m128d d = _mm_loadu_pd(columns[3] + i);
+    const __m128d e = _mm_loadu_pd(columns[4] + i);
+    const __m128d f = _mm_loadu_pd(columns[5] + i);
+    _mm_storeu_pd(rows + 0, _mm_unpacklo_pd(a, b));
+    _mm_storeu_pd(rows + 2, _mm_unpacklo_pd(c, d));
+    _mm_storeu_pd(rows + 4, _mm_unpacklo_pd(e, f));
+    _mm_storeu_pd(rows + 6, _mm_unpackhi_pd(a, b));
+    _mm_storeu_pd(rows + 8, _mm_unpackhi_pd(c, d));
+    _mm_storeu_pd(rows + 10, _mm_unpackhi_pd(e, f));
+  }
+#endif
+  for (; i < count; ++i, rows += 6) {
+    for (int k = 0; k < 6; ++k) {
+      std::memcpy(rows + k, columns[k] + i, sizeof(double));
+    }
+  }
+}
+
+/**
+ * @brief Inverse of InterleaveRows().
+ */
+void DeinterleaveRows(const double *rows, size_t count,
+                      double *const columns[6]) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 2 <= count; i += 2, rows += 12) {
+    const __m128d ab0 = _mm_loadu_pd(rows + 0);
+    const __m128d cd0 = _mm_loadu_pd(rows + 2);
+    const __m128d ef0 = _mm_loadu_pd(rows + 4);
+    const __m128d ab1 = _mm_loadu_pd(rows + 6);
+    const __m128d cd1 = _mm_loadu_pd(rows + 8);
+    const __m128d ef1 = _mm_loadu_pd(rows + 10);
+    _mm_storeu_pd(columns[0] + i, _mm_unpacklo_pd(ab0, ab1));
+    _mm_storeu_pd(columns[1] + i, _mm_unpackhi_pd(ab0, ab1));
+    _mm_storeu_pd(columns[2] + i, _mm_unpacklo_pd(cd0, cd1));
+    _mm_storeu_pd(columns[3] + i, _mm_unpackhi_pd(cd0, cd1));
+    _mm_storeu_pd(columns[4] + i, _mm_unpacklo_pd(ef0, ef1));
+    _mm_storeu_pd(columns[5] + i, _mm_unpackhi_pd(ef0, ef1));
+  }
+#endif
+  for (; i < count; ++i, rows += 6) {
+    for (int k = 0; k < 6; ++k) {
+      std::memcpy(columns[k] + i, rows + k, sizeof(double));
+    }
+  }
+}
+
+}  // namespace
 
 TimeSeries::TimeSeries(std::vector<uint64_t> timestamps,
                        std::vector<double> opens, std::vector<double> highs,
@@ -29,6 +110,7 @@ void TimeSeries::reserve(size_t capacity) {
   lows_.reserve(capacity);
   closes_.reserve(capacity);
   volumes_.reserve(capacity);
+  for (auto &column : optional_) column.values.reserve(capacity);
 }
 
 void TimeSeries::clear() {
@@ -38,9 +120,13 @@ void TimeSeries::clear() {
   lows_.clear();
   closes_.clear();
   volumes_.clear();
+  optional_.clear();
+  deferred_.reset();
+  pending_.Store(0);
 }
 
 const OHLCV TimeSeries::DataPoint(size_t index) const {
+  Ensure(SeriesColumn::kAll);
   if (index >= timestamps_.size()) {
     throw std::out_of_range("Index out of range");
   }
@@ -49,6 +135,7 @@ const OHLCV TimeSeries::DataPoint(size_t index) const {
 }
 
 const OHLCV TimeSeries::DataPointByTimestamp(uint64_t timestamp) const {
+  Ensure(SeriesColumn::kAll);
   auto it = std::find(timestamps_.begin(), timestamps_.end(), timestamp);
   if (it == timestamps_.end()) {
     throw std::out_of_range("Timestamp not found");
@@ -58,28 +145,237 @@ const OHLCV TimeSeries::DataPointByTimestamp(uint64_t timestamp) const {
                lows_[index],       closes_[index], volumes_[index]};
 }
 
+void TimeSeries::ToRows(size_t begin, size_t end, OHLCV *out) const {
+  Ensure(SeriesColumn::kAll);
+  if (begin > end || end > timestamps_.size()) {
+    throw std::out_of_range("Row range out of range");
+  }
+  // Timestamps are copied bit for bit through the double lanes
+  const double *const columns[6] = {
+      reinterpret_cast<const double *>(timestamps_.data()) + begin,
+      opens_.data() + begin,
+      highs_.data() + begin,
+      lows_.data() + begin,
+      closes_.data() + begin,
+      volumes_.data() + begin};
+  InterleaveRows(columns, end - begin, reinterpret_cast<double *>(out));
+}
+
+TimeSeries TimeSeries::FromRows(const OHLCV *rows, size_t count) {
+  TimeSeries series;
+  series.AppendRows(rows, count);
+  return series;
+}
+
+void TimeSeries::AppendRows(const OHLCV *rows, size_t count) {
+  Ensure(SeriesColumn::kAll);
+  const size_t offset = timestamps_.size();
+  const size_t size = offset + count;
+  timestamps_.resize(size);
+  opens_.resize(size);
+  highs_.resize(size);
+  lows_.resize(size);
+  closes_.resize(size);
+  volumes_.resize(size);
+  for (auto &column : optional_) column.values.resize(size, 0.0);
+  double *const columns[6] = {
+      reinterpret_cast<double *>(timestamps_.data()) + offset,
+      opens_.data() + offset,
+      highs_.data() + offset,
+      lows_.data() + offset,
+      closes_.data() + offset,
+      volumes_.data() + offset};
+  DeinterleaveRows(reinterpret_cast<const double *>(rows), count, columns);
+}
+
+TimeSeries::RowRange TimeSeries::Rows(size_t begin, size_t end) const {
+  Ensure(SeriesColumn::kAll);
+  if (end == std::numeric_limits<size_t>::max()) end = timestamps_.size();
+  if (begin > end || end > timestamps_.size()) {
+    throw std::out_of_range("Row range out of range");
+  }
+  RowRange::Columns columns;
+  columns.timestamps = timestamps_.data();
+  columns.opens = opens_.data();
+  columns.highs = highs_.data();
+  columns.lows = lows_.data();
+  columns.closes = closes_.data();
+  columns.volumes = volumes_.data();
+  return RowRange(columns, begin, end);
+}
+
 const std::vector<uint64_t> &TimeSeries::Timestamps() const {
   return timestamps_;
 }
 
-const std::vector<double> &TimeSeries::Opens() const { return opens_; }
+const std::vector<double> &TimeSeries::Opens() const {
+  Ensure(SeriesColumn::kOpen);
+  return opens_;
+}
 
-const std::vector<double> &TimeSeries::Highs() const { return highs_; }
+const std::vector<double> &TimeSeries::Highs() const {
+  Ensure(SeriesColumn::kHigh);
+  return highs_;
+}
 
-const std::vector<double> &TimeSeries::Lows() const { return lows_; }
+const std::vector<double> &TimeSeries::Lows() const {
+  Ensure(SeriesColumn::kLow);
+  return lows_;
+}
 
-const std::vector<double> &TimeSeries::Closes() const { return closes_; }
+const std::vector<double> &TimeSeries::Closes() const {
+  Ensure(SeriesColumn::kClose);
+  return closes_;
+}
 
-const std::vector<double> &TimeSeries::Volumes() const { return volumes_; }
+const std::vector<double> &TimeSeries::Volumes() const {
+  Ensure(SeriesColumn::kVolume);
+  return volumes_;
+}
 
 std::vector<uint64_t> &TimeSeries::Timestamps() { return timestamps_; }
 
-std::vector<double> &TimeSeries::Opens() { return opens_; }
+std::vector<double> &TimeSeries::Opens() {
+  Ensure(SeriesColumn::kOpen);
+  return opens_;
+}
+
+std::vector<double> &TimeSeries::Highs() {
+  Ensure(SeriesColumn::kHigh);
+  return highs_;
+}
+
+std::vector<double> &TimeSeries::Lows() {
+  Ensure(SeriesColumn::kLow);
+  return lows_;
+}
+
+std::vector<double> &TimeSeries::Closes() {
+  Ensure(SeriesColumn::kClose);
+  return closes_;
+}
+
+std::vector<double> &TimeSeries::Volumes() {
+  Ensure(SeriesColumn::kVolume);
+  return volumes_;
+}
+bool TimeSeries::HasColumn(std::string_view name) const {
+  for (const auto &column : optional_) {
+    if (column.name == name) return true;
+  }
+  return false;
+}
+
+const std::vector<double> *TimeSeries::FindColumn(
+    std::string_view name) const {
+  return const_cast<TimeSeries *>(this)->FindColumn(name);
+}
+
+std::vector<double> *TimeSeries::FindColumn(std::string_view name) {
+  if (name == "open") return &Opens();
+  if (name == "high") return &Highs();
+  if (name == "low") return &Lows();
+  if (name == "close") return &Closes();
+  if (name == "volume") return &Volumes();
+  if (name == kOpenInterest) Ensure(SeriesColumn::kOpenInterest);
+  if (name == kSettlement) Ensure(SeriesColumn::kSettlement);
+  for (auto &column : optional_) {
+    if (column.name == name) return &column.values;
+  }
+  return nullptr;
+}
+
+std::vector<double> &TimeSeries::AddColumn(const std::string &name) {
+  if (auto *existing = FindColumn(name)) {
+    if (!HasColumn(name)) {
+      throw std::invalid_argument("Not an optional column: " + name);
+    }
+    return *existing;
+  }
+  optional_.push_back({name, std::vector<double>(timestamps_.size(), 0.0)});
+  return optional_.back().values;
+}
+
+void TimeSeries::DropColumn(std::string_view name) {
+  ColumnMask pending = pending_.Load();
+  if (name == kOpenInterest) pending &= ~SeriesColumn::kOpenInterest;
+  if (name == kSettlement) pending &= ~SeriesColumn::kSettlement;
+  pending_.Store(pending);
+  optional_.erase(std::remove_if(optional_.begin(), optional_.end(),
+                                 [&](const NamedColumn &column) {
+                                   return column.name == name;
+                                 }),
+                  optional_.end());
+}
 
-std::vector<double> &TimeSeries::Highs() { return highs_; }
+std::vector<std::string_view> TimeSeries::OptionalColumns() const {
+  std::vector<std::string_view> names;
+  names.reserve(optional_.size());
+  for (const auto &column : optional_) names.push_back(column.name);
+  return names;
+}
 
-std::vector<double> &TimeSeries::Lows() { return lows_; }
+const std::vector<double> &TimeSeries::OpenInterest() const {
+  const auto *column = FindColumn(kOpenInterest);
+  if (!column) throw std::out_of_range("Series has no open interest");
+  return *column;
+}
 
-std::vector<double> &TimeSeries::Closes() { return closes_; }
+const std::vector<double> &TimeSeries::Settlements() const {
+  const auto *column = FindColumn(kSettlement);
+  if (!column) throw std::out_of_range("Series has no settlement prices");
+  return *column;
+}
+
+void TimeSeries::SetDeferredColumns(
+    std::shared_ptr<const DeferredColumns> source, ColumnMask columns) {
+  Materialize();  // At most one source per series
+  deferred_ = std::move(source);
+  pending_.Store(deferred_ ? columns & SeriesColumn::kAll : 0);
+}
 
-std::vector<double> &TimeSeries::Volumes() { return volumes_; }
\ No newline at end of file
+void TimeSeries::Materialize(ColumnMask columns) {
+  Ensure(columns);
+  if (pending_.Load() == 0) deferred_.reset();
+}
+
+std::vector<double> *TimeSeries::ColumnFor(ColumnMask column) {
+  switch (column) {
+    case SeriesColumn::kOpen:
+      return &opens_;
+    case SeriesColumn::kHigh:
+      return &highs_;
+    case SeriesColumn::kLow:
+      return &lows_;
+    case SeriesColumn::kClose:
+      return &closes_;
+    case SeriesColumn::kVolume:
+      return &volumes_;
+  }
+  const char *name = column == SeriesColumn::kOpenInterest ? kOpenInterest
+                                                            : kSettlement;
+  for (auto &optional : optional_) {
+    if (optional.name == name) return &optional.values;
+  }
+  return nullptr;
+}
+
+void TimeSeries::MaterializeSlow(ColumnMask columns) const {
+  // A moved-from series keeps its mask but has no source
+  if (!deferred_) {
+    pending_.Store(0);
+    return;
+  }
+  auto *self = const_cast<TimeSeries *>(this);
+  std::lock_guard<std::mutex> lock(deferred_->Mutex());
+  ColumnMask pending = pending_.Load();
+  for (ColumnMask todo = pending & columns; todo != 0; todo &= todo - 1) {
+    const ColumnMask column = todo & (~todo + 1);
+    if (std::vector<double> *out = self->ColumnFor(column)) {
+      out->resize(timestamps_.size());
+      deferred_->Materialize(column, out->data());
+    }
+    pending &= ~column;
+    pending_.Store(pending);
+  }
+}
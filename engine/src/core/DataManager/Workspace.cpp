@@ -0,0 +1,361 @@
+/**
+ * @file Workspace.cpp
+ * @brief Implementation of workspace files and their writer.
+ */
+
+#include "include/Workspace.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'L', 'C', 'W', 'S', 'P', 'C', '\0'};
+constexpr uint64_t kAlignment = 64;
+
+/**
+ * Fixed header at offset 0; the first payload starts right after it.
+ */
+struct FileHeader {
+  char magic[8];
+  uint32_t format;
+  uint32_t reserved;
+  uint64_t entries;
+  uint64_t directory_offset;
+  uint64_t directory_size;
+  uint64_t file_size;
+  uint64_t padding[2];
+};
+static_assert(sizeof(FileHeader) == kAlignment, "Header fills one line");
+
+/**
+ * Directory record, followed by the key padded to 8 bytes.
+ */
+struct DirectoryRecord {
+  uint32_t kind;
+  uint32_t key_size;
+  uint64_t version;
+  uint64_t rows;
+  uint64_t cols;
+  uint64_t offset;
+  uint64_t size;
+};
+
+constexpr uint64_t Align(uint64_t n, uint64_t to) {
+  return (n + to - 1) / to * to;
+}
+
+/**
+ * Byte layout of a series payload: a block of optional column names, then
+ * 6 + names columns of `rows` values, each on a 64-byte boundary.
+ */
+struct SeriesLayout {
+  std::vector<std::string> names;
+  uint64_t columns_offset = 0;
+  uint64_t stride = 0;
+};
+
+bool ParseSeries(const char *data, uint64_t size, uint64_t rows,
+                 uint64_t cols, SeriesLayout &layout) {
+  // Every bound is checked in subtraction form: the fields come from the
+  // file and a damaged one must not wrap a sum past the check
+  auto read = [&](uint64_t at, uint64_t &value) {
+    if (at > size || sizeof(value) > size - at) return false;
+    std::memcpy(&value, data + at, sizeof(value));
+    return true;
+  };
+  uint64_t count = 0;
+  uint64_t at = 0;
+  if (cols < 6 || !read(at, count) || count != cols - 6) return false;
+  at += sizeof(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t length = 0;
+    if (!read(at, length)) return false;
+    at += sizeof(length);
+    if (length > size - at) return false;
+    layout.names.emplace_back(data + at, length);
+    at += length;
+  }
+  if (rows > size / sizeof(double)) return false;
+  layout.columns_offset = Align(at, kAlignment);
+  layout.stride = Align(rows * sizeof(double), kAlignment);
+  if (layout.columns_offset > size) return false;
+  return layout.stride == 0 ||
+         cols <= (size - layout.columns_offset) / layout.stride;
+}
+
+}  // namespace
+
+bool Workspace::Open(const std::string &path) {
+  file_.Close();
+  keys_.clear();
+  directory_.clear();
+
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(path, ec)) return false;
+  // Demand paging: only the header and directory are read here
+  if (!file_.Open(path, ReadaheadPolicy::kNone)) return false;
+
+  auto fail = [this] {
+    file_.Close();
+    keys_.clear();
+    directory_.clear();
+    return false;
+  };
+
+  const char *data = file_.Data();
+  const uint64_t size = file_.Size();
+  FileHeader header;
+  if (size < sizeof(header)) return fail();
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.format != kFormatVersion || header.file_size != size ||
+      header.directory_offset > size ||
+      header.directory_size > size - header.directory_offset) {
+    return fail();
+  }
+
+  uint64_t at = header.directory_offset;
+  const uint64_t end = at + header.directory_size;
+  for (uint64_t i = 0; i < header.entries; ++i) {
+    DirectoryRecord record;
+    if (end - at < sizeof(record)) return fail();
+    std::memcpy(&record, data + at, sizeof(record));
+    at += sizeof(record);
+    if (end - at < record.key_size) return fail();
+    std::string key(data + at, record.key_size);
+    at += Align(record.key_size, 8);
+    if (at > end || record.offset > size ||
+        record.size > size - record.offset) {
+      return fail();
+    }
+
+    Entry entry{static_cast<WorkspaceEntryKind>(record.kind),
+                record.version,
+                record.rows,
+                record.cols,
+                record.offset,
+                record.size};
+    switch (entry.kind) {
+      case WorkspaceEntryKind::kSeries:
+        if (entry.cols < 6) return fail();
+        break;
+      case WorkspaceEntryKind::kMatrix:
+        if (entry.cols != 0 &&
+            entry.rows > entry.size / sizeof(double) / entry.cols) {
+          return fail();
+        }
+        break;
+      case WorkspaceEntryKind::kBlob:
+        if (entry.rows > entry.size) return fail();
+        break;
+      default:
+        return fail();
+    }
+    if (directory_.emplace(key, entry).second) keys_.push_back(key);
+  }
+  return true;
+}
+
+std::vector<std::string> Workspace::Keys() const { return keys_; }
+
+const Workspace::Entry *Workspace::Find(const std::string &key,
+                                        WorkspaceEntryKind kind,
+                                        uint64_t version) const {
+  auto it = directory_.find(key);
+  if (it == directory_.end() || it->second.kind != kind ||
+      it->second.version != version) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+bool Workspace::ReadSeries(const std::string &key, uint64_t version,
+                           TimeSeries &series) const {
+  const Entry *entry = Find(key, WorkspaceEntryKind::kSeries, version);
+  if (!entry) return false;
+  const char *data = file_.Data() + entry->offset;
+  SeriesLayout layout;
+  if (!ParseSeries(data, entry->size, entry->rows, entry->cols, layout)) {
+    return false;
+  }
+
+  const size_t rows = entry->rows;
+  auto column = [&](size_t i) {
+    return data + layout.columns_offset + i * layout.stride;
+  };
+  auto doubles = [&](size_t i) {
+    const double *values = reinterpret_cast<const double *>(column(i));
+    return std::vector<double>(values, values + rows);
+  };
+  const uint64_t *timestamps =
+      reinterpret_cast<const uint64_t *>(column(0));
+  series = TimeSeries(std::vector<uint64_t>(timestamps, timestamps + rows),
+                      doubles(1), doubles(2), doubles(3), doubles(4),
+                      doubles(5));
+  for (size_t i = 0; i < layout.names.size(); ++i) {
+    std::vector<double> values = doubles(6 + i);
+    series.AddColumn(layout.names[i]).swap(values);
+  }
+  return true;
+}
+
+bool Workspace::ReadMatrix(const std::string &key, uint64_t version,
+                           size_t &rows, size_t &cols,
+                           std::vector<double> &values) const {
+  const Entry *entry = Find(key, WorkspaceEntryKind::kMatrix, version);
+  if (!entry) return false;
+  rows = entry->rows;
+  cols = entry->cols;
+  const double *data =
+      reinterpret_cast<const double *>(file_.Data() + entry->offset);
+  values.assign(data, data + rows * cols);
+  return true;
+}
+
+bool Workspace::ReadBlob(const std::string &key, uint64_t version,
+                         std::vector<uint8_t> &bytes) const {
+  const Entry *entry = Find(key, WorkspaceEntryKind::kBlob, version);
+  if (!entry) return false;
+  const uint8_t *data =
+      reinterpret_cast<const uint8_t *>(file_.Data() + entry->offset);
+  bytes.assign(data, data + entry->rows);
+  return true;
+}
+
+WorkspaceWriter::WorkspaceWriter(std::string path)
+    : path_(std::move(path)), temp_(path_ + ".tmp") {
+  out_.open(temp_, std::ios::binary | std::ios::trunc);
+  const FileHeader placeholder{};
+  Write(&placeholder, sizeof(placeholder));
+}
+
+WorkspaceWriter::~WorkspaceWriter() {
+  if (committed_) return;
+  out_.close();
+  std::remove(temp_.c_str());
+}
+
+bool WorkspaceWriter::Begin(const std::string &key, WorkspaceEntryKind kind,
+                            uint64_t version, uint64_t rows, uint64_t cols) {
+  if (committed_ || !out_ || !written_.insert(key).second) return false;
+  entries_.push_back({key, {kind, version, rows, cols, offset_, 0}});
+  return true;
+}
+
+void WorkspaceWriter::Write(const void *data, size_t size) {
+  out_.write(static_cast<const char *>(data), size);
+  offset_ += size;
+}
+
+void WorkspaceWriter::Finish() {
+  Workspace::Entry &entry = entries_.back().entry;
+  static const char kZeros[kAlignment] = {};
+  Write(kZeros, Align(offset_, kAlignment) - offset_);
+  entry.size = offset_ - entry.offset;
+}
+
+bool WorkspaceWriter::AddSeries(const std::string &key, uint64_t version,
+                                const TimeSeries &series) {
+  const auto names = series.OptionalColumns();
+  const uint64_t rows = series.Timestamps().size();
+  if (!Begin(key, WorkspaceEntryKind::kSeries, version, rows,
+             6 + names.size())) {
+    return false;
+  }
+  static const char kZeros[kAlignment] = {};
+  const uint64_t start = offset_;
+  const uint64_t count = names.size();
+  Write(&count, sizeof(count));
+  for (const auto name : names) {
+    const uint64_t length = name.size();
+    Write(&length, sizeof(length));
+    Write(name.data(), name.size());
+  }
+  Write(kZeros, Align(offset_ - start, kAlignment) - (offset_ - start));
+
+  auto column = [&](const void *values) {
+    Write(values, rows * sizeof(double));
+    Write(kZeros, Align(offset_, kAlignment) - offset_);
+  };
+  column(series.Timestamps().data());
+  column(series.Opens().data());
+  column(series.Highs().data());
+  column(series.Lows().data());
+  column(series.Closes().data());
+  column(series.Volumes().data());
+  for (const auto name : names) column(series.FindColumn(name)->data());
+  Finish();
+  return static_cast<bool>(out_);
+}
+
+bool WorkspaceWriter::AddMatrix(const std::string &key, uint64_t version,
+                                size_t rows, size_t cols,
+                                const double *values) {
+  if (!Begin(key, WorkspaceEntryKind::kMatrix, version, rows, cols)) {
+    return false;
+  }
+  Write(values, rows * cols * sizeof(double));
+  Finish();
+  return static_cast<bool>(out_);
+}
+
+bool WorkspaceWriter::AddBlob(const std::string &key, uint64_t version,
+                              const void *data, size_t size) {
+  if (!Begin(key, WorkspaceEntryKind::kBlob, version, size, 1)) return false;
+  Write(data, size);
+  Finish();
+  return static_cast<bool>(out_);
+}
+
+size_t WorkspaceWriter::CarryOver(const Workspace &previous) {
+  size_t copied = 0;
+  for (const auto &key : previous.keys_) {
+    const Workspace::Entry &entry = previous.directory_.at(key);
+    if (!Begin(key, entry.kind, entry.version, entry.rows, entry.cols)) {
+      continue;
+    }
+    // Payloads only hold offsets relative to their own start
+    Write(previous.file_.Data() + entry.offset, entry.size);
+    Finish();
+    ++copied;
+  }
+  return copied;
+}
+
+bool WorkspaceWriter::Commit() {
+  if (committed_ || !out_) return false;
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.format = Workspace::kFormatVersion;
+  header.entries = entries_.size();
+  header.directory_offset = offset_;
+  for (const auto &pending : entries_) {
+    const Workspace::Entry &e = pending.entry;
+    const DirectoryRecord record{static_cast<uint32_t>(e.kind),
+                                 static_cast<uint32_t>(pending.key.size()),
+                                 e.version,
+                                 e.rows,
+                                 e.cols,
+                                 e.offset,
+                                 e.size};
+    Write(&record, sizeof(record));
+    Write(pending.key.data(), pending.key.size());
+    static const char kZeros[8] = {};
+    Write(kZeros, Align(pending.key.size(), 8) - pending.key.size());
+  }
+  header.directory_size = offset_ - header.directory_offset;
+  header.file_size = offset_;
+  out_.seekp(0);
+  out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out_.close();
+  if (!out_) return false;
+
+  std::error_code ec;
+  std::filesystem::rename(temp_, path_, ec);
+  if (ec) return false;
+  committed_ = true;
+  return true;
+}
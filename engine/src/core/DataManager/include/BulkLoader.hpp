@@ -0,0 +1,101 @@
+/**
+ * @file BulkLoader.hpp
+ * @brief Batched loading of many contract files.
+ *
+ * Loading a commodity's full history means hundreds of small files, and one
+ * synchronous open/fstat/mmap sequence per file leaves the loader waiting on
+ * syscall latency. The BulkLoader keeps a deep queue of opens, stats and
+ * reads in flight on an io_uring and hands each finished buffer to a parser
+ * task on the TaskScheduler while the remaining I/O continues. Where io_uring is not
+ * available it falls back to a pool of blocking reader threads.
+ */
+
+#ifndef BULK_LOADER_HPP
+#define BULK_LOADER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "TimeSeries.hpp"
+
+class JobContext;
+
+/**
+ * @enum BulkLoadBackend
+ * @brief I/O engine used by the BulkLoader.
+ */
+enum class BulkLoadBackend {
+  kAuto,       ///< io_uring if the kernel supports the needed opcodes
+  kIoUring,    ///< io_uring; falls back to kThreadPool if unavailable
+  kThreadPool  ///< Blocking open/read on a pool of threads
+};
+
+/**
+ * @struct BulkLoadOptions
+ * @brief Tuning knobs for the BulkLoader.
+ */
+struct BulkLoadOptions {
+  BulkLoadBackend backend = BulkLoadBackend::kAuto;
+  unsigned queue_depth = 64;  ///< Submission queue entries (io_uring)
+  size_t io_threads = 8;      ///< Reader threads (thread-pool fallback)
+};
+
+/**
+ * @struct BulkLoadResult
+ * @brief Outcome of loading one file.
+ */
+struct BulkLoadResult {
+  std::string path;
+  TimeSeries data;
+  bool ok = false;
+  int error = 0;  ///< errno of the failed I/O operation, or 0
+};
+
+/**
+ * @class BulkLoader
+ * @brief Loads many CSV or compressed (`.acz`) contract files at once.
+ *
+ * @example
+ * ```cpp
+ * BulkLoader loader;
+ * auto results = loader.Load(paths);
+ * for (auto &r : results) {
+ *   if (r.ok) Process(r.data);
+ * }
+ * ```
+ */
+class BulkLoader {
+ public:
+  explicit BulkLoader(BulkLoadOptions options = {});
+
+  /**
+   * @brief Loads every path; results are in input order.
+   *
+   * CSV files are expected to have a header row, which selects the column
+   * layout (see CsvSchemaRegistry). A file that cannot be read or decoded
+   * yields `ok == false` without affecting the others.
+   *
+   * With a job, parsed files are counted on JobContext::kContractsLoaded.
+   * Once the job is cancelled no further files are read or parsed; those
+   * yield `ok == false`.
+   */
+  std::vector<BulkLoadResult> Load(const std::vector<std::string> &paths,
+                                   JobContext *context = nullptr);
+
+  /**
+   * @brief Backend used by the most recent Load().
+   */
+  BulkLoadBackend LastBackend() const { return last_backend_; }
+
+  /**
+   * @brief Returns true if this kernel supports the io_uring backend.
+   */
+  static bool IoUringAvailable();
+
+ private:
+  BulkLoadOptions options_;
+  BulkLoadBackend last_backend_ = BulkLoadBackend::kAuto;
+};
+
+#endif /* BULK_LOADER_HPP */
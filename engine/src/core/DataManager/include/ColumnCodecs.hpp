@@ -0,0 +1,102 @@
+/**
+ * @file ColumnCodecs.hpp
+ * @brief Lightweight compression codecs for time series columns.
+ *
+ * Market data columns are highly regular: timestamps advance by a fixed
+ * step, prices move by a few ticks and volumes are small integers. The codecs
+ * here exploit that with byte-aligned encodings that decode in tight loops:
+ *
+ * - Delta-of-delta timestamps with zero-run folding (regular bars cost a
+ *   few bytes per run instead of eight bytes per row)
+ * - Tick-scaled price deltas as zig-zag varints
+ * - Byte-aligned Gorilla-style XOR for arbitrary doubles
+ * - Varints for non-negative integral values such as volume
+ *
+ * Every decoder is a single forward pass writing straight into the output
+ * column. Varints are read a word at a time: the continuation bits of eight
+ * bytes select a precomputed layout, and every one- or two-byte varint in
+ * the word is unpacked without a per-byte loop. Longer varints and the last
+ * few bytes of a column fall back to a scalar loop.
+ */
+
+#ifndef COLUMN_CODECS_HPP
+#define COLUMN_CODECS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @enum ColumnCodec
+ * @brief Identifies the encoding of one stored column.
+ */
+enum class ColumnCodec : uint8_t {
+  kRaw = 0,           ///< Uncompressed little-endian values
+  kDeltaOfDelta = 1,  ///< Integer timestamps, delta-of-delta with zero runs
+  kTickDelta = 2,     ///< Doubles that are exact multiples of 1 / scale
+  kXor = 3,           ///< Doubles, byte-aligned XOR with the previous value
+  kVarint = 4         ///< Non-negative integral doubles as varints
+};
+
+/**
+ * @brief Encodes integer timestamps with delta-of-delta and zero runs.
+ */
+void EncodeDeltaOfDelta(const uint64_t *values, size_t count,
+                        std::vector<uint8_t> &out);
+
+/**
+ * @brief Decodes `count` timestamps; returns bytes consumed, 0 on error.
+ */
+size_t DecodeDeltaOfDelta(const uint8_t *data, size_t size, size_t count,
+                          uint64_t *out);
+
+/**
+ * @brief Finds a scale such that every value is `k / scale` exactly.
+ *
+ * @return double The scale, or 0 if no candidate round-trips every value
+ *
+ * Candidates are powers of two (fractional ticks like 1/4 or 1/8) and
+ * powers of ten up to 10^8 (decimal quotes).
+ */
+double FindTickScale(const double *values, size_t count);
+
+/**
+ * @brief Encodes doubles as zig-zag varint deltas of `value * scale`.
+ */
+void EncodeTickDelta(const double *values, size_t count, double scale,
+                     std::vector<uint8_t> &out);
+
+/**
+ * @brief Decodes `count` tick-delta doubles; returns bytes consumed or 0.
+ */
+size_t DecodeTickDelta(const uint8_t *data, size_t size, size_t count,
+                       double scale, double *out);
+
+/**
+ * @brief Encodes doubles with byte-aligned XOR against the previous value.
+ */
+void EncodeXor(const double *values, size_t count, std::vector<uint8_t> &out);
+
+/**
+ * @brief Decodes `count` XOR-coded doubles; returns bytes consumed or 0.
+ */
+size_t DecodeXor(const uint8_t *data, size_t size, size_t count, double *out);
+
+/**
+ * @brief Returns true if every value is a non-negative integer below 2^53.
+ */
+bool IsVarintCompatible(const double *values, size_t count);
+
+/**
+ * @brief Encodes non-negative integral doubles as varints.
+ */
+void EncodeVarint(const double *values, size_t count,
+                  std::vector<uint8_t> &out);
+
+/**
+ * @brief Decodes `count` varint doubles; returns bytes consumed or 0.
+ */
+size_t DecodeVarint(const uint8_t *data, size_t size, size_t count,
+                    double *out);
+
+#endif /* COLUMN_CODECS_HPP */
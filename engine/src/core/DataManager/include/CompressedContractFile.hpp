@@ -0,0 +1,92 @@
+/**
+ * @file CompressedContractFile.hpp
+ * @brief Compressed columnar binary storage for contract time series.
+ *
+ * A `.acz` file stores the same six columns as a contract CSV, each encoded
+ * with the cheapest codec from ColumnCodecs.hpp that round-trips it exactly.
+ * Minute bars typically shrink by an order of magnitude versus CSV and load
+ * without any text parsing.
+ *
+ * Layout (little-endian):
+ * - FileHeader: magic "ACZ1", format version, column count, row count
+ * - One ColumnHeader per column: codec, tick scale, payload length
+ * - Column payloads in header order: timestamps, opens, highs, lows, closes,
+ *   volumes
+ */
+
+#ifndef COMPRESSED_CONTRACT_FILE_HPP
+#define COMPRESSED_CONTRACT_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ColumnCodecs.hpp"
+#include "MappedFile.hpp"
+#include "TimeSeries.hpp"
+
+/**
+ * @class CompressedContractFile
+ * @brief Encodes, decodes, reads and writes compressed contract files.
+ *
+ * @example
+ * ```cpp
+ * CompressedContractFile::ConvertCsv("data/ZC/H/2025.csv",
+ *                                    "data/ZC/H/2025.acz");
+ * TimeSeries data;
+ * CompressedContractFile::Read("data/ZC/H/2025.acz", data);
+ * ```
+ */
+class CompressedContractFile {
+ public:
+  static constexpr const char *kExtension = ".acz";
+  static constexpr uint16_t kVersion = 1;
+  static constexpr size_t kColumns = 6;
+
+  /**
+   * @brief Per-column storage description.
+   */
+  struct ColumnHeader {
+    ColumnCodec codec;     ///< Encoding of the payload
+    uint8_t reserved[7];   ///< Zero
+    double scale;          ///< Ticks per unit for kTickDelta, else 0
+    uint64_t bytes;        ///< Payload length
+  };
+
+  /**
+   * @brief Encodes a series into an in-memory file image.
+   */
+  static std::vector<uint8_t> Encode(const TimeSeries &data);
+
+  /**
+   * @brief Decodes a file image straight into the series' columns.
+   * @return bool False if the image is truncated, corrupt or of an
+   *         unsupported version; `data` is then left empty
+   */
+  static bool Decode(const uint8_t *bytes, size_t size, TimeSeries &data);
+
+  /**
+   * @brief Writes a series; the file appears atomically via rename.
+   */
+  static bool Write(const std::string &filename, const TimeSeries &data);
+
+  /**
+   * @brief Memory-maps and decodes a compressed contract file.
+   */
+  static bool Read(const std::string &filename, TimeSeries &data,
+                   ReadaheadPolicy policy = ReadaheadPolicy::kAuto);
+
+  /**
+   * @brief Converts a contract CSV (with header row) to a compressed file.
+   */
+  static bool ConvertCsv(const std::string &csv_filename,
+                         const std::string &filename);
+
+  /**
+   * @brief Returns true if the path has the compressed file extension.
+   */
+  static bool IsCompressedPath(const std::string &path);
+};
+
+#endif /* COMPRESSED_CONTRACT_FILE_HPP */
@@ -70,6 +70,40 @@ inline std::string ExpirationMonthToString(ExpirationMonth month) {
   }
 };
 
+/**
+ * @brief Parses a single-letter month code into an ExpirationMonth.
+ *
+ * @param letter The month letter, e.g. "H"
+ * @param month Receives the parsed month on success
+ * @return bool False if `letter` is not a futures month code
+ *
+ * @example
+ * ```cpp
+ * ExpirationMonth month;
+ * if (ExpirationMonthFromString("K", month)) { // month == ExpirationMonth::K
+ * }
+ * ```
+ */
+inline bool ExpirationMonthFromString(const std::string &letter,
+                                      ExpirationMonth &month) {
+  if (letter.size() != 1) return false;
+  switch (letter[0]) {
+    case 'F': month = F; return true;
+    case 'G': month = G; return true;
+    case 'H': month = H; return true;
+    case 'J': month = J; return true;
+    case 'K': month = K; return true;
+    case 'M': month = M; return true;
+    case 'N': month = N; return true;
+    case 'Q': month = Q; return true;
+    case 'U': month = U; return true;
+    case 'V': month = V; return true;
+    case 'X': month = X; return true;
+    case 'Z': month = Z; return true;
+    default: return false;
+  }
+}
+
 /**
  * @struct Contract
  * @brief Represents a futures contract with symbol, expiration month, and year.
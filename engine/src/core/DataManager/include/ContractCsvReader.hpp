@@ -10,10 +10,15 @@
 #ifndef CSV_READER_HPP
 #define CSV_READER_HPP
 
-#include <ctime>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "Contract.hpp"
+#include "ContractId.hpp"
+#include "CsvSchema.hpp"
+#include "MappedFile.hpp"
 #include "TimeSeries.hpp"
 
 /**
@@ -32,7 +37,7 @@ class PathFinder {
    * @return std::string The complete file path to the contract's CSV data
    * 
    * The path format follows the pattern:
-   * `/data/contracts/{symbol}/{month_letter}/{year}.csv`
+   * `{data_root}/{symbol}/{month_letter}/{year}.csv`
    * 
    * @example
    * ```cpp
@@ -42,6 +47,34 @@ class PathFinder {
    * ```
    */
   static std::string find_contract_csv(const Contract &contract);
+
+  /**
+   * @brief Sets the directory contract paths are resolved against.
+   * 
+   * @param root Data root directory; empty restores the default
+   * 
+   * The default root is taken from the `ALCHEMATH_DATA_ROOT` environment
+   * variable, falling back to the development checkout path. Changing the
+   * root invalidates previously resolved ContractId paths for new lookups.
+   */
+  static void set_data_root(const std::string &root);
+
+  /**
+   * @brief Returns the current data root, always ending in '/'.
+   */
+  static std::string data_root();
+
+  /**
+   * @brief Resolves the CSV path of an interned contract.
+   * 
+   * @param id The packed contract identity
+   * @return const std::string& The contract's CSV path
+   * 
+   * Paths are built once per contract and then served from a table keyed
+   * by ContractId, so repeated loads do no string concatenation. The
+   * returned reference stays valid for the lifetime of the process.
+   */
+  static const std::string &find_contract_csv(ContractId id);
 };
 
 /**
@@ -57,8 +90,10 @@ class PathFinder {
  * library parsing functions.
  *
  * Expected CSV format:
- * - Columns: timestamp, close, open, high, low, volume
- * - Timestamp format: ISO date string (YYYY-MM-DD HH:MM:SS)
+ * - Columns: timestamp, close, open, high, low, volume (csv::DefaultSchema;
+ *   read_csv_detect accepts any layout in CsvSchemaRegistry)
+ * - Timestamp format: ISO date string (YYYY-MM-DD HH:MM:SS), stored as
+ *   milliseconds since epoch
  * - Numeric precision: Double precision floating point
  * - Optional header row
  *
@@ -75,86 +110,89 @@ class PathFinder {
  * ```
  */
 class ContractCsvReader {
- private:
+ public:
   /**
-   * @brief Fast string-to-double conversion optimized for CSV parsing.
-   * 
-   * @param start Pointer to the start of the number string
-   * @param end Pointer to one past the end of the number string
-   * @return double The parsed double value
+   * @brief Reads CSV data using memory-mapped file I/O.
    * 
-   * Custom implementation that avoids locale-dependent parsing and
-   * provides better performance than std::stod for CSV data.
-   */
-  inline double fast_stod(const char *start, const char *end);
-
-  /**
-   * @brief Fast string-to-long-long conversion for timestamp parsing.
+   * @param filename Path to the CSV file to read
+   * @param data TimeSeries object to populate with parsed data
+   * @param has_header Whether the CSV file contains a header row (default: true)
+   * @param policy Readahead hints for the mapping (default: by file size)
+   * @param errors Receives rejected rows in ParseMode::kValidate (optional)
+   * @param columns Columns to parse now (default: all)
+   * @return bool True if reading was successful, false on error
    * 
-   * @param start Pointer to the start of the number string
-   * @param end Pointer to one past the end of the number string
-   * @return long long The parsed integer value
+   * Memory-mapped I/O provides the best performance for large files by mapping
+   * the entire file into virtual memory. This avoids copying data and allows
+   * the OS to optimize memory access patterns.
    * 
-   * Optimized for parsing Unix timestamps and other integer values
-   * commonly found in financial data files.
-   */
-  inline long long fast_stoll(const char *start, const char *end);
-
-  /**
-   * @brief Parses timestamp strings into std::time_t values.
+   * Malformed rows are skipped whole, so all columns always have the same
+   * length. Use `read_csv_mmap<ParseMode::kValidate>` to find out which rows
+   * were dropped and why.
    * 
-   * @param start Pointer to the start of the timestamp string
-   * @param end Pointer to one past the end of the timestamp string
-   * @return std::time_t The parsed timestamp
+   * Columns outside `columns` are stepped over by the delimiter scan and
+   * parsed only when first accessed; the mapping stays open until then.
+   * Spread studies that only read closes pass `SeriesColumn::kClose`.
    * 
-   * Supports multiple timestamp formats commonly used in financial data:
-   * - Unix timestamps (seconds since epoch)
-   * - ISO 8601 date strings
-   * - Custom date formats
+   * @note This method may use significant virtual memory for very large files.
    */
-  inline std::time_t parse_timestamp(const char *start, const char *end);
+  template <ParseMode Mode = ParseMode::kFast>
+  bool read_csv_mmap(const std::string &filename, TimeSeries &data,
+                     bool has_header = true,
+                     ReadaheadPolicy policy = ReadaheadPolicy::kAuto,
+                     std::vector<ParseError> *errors = nullptr,
+                     ColumnMask columns = SeriesColumn::kAll);
 
   /**
-   * @brief Finds the next occurrence of a delimiter character.
+   * @brief Parses CSV data that is already in memory.
    * 
-   * @param start Pointer to start searching from
-   * @param end Pointer to the end of the search range
-   * @param delimiter The character to search for (typically ',' or '\t')
-   * @return const char* Pointer to the delimiter, or end if not found
+   * @param file_data Pointer to the first byte of the CSV contents
+   * @param file_size Number of bytes in the buffer
+   * @param data TimeSeries object to populate with parsed data
+   * @param has_header Whether the buffer starts with a header row (default: true)
+   * @param errors Receives rejected rows in ParseMode::kValidate (optional)
+   * @return bool True if parsing was successful
    * 
-   * Optimized for CSV parsing with minimal overhead.
+   * Same parser as read_csv_mmap, for callers that obtained the bytes
+   * themselves (e.g. the bulk loader).
    */
-  inline const char *find_delimiter(const char *start, const char *end,
-                                    char delimiter);
+  template <ParseMode Mode = ParseMode::kFast>
+  bool parse_csv_buffer(const char *file_data, size_t file_size,
+                        TimeSeries &data, bool has_header = true,
+                        std::vector<ParseError> *errors = nullptr);
 
   /**
-   * @brief Skips the header row in CSV data.
-   * 
-   * @param data Pointer to the start of the CSV data
-   * @param end Pointer to the end of the CSV data
-   * @return const char* Pointer to the start of the first data row
+   * @brief Parses an in-memory CSV file whose layout is given by its header.
    * 
-   * Efficiently locates the first newline character to skip header information.
+   * @param file_data Pointer to the first byte of the CSV contents
+   * @param file_size Number of bytes in the buffer
+   * @param data TimeSeries object to populate with parsed data
+   * @param mode Fast or validating parser
+   * @param errors Receives rejected rows in ParseMode::kValidate (optional)
+   * @param columns Columns to parse now (default: all)
+   * @param owner Keeps the buffer alive so other columns can be deferred
+   * @return bool True if parsing was successful
+   * 
+   * The header row selects a layout from CsvSchemaRegistry (vendor column
+   * orders, an extra open interest column, ...). A header that matches no
+   * registered layout is parsed as the default AlcheMath layout.
    */
-  inline const char *skip_header(const char *data, const char *end);
+  bool parse_csv_detect(const char *file_data, size_t file_size,
+                        TimeSeries &data, ParseMode mode = ParseMode::kFast,
+                        std::vector<ParseError> *errors = nullptr,
+                        ColumnMask columns = SeriesColumn::kAll,
+                        std::shared_ptr<const void> owner = nullptr);
 
- public:
   /**
-   * @brief Reads CSV data using memory-mapped file I/O.
+   * @brief Memory-maps a CSV file and parses it with parse_csv_detect.
    * 
-   * @param filename Path to the CSV file to read
-   * @param data TimeSeries object to populate with parsed data
-   * @param has_header Whether the CSV file contains a header row (default: true)
-   * @return bool True if reading was successful, false on error
-   * 
-   * Memory-mapped I/O provides the best performance for large files by mapping
-   * the entire file into virtual memory. This avoids copying data and allows
-   * the OS to optimize memory access patterns.
-   * 
-   * @note This method may use significant virtual memory for very large files.
+   * Columns outside `columns` are deferred as in read_csv_mmap.
    */
-  bool read_csv_mmap(const std::string &filename, TimeSeries &data,
-                     bool has_header = true);
+  bool read_csv_detect(const std::string &filename, TimeSeries &data,
+                       ParseMode mode = ParseMode::kFast,
+                       ReadaheadPolicy policy = ReadaheadPolicy::kAuto,
+                       std::vector<ParseError> *errors = nullptr,
+                       ColumnMask columns = SeriesColumn::kAll);
 
   /**
    * @brief Reads CSV data using traditional stream-based I/O.
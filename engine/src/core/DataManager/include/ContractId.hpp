@@ -0,0 +1,158 @@
+/**
+ * @file ContractId.hpp
+ * @brief Compact integer identity for futures contracts.
+ *
+ * `Contract` carries its symbol as a `std::string`, which makes it costly to
+ * hash and compare on hot paths. This file provides a process-wide symbol
+ * interning table and a packed 32-bit ContractId so caches, joins and sweep
+ * grids can key on integers.
+ */
+
+#ifndef CONTRACT_ID_HPP
+#define CONTRACT_ID_HPP
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Contract.hpp"
+
+/**
+ * @class SymbolTable
+ * @brief Thread-safe interning table mapping commodity symbols to indices.
+ *
+ * Indices are dense, start at zero and never change for the lifetime of the
+ * process. Interned strings have stable addresses.
+ */
+class SymbolTable {
+ public:
+  /**
+   * @brief Returns the process-wide table.
+   */
+  static SymbolTable &Instance();
+
+  /**
+   * @brief Returns the index of `symbol`, adding it on first use.
+   * @throws std::length_error once 65536 symbols are interned
+   */
+  uint16_t Intern(std::string_view symbol);
+
+  /**
+   * @brief Returns the index of an interned `symbol` without adding it.
+   */
+  std::optional<uint16_t> Find(std::string_view symbol) const;
+
+  /**
+   * @brief Returns the symbol of an interned index.
+   * @throws std::out_of_range for an unknown index
+   */
+  const std::string &Symbol(uint16_t index) const;
+
+  /**
+   * @brief Number of interned symbols.
+   */
+  size_t Size() const;
+
+ private:
+  SymbolTable() = default;
+
+  mutable std::shared_mutex mutex_;
+  std::deque<std::string> symbols_;
+  std::unordered_map<std::string_view, uint16_t> index_;
+};
+
+/**
+ * @class ContractId
+ * @brief Packed (symbol index, expiration year, expiration month) identity.
+ *
+ * Bit layout, most significant first: 16 bits symbol index, 12 bits year
+ * offset from 1900, 4 bits ExpirationMonth. Integer order therefore groups
+ * contracts by symbol index, then sorts them chronologically by expiry.
+ * Symbol indices are handed out in first-seen order, so the order between
+ * symbols is not alphabetical and differs between processes; neither it nor
+ * Raw() may be persisted or compared across processes.
+ *
+ * @example
+ * ```cpp
+ * ContractId id = ContractId::FromContract({"ZC", ExpirationMonth::H, 2025});
+ * std::unordered_map<ContractId, TimeSeries> cache;
+ * cache[id] = DataManager::loadContractData(id.ToContract());
+ * ```
+ */
+class ContractId {
+ public:
+  static constexpr int kBaseYear = 1900;
+  static constexpr int kMaxYear = kBaseYear + 0xFFF;
+
+  constexpr ContractId() = default;
+
+  /**
+   * @brief Packs already-interned components.
+   * @throws std::out_of_range if the year is outside [1900, 5995]
+   */
+  static constexpr ContractId Encode(uint16_t symbol_index,
+                                     ExpirationMonth month, int year) {
+    if (year < kBaseYear || year > kMaxYear) {
+      throw std::out_of_range("Contract year out of range");
+    }
+    return ContractId(static_cast<uint32_t>(symbol_index) << 16 |
+                      static_cast<uint32_t>(year - kBaseYear) << 4 |
+                      static_cast<uint32_t>(month));
+  }
+
+  /**
+   * @brief Interns the contract's symbol and packs the contract.
+   */
+  static ContractId FromContract(const Contract &contract) {
+    return Encode(SymbolTable::Instance().Intern(contract.symbol),
+                  contract.expirationMonth, contract.expirationYear);
+  }
+
+  /**
+   * @brief Rebuilds the Contract this id was created from.
+   */
+  Contract ToContract() const {
+    return {SymbolTable::Instance().Symbol(SymbolIndex()), Month(), Year()};
+  }
+
+  constexpr uint16_t SymbolIndex() const {
+    return static_cast<uint16_t>(packed_ >> 16);
+  }
+  constexpr ExpirationMonth Month() const {
+    return static_cast<ExpirationMonth>(packed_ & 0xF);
+  }
+  constexpr int Year() const {
+    return kBaseYear + static_cast<int>((packed_ >> 4) & 0xFFF);
+  }
+  constexpr uint32_t Raw() const { return packed_; }
+
+  constexpr bool operator==(ContractId o) const { return packed_ == o.packed_; }
+  constexpr bool operator!=(ContractId o) const { return packed_ != o.packed_; }
+  constexpr bool operator<(ContractId o) const { return packed_ < o.packed_; }
+  constexpr bool operator>(ContractId o) const { return packed_ > o.packed_; }
+  constexpr bool operator<=(ContractId o) const { return packed_ <= o.packed_; }
+  constexpr bool operator>=(ContractId o) const { return packed_ >= o.packed_; }
+
+ private:
+  constexpr explicit ContractId(uint32_t packed) : packed_(packed) {}
+
+  uint32_t packed_ = 0;
+};
+
+namespace std {
+template <>
+struct hash<ContractId> {
+  size_t operator()(ContractId id) const noexcept {
+    // Fibonacci hashing spreads the structured bits over the word
+    return static_cast<size_t>(id.Raw() * 0x9E3779B97F4A7C15ULL);
+  }
+};
+}  // namespace std
+
+#endif /* CONTRACT_ID_HPP */
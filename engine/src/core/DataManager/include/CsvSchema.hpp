@@ -0,0 +1,821 @@
+/**
+ * @file CsvSchema.hpp
+ * @brief Compile-time CSV column layouts and the parsers generated from them.
+ *
+ * A layout is a type list of column descriptors:
+ *
+ * ```cpp
+ * using VendorLayout = csv::Schema<csv::Timestamp, csv::Open, csv::High,
+ *                                  csv::Low, csv::Close, csv::Volume,
+ *                                  csv::OpenInterest>;
+ * ```
+ *
+ * `Schema<...>::ParseRow` expands into one straight-line sequence of
+ * delimiter searches and field conversions per layout, so the parser never
+ * branches on column type at run time. CsvSchemaRegistry maps header lines
+ * to the layouts instantiated in CsvSchema.cpp.
+ */
+
+#ifndef CSV_SCHEMA_HPP
+#define CSV_SCHEMA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "CivilDate.hpp"
+#include "TimeSeries.hpp"
+
+/**
+ * @enum ParseMode
+ * @brief Compile-time choice between the fast parser and a validating one.
+ *
+ * kFast only checks row structure (field count, timestamp length) and skips
+ * rows that fail it. kValidate additionally checks every field's syntax and
+ * logs each rejected row. The mode is a template parameter, so the fast
+ * instantiation contains none of the validation code.
+ */
+enum class ParseMode { kFast, kValidate };
+
+/**
+ * @enum ParseErrorReason
+ * @brief Why a row was rejected.
+ */
+enum class ParseErrorReason : uint8_t {
+  kMissingField,  ///< Fewer fields than the layout has columns
+  kExtraField,    ///< More fields than the layout has columns
+  kBadTimestamp,  ///< Not `YYYY-MM-DD HH:MM:SS` or out of range
+  kBadNumber      ///< Price or volume is not a number
+};
+
+/**
+ * @struct ParseError
+ * @brief One rejected row; 8 bytes so large error logs stay cheap.
+ */
+struct ParseError {
+  uint32_t line;            ///< 1-based line number in the file (header = 1)
+  ParseErrorReason reason;  ///< What was wrong with the row
+};
+
+/**
+ * @brief Returns a short human-readable description of a reason.
+ */
+const char *ParseErrorReasonToString(ParseErrorReason reason);
+
+namespace csv {
+
+/**
+ * @struct Row
+ * @brief Every value any layout can produce for one line.
+ */
+struct Row {
+  uint64_t timestamp = 0;
+  double open = 0.0;
+  double high = 0.0;
+  double low = 0.0;
+  double close = 0.0;
+  double volume = 0.0;
+  double open_interest = 0.0;
+  double settlement = 0.0;
+};
+
+// Field primitives ----------------------------------------------------------
+
+inline const char *FindDelimiter(const char *start, const char *end,
+                                 char delimiter) {
+  while (start < end && *start != delimiter) {
+    start++;
+  }
+  return start;
+}
+
+/**
+ * Locale-free decimal parser. Accumulates the fraction digit by digit, which
+ * is faster than std::strtod; results may differ from it in the last ulp.
+ */
+inline double ParseDecimal(const char *start, const char *end) {
+  double result = 0.0;
+  double sign = 1.0;
+  bool decimal = false;
+  double decimal_factor = 0.1;
+
+  if (start < end && *start == '-') {
+    sign = -1.0;
+    start++;
+  }
+
+  while (start < end) {
+    if (*start == '.') {
+      decimal = true;
+    } else if (*start >= '0' && *start <= '9') {
+      if (decimal) {
+        result += (*start - '0') * decimal_factor;
+        decimal_factor *= 0.1;
+      } else {
+        result = result * 10.0 + (*start - '0');
+      }
+    }
+    start++;
+  }
+
+  return result * sign;
+}
+
+inline long long ParseInteger(const char *start, const char *end) {
+  long long result = 0;
+  long long sign = 1;
+
+  if (start < end && *start == '-') {
+    sign = -1;
+    start++;
+  }
+
+  while (start < end && *start >= '0' && *start <= '9') {
+    result = result * 10 + (*start - '0');
+    start++;
+  }
+
+  return result * sign;
+}
+
+using ::DaysFromCivil;  // CivilDate.hpp
+
+constexpr size_t kTimestampWidth = 19;  // "YYYY-MM-DD HH:MM:SS"
+
+/**
+ * Parses the fixed-width `YYYY-MM-DD HH:MM:SS` layout into milliseconds
+ * since epoch. The wall-clock time is kept as is (no time zone or DST
+ * adjustment), so session boundaries stay at fixed times of day.
+ */
+inline uint64_t ParseTimestamp(const char *start) {
+  int year = (start[0] - '0') * 1000 + (start[1] - '0') * 100 +
+             (start[2] - '0') * 10 + (start[3] - '0');
+  int month = (start[5] - '0') * 10 + (start[6] - '0');
+  int day = (start[8] - '0') * 10 + (start[9] - '0');
+  int hour = (start[11] - '0') * 10 + (start[12] - '0');
+  int minute = (start[14] - '0') * 10 + (start[15] - '0');
+  int second = (start[17] - '0') * 10 + (start[18] - '0');
+
+  int64_t days = DaysFromCivil(year, month, day);
+  int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second;
+  return static_cast<uint64_t>(seconds) * 1000;
+}
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline int TwoDigits(const char *p) {
+  return (p[0] - '0') * 10 + (p[1] - '0');
+}
+
+// Strict `YYYY-MM-DD HH:MM:SS` with calendar-plausible field ranges.
+inline bool ValidTimestamp(const char *start, const char *end) {
+  static constexpr char kLayout[] = "dddd-dd-dd dd:dd:dd";
+  if (static_cast<size_t>(end - start) != kTimestampWidth) return false;
+  for (size_t i = 0; i < kTimestampWidth; ++i) {
+    if (kLayout[i] == 'd' ? !IsDigit(start[i]) : start[i] != kLayout[i]) {
+      return false;
+    }
+  }
+  const int month = TwoDigits(start + 5);
+  const int day = TwoDigits(start + 8);
+  return month >= 1 && month <= 12 && day >= 1 && day <= 31 &&
+         TwoDigits(start + 11) < 24 && TwoDigits(start + 14) < 60 &&
+         TwoDigits(start + 17) < 60;
+}
+
+// Optional '-', digits, at most one '.', at least one digit.
+inline bool ValidDecimal(const char *start, const char *end) {
+  if (start < end && *start == '-') ++start;
+  bool digits = false;
+  bool point = false;
+  for (; start < end; ++start) {
+    if (IsDigit(*start)) {
+      digits = true;
+    } else if (*start == '.' && !point) {
+      point = true;
+    } else {
+      return false;
+    }
+  }
+  return digits;
+}
+
+inline bool ValidInteger(const char *start, const char *end) {
+  if (start == end) return false;
+  for (; start < end; ++start) {
+    if (!IsDigit(*start)) return false;
+  }
+  return true;
+}
+
+/**
+ * Case-insensitive comparison of a trimmed header token with a name.
+ */
+inline bool HeaderIs(std::string_view token, std::string_view name) {
+  if (token.size() != name.size()) return false;
+  for (size_t i = 0; i < token.size(); ++i) {
+    char c = token[i];
+    if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    if (c == ' ' || c == '-') c = '_';
+    if (c != name[i]) return false;
+  }
+  return true;
+}
+
+// Column descriptors --------------------------------------------------------
+//
+// Each descriptor provides:
+//   kName                      canonical header name
+//   kBit                       SeriesColumn bit (0 = not a series column)
+//   Accepts(token)             whether a header token names this column
+//   Parse<Mode>(b, e, row, r)  converts one field into `row`
+
+/**
+ * @struct Timestamp
+ * @brief `YYYY-MM-DD HH:MM:SS` wall-clock time.
+ */
+struct Timestamp {
+  static constexpr const char *kName = "timestamp";
+  static constexpr ColumnMask kBit = 0;  // Always parsed
+
+  static bool Accepts(std::string_view token) {
+    return HeaderIs(token, "timestamp") || HeaderIs(token, "datetime") ||
+           HeaderIs(token, "date_time") || HeaderIs(token, "date") ||
+           HeaderIs(token, "time");
+  }
+
+  template <ParseMode Mode>
+  static bool Parse(const char *start, const char *end, Row &row,
+                    ParseErrorReason &reason) {
+    // ParseTimestamp reads fixed positions, so the length check is kept
+    // even on the fast path
+    if (Mode == ParseMode::kValidate
+            ? !ValidTimestamp(start, end)
+            : static_cast<size_t>(end - start) < kTimestampWidth) {
+      reason = ParseErrorReason::kBadTimestamp;
+      return false;
+    }
+    row.timestamp = ParseTimestamp(start);
+    return true;
+  }
+};
+
+/**
+ * @brief Decimal column stored in `Row::*Member`.
+ */
+template <double Row::*Member>
+struct DecimalColumn {
+  template <ParseMode Mode>
+  static bool Parse(const char *start, const char *end, Row &row,
+                    ParseErrorReason &reason) {
+    if (Mode == ParseMode::kValidate && !ValidDecimal(start, end)) {
+      reason = ParseErrorReason::kBadNumber;
+      return false;
+    }
+    row.*Member = ParseDecimal(start, end);
+    return true;
+  }
+
+  static double Value(const Row &row) { return row.*Member; }
+};
+
+/**
+ * @brief Non-negative integer column stored in `Row::*Member`.
+ */
+template <double Row::*Member>
+struct IntegerColumn {
+  template <ParseMode Mode>
+  static bool Parse(const char *start, const char *end, Row &row,
+                    ParseErrorReason &reason) {
+    if (Mode == ParseMode::kValidate && !ValidInteger(start, end)) {
+      reason = ParseErrorReason::kBadNumber;
+      return false;
+    }
+    row.*Member = static_cast<double>(ParseInteger(start, end));
+    return true;
+  }
+
+  static double Value(const Row &row) { return row.*Member; }
+};
+
+struct Open : DecimalColumn<&Row::open> {
+  static constexpr const char *kName = "open";
+  static constexpr ColumnMask kBit = SeriesColumn::kOpen;
+  static bool Accepts(std::string_view t) {
+    return HeaderIs(t, "open") || HeaderIs(t, "o");
+  }
+};
+
+struct High : DecimalColumn<&Row::high> {
+  static constexpr const char *kName = "high";
+  static constexpr ColumnMask kBit = SeriesColumn::kHigh;
+  static bool Accepts(std::string_view t) {
+    return HeaderIs(t, "high") || HeaderIs(t, "h");
+  }
+};
+
+struct Low : DecimalColumn<&Row::low> {
+  static constexpr const char *kName = "low";
+  static constexpr ColumnMask kBit = SeriesColumn::kLow;
+  static bool Accepts(std::string_view t) {
+    return HeaderIs(t, "low") || HeaderIs(t, "l");
+  }
+};
+
+struct Close : DecimalColumn<&Row::close> {
+  static constexpr const char *kName = "close";
+  static constexpr ColumnMask kBit = SeriesColumn::kClose;
+  static bool Accepts(std::string_view t) {
+    return HeaderIs(t, "close") || HeaderIs(t, "c") || HeaderIs(t, "last");
+  }
+};
+
+struct Volume : IntegerColumn<&Row::volume> {
+  static constexpr const char *kName = "volume";
+  static constexpr ColumnMask kBit = SeriesColumn::kVolume;
+  static bool Accepts(std::string_view t) {
+    return HeaderIs(t, "volume") || HeaderIs(t, "vol") || HeaderIs(t, "v");
+  }
+};
+
+struct OpenInterest : IntegerColumn<&Row::open_interest> {
+  static constexpr const char *kName = "open_interest";
+  static constexpr ColumnMask kBit = SeriesColumn::kOpenInterest;
+  static bool Accepts(std::string_view t) {
+    return HeaderIs(t, "open_interest") || HeaderIs(t, "openinterest") ||
+           HeaderIs(t, "oi");
+  }
+};
+
+struct Settlement : DecimalColumn<&Row::settlement> {
+  static constexpr const char *kName = "settlement";
+  static constexpr ColumnMask kBit = SeriesColumn::kSettlement;
+  static bool Accepts(std::string_view t) {
+    return HeaderIs(t, "settlement") || HeaderIs(t, "settlement_price") ||
+           HeaderIs(t, "settle");
+  }
+};
+
+/**
+ * @struct Skip
+ * @brief A column whose contents are ignored; matches any header token.
+ */
+struct Skip {
+  static constexpr const char *kName = "*";
+  static constexpr ColumnMask kBit = 0;
+  static bool Accepts(std::string_view) { return true; }
+
+  template <ParseMode Mode>
+  static bool Parse(const char *, const char *, Row &, ParseErrorReason &) {
+    return true;
+  }
+};
+
+// Row and buffer parsers ----------------------------------------------------
+
+// Converts one field unless it is outside `columns`. Numeric fields never
+// reject a row in kFast, so skipping them keeps the accepted rows identical;
+// kValidate still checks every field.
+template <ParseMode Mode, typename Column>
+inline bool ParseField(const char *start, const char *end, Row &row,
+                       ParseErrorReason &reason, ColumnMask columns) {
+  if (Mode == ParseMode::kFast && Column::kBit != 0 &&
+      !(columns & Column::kBit)) {
+    return true;
+  }
+  return Column::template Parse<Mode>(start, end, row, reason);
+}
+
+template <ParseMode Mode, typename First, typename... Rest>
+inline bool ParseFields(const char *current, const char *end, Row &row,
+                        ParseErrorReason &reason, ColumnMask columns) {
+  if constexpr (sizeof...(Rest) == 0) {
+    // Last column runs to the end of the line
+    if constexpr (Mode == ParseMode::kValidate) {
+      if (FindDelimiter(current, end, ',') != end) {
+        reason = ParseErrorReason::kExtraField;
+        return false;
+      }
+    }
+    return ParseField<Mode, First>(current, end, row, reason, columns);
+  } else {
+    const char *field_end = FindDelimiter(current, end, ',');
+    if (field_end >= end) {
+      reason = ParseErrorReason::kMissingField;
+      return false;
+    }
+    if (!ParseField<Mode, First>(current, field_end, row, reason, columns)) {
+      return false;
+    }
+    return ParseFields<Mode, Rest...>(field_end + 1, end, row, reason,
+                                      columns);
+  }
+}
+
+/**
+ * @struct Schema
+ * @brief A column layout and the parsers generated for it.
+ *
+ * Core columns missing from the layout are filled so every TimeSeries
+ * column keeps the same length: open, high and low default to the close,
+ * volume to zero. OpenInterest and Settlement go to the series' optional
+ * columns of the same name, which exist only if the layout has them.
+ */
+template <typename... Columns>
+struct Schema {
+  static_assert(sizeof...(Columns) > 0, "A schema needs at least one column");
+  static_assert((std::is_same_v<Columns, Timestamp> || ...),
+                "A schema needs a Timestamp column");
+  static_assert((std::is_same_v<Columns, Close> || ...),
+                "A schema needs a Close column");
+
+  static constexpr size_t kColumns = sizeof...(Columns);
+
+  template <typename Column>
+  static constexpr bool kHas = (std::is_same_v<Columns, Column> || ...);
+
+  /**
+   * @brief Canonical header names in column order.
+   */
+  static std::vector<std::string_view> Names() { return {Columns::kName...}; }
+
+  /**
+   * @brief True if the header tokens name this layout's columns in order.
+   */
+  static bool MatchesHeader(const std::vector<std::string_view> &tokens) {
+    if (tokens.size() != kColumns) return false;
+    size_t i = 0;
+    return (Columns::Accepts(tokens[i++]) && ...);
+  }
+
+  /// Columns a series parsed with this layout has.
+  static constexpr ColumnMask kProvided =
+      SeriesColumn::kOpen | SeriesColumn::kHigh | SeriesColumn::kLow |
+      SeriesColumn::kClose | SeriesColumn::kVolume |
+      (kHas<OpenInterest> ? SeriesColumn::kOpenInterest : 0) |
+      (kHas<Settlement> ? SeriesColumn::kSettlement : 0);
+
+  /**
+   * @brief Position of a column in the layout, or kColumns if absent.
+   */
+  template <typename Column>
+  static constexpr size_t IndexOf() {
+    constexpr bool kSame[] = {std::is_same_v<Columns, Column>...};
+    for (size_t i = 0; i < kColumns; ++i) {
+      if (kSame[i]) return i;
+    }
+    return kColumns;
+  }
+
+  /**
+   * @brief Fields that must be converted to fill `columns`; open, high and
+   *        low missing from the layout are copies of the close.
+   */
+  static constexpr ColumnMask FieldsFor(ColumnMask columns) {
+    const ColumnMask from_close =
+        (kHas<Open> ? 0 : SeriesColumn::kOpen) |
+        (kHas<High> ? 0 : SeriesColumn::kHigh) |
+        (kHas<Low> ? 0 : SeriesColumn::kLow);
+    return (columns & from_close) ? columns | SeriesColumn::kClose : columns;
+  }
+
+  /**
+   * @brief Parses one line (without its terminator).
+   *
+   * @param columns Fields outside this mask are skipped in kFast mode
+   */
+  template <ParseMode Mode>
+  static bool ParseRow(const char *current, const char *end, Row &row,
+                       ParseErrorReason &reason,
+                       ColumnMask columns = SeriesColumn::kAll) {
+    return ParseFields<Mode, Columns...>(current, end, row, reason, columns);
+  }
+
+  /**
+   * @brief The columns of a series that rows are appended to.
+   */
+  struct Target {
+    TimeSeries *data;
+    std::vector<double> *open_interest;
+    std::vector<double> *settlement;
+    ColumnMask columns;  ///< Columns appended to; the rest are deferred
+  };
+
+  /**
+   * @brief Clears `data`, reserves `capacity` rows in the loaded columns
+   *        and adds the optional columns this layout provides.
+   */
+  static Target Prepare(TimeSeries &data, size_t capacity,
+                        ColumnMask columns = SeriesColumn::kAll) {
+    data.clear();
+    if constexpr (kHas<OpenInterest>) {
+      data.AddColumn(TimeSeries::kOpenInterest);
+    }
+    if constexpr (kHas<Settlement>) {
+      data.AddColumn(TimeSeries::kSettlement);
+    }
+    // Looked up after all AddColumn() calls, which may move the columns
+    Target target{&data, data.FindColumn(TimeSeries::kOpenInterest),
+                  data.FindColumn(TimeSeries::kSettlement),
+                  columns & kProvided};
+    data.Timestamps().reserve(capacity);
+    if (target.columns & SeriesColumn::kOpen) data.Opens().reserve(capacity);
+    if (target.columns & SeriesColumn::kHigh) data.Highs().reserve(capacity);
+    if (target.columns & SeriesColumn::kLow) data.Lows().reserve(capacity);
+    if (target.columns & SeriesColumn::kClose) data.Closes().reserve(capacity);
+    if (target.columns & SeriesColumn::kVolume) {
+      data.Volumes().reserve(capacity);
+    }
+    if (target.columns & SeriesColumn::kOpenInterest) {
+      target.open_interest->reserve(capacity);
+    }
+    if (target.columns & SeriesColumn::kSettlement) {
+      target.settlement->reserve(capacity);
+    }
+    return target;
+  }
+
+  /**
+   * @brief Appends a parsed row to the loaded columns of the series.
+   */
+  static void Append(const Row &row, const Target &target) {
+    TimeSeries &data = *target.data;
+    const ColumnMask columns = target.columns;
+    data.Timestamps().push_back(row.timestamp);
+    if (columns == kProvided) {
+      // Everything loaded: no per-column tests
+      data.Closes().push_back(row.close);
+      data.Opens().push_back(kHas<Open> ? row.open : row.close);
+      data.Highs().push_back(kHas<High> ? row.high : row.close);
+      data.Lows().push_back(kHas<Low> ? row.low : row.close);
+      data.Volumes().push_back(kHas<Volume> ? row.volume : 0.0);
+      if constexpr (kHas<OpenInterest>) {
+        target.open_interest->push_back(row.open_interest);
+      }
+      if constexpr (kHas<Settlement>) {
+        target.settlement->push_back(row.settlement);
+      }
+      return;
+    }
+    if (columns & SeriesColumn::kClose) data.Closes().push_back(row.close);
+    if (columns & SeriesColumn::kOpen) {
+      data.Opens().push_back(kHas<Open> ? row.open : row.close);
+    }
+    if (columns & SeriesColumn::kHigh) {
+      data.Highs().push_back(kHas<High> ? row.high : row.close);
+    }
+    if (columns & SeriesColumn::kLow) {
+      data.Lows().push_back(kHas<Low> ? row.low : row.close);
+    }
+    if (columns & SeriesColumn::kVolume) {
+      data.Volumes().push_back(kHas<Volume> ? row.volume : 0.0);
+    }
+    if (columns & SeriesColumn::kOpenInterest) {
+      target.open_interest->push_back(row.open_interest);
+    }
+    if (columns & SeriesColumn::kSettlement) {
+      target.settlement->push_back(row.settlement);
+    }
+  }
+
+  /**
+   * @class Deferred
+   * @brief Converts skipped columns from the retained file bytes.
+   *
+   * Keeps one offset per accepted row (8 bytes) instead of the skipped
+   * columns' values (8 bytes each).
+   */
+  class Deferred : public DeferredColumns {
+   public:
+    Deferred(const char *data, size_t size, std::shared_ptr<const void> owner,
+             std::vector<uint64_t> rows)
+        : data_(data), end_(data + size), owner_(std::move(owner)),
+          rows_(std::move(rows)) {}
+
+    void Materialize(ColumnMask column, double *out) const override {
+      switch (column) {
+        case SeriesColumn::kOpen:
+          return Fill<std::conditional_t<kHas<Open>, Open, Close>>(out);
+        case SeriesColumn::kHigh:
+          return Fill<std::conditional_t<kHas<High>, High, Close>>(out);
+        case SeriesColumn::kLow:
+          return Fill<std::conditional_t<kHas<Low>, Low, Close>>(out);
+        case SeriesColumn::kClose:
+          return Fill<Close>(out);
+        case SeriesColumn::kVolume:
+          if constexpr (kHas<Volume>) return Fill<Volume>(out);
+          std::fill(out, out + rows_.size(), 0.0);
+          return;
+        case SeriesColumn::kOpenInterest:
+          if constexpr (kHas<OpenInterest>) Fill<OpenInterest>(out);
+          return;
+        case SeriesColumn::kSettlement:
+          if constexpr (kHas<Settlement>) Fill<Settlement>(out);
+          return;
+      }
+    }
+
+   private:
+    template <typename Column>
+    void Fill(double *out) const {
+      constexpr size_t kIndex = IndexOf<Column>();
+      static_assert(kIndex < kColumns, "Column is not in the layout");
+      Row row;
+      ParseErrorReason reason;
+      for (size_t i = 0; i < rows_.size(); ++i) {
+        const char *start = data_ + rows_[i];
+        for (size_t field = 0; field < kIndex; ++field) {
+          start = FindDelimiter(start, end_, ',') + 1;
+        }
+        const char *field_end;
+        if constexpr (kIndex + 1 < kColumns) {
+          field_end = FindDelimiter(start, end_, ',');
+        } else {
+          field_end = static_cast<const char *>(
+              std::memchr(start, '\n', end_ - start));
+          if (!field_end) field_end = end_;
+          if (field_end > start && *(field_end - 1) == '\r') field_end--;
+        }
+        Column::template Parse<ParseMode::kFast>(start, field_end, row,
+                                                  reason);
+        out[i] = Column::Value(row);
+      }
+    }
+
+    const char *data_;
+    const char *end_;
+    std::shared_ptr<const void> owner_;  ///< Keeps data_ alive
+    std::vector<uint64_t> rows_;         ///< Offset of each accepted row
+  };
+
+  /**
+   * @brief Parses a whole CSV buffer into `data`.
+   *
+   * @param columns Columns to convert now (default: all)
+   * @param owner Keeps the buffer alive for deferred columns
+   *
+   * Rows are bounded by their newline and committed whole, so a malformed
+   * row never leaves the columns with different lengths. In kValidate mode
+   * every rejected row is appended to `errors` (if given).
+   *
+   * Columns outside `columns` are skipped by the delimiter scan and parsed
+   * on first access (TimeSeries::SetDeferredColumns). Deferral needs an
+   * `owner` that keeps the buffer valid; without one every column is
+   * parsed.
+   */
+  template <ParseMode Mode>
+  static bool Parse(const char *file_data, size_t file_size, TimeSeries &data,
+                    bool has_header, std::vector<ParseError> *errors,
+                    ColumnMask columns = SeriesColumn::kAll,
+                    std::shared_ptr<const void> owner = nullptr) {
+    const char *current = file_data;
+    const char *end = file_data + file_size;
+
+    if (!owner) columns = SeriesColumn::kAll;
+    const ColumnMask deferred = kProvided & ~columns;
+    const ColumnMask fields = FieldsFor(columns);
+    std::vector<uint64_t> rows;
+
+    // Rough estimate of number of rows for pre-allocation
+    const Target target = Prepare(data, file_size / 60, columns);
+    if (deferred) rows.reserve(file_size / 60);
+
+    uint32_t line = 1;
+    Row row;
+    ParseErrorReason reason;
+    for (; current < end; ++line) {
+      const char *line_end = static_cast<const char *>(
+          std::memchr(current, '\n', end - current));
+      if (!line_end) line_end = end;
+      const char *next = line_end + 1;
+      if (line_end > current && *(line_end - 1) == '\r') line_end--;
+
+      if (has_header && line == 1) {
+        // Header row
+      } else if (line_end > current) {
+        if (ParseRow<Mode>(current, line_end, row, reason, fields)) {
+          Append(row, target);
+          if (deferred) rows.push_back(current - file_data);
+        } else if (Mode == ParseMode::kValidate && errors) {
+          errors->push_back({line, reason});
+        }
+      }
+      current = next;
+    }
+
+    if (deferred) {
+      data.SetDeferredColumns(
+          std::make_shared<Deferred>(file_data, file_size, std::move(owner),
+                                     std::move(rows)),
+          deferred);
+    }
+    return true;
+  }
+};
+
+/**
+ * @brief The AlcheMath contract file layout.
+ */
+using DefaultSchema = Schema<Timestamp, Close, Open, High, Low, Volume>;
+
+/**
+ * @brief Splits a header line into trimmed, unquoted tokens.
+ */
+std::vector<std::string_view> SplitHeader(std::string_view header);
+
+}  // namespace csv
+
+/**
+ * @class CsvSchemaRegistry
+ * @brief Runtime selection among the compiled CSV layouts by header line.
+ *
+ * Built-in layouts:
+ * - `alchemath`: timestamp, close, open, high, low, volume
+ * - `alchemath_oi`: the above plus open interest
+ * - `ohlcv`: timestamp, open, high, low, close, volume
+ * - `ohlcv_oi`: the above plus open interest
+ * - `ohlcv_settle_oi`: timestamp, open, high, low, close, settlement,
+ *   volume, open interest
+ *
+ * @example
+ * ```cpp
+ * CsvSchemaRegistry::Instance().Register<
+ *     csv::Schema<csv::Timestamp, csv::Skip, csv::Close, csv::Volume>>(
+ *     "vendor_x");
+ * ```
+ */
+class CsvSchemaRegistry {
+ public:
+  using ParseFn = bool (*)(const char *, size_t, TimeSeries &, bool,
+                           std::vector<ParseError> *, ColumnMask,
+                           std::shared_ptr<const void>);
+  using MatchFn = bool (*)(const std::vector<std::string_view> &);
+
+  /**
+   * @brief A registered layout with its fast and validating parsers.
+   */
+  struct Layout {
+    std::string name;
+    std::vector<std::string_view> columns;
+    MatchFn matches;
+    ParseFn parse_fast;
+    ParseFn parse_validate;
+  };
+
+  /**
+   * @brief Returns the process-wide registry with the built-in layouts.
+   */
+  static CsvSchemaRegistry &Instance();
+
+  /**
+   * @brief Adds a layout; later registrations take precedence.
+   *
+   * Not thread-safe with concurrent lookups; register layouts at startup.
+   */
+  template <typename SchemaT>
+  void Register(std::string name) {
+    layouts_.insert(layouts_.begin(),
+                    Layout{std::move(name), SchemaT::Names(),
+                           &SchemaT::MatchesHeader,
+                           &SchemaT::template Parse<ParseMode::kFast>,
+                           &SchemaT::template Parse<ParseMode::kValidate>});
+  }
+
+  /**
+   * @brief Finds the layout whose columns match a header line.
+   * @return const Layout* The layout, or nullptr if none matches
+   */
+  const Layout *Match(std::string_view header) const;
+
+  /**
+   * @brief Finds a layout by name, or nullptr.
+   */
+  const Layout *Find(std::string_view name) const;
+
+  /**
+   * @brief Parses a buffer whose first line is a header.
+   * @param columns Columns to convert now; see csv::Schema::Parse
+   * @param owner Keeps the buffer alive for deferred columns
+   * @return bool False if no layout matches the header
+   */
+  bool Parse(const char *data, size_t size, TimeSeries &series,
+             ParseMode mode = ParseMode::kFast,
+             std::vector<ParseError> *errors = nullptr,
+             ColumnMask columns = SeriesColumn::kAll,
+             std::shared_ptr<const void> owner = nullptr) const;
+
+  const std::vector<Layout> &Layouts() const { return layouts_; }
+
+ private:
+  CsvSchemaRegistry();
+
+  std::vector<Layout> layouts_;
+};
+
+#endif /* CSV_SCHEMA_HPP */
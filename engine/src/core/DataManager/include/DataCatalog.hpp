@@ -0,0 +1,140 @@
+/**
+ * @file DataCatalog.hpp
+ * @brief In-memory index of the contract files available under data roots.
+ *
+ * The catalog scans one or more data roots once, records every contract file
+ * with its size and modification time, and from then on answers existence
+ * and expiry queries without touching the filesystem. An optional inotify
+ * watcher keeps the index current as files are added, rewritten or removed.
+ */
+
+#ifndef DATA_CATALOG_HPP
+#define DATA_CATALOG_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ContractId.hpp"
+
+/**
+ * @struct CatalogEntry
+ * @brief A contract file known to the catalog.
+ */
+struct CatalogEntry {
+  ContractId id;            ///< Contract stored in the file
+  std::string path;         ///< Absolute or root-relative file path
+  uint64_t size_bytes = 0;  ///< File size at the last scan or event
+  int64_t mtime_ns = 0;     ///< Modification time, ns since epoch
+};
+
+/**
+ * @class DataCatalog
+ * @brief Index of `{root}/{symbol}/{month_letter}/{year}.csv` files.
+ *
+ * When the same contract exists under several roots, the first root in the
+ * list wins. Within a root, a compressed `{year}.acz` file (see
+ * CompressedContractFile) is preferred over the CSV. All queries are
+ * thread-safe.
+ *
+ * @example
+ * ```cpp
+ * DataCatalog catalog({"/mnt/fast/contracts", "/mnt/archive/contracts"});
+ * catalog.StartWatching();
+ * for (ContractId id : catalog.Expiries("ZC")) {
+ *   std::cout << catalog.Find(id)->path << "\n";
+ * }
+ * ```
+ */
+class DataCatalog {
+ public:
+  /**
+   * @brief Scans the given roots. Missing roots are skipped.
+   */
+  explicit DataCatalog(std::vector<std::string> roots);
+  ~DataCatalog();
+
+  DataCatalog(const DataCatalog &) = delete;
+  DataCatalog &operator=(const DataCatalog &) = delete;
+
+  /**
+   * @brief Rebuilds the whole index from disk.
+   */
+  void Rescan();
+
+  /**
+   * @brief Looks up a contract without any filesystem call.
+   */
+  std::optional<CatalogEntry> Find(ContractId id) const;
+
+  /**
+   * @brief Returns every indexed expiry of a symbol, oldest first.
+   */
+  std::vector<ContractId> Expiries(std::string_view symbol) const;
+
+  /**
+   * @brief Number of indexed contract files.
+   */
+  size_t Size() const;
+
+  const std::vector<std::string> &Roots() const { return roots_; }
+
+  /**
+   * @brief Starts a background thread applying inotify events to the index.
+   * @return bool False if inotify is unavailable
+   */
+  bool StartWatching();
+
+  /**
+   * @brief Stops the watcher thread, if running.
+   */
+  void StopWatching();
+
+  /**
+   * @brief Applies all pending inotify events without blocking.
+   * @return size_t Number of index entries added, updated or removed
+   *
+   * Useful when the caller prefers to refresh at points of its choosing
+   * instead of running the watcher thread.
+   */
+  size_t PollChanges();
+
+ private:
+  struct Watch {
+    std::string dir;
+    int depth;  // 0 root, 1 symbol, 2 month
+    size_t root_rank;
+  };
+
+  void ScanRoot(size_t rank);
+  void ScanDir(const std::string &dir, int depth, size_t rank);
+  bool IndexFile(const std::string &path, size_t rank);
+  bool RemoveFile(const std::string &path);
+  void AddWatch(const std::string &dir, int depth, size_t rank);
+  size_t DrainEvents();
+  void WatchLoop();
+
+  std::vector<std::string> roots_;
+
+  // Serializes rescans and event draining; index readers only take mutex_.
+  std::mutex refresh_mutex_;
+  mutable std::shared_mutex mutex_;
+  std::map<ContractId, CatalogEntry> index_;
+  std::map<ContractId, size_t> rank_;  // 2 * root rank + (csv ? 1 : 0)
+
+  int inotify_fd_ = -1;
+  int wake_fd_ = -1;
+  std::unordered_map<int, Watch> watches_;
+  std::thread watcher_;
+  std::atomic<bool> watching_{false};
+};
+
+#endif /* DATA_CATALOG_HPP */
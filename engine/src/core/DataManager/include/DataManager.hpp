@@ -10,8 +10,17 @@
 #ifndef DATA_MANAGER_HPP
 #define DATA_MANAGER_HPP
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "Contract.hpp"
+#include "DataCatalog.hpp"
+#include "Resampler.hpp"
 #include "TimeSeries.hpp"
+#include "Workspace.hpp"
+
+class JobContext;
 
 /**
  * @class DataManager
@@ -49,6 +58,8 @@ class DataManager {
    * @brief Loads time series data for the specified contract.
    * 
    * @param contract The futures contract for which to load data
+   * @param columns Columns to parse up front; the others are parsed on
+   *        first access (CSV sources only, default: all)
    * @return TimeSeries The loaded time series data, or empty TimeSeries if loading fails
    * 
    * This method automatically:
@@ -59,6 +70,7 @@ class DataManager {
    * 
    * The method handles various data sources transparently:
    * - CSV files following standard naming conventions
+   * - Compressed `.acz` files, preferred by a configured DataCatalog
    * - Database connections for real-time data
    * - Cached data for frequently accessed contracts
    * 
@@ -70,9 +82,119 @@ class DataManager {
    *          an empty TimeSeries is returned. Check the result using
    *          `data.Timestamps().empty()` before processing.
    */
-  static TimeSeries loadContractData(const Contract& contract);
+  static TimeSeries loadContractData(const Contract& contract,
+                                     ColumnMask columns = SeriesColumn::kAll);
+
+  /**
+   * @brief Loads many contracts with batched I/O and parallel parsing.
+   * 
+   * @param contracts Contracts to load
+   * @param job Receives JobContext::kContractsLoaded progress and can
+   *        cancel the load (optional)
+   * @return std::vector<TimeSeries> One series per contract, in input order
+   * 
+   * Uses BulkLoader, which keeps opens and reads for all files in flight
+   * at once (io_uring where available) and parses finished files on a
+   * thread pool. Prefer this over a loop of loadContractData() when loading
+   * a commodity's whole history.
+   * 
+   * @throws std::runtime_error if any contract cannot be loaded
+   * @throws JobCancelled if the job was cancelled during the load
+   */
+  static std::vector<TimeSeries> loadContractsBulk(
+      const std::vector<Contract>& contracts, JobContext* job = nullptr);
+
+  /**
+   * @brief Loads a contract and aggregates it into bars of the given size.
+   * 
+   * @param contract The futures contract for which to load data
+   * @param bucket Target bar size and trading-session boundary
+   * @return TimeSeries The resampled bars
+   * 
+   * Resampled series are cached per contract and bucket, so daily studies
+   * pay for the minute-bar load and reduction only once per process. A
+   * cached series is rebuilt once contractDataVersion() changes. Misses are
+   * looked up in the attached workspace before loading.
+   * 
+   * @throws std::runtime_error if the contract data cannot be loaded
+   */
+  static TimeSeries loadResampledData(const Contract& contract,
+                                      const BarBucket& bucket);
+
+  /**
+   * @brief Drops every cached resampled series.
+   */
+  static void clearCache();
 
- private:
+  /**
+   * @brief Writes every cached resampled series into a workspace snapshot.
+   * 
+   * @param writer Workspace being written, typically on shutdown
+   * @return size_t Number of series written
+   */
+  static size_t snapshotWorkspace(WorkspaceWriter& writer);
+
+  /**
+   * @brief Serves resampled series from a workspace snapshot.
+   * 
+   * @param workspace Opened snapshot, or nullptr to detach
+   * 
+   * loadResampledData() consults the workspace on a cache miss and uses an
+   * entry only if it was built from the current contractDataVersion(), so a
+   * restarted process answers its first requests without reloading. Pages
+   * are read from the mapping only when an entry is first requested.
+   */
+  static void attachWorkspace(std::shared_ptr<const Workspace> workspace);
+
+  /**
+   * @brief Fingerprint of the file a contract is loaded from.
+   * 
+   * @param contract The futures contract
+   * @return uint64_t Changes whenever the file's path, size or modification
+   *         time changes; 0 if the contract has no readable file. Stable
+   *         across processes, so it can validate persisted results.
+   * 
+   * Caches of derived data store this alongside their results and discard
+   * them once it no longer matches. With data roots configured it is read
+   * from the catalog, so a rewritten file shows up once the catalog sees
+   * it (watcher, PollChanges() or Rescan()); otherwise it costs one stat().
+   */
+  static uint64_t contractDataVersion(const Contract& contract);
+
+  /**
+   * @brief Indexes the given data roots and resolves contracts through them.
+   * 
+   * @param roots Data roots in priority order
+   * @param watch Keep the index current through inotify
+   * 
+   * Once configured, contract lookups are answered from the in-memory
+   * DataCatalog and a missing contract fails without a filesystem call.
+   * Passing an empty list reverts to PathFinder path resolution.
+   */
+  static void configureDataRoots(const std::vector<std::string>& roots,
+                                 bool watch = false);
+
+  /**
+   * @brief Starts warming the page cache for contracts needed soon.
+   * 
+   * @param contracts Contracts the caller expects to load next
+   * @return size_t Number of files queued (unknown contracts are skipped)
+   * 
+   * Files are read by background threads while the caller keeps working,
+   * so the subsequent loadContractData() maps already-cached pages. Files
+   * are warmed at most once per process.
+   */
+  static size_t prefetchContracts(const std::vector<Contract>& contracts);
+
+  /**
+   * @brief Blocks until all queued prefetches have completed.
+   */
+  static void waitForPrefetch();
+
+  /**
+   * @brief Returns the active catalog, or nullptr if none is configured.
+   */
+  static std::shared_ptr<DataCatalog> catalog();
 };
 
 #endif /* DATA_MANAGER_HPP */
\ No newline at end of file
@@ -0,0 +1,86 @@
+/**
+ * @file FilePrefetcher.hpp
+ * @brief Background threads that pull upcoming files into the page cache.
+ *
+ * A study usually knows which contracts it will load next. Handing their
+ * paths to a FilePrefetcher lets the disk work ahead of the parser, so by
+ * the time a file is mapped its pages are already cached.
+ */
+
+#ifndef FILE_PREFETCHER_HPP
+#define FILE_PREFETCHER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @class FilePrefetcher
+ * @brief FIFO queue of files warmed by background threads.
+ *
+ * Files already warmed by this prefetcher are skipped when enqueued again;
+ * call Forget() after files are rewritten.
+ *
+ * @example
+ * ```cpp
+ * FilePrefetcher prefetcher;
+ * prefetcher.Enqueue({path_2024, path_2025});
+ * reader.read_csv_mmap(path_2023, data);  // overlaps with the prefetch
+ * ```
+ */
+class FilePrefetcher {
+ public:
+  /**
+   * @brief Starts `num_threads` workers (at least one).
+   */
+  explicit FilePrefetcher(size_t num_threads = 1);
+  ~FilePrefetcher();
+
+  FilePrefetcher(const FilePrefetcher &) = delete;
+  FilePrefetcher &operator=(const FilePrefetcher &) = delete;
+
+  /**
+   * @brief Queues files for warming; returns immediately.
+   */
+  void Enqueue(const std::vector<std::string> &paths);
+
+  /**
+   * @brief Blocks until every queued file has been processed.
+   */
+  void Wait();
+
+  /**
+   * @brief Number of files queued or in flight.
+   */
+  size_t Pending() const;
+
+  /**
+   * @brief Number of files warmed so far.
+   */
+  size_t Warmed() const;
+
+  /**
+   * @brief Clears the already-warmed set.
+   */
+  void Forget();
+
+ private:
+  void WorkerLoop();
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable idle_cv_;
+  std::deque<std::string> queue_;
+  std::unordered_set<std::string> seen_;
+  size_t in_flight_ = 0;
+  size_t warmed_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+#endif /* FILE_PREFETCHER_HPP */
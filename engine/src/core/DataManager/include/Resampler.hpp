@@ -0,0 +1,82 @@
+/**
+ * @file Resampler.hpp
+ * @brief Bar aggregation of OHLCV time series into coarser buckets.
+ *
+ * This file provides the bucket description and the resampling kernel used to
+ * turn intraday contract data (e.g. minute bars) into hourly, daily or weekly
+ * OHLCV bars. Daily and weekly buckets honour a trading-session boundary so
+ * that an evening session is attributed to the following trading day.
+ */
+
+#ifndef RESAMPLER_HPP
+#define RESAMPLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "TimeSeries.hpp"
+
+/**
+ * @struct BarBucket
+ * @brief Describes the target bar size of a resampling operation.
+ *
+ * Intraday buckets (minutes, hours) are aligned to the wall clock. Daily and
+ * weekly buckets start at `session_start_ms`, the time of day at which a new
+ * trading session opens. Bars at or after that time roll into the next
+ * trading day, and the resulting bar is labelled with the trading date at
+ * midnight. Weekly bars are labelled with the Monday of the trading week.
+ *
+ * @example
+ * ```cpp
+ * // CME grains: the Globex session for day D opens at 19:00 on day D-1
+ * BarBucket daily = BarBucket::Days(1, 19 * BarBucket::kHourMs);
+ * TimeSeries bars = Resample(minute_bars, daily);
+ * ```
+ */
+struct BarBucket {
+  static constexpr uint64_t kMinuteMs = 60ULL * 1000ULL;
+  static constexpr uint64_t kHourMs = 60ULL * kMinuteMs;
+  static constexpr uint64_t kDayMs = 24ULL * kHourMs;
+  static constexpr uint64_t kWeekMs = 7ULL * kDayMs;
+
+  uint64_t width_ms = kDayMs;     ///< Bucket width in milliseconds
+  uint64_t session_start_ms = 0;  ///< Session open as time of day (ms)
+  bool session_aligned = true;    ///< Apply the session boundary
+
+  static BarBucket Minutes(uint64_t n) { return {n * kMinuteMs, 0, false}; }
+  static BarBucket Hours(uint64_t n) { return {n * kHourMs, 0, false}; }
+  static BarBucket Days(uint64_t n, uint64_t session_start_ms = 0) {
+    return {n * kDayMs, session_start_ms % kDayMs, true};
+  }
+  static BarBucket Weeks(uint64_t n, uint64_t session_start_ms = 0) {
+    return {n * kWeekMs, session_start_ms % kDayMs, true};
+  }
+
+  bool operator==(const BarBucket &other) const {
+    return width_ms == other.width_ms &&
+           session_start_ms == other.session_start_ms &&
+           session_aligned == other.session_aligned;
+  }
+};
+
+/**
+ * @brief Aggregates a time series into OHLCV bars of the given bucket size.
+ *
+ * @param series Source series, sorted by ascending timestamp (milliseconds)
+ * @param bucket Target bar size and session boundary
+ * @param num_threads Parallel chunks; 0 = one per scheduler worker
+ * @return TimeSeries One bar per non-empty bucket
+ *
+ * Each bar takes the first open, the maximum high, the minimum low, the last
+ * close and the summed volume of the rows falling into its bucket; optional
+ * columns (open interest, settlement) take the last value. The kernel
+ * is a single linear pass. Large inputs are split into chunks whose borders
+ * are moved to bucket boundaries, so every chunk reduces independently and
+ * the partial outputs are simply concatenated.
+ *
+ * @throws std::invalid_argument if the bucket width is zero
+ */
+TimeSeries Resample(const TimeSeries &series, const BarBucket &bucket,
+                    size_t num_threads = 0);
+
+#endif /* RESAMPLER_HPP */
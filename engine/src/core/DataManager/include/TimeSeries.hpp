@@ -10,7 +10,15 @@
 #ifndef TIME_SERIES_HPP
 #define TIME_SERIES_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -30,6 +38,54 @@ struct OHLCV {
   double volume;      ///< Trading volume during the time period
 };
 
+/**
+ * @brief Bit set of TimeSeries value columns; timestamps are always loaded.
+ */
+using ColumnMask = uint32_t;
+
+/**
+ * @struct SeriesColumn
+ * @brief ColumnMask bits for each value column.
+ */
+struct SeriesColumn {
+  static constexpr ColumnMask kOpen = 1u << 0;
+  static constexpr ColumnMask kHigh = 1u << 1;
+  static constexpr ColumnMask kLow = 1u << 2;
+  static constexpr ColumnMask kClose = 1u << 3;
+  static constexpr ColumnMask kVolume = 1u << 4;
+  static constexpr ColumnMask kOpenInterest = 1u << 5;
+  static constexpr ColumnMask kSettlement = 1u << 6;
+  static constexpr ColumnMask kAll = (1u << 7) - 1;
+};
+
+class TimeSeries;
+
+/**
+ * @class DeferredColumns
+ * @brief Source of columns a loader skipped, parsed on first access.
+ *
+ * Implemented by the CSV layouts (csv::Schema), which keep the file bytes
+ * and each row's offset alive so a column can be converted later.
+ */
+class DeferredColumns {
+ public:
+  virtual ~DeferredColumns() = default;
+
+  /**
+   * @brief Converts one column (a single SeriesColumn bit) into `out`.
+   * @param out Destination sized to the series' row count
+   */
+  virtual void Materialize(ColumnMask column, double *out) const = 0;
+
+  /**
+   * @brief Serializes first accesses from every series sharing the source.
+   */
+  std::mutex &Mutex() const { return mutex_; }
+
+ private:
+  mutable std::mutex mutex_;
+};
+
 /**
  * @class TimeSeries
  * @brief High-performance time series container using Structure of Arrays layout.
@@ -59,9 +115,30 @@ struct OHLCV {
  * // Access data by timestamp
  * OHLCV point = series.DataPointByTimestamp(1640995200000);
  * ```
+ *
+ * Besides the six core columns, a series can carry named optional columns
+ * (open interest, settlement price, ...). They are allocated only when a
+ * data source provides them, and kernels look up exactly the columns they
+ * use:
+ *
+ * ```cpp
+ * if (const auto *oi = series.FindColumn(TimeSeries::kOpenInterest)) {
+ *   RollOnOpenInterest(series.Timestamps(), *oi);
+ * }
+ * ```
+ *
+ * Loaders can also leave columns unparsed (see SetDeferredColumns()). Such
+ * a column is converted the first time any accessor touches it; concurrent
+ * first accesses are synchronized, so a loaded series can be shared with
+ * worker threads as usual.
  */
 class TimeSeries {
  public:
+  /// Name of the optional open interest column.
+  static constexpr const char *kOpenInterest = "open_interest";
+  /// Name of the optional settlement price column.
+  static constexpr const char *kSettlement = "settlement";
+
   /**
    * @brief Constructs a TimeSeries with provided data arrays.
    * 
@@ -96,7 +173,9 @@ class TimeSeries {
   /**
    * @brief Clears all data from the time series.
    * 
-   * Removes all data points while preserving allocated memory capacity.
+   * Removes all data points while preserving the core columns' allocated
+   * capacity. Optional columns are removed entirely, so a series reused for
+   * another file only carries the columns that file provides.
    */
   void clear();
 
@@ -122,6 +201,54 @@ class TimeSeries {
    */
   const OHLCV DataPointByTimestamp(uint64_t timestamp) const;
 
+  class RowRange;
+
+  /**
+   * @brief Copies rows [begin, end) into an array of OHLCV structs.
+   * 
+   * @param begin First row to copy
+   * @param end One past the last row to copy
+   * @param out Destination with room for `end - begin` rows
+   * @throws std::out_of_range if the range is not within [0, size)
+   * 
+   * The transposition interleaves two rows per SSE2 step, reading every
+   * column and writing the rows strictly in order, so it runs at memory
+   * bandwidth. Deferred columns are parsed first.
+   */
+  void ToRows(size_t begin, size_t end, OHLCV *out) const;
+
+  /**
+   * @brief Builds a series from an array of OHLCV structs.
+   * 
+   * @param rows Rows to transpose, in timestamp order
+   * @param count Number of rows
+   * @return TimeSeries Series with the six core columns
+   */
+  static TimeSeries FromRows(const OHLCV *rows, size_t count);
+
+  /**
+   * @brief Appends an array of OHLCV structs to the core columns.
+   * 
+   * Optional columns, if any, are extended with zeros.
+   */
+  void AppendRows(const OHLCV *rows, size_t count);
+
+  /**
+   * @brief Lazily assembled OHLCV view of rows [begin, end).
+   * 
+   * @throws std::out_of_range if the range is not within [0, size)
+   * 
+   * The range is checked once here; iteration does no bounds checks. The
+   * view holds pointers into the columns and is invalidated like iterators
+   * of the underlying vectors.
+   * 
+   * ```cpp
+   * for (const OHLCV bar : series.Rows()) chart.Add(bar);
+   * ```
+   */
+  RowRange Rows(size_t begin = 0,
+                size_t end = std::numeric_limits<size_t>::max()) const;
+
   /**
    * @brief Gets read-only access to the timestamps array.
    * @return const std::vector<uint64_t>& Reference to timestamps vector
@@ -194,13 +321,258 @@ class TimeSeries {
    */
   std::vector<double> &Volumes();
 
+  /**
+   * @brief Returns true if an optional column with this name is present.
+   */
+  bool HasColumn(std::string_view name) const;
+
+  /**
+   * @brief Looks up a core or optional column by name.
+   * 
+   * @param name "open", "high", "low", "close", "volume" or the name of an
+   *        optional column
+   * @return const std::vector<double>* The column, or nullptr if absent
+   */
+  const std::vector<double> *FindColumn(std::string_view name) const;
+
+  /**
+   * @brief Mutable variant of FindColumn().
+   */
+  std::vector<double> *FindColumn(std::string_view name);
+
+  /**
+   * @brief Adds an optional column, or returns it if already present.
+   * 
+   * @param name Column name (must not be a core column name)
+   * @return std::vector<double>& The column, sized to the current number of
+   *         rows; new entries are zero
+   * 
+   * @note References to optional columns are invalidated by the next
+   *       AddColumn(), DropColumn() or clear().
+   */
+  std::vector<double> &AddColumn(const std::string &name);
+
+  /**
+   * @brief Removes an optional column; does nothing if it is absent.
+   */
+  void DropColumn(std::string_view name);
+
+  /**
+   * @brief Leaves columns to be parsed from `source` on first access.
+   * 
+   * @param source Converter for the skipped columns
+   * @param columns Columns to defer; their vectors must be empty (optional
+   *        columns must already have been added)
+   * 
+   * Used by loaders given a column mask. Everything else stays as is.
+   */
+  void SetDeferredColumns(std::shared_ptr<const DeferredColumns> source,
+                          ColumnMask columns);
+
+  /**
+   * @brief Columns that are still waiting to be parsed.
+   */
+  ColumnMask DeferredColumnMask() const { return pending_.Load(); }
+
+  /**
+   * @brief Parses deferred columns now.
+   * 
+   * @param columns Columns to materialize (default: all)
+   * 
+   * Once nothing is deferred, the source bytes are released.
+   */
+  void Materialize(ColumnMask columns = SeriesColumn::kAll);
+
+  /**
+   * @brief Names of the optional columns present, in insertion order.
+   */
+  std::vector<std::string_view> OptionalColumns() const;
+
+  /**
+   * @brief Gets the open interest column.
+   * @throws std::out_of_range if the series has no open interest
+   */
+  const std::vector<double> &OpenInterest() const;
+
+  /**
+   * @brief Gets the settlement price column.
+   * @throws std::out_of_range if the series has no settlement prices
+   */
+  const std::vector<double> &Settlements() const;
+
  private:
+  /**
+   * @brief An optional column and its name.
+   */
+  struct NamedColumn {
+    std::string name;
+    std::vector<double> values;
+  };
+
   std::vector<uint64_t> timestamps_; ///< Timestamps in milliseconds since epoch
   std::vector<double> opens_;        ///< Opening prices
   std::vector<double> highs_;        ///< High prices
   std::vector<double> lows_;         ///< Low prices
   std::vector<double> closes_;       ///< Closing prices
   std::vector<double> volumes_;      ///< Trading volumes
+  /**
+   * @brief Copyable atomic column mask.
+   */
+  class PendingMask {
+   public:
+    PendingMask() = default;
+    PendingMask(const PendingMask &other) : bits_(other.Load()) {}
+    PendingMask &operator=(const PendingMask &other) {
+      bits_.store(other.Load(), std::memory_order_relaxed);
+      return *this;
+    }
+    ColumnMask Load() const { return bits_.load(std::memory_order_acquire); }
+    void Store(ColumnMask bits) {
+      bits_.store(bits, std::memory_order_release);
+    }
+
+   private:
+    std::atomic<ColumnMask> bits_{0};
+  };
+
+  /**
+   * @brief Parses `columns` if any of them are still deferred.
+   */
+  void Ensure(ColumnMask columns) const {
+    if (pending_.Load() & columns) MaterializeSlow(columns);
+  }
+
+  void MaterializeSlow(ColumnMask columns) const;
+
+  std::vector<double> *ColumnFor(ColumnMask column);
+
+  std::vector<NamedColumn> optional_; ///< Optional columns, if any
+  std::shared_ptr<const DeferredColumns> deferred_; ///< Deferred source
+  mutable PendingMask pending_;      ///< Columns not parsed yet
+};
+
+/**
+ * @class TimeSeries::RowRange
+ * @brief Range of OHLCV rows read straight from the columns.
+ */
+class TimeSeries::RowRange {
+ public:
+  /**
+   * @brief Base pointers of the core columns.
+   */
+  struct Columns {
+    const uint64_t *timestamps = nullptr;
+    const double *opens = nullptr;
+    const double *highs = nullptr;
+    const double *lows = nullptr;
+    const double *closes = nullptr;
+    const double *volumes = nullptr;
+  };
+
+  /**
+   * @brief Random-access iterator yielding OHLCV rows by value.
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = OHLCV;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = OHLCV;
+
+    Iterator() = default;
+    Iterator(const Columns &columns, size_t index)
+        : columns_(columns), index_(index) {}
+
+    OHLCV operator*() const { return (*this)[0]; }
+    OHLCV operator[](difference_type n) const {
+      const size_t i = index_ + n;
+      return OHLCV{columns_.timestamps[i], columns_.opens[i],
+                   columns_.highs[i],      columns_.lows[i],
+                   columns_.closes[i],     columns_.volumes[i]};
+    }
+
+    Iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++index_;
+      return old;
+    }
+    Iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --index_;
+      return old;
+    }
+    Iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    Iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const Iterator &a, const Iterator &b) {
+      return static_cast<difference_type>(a.index_) -
+             static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const Iterator &a, const Iterator &b) {
+      return a.index_ == b.index_;
+    }
+    friend bool operator!=(const Iterator &a, const Iterator &b) {
+      return a.index_ != b.index_;
+    }
+    friend bool operator<(const Iterator &a, const Iterator &b) {
+      return a.index_ < b.index_;
+    }
+    friend bool operator>(const Iterator &a, const Iterator &b) {
+      return b < a;
+    }
+    friend bool operator<=(const Iterator &a, const Iterator &b) {
+      return !(b < a);
+    }
+    friend bool operator>=(const Iterator &a, const Iterator &b) {
+      return !(a < b);
+    }
+
+   private:
+    Columns columns_;
+    size_t index_ = 0;
+  };
+
+  RowRange() = default;
+  RowRange(const Columns &columns, size_t begin, size_t end)
+      : columns_(columns), begin_(begin), end_(end) {}
+
+  Iterator begin() const { return Iterator(columns_, begin_); }
+  Iterator end() const { return Iterator(columns_, end_); }
+  size_t size() const { return end_ - begin_; }
+  bool empty() const { return begin_ == end_; }
+
+  /**
+   * @brief The `n`th row of the range; not bounds checked.
+   */
+  OHLCV operator[](size_t n) const { return begin()[n]; }
+
+ private:
+  Columns columns_;
+  size_t begin_ = 0;
+  size_t end_ = 0;
 };
 
 #endif /* TIME_SERIES_HPP */
\ No newline at end of file
@@ -0,0 +1,230 @@
+/**
+ * @file Workspace.hpp
+ * @brief Versioned, memory-mapped snapshots of the engine's warm state.
+ *
+ * A restarted backend would otherwise reload, resample and re-evaluate
+ * everything its users asked for before the restart. A workspace file holds
+ * those results (series columns, matrices and encoded blobs) in a layout
+ * that can be mapped and read in place. Opening one only reads its
+ * directory; the data pages of an entry are faulted in when it is first
+ * asked for.
+ *
+ * File layout, integers in host byte order:
+ *
+ * ```
+ * header     magic "ALCWSPC\0", format version, entry count,
+ *            directory offset and size, file size
+ * entries    payloads, each starting on a 64-byte boundary
+ * directory  per entry: kind, key, data version, shape, offset, size
+ * ```
+ */
+
+#ifndef WORKSPACE_HPP
+#define WORKSPACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "TimeSeries.hpp"
+
+/**
+ * @brief 64-bit FNV-1a hash of `bytes`.
+ *
+ * Stable across processes and builds, unlike std::hash. Data versions and
+ * file names that outlive the process (workspace entries, spill files) must
+ * all be derived from this one definition.
+ */
+inline uint64_t Fnv1a(std::string_view bytes) {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (unsigned char c : bytes) hash = (hash ^ c) * 0x100000001B3ULL;
+  return hash;
+}
+
+/**
+ * @enum WorkspaceEntryKind
+ * @brief Payload type of a workspace entry.
+ */
+enum class WorkspaceEntryKind : uint32_t {
+  kSeries = 1,  ///< TimeSeries core and optional columns
+  kMatrix = 2,  ///< Row-major doubles
+  kBlob = 3     ///< Opaque bytes
+};
+
+/**
+ * @class Workspace
+ * @brief Read-only view of a workspace file.
+ *
+ * Every entry carries the data version it was built from (for example
+ * DataManager::contractDataVersion()). Reads name the version they expect
+ * and miss on any other, so a snapshot never serves data older than its
+ * source files. Files written with another format version do not open.
+ *
+ * Reads are const and thread-safe.
+ *
+ * @example
+ * ```cpp
+ * auto workspace = std::make_shared<Workspace>();
+ * if (workspace->Open("/var/lib/alchemath/workspace.aws")) {
+ *   DataManager::attachWorkspace(workspace);
+ *   SpreadCache::Instance().Attach(workspace);
+ * }
+ * ```
+ */
+class Workspace {
+ public:
+  /// Layout version; bumped whenever the file format changes.
+  static constexpr uint32_t kFormatVersion = 1;
+
+  Workspace() = default;
+  Workspace(const Workspace &) = delete;
+  Workspace &operator=(const Workspace &) = delete;
+
+  /**
+   * @brief Maps a workspace file and reads its directory.
+   * @return bool False if the file is missing, truncated, corrupt or of
+   *         another format version
+   */
+  bool Open(const std::string &path);
+
+  size_t Entries() const { return directory_.size(); }
+  bool Contains(const std::string &key) const {
+    return directory_.count(key) != 0;
+  }
+
+  /**
+   * @brief Keys of every entry, in file order.
+   */
+  std::vector<std::string> Keys() const;
+
+  /**
+   * @brief Copies a series entry out of the mapping.
+   * @return bool False if the key is absent, of another kind or version
+   */
+  bool ReadSeries(const std::string &key, uint64_t version,
+                  TimeSeries &series) const;
+
+  /**
+   * @brief Copies a matrix entry out of the mapping.
+   * @return bool False if the key is absent, of another kind or version
+   */
+  bool ReadMatrix(const std::string &key, uint64_t version, size_t &rows,
+                  size_t &cols, std::vector<double> &values) const;
+
+  /**
+   * @brief Copies a blob entry out of the mapping.
+   * @return bool False if the key is absent, of another kind or version
+   */
+  bool ReadBlob(const std::string &key, uint64_t version,
+                std::vector<uint8_t> &bytes) const;
+
+ private:
+  friend class WorkspaceWriter;
+
+  struct Entry {
+    WorkspaceEntryKind kind;
+    uint64_t version;
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  const Entry *Find(const std::string &key, WorkspaceEntryKind kind,
+                    uint64_t version) const;
+
+  MappedFile file_;
+  std::vector<std::string> keys_;
+  std::unordered_map<std::string, Entry> directory_;
+};
+
+/**
+ * @class WorkspaceWriter
+ * @brief Streams entries into a new workspace file.
+ *
+ * Entries are written as they are added, so a snapshot never holds a second
+ * copy of the state in memory. The file is built next to `path` and renamed
+ * over it by Commit(), so readers (including a Workspace mapping the old
+ * file) never see a partial snapshot. A writer destroyed without Commit()
+ * removes its temporary file.
+ *
+ * Adding a key twice keeps the first entry.
+ *
+ * @example
+ * ```cpp
+ * WorkspaceWriter writer("/var/lib/alchemath/workspace.aws");
+ * DataManager::snapshotWorkspace(writer);
+ * SpreadCache::Instance().Snapshot(writer);
+ * writer.CarryOver(*workspace);  // The snapshot opened at startup
+ * writer.Commit();
+ * ```
+ */
+class WorkspaceWriter {
+ public:
+  explicit WorkspaceWriter(std::string path);
+  ~WorkspaceWriter();
+
+  WorkspaceWriter(const WorkspaceWriter &) = delete;
+  WorkspaceWriter &operator=(const WorkspaceWriter &) = delete;
+
+  /**
+   * @brief Writes every column of a series, parsing deferred ones.
+   */
+  bool AddSeries(const std::string &key, uint64_t version,
+                 const TimeSeries &series);
+
+  bool AddMatrix(const std::string &key, uint64_t version, size_t rows,
+                 size_t cols, const double *values);
+
+  bool AddBlob(const std::string &key, uint64_t version, const void *data,
+               size_t size);
+
+  /**
+   * @brief Copies the entries of an older workspace not written yet.
+   *
+   * Call after adding the fresh entries. Keeps entries nobody asked for
+   * since the last restart; the copies keep their data versions and are
+   * still validated on read.
+   *
+   * @return size_t Entries copied
+   */
+  size_t CarryOver(const Workspace &previous);
+
+  bool Contains(const std::string &key) const {
+    return written_.count(key) != 0;
+  }
+  size_t Entries() const { return entries_.size(); }
+
+  /**
+   * @brief Writes the directory and atomically replaces `path`.
+   * @return bool False if any write failed; `path` is then left untouched
+   */
+  bool Commit();
+
+ private:
+  struct Pending {
+    std::string key;
+    Workspace::Entry entry;
+  };
+
+  bool Begin(const std::string &key, WorkspaceEntryKind kind,
+             uint64_t version, uint64_t rows, uint64_t cols);
+  void Write(const void *data, size_t size);
+  void Finish();
+
+  std::string path_;
+  std::string temp_;
+  std::ofstream out_;
+  uint64_t offset_ = 0;
+  bool committed_ = false;
+  std::vector<Pending> entries_;
+  std::unordered_set<std::string> written_;
+};
+
+#endif /* WORKSPACE_HPP */
@@ -45,6 +45,12 @@ echo "=================="
 # Store test result
 TEST_RESULT=$?
 
+# The allocation-counting arena test has its own executable
+./analysis_arena_tests --gtest_output=xml:arena_test_results.xml --gtest_color=yes
+if [ $? -ne 0 ]; then
+    TEST_RESULT=1
+fi
+
 echo ""
 echo "=================="
 
@@ -57,8 +63,8 @@ fi
 # Display summary
 echo ""
 echo "Test Results Summary:"
-echo "- Test executable: $PWD/engine_tests"
-echo "- XML report: $PWD/test_results.xml"
+echo "- Test executables: $PWD/engine_tests, $PWD/analysis_arena_tests"
+echo "- XML reports: $PWD/test_results.xml, $PWD/arena_test_results.xml"
 echo "- Return code: $TEST_RESULT"
 
 exit $TEST_RESULT
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include "AnalysisArena.hpp"
+#include "SpreadDefinition.hpp"
+#include "SpreadMetrics.hpp"
+#include "TimestampJoin.hpp"
+
+// Counts global allocations made by the calling thread, so background
+// workers of other components do not disturb the measurement. Replacing the
+// global allocation functions affects the whole program, so this file is
+// built as its own test executable (analysis_arena_tests).
+namespace {
+thread_local size_t g_allocations = 0;
+}  // namespace
+
+void *operator new(size_t size) {
+  ++g_allocations;
+  if (void *p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned form
+void *operator new(size_t size, std::align_val_t alignment) {
+  ++g_allocations;
+  const size_t align = static_cast<size_t>(alignment);
+  const size_t rounded = (size + align - 1) / align * align;
+  if (void *p = std::aligned_alloc(align, rounded ? rounded : align)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+class AnalysisArenaTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Two legs over six years of hourly bars; the far leg misses every
+    // seventh bar so the join has work to do
+    const uint64_t start = 1577836800000ULL;  // 2020-01-01
+    for (size_t i = 0; i < 6 * 365 * 6; ++i) {
+      const uint64_t t = start + i * 4 * 3600000ULL;
+      near_ts.push_back(t);
+      near_px.push_back(400.0 + std::sin(i * 0.01) * 20.0);
+      if (i % 7 != 3) {
+        far_ts.push_back(t);
+        far_px.push_back(410.0 + std::cos(i * 0.013) * 15.0);
+      }
+    }
+    columns[0] = {near_ts.data(), near_px.data(), near_ts.size()};
+    columns[1] = {far_ts.data(), far_px.data(), far_ts.size()};
+    definition = SpreadDefinition::Calendar("ZC", H, K, 2025);
+  }
+
+  // One analysis request: align, evaluate, slice by year, summarize
+  double RunRequest(std::pmr::memory_resource *resource) {
+    const AlignedMatrix aligned =
+        JoinTimestamps(columns, 2, JoinMode::kInner, resource);
+    std::pmr::vector<double> spread(aligned.Rows(), resource);
+    EvaluateSpread(definition, aligned, spread.data());
+    const auto metrics = MetricsByYear(aligned.Timestamps().data(),
+                                       spread.data(), aligned.Rows(),
+                                       resource);
+    double checksum = 0.0;
+    for (const auto &m : metrics) checksum += m.profit_loss + m.max_drawdown;
+    return checksum;
+  }
+
+  std::vector<uint64_t> near_ts;
+  std::vector<double> near_px;
+  std::vector<uint64_t> far_ts;
+  std::vector<double> far_px;
+  JoinColumn columns[2];
+  SpreadDefinition definition;
+};
+
+TEST_F(AnalysisArenaTest, ResultsMatchHeapAllocation) {
+  AnalysisArena arena;
+  const double heap = RunRequest(std::pmr::get_default_resource());
+  EXPECT_EQ(RunRequest(arena.Resource()), heap);
+
+  const AlignedMatrix a =
+      JoinTimestamps(columns, 2, JoinMode::kOuterForwardFill,
+                     arena.Resource());
+  const AlignedMatrix b =
+      JoinTimestamps({columns[0], columns[1]}, JoinMode::kOuterForwardFill);
+  ASSERT_EQ(a.Rows(), b.Rows());
+  for (size_t i = 0; i < a.Rows(); ++i) {
+    ASSERT_EQ(a.Timestamps()[i], b.Timestamps()[i]);
+    ASSERT_EQ(a.Leg(1)[i], b.Leg(1)[i]);
+  }
+}
+
+TEST_F(AnalysisArenaTest, SpillsGrowTheRetainedBlock) {
+  AnalysisArena arena(1024);
+  RunRequest(arena.Resource());
+  EXPECT_GT(arena.Spilled(), 0u);
+
+  arena.Reset();
+  EXPECT_GT(arena.Capacity(), 1024u);
+  EXPECT_EQ(arena.Spilled(), 0u);
+  RunRequest(arena.Resource());
+  EXPECT_EQ(arena.Spilled(), 0u);
+}
+
+TEST_F(AnalysisArenaTest, SteadyStateMakesNoGlobalAllocations) {
+  AnalysisArena arena(4096);
+  RunRequest(arena.Resource());  // Sizes the arena
+  arena.Reset();
+
+  const size_t before = g_allocations;
+  double checksum = 0.0;
+  for (int request = 0; request < 20; ++request) {
+    checksum += RunRequest(arena.Resource());
+    arena.Reset();
+  }
+  const size_t allocations = g_allocations - before;
+  EXPECT_EQ(allocations, 0u);
+  EXPECT_NE(checksum, 0.0);
+
+  // The same requests on the heap allocate every time
+  const size_t heap_before = g_allocations;
+  RunRequest(std::pmr::get_default_resource());
+  EXPECT_GT(g_allocations - heap_before, 0u);
+}
+
+TEST_F(AnalysisArenaTest, RequestTiming) {
+  AnalysisArena arena;
+  RunRequest(arena.Resource());
+  arena.Reset();
+  double heap_sum = 0.0;
+  double arena_sum = 0.0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int request = 0; request < 50; ++request) {
+    heap_sum += RunRequest(std::pmr::get_default_resource());
+  }
+  auto heap = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int request = 0; request < 50; ++request) {
+    arena_sum += RunRequest(arena.Resource());
+    arena.Reset();
+  }
+  auto pooled = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  std::cout << "50 join/spread/metrics requests: heap " << heap.count()
+            << " us, arena " << pooled.count() << " us" << std::endl;
+  EXPECT_EQ(arena_sum, heap_sum);
+}
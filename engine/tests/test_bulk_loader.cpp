@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "BulkLoader.hpp"
+#include "CompressedContractFile.hpp"
+#include "ContractCsvReader.hpp"
+#include "DataManager.hpp"
+
+class BulkLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir = "/tmp/bulk_loader_test";
+    std::filesystem::create_directories(test_dir);
+  }
+
+  void TearDown() override {
+    DataManager::configureDataRoots({});
+    std::filesystem::remove_all(test_dir);
+  }
+
+  std::string CreateCsv(const std::string& name, size_t rows,
+                        double base = 100.0) {
+    const std::string path = test_dir + "/" + name;
+    std::filesystem::create_directories(
+        std::filesystem::path(path).parent_path());
+    std::ofstream file(path);
+    file << "timestamp,close,open,high,low,volume\n";
+    for (size_t i = 0; i < rows; ++i) {
+      file << "2024-01-02 " << (10 + i / 60 % 10) << ":"
+           << (i % 60 < 10 ? "0" : "") << i % 60 << ":00," << base + i % 9
+           << ",100.5,110.25,90.75," << i << "\n";
+    }
+    return path;
+  }
+
+  // Many small files, as in a commodity's full history.
+  std::vector<std::string> CreateHistory(size_t files, size_t rows) {
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < files; ++i) {
+      paths.push_back(CreateCsv("h" + std::to_string(i) + ".csv", rows,
+                                100.0 + static_cast<double>(i)));
+    }
+    return paths;
+  }
+
+  void ExpectMatchesReader(const std::vector<std::string>& paths,
+                           const std::vector<BulkLoadResult>& results) {
+    ASSERT_EQ(results.size(), paths.size());
+    ContractCsvReader reader;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      TimeSeries expected;
+      ASSERT_TRUE(reader.read_csv_mmap(paths[i], expected, true));
+      EXPECT_TRUE(results[i].ok) << paths[i];
+      EXPECT_EQ(results[i].path, paths[i]);
+      EXPECT_EQ(results[i].data.Timestamps(), expected.Timestamps());
+      EXPECT_EQ(results[i].data.Closes(), expected.Closes());
+      EXPECT_EQ(results[i].data.Volumes(), expected.Volumes());
+    }
+  }
+
+  std::string test_dir;
+};
+
+TEST_F(BulkLoaderTest, IoUringLoadsManyFilesInOrder) {
+  auto paths = CreateHistory(150, 200);
+  BulkLoadOptions options;
+  options.backend = BulkLoadBackend::kIoUring;
+  options.queue_depth = 16;  // Far fewer entries than files
+  BulkLoader loader(options);
+  auto results = loader.Load(paths);
+  ExpectMatchesReader(paths, results);
+
+  if (BulkLoader::IoUringAvailable()) {
+    EXPECT_EQ(loader.LastBackend(), BulkLoadBackend::kIoUring);
+  } else {
+    EXPECT_EQ(loader.LastBackend(), BulkLoadBackend::kThreadPool);
+  }
+}
+
+TEST_F(BulkLoaderTest, ThreadPoolFallbackMatches) {
+  auto paths = CreateHistory(40, 100);
+  BulkLoadOptions options;
+  options.backend = BulkLoadBackend::kThreadPool;
+  options.io_threads = 3;
+  BulkLoader loader(options);
+  auto results = loader.Load(paths);
+  EXPECT_EQ(loader.LastBackend(), BulkLoadBackend::kThreadPool);
+  ExpectMatchesReader(paths, results);
+}
+
+TEST_F(BulkLoaderTest, FailuresAreIsolated) {
+  for (auto backend : {BulkLoadBackend::kAuto, BulkLoadBackend::kThreadPool}) {
+    std::vector<std::string> paths = {CreateCsv("ok.csv", 10),
+                                      test_dir + "/missing.csv",
+                                      test_dir + "/empty.csv"};
+    std::ofstream(paths[2]).close();
+
+    BulkLoadOptions options;
+    options.backend = backend;
+    auto results = BulkLoader(options).Load(paths);
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].ok);
+    EXPECT_EQ(results[0].data.Timestamps().size(), 10u);
+    EXPECT_FALSE(results[1].ok);
+    EXPECT_EQ(results[1].error, ENOENT);
+    EXPECT_TRUE(results[2].ok);
+    EXPECT_TRUE(results[2].data.Timestamps().empty());
+  }
+}
+
+TEST_F(BulkLoaderTest, DecodesCompressedFiles) {
+  const std::string csv = CreateCsv("c.csv", 300);
+  const std::string acz = test_dir + "/c.acz";
+  ASSERT_TRUE(CompressedContractFile::ConvertCsv(csv, acz));
+
+  auto results = BulkLoader().Load({acz, csv});
+  ASSERT_TRUE(results[0].ok);
+  ASSERT_TRUE(results[1].ok);
+  EXPECT_EQ(results[0].data.Timestamps(), results[1].data.Timestamps());
+  EXPECT_EQ(results[0].data.Closes(), results[1].data.Closes());
+}
+
+TEST_F(BulkLoaderTest, EmptyInput) {
+  EXPECT_TRUE(BulkLoader().Load({}).empty());
+}
+
+TEST_F(BulkLoaderTest, DataManagerLoadsContractsInBulk) {
+  CreateCsv("root/ZC/H/2023.csv", 20, 400.0);
+  CreateCsv("root/ZC/H/2024.csv", 30, 450.0);
+  DataManager::configureDataRoots({test_dir + "/root"});
+
+  auto series = DataManager::loadContractsBulk(
+      {{"ZC", ExpirationMonth::H, 2024}, {"ZC", ExpirationMonth::H, 2023}});
+  ASSERT_EQ(series.size(), 2u);
+  EXPECT_EQ(series[0].Timestamps().size(), 30u);
+  EXPECT_EQ(series[1].Timestamps().size(), 20u);
+  EXPECT_DOUBLE_EQ(series[0].Closes()[0], 450.0);
+
+  EXPECT_THROW(DataManager::loadContractsBulk(
+                   {{"ZC", ExpirationMonth::Z, 1999}}),
+               std::runtime_error);
+}
+
+TEST_F(BulkLoaderTest, BulkVersusSequentialTiming) {
+  auto paths = CreateHistory(300, 500);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto results = BulkLoader().Load(paths);
+  auto bulk = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  start = std::chrono::high_resolution_clock::now();
+  ContractCsvReader reader;
+  for (const auto& path : paths) {
+    TimeSeries data;
+    reader.read_csv_mmap(path, data, true);
+  }
+  auto sequential = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  for (const auto& r : results) EXPECT_TRUE(r.ok);
+  std::cout << "300 files: bulk " << bulk.count() << " ms, sequential "
+            << sequential.count() << " ms" << std::endl;
+}
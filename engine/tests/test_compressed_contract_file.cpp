@@ -0,0 +1,364 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+
+#include "ColumnCodecs.hpp"
+#include "CompressedContractFile.hpp"
+#include "ContractCsvReader.hpp"
+#include "DataCatalog.hpp"
+#include "DataManager.hpp"
+
+class CompressedContractFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir = "/tmp/compressed_contract_test";
+    std::filesystem::create_directories(test_dir);
+  }
+
+  void TearDown() override {
+    DataManager::configureDataRoots({});
+    std::filesystem::remove_all(test_dir);
+  }
+
+  // Regular minute bars with quarter-tick prices, like a grain contract.
+  static TimeSeries MinuteBars(size_t rows, uint32_t seed = 7) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> step(-3, 3);
+    std::uniform_int_distribution<int> vol(0, 900);
+    TimeSeries ts;
+    ts.reserve(rows);
+    uint64_t t = 1704186000000ULL;  // 2024-01-02 09:00
+    int ticks = 1800;
+    for (size_t i = 0; i < rows; ++i) {
+      // Session gap every 1000 bars
+      t += (i % 1000 == 0 && i) ? 3600000ULL * 17 : 60000ULL;
+      ticks += step(rng);
+      const double close = ticks * 0.25;
+      ts.Timestamps().push_back(t);
+      ts.Opens().push_back(close - 0.25);
+      ts.Highs().push_back(close + 0.5);
+      ts.Lows().push_back(close - 0.75);
+      ts.Closes().push_back(close);
+      ts.Volumes().push_back(vol(rng));
+    }
+    return ts;
+  }
+
+  static bool SameBits(const std::vector<double>& a,
+                       const std::vector<double>& b) {
+    return a.size() == b.size() &&
+           std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+  }
+
+  static void ExpectIdentical(const TimeSeries& a, const TimeSeries& b) {
+    EXPECT_EQ(a.Timestamps(), b.Timestamps());
+    EXPECT_TRUE(SameBits(a.Opens(), b.Opens()));
+    EXPECT_TRUE(SameBits(a.Highs(), b.Highs()));
+    EXPECT_TRUE(SameBits(a.Lows(), b.Lows()));
+    EXPECT_TRUE(SameBits(a.Closes(), b.Closes()));
+    EXPECT_TRUE(SameBits(a.Volumes(), b.Volumes()));
+  }
+
+  std::string test_dir;
+};
+
+TEST_F(CompressedContractFileTest, DeltaOfDeltaRoundTripsIrregularTimestamps) {
+  std::vector<uint64_t> ts = {0, 60000, 120000, 180000, 240000, 250000,
+                              260000, 9000000, 9060000, 9120000, 9120000,
+                              std::numeric_limits<uint64_t>::max() / 2};
+  std::vector<uint8_t> bytes;
+  EncodeDeltaOfDelta(ts.data(), ts.size(), bytes);
+
+  std::vector<uint64_t> decoded(ts.size());
+  EXPECT_EQ(DecodeDeltaOfDelta(bytes.data(), bytes.size(), ts.size(),
+                               decoded.data()),
+            bytes.size());
+  EXPECT_EQ(decoded, ts);
+
+  // Truncated input is rejected
+  EXPECT_EQ(DecodeDeltaOfDelta(bytes.data(), bytes.size() - 1, ts.size(),
+                               decoded.data()),
+            0u);
+}
+
+TEST_F(CompressedContractFileTest, RegularTimestampsCollapseToRuns) {
+  std::vector<uint64_t> ts(100000);
+  for (size_t i = 0; i < ts.size(); ++i) ts[i] = 1704186000000ULL + i * 60000;
+  std::vector<uint8_t> bytes;
+  EncodeDeltaOfDelta(ts.data(), ts.size(), bytes);
+  EXPECT_LT(bytes.size(), 20u);
+
+  std::vector<uint64_t> decoded(ts.size());
+  DecodeDeltaOfDelta(bytes.data(), bytes.size(), ts.size(), decoded.data());
+  EXPECT_EQ(decoded, ts);
+}
+
+TEST_F(CompressedContractFileTest, TickScaleDetection) {
+  std::vector<double> quarters = {450.25, 450.5, 449.75, 451.0};
+  EXPECT_EQ(FindTickScale(quarters.data(), quarters.size()), 4.0);
+
+  std::vector<double> cents = {1.23, 1.24, 1.19, 0.01};
+  EXPECT_EQ(FindTickScale(cents.data(), cents.size()), 100.0);
+
+  std::vector<double> noise = {M_PI, std::exp(1.0)};
+  EXPECT_EQ(FindTickScale(noise.data(), noise.size()), 0.0);
+
+  std::vector<double> nan = {1.0, std::nan("")};
+  EXPECT_EQ(FindTickScale(nan.data(), nan.size()), 0.0);
+
+  std::vector<uint8_t> bytes;
+  EncodeTickDelta(cents.data(), cents.size(), 100.0, bytes);
+  std::vector<double> decoded(cents.size());
+  EXPECT_EQ(DecodeTickDelta(bytes.data(), bytes.size(), cents.size(), 100.0,
+                            decoded.data()),
+            bytes.size());
+  EXPECT_TRUE(SameBits(decoded, cents));
+}
+
+TEST_F(CompressedContractFileTest, XorRoundTripsArbitraryDoubles) {
+  std::mt19937_64 rng(3);
+  std::vector<double> values = {0.0, -0.0, std::nan(""),
+                                std::numeric_limits<double>::infinity(),
+                                1e-300, 1e300, 42.0, 42.0};
+  std::normal_distribution<double> dist(100.0, 5.0);
+  for (int i = 0; i < 1000; ++i) values.push_back(dist(rng));
+
+  std::vector<uint8_t> bytes;
+  EncodeXor(values.data(), values.size(), bytes);
+  std::vector<double> decoded(values.size());
+  EXPECT_EQ(DecodeXor(bytes.data(), bytes.size(), values.size(),
+                      decoded.data()),
+            bytes.size());
+  EXPECT_TRUE(SameBits(decoded, values));
+}
+
+TEST_F(CompressedContractFileTest, VarintVolumes) {
+  std::vector<double> volumes = {0, 1, 127, 128, 300000, 9007199254740991.0};
+  ASSERT_TRUE(IsVarintCompatible(volumes.data(), volumes.size()));
+
+  std::vector<uint8_t> bytes;
+  EncodeVarint(volumes.data(), volumes.size(), bytes);
+  std::vector<double> decoded(volumes.size());
+  EXPECT_EQ(DecodeVarint(bytes.data(), bytes.size(), volumes.size(),
+                         decoded.data()),
+            bytes.size());
+  EXPECT_EQ(decoded, volumes);
+
+  std::vector<double> fractional = {1.5};
+  std::vector<double> negative = {-1.0};
+  EXPECT_FALSE(IsVarintCompatible(fractional.data(), 1));
+  EXPECT_FALSE(IsVarintCompatible(negative.data(), 1));
+}
+
+TEST_F(CompressedContractFileTest, WordDecodingHandlesEveryVarintLength) {
+  // Runs of small values decode a word at a time, varints of three to eight
+  // bytes (up to 2^53 - 1) interrupt the words, and the last few values sit
+  // too close to the end for an 8-byte load.
+  std::vector<double> values;
+  for (int bytes = 1; bytes <= 8; ++bytes) {
+    const double top = std::ldexp(1.0, std::min(7 * bytes, 53)) - 1.0;
+    for (int i = 0; i < 11; ++i) values.push_back(i);
+    values.push_back(top);
+    values.push_back(std::ldexp(1.0, 7 * (bytes - 1)));
+  }
+  for (double v : {300.0, 5.0, 70000.0}) values.push_back(v);
+
+  std::vector<uint8_t> bytes;
+  EncodeVarint(values.data(), values.size(), bytes);
+  std::vector<double> decoded(values.size());
+  EXPECT_EQ(DecodeVarint(bytes.data(), bytes.size(), values.size(),
+                         decoded.data()),
+            bytes.size());
+  EXPECT_EQ(decoded, values);
+  for (size_t cut = 1; cut <= 4; ++cut) {
+    EXPECT_EQ(DecodeVarint(bytes.data(), bytes.size() - cut, values.size(),
+                           decoded.data()),
+              0u);
+  }
+
+  // Tick deltas mix one-byte moves with jumps of every width
+  std::vector<double> prices;
+  double price = 1000.0;
+  for (int i = 0; i < 200; ++i) {
+    price += (i % 17 == 16) ? std::ldexp(1.0, i % 40) / 4 : (i % 5) * 0.25;
+    prices.push_back(i % 3 ? price : -price);
+  }
+  // Scaled by multiplying with 1/4 and by dividing by 100
+  for (double scale : {4.0, 100.0}) {
+    bytes.clear();
+    EncodeTickDelta(prices.data(), prices.size(), scale, bytes);
+    decoded.assign(prices.size(), 0.0);
+    EXPECT_EQ(DecodeTickDelta(bytes.data(), bytes.size(), prices.size(),
+                              scale, decoded.data()),
+              bytes.size());
+    EXPECT_TRUE(SameBits(decoded, prices));
+  }
+}
+
+TEST_F(CompressedContractFileTest, FileRoundTripIsBitExact) {
+  TimeSeries original = MinuteBars(5000);
+  // One column of arbitrary doubles forces the XOR codec
+  for (auto& v : original.Opens()) v += 1e-7;
+
+  const std::string path = test_dir + "/bars.acz";
+  ASSERT_TRUE(CompressedContractFile::Write(path, original));
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+  TimeSeries loaded;
+  ASSERT_TRUE(CompressedContractFile::Read(path, loaded));
+  ExpectIdentical(original, loaded);
+}
+
+TEST_F(CompressedContractFileTest, EmptySeriesRoundTrips) {
+  TimeSeries empty;
+  auto image = CompressedContractFile::Encode(empty);
+  TimeSeries loaded = MinuteBars(3);
+  ASSERT_TRUE(CompressedContractFile::Decode(image.data(), image.size(),
+                                             loaded));
+  EXPECT_TRUE(loaded.Timestamps().empty());
+  EXPECT_TRUE(loaded.Closes().empty());
+}
+
+TEST_F(CompressedContractFileTest, ConvertCsvMatchesCsvReader) {
+  const std::string csv = test_dir + "/2024.csv";
+  {
+    std::ofstream file(csv);
+    file << "timestamp,close,open,high,low,volume\n";
+    file << "2024-01-02 09:00:00,104.12,100.5,105.3,99.01,1000\n";
+    file << "2024-01-02 09:01:00,104.13,104.12,105.0,103.99,0\n";
+    file << "2024-01-02 09:02:00,103.87,104.13,104.2,103.5,12\n";
+  }
+  const std::string acz = test_dir + "/2024.acz";
+  ASSERT_TRUE(CompressedContractFile::ConvertCsv(csv, acz));
+
+  TimeSeries from_csv;
+  ContractCsvReader reader;
+  ASSERT_TRUE(reader.read_csv_mmap(csv, from_csv, true));
+  TimeSeries from_acz;
+  ASSERT_TRUE(CompressedContractFile::Read(acz, from_acz));
+  ExpectIdentical(from_csv, from_acz);
+}
+
+TEST_F(CompressedContractFileTest, CompressesMinuteBars) {
+  TimeSeries bars = MinuteBars(100000);
+  auto image = CompressedContractFile::Encode(bars);
+  // ~48 bytes per row as SoA doubles; CSV is larger still
+  const size_t raw_bytes = bars.Timestamps().size() * 48;
+  EXPECT_LT(image.size() * 8, raw_bytes);
+}
+
+TEST_F(CompressedContractFileTest, RejectsCorruptImages) {
+  auto image = CompressedContractFile::Encode(MinuteBars(100));
+  TimeSeries loaded;
+
+  auto bad_magic = image;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(CompressedContractFile::Decode(bad_magic.data(),
+                                              bad_magic.size(), loaded));
+
+  EXPECT_FALSE(CompressedContractFile::Decode(image.data(), image.size() - 1,
+                                              loaded));
+  EXPECT_FALSE(CompressedContractFile::Decode(image.data(), 10, loaded));
+
+  auto bad_rows = image;
+  const uint64_t huge = 1ULL << 40;
+  std::memcpy(bad_rows.data() + 8, &huge, sizeof(huge));
+  EXPECT_FALSE(CompressedContractFile::Decode(bad_rows.data(),
+                                              bad_rows.size(), loaded));
+  EXPECT_TRUE(loaded.Timestamps().empty());
+
+  EXPECT_FALSE(CompressedContractFile::Read(test_dir + "/missing.acz", loaded));
+}
+
+TEST_F(CompressedContractFileTest, CatalogPrefersCompressedFile) {
+  const std::string root = test_dir + "/root";
+  std::filesystem::create_directories(root + "/ZC/H");
+  {
+    std::ofstream file(root + "/ZC/H/2024.csv");
+    file << "timestamp,close,open,high,low,volume\n"
+         << "2024-01-02 09:00:00,1,1,1,1,1\n";
+  }
+  TimeSeries bars = MinuteBars(10);
+  ASSERT_TRUE(CompressedContractFile::Write(root + "/ZC/H/2024.acz", bars));
+
+  DataManager::configureDataRoots({root});
+  auto entry = DataManager::catalog()->Find(
+      ContractId::FromContract({"ZC", ExpirationMonth::H, 2024}));
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(entry->path, root + "/ZC/H/2024.acz");
+
+  TimeSeries loaded =
+      DataManager::loadContractData({"ZC", ExpirationMonth::H, 2024});
+  ExpectIdentical(bars, loaded);
+}
+
+TEST_F(CompressedContractFileTest, DecodeTiming) {
+  TimeSeries bars = MinuteBars(1000000);
+  auto image = CompressedContractFile::Encode(bars);
+
+  TimeSeries loaded;
+  auto start = std::chrono::high_resolution_clock::now();
+  ASSERT_TRUE(CompressedContractFile::Decode(image.data(), image.size(),
+                                             loaded));
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  EXPECT_EQ(loaded.Timestamps().size(), 1000000u);
+  EXPECT_LT(elapsed.count(), 2000);
+  std::cout << "Decoded 1M rows (" << image.size() / 1024
+            << " KiB) in " << elapsed.count() << " ms" << std::endl;
+}
+
+TEST_F(CompressedContractFileTest, ReadTimingAgainstCsv) {
+  // The same 500k minute bars as CSV and as .acz
+  const TimeSeries bars = MinuteBars(500000);
+  const std::string csv = test_dir + "/2024.csv";
+  {
+    std::ofstream file(csv);
+    file << "timestamp,close,open,high,low,volume\n";
+    char line[160];
+    for (size_t i = 0; i < bars.Timestamps().size(); ++i) {
+      const time_t seconds = bars.Timestamps()[i] / 1000;
+      std::tm tm{};
+      gmtime_r(&seconds, &tm);
+      char stamp[32];
+      std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &tm);
+      std::snprintf(line, sizeof(line), "%s,%.2f,%.2f,%.2f,%.2f,%.0f\n",
+                    stamp, bars.Closes()[i], bars.Opens()[i], bars.Highs()[i],
+                    bars.Lows()[i], bars.Volumes()[i]);
+      file << line;
+    }
+  }
+  const std::string acz = test_dir + "/2024.acz";
+  ASSERT_TRUE(CompressedContractFile::ConvertCsv(csv, acz));
+
+  TimeSeries from_csv;
+  ContractCsvReader reader;
+  auto start = std::chrono::high_resolution_clock::now();
+  ASSERT_TRUE(reader.read_csv_mmap(csv, from_csv, true));
+  auto csv_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  TimeSeries from_acz;
+  start = std::chrono::high_resolution_clock::now();
+  ASSERT_TRUE(CompressedContractFile::Read(acz, from_acz));
+  auto acz_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  ExpectIdentical(from_csv, from_acz);
+  EXPECT_EQ(from_acz.Closes(), bars.Closes());
+  EXPECT_LT(acz_ms.count(), csv_ms.count());
+  std::cout << "500k rows: CSV " << csv_ms.count() << " ms ("
+            << std::filesystem::file_size(csv) / 1024 << " KiB), .acz "
+            << acz_ms.count() << " ms ("
+            << std::filesystem::file_size(acz) / 1024 << " KiB)" << std::endl;
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "ContractCsvReader.hpp"
+#include "ContractId.hpp"
+
+class ContractIdTest : public ::testing::Test {
+ protected:
+  Contract corn_contract = {"ZC", ExpirationMonth::H, 2025};
+};
+
+TEST_F(ContractIdTest, ConstexprRoundTrip) {
+  constexpr ContractId id = ContractId::Encode(7, ExpirationMonth::Z, 2031);
+  static_assert(id.SymbolIndex() == 7);
+  static_assert(id.Month() == ExpirationMonth::Z);
+  static_assert(id.Year() == 2031);
+  static_assert(sizeof(ContractId) == sizeof(uint32_t));
+  EXPECT_EQ(id.Raw(), (7u << 16) | ((2031u - 1900u) << 4) | 11u);
+}
+
+TEST_F(ContractIdTest, FromContractInternsSymbol) {
+  ContractId a = ContractId::FromContract(corn_contract);
+  ContractId b = ContractId::FromContract({"ZC", ExpirationMonth::K, 2025});
+  ContractId c = ContractId::FromContract({"ZS", ExpirationMonth::H, 2025});
+
+  EXPECT_EQ(a.SymbolIndex(), b.SymbolIndex());
+  EXPECT_NE(a.SymbolIndex(), c.SymbolIndex());
+  EXPECT_EQ(SymbolTable::Instance().Symbol(a.SymbolIndex()), "ZC");
+
+  Contract back = a.ToContract();
+  EXPECT_EQ(back.symbol, "ZC");
+  EXPECT_EQ(back.expirationMonth, ExpirationMonth::H);
+  EXPECT_EQ(back.expirationYear, 2025);
+}
+
+TEST_F(ContractIdTest, OrderingIsSymbolThenExpiry) {
+  uint16_t zc = SymbolTable::Instance().Intern("ZC");
+  ContractId h25 = ContractId::Encode(zc, ExpirationMonth::H, 2025);
+  ContractId z24 = ContractId::Encode(zc, ExpirationMonth::Z, 2024);
+  ContractId k25 = ContractId::Encode(zc, ExpirationMonth::K, 2025);
+
+  std::vector<ContractId> ids = {k25, h25, z24};
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(ids, (std::vector<ContractId>{z24, h25, k25}));
+  EXPECT_LT(h25, k25);
+  EXPECT_GE(k25, h25);
+}
+
+TEST_F(ContractIdTest, HashingAndMapKeys) {
+  std::unordered_set<ContractId> set;
+  std::map<ContractId, int> map;
+  for (int year = 2000; year < 2030; ++year) {
+    for (int m = 0; m < 12; ++m) {
+      ContractId id = ContractId::FromContract(
+          {"ZW", static_cast<ExpirationMonth>(m), year});
+      set.insert(id);
+      map[id] = year;
+    }
+  }
+  EXPECT_EQ(set.size(), 360);
+  EXPECT_EQ(map.size(), 360);
+  EXPECT_EQ(map.begin()->first.Year(), 2000);
+}
+
+TEST_F(ContractIdTest, YearOutOfRangeThrows) {
+  EXPECT_THROW(ContractId::FromContract({"ZC", ExpirationMonth::H, 1899}),
+               std::out_of_range);
+  EXPECT_THROW(ContractId::FromContract({"ZC", ExpirationMonth::H, 6000}),
+               std::out_of_range);
+}
+
+TEST_F(ContractIdTest, ConcurrentInterning) {
+  std::vector<std::thread> threads;
+  std::vector<uint16_t> indices(8);
+  for (size_t t = 0; t < indices.size(); ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) SymbolTable::Instance().Intern("HE");
+      indices[t] = SymbolTable::Instance().Intern("HE");
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (uint16_t index : indices) EXPECT_EQ(index, indices[0]);
+}
+
+TEST_F(ContractIdTest, PathLookupMatchesStringPath) {
+  ContractId id = ContractId::FromContract(corn_contract);
+  const std::string& path = PathFinder::find_contract_csv(id);
+  EXPECT_EQ(path, PathFinder::find_contract_csv(corn_contract));
+  EXPECT_EQ(&path, &PathFinder::find_contract_csv(id));
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <chrono>
 #include <fstream>
 #include <filesystem>
+#include <sstream>
+#include <thread>
 
 #include "Contract.hpp"
 #include "ContractCsvReader.hpp"
@@ -247,4 +250,194 @@ TEST_F(CsvReaderTest, ReadDataWithNegativeValues) {
   
   EXPECT_DOUBLE_EQ(data.Opens()[0], -100.0);
   EXPECT_DOUBLE_EQ(data.Lows()[0], -99.0);
-}
\ No newline at end of file
+}
+TEST_F(CsvReaderTest, TimestampsAreEpochMilliseconds) {
+  CreateTestFile("timestamps.csv", test_csv_content);
+
+  TimeSeries stream_data;
+  TimeSeries mmap_data;
+  reader.read_csv_stream(test_dir + "/timestamps.csv", stream_data, true);
+  reader.read_csv_mmap(test_dir + "/timestamps.csv", mmap_data, true);
+
+  // 2025-01-01 09:00:00 and 10:00:00, wall clock taken as UTC
+  ASSERT_EQ(stream_data.Timestamps().size(), 4);
+  EXPECT_EQ(stream_data.Timestamps()[0], 1735722000000ULL);
+  EXPECT_EQ(stream_data.Timestamps()[1], 1735725600000ULL);
+  EXPECT_EQ(mmap_data.Timestamps(), stream_data.Timestamps());
+}
+
+TEST_F(CsvReaderTest, MalformedRowsKeepColumnsAligned) {
+  CreateTestFile("malformed.csv", malformed_csv);
+
+  TimeSeries mmap_data;
+  TimeSeries stream_data;
+  ASSERT_TRUE(reader.read_csv_mmap(test_dir + "/malformed.csv", mmap_data));
+  ASSERT_TRUE(
+      reader.read_csv_stream(test_dir + "/malformed.csv", stream_data, true));
+
+  for (const TimeSeries* data : {&mmap_data, &stream_data}) {
+    ASSERT_EQ(data->Timestamps().size(), 1);
+    EXPECT_EQ(data->Opens().size(), 1);
+    EXPECT_EQ(data->Highs().size(), 1);
+    EXPECT_EQ(data->Lows().size(), 1);
+    EXPECT_EQ(data->Closes().size(), 1);
+    EXPECT_EQ(data->Volumes().size(), 1);
+    EXPECT_DOUBLE_EQ(data->Closes()[0], 109.0);
+    EXPECT_DOUBLE_EQ(data->Volumes()[0], 1200);
+  }
+}
+
+TEST_F(CsvReaderTest, ValidateModeLogsRejectedRows) {
+  CreateTestFile("dirty.csv",
+                 "timestamp,close,open,high,low,volume\n"
+                 "2025-01-01 09:00:00,104.0,100.0,105.0,99.0,1000\n"
+                 "2025-01-01 09:01:00,104.0,100.0,105.0\n"
+                 "2025-13-01 09:02:00,104.0,100.0,105.0,99.0,1000\n"
+                 "2025-01-01 09:03:00,104.0,1OO.0,105.0,99.0,1000\n"
+                 "2025-01-01 09:04:00,104.0,100.0,105.0,99.0,1000,7\n"
+                 "\n"
+                 "2025-01-01 09:05:00,104.5,100.0,105.0,99.0,12.5\n"
+                 "2025-01-01 09:06:00,105.0,100.0,106.0,99.0,1100\r\n");
+
+  TimeSeries data;
+  std::vector<ParseError> errors;
+  ASSERT_TRUE(reader.read_csv_mmap<ParseMode::kValidate>(
+      test_dir + "/dirty.csv", data, true, ReadaheadPolicy::kAuto, &errors));
+
+  ASSERT_EQ(data.Timestamps().size(), 2);
+  EXPECT_EQ(data.Volumes().size(), 2);
+  EXPECT_DOUBLE_EQ(data.Closes()[1], 105.0);
+
+  ASSERT_EQ(errors.size(), 5);
+  EXPECT_EQ(errors[0].line, 3u);
+  EXPECT_EQ(errors[0].reason, ParseErrorReason::kMissingField);
+  EXPECT_EQ(errors[1].line, 4u);
+  EXPECT_EQ(errors[1].reason, ParseErrorReason::kBadTimestamp);
+  EXPECT_EQ(errors[2].line, 5u);
+  EXPECT_EQ(errors[2].reason, ParseErrorReason::kBadNumber);
+  EXPECT_EQ(errors[3].line, 6u);
+  EXPECT_EQ(errors[3].reason, ParseErrorReason::kExtraField);
+  EXPECT_EQ(errors[4].line, 8u);
+  EXPECT_EQ(errors[4].reason, ParseErrorReason::kBadNumber);
+  EXPECT_STREQ(ParseErrorReasonToString(errors[4].reason), "bad number");
+}
+
+TEST_F(CsvReaderTest, ValidateModeMatchesFastModeOnCleanData) {
+  CreateTestFile("clean.csv", test_csv_content);
+
+  TimeSeries fast;
+  TimeSeries validated;
+  std::vector<ParseError> errors;
+  ASSERT_TRUE(reader.read_csv_mmap(test_dir + "/clean.csv", fast));
+  ASSERT_TRUE(reader.read_csv_mmap<ParseMode::kValidate>(
+      test_dir + "/clean.csv", validated, true, ReadaheadPolicy::kAuto,
+      &errors));
+
+  EXPECT_TRUE(errors.empty());
+  EXPECT_EQ(fast.Timestamps(), validated.Timestamps());
+  EXPECT_EQ(fast.Closes(), validated.Closes());
+  EXPECT_EQ(fast.Volumes(), validated.Volumes());
+}
+
+TEST_F(CsvReaderTest, DeferredColumnsMatchEagerParse) {
+  CreateTestFile("lazy.csv",
+                 "timestamp,close,open,high,low,volume\r\n"
+                 "2025-01-01 09:00:00,104.0,100.0,105.0,99.0,1000\r\n"
+                 "2025-01-01 10:00:00,107.0,104.0\r\n"  // Rejected
+                 "2025-01-01 11:00:00,109.0,107.0,110.0,106.0,1200\r\n"
+                 "2025-01-01 12:00:00,-1.5,109.0,112.0,108.0,1300");
+  const std::string path = test_dir + "/lazy.csv";
+  TimeSeries eager;
+  ASSERT_TRUE(reader.read_csv_mmap(path, eager, true));
+
+  TimeSeries lazy;
+  ASSERT_TRUE(reader.read_csv_mmap(path, lazy, true, ReadaheadPolicy::kAuto,
+                                   nullptr, SeriesColumn::kClose));
+  EXPECT_EQ(lazy.DeferredColumnMask(),
+            SeriesColumn::kOpen | SeriesColumn::kHigh | SeriesColumn::kLow |
+                SeriesColumn::kVolume);
+  EXPECT_EQ(lazy.Timestamps(), eager.Timestamps());
+  EXPECT_EQ(lazy.Closes(), eager.Closes());
+
+  // A copy materializes independently of the original
+  TimeSeries copy = lazy;
+  EXPECT_EQ(copy.Volumes(), eager.Volumes());
+  EXPECT_EQ(copy.DeferredColumnMask() & SeriesColumn::kVolume, 0u);
+  EXPECT_NE(lazy.DeferredColumnMask() & SeriesColumn::kVolume, 0u);
+
+  EXPECT_EQ(lazy.Opens(), eager.Opens());
+  EXPECT_EQ(lazy.Highs(), eager.Highs());
+  EXPECT_EQ(lazy.Lows(), eager.Lows());
+  EXPECT_EQ(lazy.Volumes(), eager.Volumes());
+  EXPECT_EQ(lazy.DeferredColumnMask(), 0u);
+}
+
+TEST_F(CsvReaderTest, DeferredColumnsFirstAccessIsThreadSafe) {
+  std::string content = "timestamp,close,open,high,low,volume\n";
+  for (int i = 0; i < 20000; ++i) {
+    content += "2025-01-01 09:00:00," + std::to_string(100 + i % 50) +
+               ".25,100.0,105.0,99.0," + std::to_string(i) + "\n";
+  }
+  CreateTestFile("shared.csv", content);
+  TimeSeries lazy;
+  ASSERT_TRUE(reader.read_csv_mmap(test_dir + "/shared.csv", lazy, true,
+                                   ReadaheadPolicy::kAuto, nullptr,
+                                   SeriesColumn::kClose));
+
+  std::vector<double> sums(4, 0.0);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < sums.size(); ++t) {
+    workers.emplace_back([&, t] {
+      for (double v : lazy.Volumes()) sums[t] += v;
+    });
+  }
+  for (auto& worker : workers) worker.join();
+  for (double sum : sums) EXPECT_DOUBLE_EQ(sum, 19999.0 * 20000.0 / 2.0);
+}
+
+TEST_F(CsvReaderTest, DeferredOptionalColumns) {
+  CreateTestFile("oi.csv",
+                 "timestamp,open,high,low,close,volume,open_interest\n"
+                 "2025-01-01 09:00:00,100.0,105.0,99.0,104.0,1000,52000\n"
+                 "2025-01-01 10:00:00,104.0,108.0,103.0,107.0,1100,52100\n");
+  TimeSeries data;
+  ASSERT_TRUE(reader.read_csv_detect(test_dir + "/oi.csv", data,
+                                     ParseMode::kFast, ReadaheadPolicy::kAuto,
+                                     nullptr, SeriesColumn::kClose));
+  EXPECT_TRUE(data.HasColumn(TimeSeries::kOpenInterest));
+  EXPECT_EQ(data.OpenInterest(), (std::vector<double>{52000.0, 52100.0}));
+  EXPECT_EQ(data.Opens(), (std::vector<double>{100.0, 104.0}));
+
+  // Materialize() releases the source once nothing is deferred
+  data.Materialize();
+  EXPECT_EQ(data.DeferredColumnMask(), 0u);
+  EXPECT_EQ(data.Volumes(), (std::vector<double>{1000.0, 1100.0}));
+}
+
+TEST_F(CsvReaderTest, CloseOnlyParseTiming) {
+  std::ostringstream out;
+  out << "timestamp,close,open,high,low,volume\n";
+  for (int i = 0; i < 500000; ++i) {
+    out << "2025-01-01 10:00:00," << 100 + i % 7 << ".25,100.125,101.5,"
+        << "99.75," << i << "\n";
+  }
+  CreateTestFile("wide.csv", out.str());
+  const std::string path = test_dir + "/wide.csv";
+
+  TimeSeries data;
+  auto start = std::chrono::high_resolution_clock::now();
+  ASSERT_TRUE(reader.read_csv_mmap(path, data, true));
+  auto full = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  TimeSeries closes;
+  start = std::chrono::high_resolution_clock::now();
+  ASSERT_TRUE(reader.read_csv_mmap(path, closes, true, ReadaheadPolicy::kAuto,
+                                   nullptr, SeriesColumn::kClose));
+  auto close_only = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  EXPECT_EQ(closes.Closes(), data.Closes());
+  std::cout << "500k rows: all columns " << full.count()
+            << " ms, close only " << close_only.count() << " ms" << std::endl;
+}
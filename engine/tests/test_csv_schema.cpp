@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "BulkLoader.hpp"
+#include "ContractCsvReader.hpp"
+#include "CsvSchema.hpp"
+
+class CsvSchemaTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir = "/tmp/csv_schema_test";
+    std::filesystem::create_directories(test_dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(test_dir); }
+
+  std::string Write(const std::string& name, const std::string& contents) {
+    const std::string path = test_dir + "/" + name;
+    std::ofstream(path) << contents;
+    return path;
+  }
+
+  static void ExpectSeries(const TimeSeries& data) {
+    ASSERT_EQ(data.Timestamps().size(), 2u);
+    EXPECT_EQ(data.Timestamps()[0], 1735722000000ULL);  // 2025-01-01 09:00
+    EXPECT_DOUBLE_EQ(data.Opens()[0], 100.0);
+    EXPECT_DOUBLE_EQ(data.Highs()[0], 105.0);
+    EXPECT_DOUBLE_EQ(data.Lows()[0], 99.0);
+    EXPECT_DOUBLE_EQ(data.Closes()[0], 104.0);
+    EXPECT_DOUBLE_EQ(data.Volumes()[0], 1000.0);
+    EXPECT_DOUBLE_EQ(data.Closes()[1], 107.0);
+    EXPECT_DOUBLE_EQ(data.Volumes()[1], 1100.0);
+  }
+
+  std::string test_dir;
+};
+
+TEST_F(CsvSchemaTest, DefaultSchemaMatchesAlchemathLayout) {
+  const std::string csv =
+      "timestamp,close,open,high,low,volume\n"
+      "2025-01-01 09:00:00,104.0,100.0,105.0,99.0,1000\n"
+      "2025-01-01 10:00:00,107.0,104.0,108.0,103.0,1100\n";
+  TimeSeries data;
+  ASSERT_TRUE(csv::DefaultSchema::Parse<ParseMode::kFast>(
+      csv.data(), csv.size(), data, true, nullptr));
+  ExpectSeries(data);
+  EXPECT_EQ(csv::DefaultSchema::kColumns, 6u);
+  EXPECT_EQ(csv::DefaultSchema::Names()[1], "close");
+}
+
+TEST_F(CsvSchemaTest, HeaderTokensAreNormalized) {
+  auto tokens = csv::SplitHeader("\"Date Time\", Open ,HIGH,low,Last,Vol\r");
+  ASSERT_EQ(tokens.size(), 6u);
+  EXPECT_EQ(tokens[0], "Date Time");
+  EXPECT_EQ(tokens[1], "Open");
+  EXPECT_TRUE(csv::Timestamp::Accepts(tokens[0]));
+  EXPECT_TRUE(csv::Open::Accepts(tokens[1]));
+  EXPECT_TRUE(csv::High::Accepts(tokens[2]));
+  EXPECT_TRUE(csv::Close::Accepts(tokens[4]));
+  EXPECT_TRUE(csv::Volume::Accepts(tokens[5]));
+  EXPECT_TRUE(csv::OpenInterest::Accepts("Open Interest"));
+  EXPECT_FALSE(csv::Close::Accepts("open"));
+}
+
+TEST_F(CsvSchemaTest, RegistrySelectsLayoutByHeader) {
+  const auto& registry = CsvSchemaRegistry::Instance();
+  ASSERT_NE(registry.Match("timestamp,close,open,high,low,volume"), nullptr);
+  EXPECT_EQ(registry.Match("timestamp,close,open,high,low,volume")->name,
+            "alchemath");
+  EXPECT_EQ(registry.Match("Date,Open,High,Low,Close,Volume")->name, "ohlcv");
+  EXPECT_EQ(registry.Match("time,o,h,l,c,v,oi")->name, "ohlcv_oi");
+  EXPECT_EQ(
+      registry.Match("timestamp,close,open,high,low,volume,open_interest")
+          ->name,
+      "alchemath_oi");
+  EXPECT_EQ(registry.Match("symbol,price"), nullptr);
+  EXPECT_NE(registry.Find("ohlcv"), nullptr);
+  EXPECT_EQ(registry.Find("nope"), nullptr);
+}
+
+TEST_F(CsvSchemaTest, VendorLayoutsParseToSameSeries) {
+  ContractCsvReader reader;
+  const std::string ohlcv = Write(
+      "ohlcv.csv",
+      "Date,Open,High,Low,Close,Volume\r\n"
+      "2025-01-01 09:00:00,100.0,105.0,99.0,104.0,1000\r\n"
+      "2025-01-01 10:00:00,104.0,108.0,103.0,107.0,1100\r\n");
+  const std::string with_oi = Write(
+      "oi.csv",
+      "timestamp,open,high,low,close,volume,open_interest\n"
+      "2025-01-01 09:00:00,100.0,105.0,99.0,104.0,1000,52000\n"
+      "2025-01-01 10:00:00,104.0,108.0,103.0,107.0,1100,52100\n");
+  const std::string unknown = Write(
+      "unknown.csv",
+      "a,b,c,d,e,f\n"
+      "2025-01-01 09:00:00,104.0,100.0,105.0,99.0,1000\n"
+      "2025-01-01 10:00:00,107.0,104.0,108.0,103.0,1100\n");
+
+  for (const auto& path : {ohlcv, with_oi, unknown}) {
+    TimeSeries data;
+    ASSERT_TRUE(reader.read_csv_detect(path, data)) << path;
+    ExpectSeries(data);
+  }
+}
+
+TEST_F(CsvSchemaTest, OpenInterestAndSettlementFillOptionalColumns) {
+  const std::string csv =
+      "Date,Open,High,Low,Close,Settle,Volume,Open Interest\n"
+      "2025-01-01 09:00:00,100.0,105.0,99.0,104.0,104.25,1000,52000\n"
+      "2025-01-01 10:00:00,104.0,108.0,103.0,107.0,106.75,1100,52100\n";
+  TimeSeries data;
+  ContractCsvReader reader;
+  ASSERT_TRUE(reader.parse_csv_detect(csv.data(), csv.size(), data));
+  ExpectSeries(data);
+  EXPECT_EQ(data.OpenInterest(), (std::vector<double>{52000.0, 52100.0}));
+  EXPECT_EQ(data.Settlements(), (std::vector<double>{104.25, 106.75}));
+
+  // Reusing the series for a file without them drops the columns
+  const std::string plain =
+      "timestamp,close,open,high,low,volume\n"
+      "2025-01-01 09:00:00,104.0,100.0,105.0,99.0,1000\n"
+      "2025-01-01 10:00:00,107.0,104.0,108.0,103.0,1100\n";
+  ASSERT_TRUE(reader.parse_csv_detect(plain.data(), plain.size(), data));
+  ExpectSeries(data);
+  EXPECT_TRUE(data.OptionalColumns().empty());
+}
+
+TEST_F(CsvSchemaTest, ValidationFollowsTheLayout) {
+  const std::string csv =
+      "timestamp,open,high,low,close,volume,open_interest\n"
+      "2025-01-01 09:00:00,100.0,105.0,99.0,104.0,1000,52000\n"
+      "2025-01-01 10:00:00,104.0,108.0,103.0,107.0,1100\n"
+      "2025-01-01 11:00:00,104.0,108.0,103.0,107.0,1100,x\n"
+      "2025-01-01 12:00:00,104.0,108.0,103.0,107.0,1100,1,2\n";
+  TimeSeries data;
+  std::vector<ParseError> errors;
+  ContractCsvReader reader;
+  ASSERT_TRUE(reader.parse_csv_detect(csv.data(), csv.size(), data,
+                                      ParseMode::kValidate, &errors));
+  EXPECT_EQ(data.Timestamps().size(), 1u);
+  ASSERT_EQ(errors.size(), 3u);
+  EXPECT_EQ(errors[0].line, 3u);
+  EXPECT_EQ(errors[0].reason, ParseErrorReason::kMissingField);
+  EXPECT_EQ(errors[1].reason, ParseErrorReason::kBadNumber);
+  EXPECT_EQ(errors[2].reason, ParseErrorReason::kExtraField);
+}
+
+TEST_F(CsvSchemaTest, CustomLayoutsCanBeRegistered) {
+  using namespace csv;
+  CsvSchemaRegistry::Instance()
+      .Register<Schema<Skip, Timestamp, Close, Volume>>("test_close_only");
+
+  const std::string csv =
+      "symbol,timestamp,close,volume\n"
+      "ZCH25,2025-01-01 09:00:00,104.0,1000\n";
+  TimeSeries data;
+  ContractCsvReader reader;
+  ASSERT_TRUE(reader.parse_csv_detect(csv.data(), csv.size(), data));
+  ASSERT_EQ(data.Timestamps().size(), 1u);
+  // Missing price columns fall back to the close
+  EXPECT_DOUBLE_EQ(data.Opens()[0], 104.0);
+  EXPECT_DOUBLE_EQ(data.Highs()[0], 104.0);
+  EXPECT_DOUBLE_EQ(data.Lows()[0], 104.0);
+  EXPECT_DOUBLE_EQ(data.Volumes()[0], 1000.0);
+}
+
+TEST_F(CsvSchemaTest, BulkLoaderDetectsLayouts) {
+  const std::string path = Write(
+      "bulk.csv",
+      "Date,Open,High,Low,Close,Volume\n"
+      "2025-01-01 09:00:00,100.0,105.0,99.0,104.0,1000\n"
+      "2025-01-01 10:00:00,104.0,108.0,103.0,107.0,1100\n");
+  auto results = BulkLoader().Load({path});
+  ASSERT_TRUE(results[0].ok);
+  ExpectSeries(results[0].data);
+}
+
+TEST_F(CsvSchemaTest, GeneratedParserTiming) {
+  std::ostringstream out;
+  out << "timestamp,open,high,low,close,volume,open_interest\n";
+  for (int i = 0; i < 500000; ++i) {
+    out << "2025-01-01 " << (10 + i / 3600 % 10) << ":"
+        << (i / 60 % 60 < 10 ? "0" : "") << i / 60 % 60 << ":"
+        << (i % 60 < 10 ? "0" : "") << i % 60 << ",100.25,101.5,99.75,"
+        << 100 + i % 7 << ".5," << i << "," << 50000 + i << "\n";
+  }
+  const std::string csv = out.str();
+
+  TimeSeries data;
+  ContractCsvReader reader;
+  auto start = std::chrono::high_resolution_clock::now();
+  ASSERT_TRUE(reader.parse_csv_detect(csv.data(), csv.size(), data));
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  EXPECT_EQ(data.Timestamps().size(), 500000u);
+  std::cout << "500k rows (ohlcv_oi layout): " << elapsed.count() << " ms"
+            << std::endl;
+}
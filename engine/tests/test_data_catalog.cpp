@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "ContractCsvReader.hpp"
+#include "DataCatalog.hpp"
+#include "DataManager.hpp"
+
+class DataCatalogTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    primary = "/tmp/data_catalog_test/primary";
+    archive = "/tmp/data_catalog_test/archive";
+    std::filesystem::create_directories(primary);
+    std::filesystem::create_directories(archive);
+
+    CreateContractFile(primary, "ZC", "H", "2024");
+    CreateContractFile(primary, "ZC", "K", "2024");
+    CreateContractFile(primary, "ZS", "F", "2025");
+    CreateContractFile(archive, "ZC", "Z", "2010");
+    CreateContractFile(archive, "ZC", "H", "2024", "2024-01-01 09:00:00,1,1,1,1,1\n");
+    // Ignored: not a contract file name
+    CreateContractFile(primary, "ZC", "H", "notes", "x");
+  }
+
+  void TearDown() override {
+    DataManager::configureDataRoots({});
+    std::filesystem::remove_all("/tmp/data_catalog_test");
+  }
+
+  std::string CreateContractFile(const std::string& root,
+                                 const std::string& symbol,
+                                 const std::string& month,
+                                 const std::string& year,
+                                 const std::string& rows = csv_rows) {
+    std::filesystem::create_directories(root + "/" + symbol + "/" + month);
+    std::string path = root + "/" + symbol + "/" + month + "/" + year + ".csv";
+    std::ofstream file(path);
+    file << "timestamp,close,open,high,low,volume\n" << rows;
+    return path;
+  }
+
+  template <typename Pred>
+  bool WaitFor(Pred pred) {
+    for (int i = 0; i < 200 && !pred(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return pred();
+  }
+
+  static inline const std::string csv_rows =
+      "2024-01-02 09:00:00,104.0,100.0,105.0,99.0,1000\n"
+      "2024-01-02 10:00:00,107.0,104.0,108.0,103.0,1100\n";
+
+  std::string primary;
+  std::string archive;
+};
+
+TEST_F(DataCatalogTest, ScansRootsOnce) {
+  DataCatalog catalog({primary, archive, "/tmp/data_catalog_test/missing"});
+
+  EXPECT_EQ(catalog.Size(), 4);
+  auto zc = catalog.Expiries("ZC");
+  ASSERT_EQ(zc.size(), 3);
+  EXPECT_EQ(zc[0].Year(), 2010);
+  EXPECT_EQ(zc[1].Month(), ExpirationMonth::H);
+  EXPECT_EQ(zc[2].Month(), ExpirationMonth::K);
+  EXPECT_EQ(catalog.Expiries("ZS").size(), 1);
+  EXPECT_TRUE(catalog.Expiries("ZW").empty());
+
+  // Looking up an unknown symbol does not intern it
+  const size_t symbols = SymbolTable::Instance().Size();
+  EXPECT_TRUE(catalog.Expiries("NEVER_INTERNED").empty());
+  EXPECT_EQ(SymbolTable::Instance().Size(), symbols);
+  EXPECT_FALSE(SymbolTable::Instance().Find("NEVER_INTERNED"));
+}
+
+TEST_F(DataCatalogTest, FirstRootWins) {
+  DataCatalog catalog({primary, archive});
+  auto entry =
+      catalog.Find(ContractId::FromContract({"ZC", ExpirationMonth::H, 2024}));
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(entry->path, primary + "/ZC/H/2024.csv");
+  EXPECT_GT(entry->size_bytes, 0);
+  EXPECT_GT(entry->mtime_ns, 0);
+
+  EXPECT_FALSE(
+      catalog.Find(ContractId::FromContract({"ZC", ExpirationMonth::N, 2024}))
+          .has_value());
+}
+
+TEST_F(DataCatalogTest, WatcherTracksChanges) {
+  DataCatalog catalog({primary, archive});
+  ASSERT_TRUE(catalog.StartWatching());
+
+  ContractId n24 = ContractId::FromContract({"ZC", ExpirationMonth::N, 2024});
+  CreateContractFile(primary, "ZC", "N", "2024");
+  EXPECT_TRUE(WaitFor([&] { return catalog.Find(n24).has_value(); }));
+
+  // A brand-new symbol directory is picked up too
+  ContractId ng = ContractId::FromContract({"NG", ExpirationMonth::F, 2026});
+  CreateContractFile(primary, "NG", "F", "2026");
+  EXPECT_TRUE(WaitFor([&] { return catalog.Find(ng).has_value(); }));
+
+  // Removing the primary copy falls back to the archive
+  ContractId h24 = ContractId::FromContract({"ZC", ExpirationMonth::H, 2024});
+  std::filesystem::remove(primary + "/ZC/H/2024.csv");
+  EXPECT_TRUE(WaitFor([&] {
+    auto e = catalog.Find(h24);
+    return e && e->path == archive + "/ZC/H/2024.csv";
+  }));
+
+  catalog.StopWatching();
+}
+
+TEST_F(DataCatalogTest, PollChangesWithoutThread) {
+  DataCatalog catalog({primary});
+  catalog.PollChanges();
+
+  CreateContractFile(primary, "ZC", "U", "2024");
+  EXPECT_GE(catalog.PollChanges(), 1);
+  EXPECT_TRUE(
+      catalog.Find(ContractId::FromContract({"ZC", ExpirationMonth::U, 2024}))
+          .has_value());
+}
+
+TEST_F(DataCatalogTest, DataManagerLoadsThroughCatalog) {
+  DataManager::configureDataRoots({primary, archive});
+  ASSERT_NE(DataManager::catalog(), nullptr);
+
+  TimeSeries data = DataManager::loadContractData({"ZC", ExpirationMonth::K, 2024});
+  EXPECT_EQ(data.Timestamps().size(), 2);
+
+  TimeSeries archived =
+      DataManager::loadContractData({"ZC", ExpirationMonth::Z, 2010});
+  EXPECT_EQ(archived.Timestamps().size(), 2);
+
+  try {
+    DataManager::loadContractData({"ZC", ExpirationMonth::N, 2030});
+    FAIL() << "Expected missing contract to throw";
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("Failed to load"), std::string::npos);
+  }
+}
+
+TEST_F(DataCatalogTest, ContractDataVersionComesFromCatalog) {
+  DataManager::configureDataRoots({primary});
+  const Contract corn = {"ZC", ExpirationMonth::K, 2024};
+  const uint64_t before = DataManager::contractDataVersion(corn);
+  EXPECT_NE(before, 0u);
+  EXPECT_EQ(DataManager::contractDataVersion({"ZC", ExpirationMonth::N, 2030}),
+            0u);
+
+  // Rewrites are seen through the catalog, not by stat() on every lookup
+  const std::string path = CreateContractFile(primary, "ZC", "K", "2024",
+                                              csv_rows + csv_rows);
+  std::filesystem::last_write_time(
+      path, std::filesystem::last_write_time(path) + std::chrono::seconds(5));
+  EXPECT_EQ(DataManager::contractDataVersion(corn), before);
+  DataManager::catalog()->Rescan();
+  EXPECT_NE(DataManager::contractDataVersion(corn), before);
+}
+
+TEST_F(DataCatalogTest, PathFinderConfigurableRoot) {
+  const std::string previous = PathFinder::data_root();
+  PathFinder::set_data_root(primary);
+
+  Contract corn = {"ZC", ExpirationMonth::K, 2024};
+  EXPECT_EQ(PathFinder::find_contract_csv(corn), primary + "/ZC/K/2024.csv");
+  EXPECT_EQ(PathFinder::find_contract_csv(ContractId::FromContract(corn)),
+            primary + "/ZC/K/2024.csv");
+  EXPECT_EQ(DataManager::loadContractData(corn).Timestamps().size(), 2);
+
+  PathFinder::set_data_root(previous);
+  EXPECT_EQ(PathFinder::data_root(), previous);
+}
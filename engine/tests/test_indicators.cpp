@@ -0,0 +1,317 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Indicators.hpp"
+
+using namespace indicators;
+
+class IndicatorsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::mt19937_64 rng(17);
+    double level = 100.0;
+    for (size_t t = 0; t < 500; ++t) {
+      OHLCV bar{};
+      bar.timestamp = 1000 + t;
+      bar.open = level;
+      level += Noise(rng);
+      bar.close = level;
+      bar.high = std::max(bar.open, bar.close) + 0.5 * (Noise(rng) + 1.0);
+      bar.low = std::min(bar.open, bar.close) - 0.5 * (Noise(rng) + 1.0);
+      bar.volume = 10.0;
+      bars_.push_back(bar);
+      closes_.push_back(bar.close);
+      highs_.push_back(bar.high);
+      lows_.push_back(bar.low);
+    }
+  }
+
+  // Uniform noise in [-1, 1), independent of the standard library's
+  // distribution implementations
+  static double Noise(std::mt19937_64 &rng) {
+    return static_cast<double>(rng() >> 11) * 0x1.0p-52 - 1.0;
+  }
+
+  // Both NaN, or within `tolerance`
+  static void ExpectColumn(const std::vector<double> &actual,
+                           const std::vector<double> &expected,
+                           double tolerance) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+      if (std::isnan(expected[i])) {
+        ASSERT_TRUE(std::isnan(actual[i])) << "row " << i;
+      } else {
+        ASSERT_NEAR(actual[i], expected[i], tolerance) << "row " << i;
+      }
+    }
+  }
+
+  static std::vector<double> ReferenceEma(const std::vector<double> &x,
+                                          size_t period) {
+    std::vector<double> out(x.size(), NAN);
+    double sum = 0.0;
+    for (size_t i = 0; i < period && i < x.size(); ++i) sum += x[i];
+    if (x.size() < period) return out;
+    double s = sum / period;
+    out[period - 1] = s;
+    const double alpha = 2.0 / (period + 1.0);
+    for (size_t i = period; i < x.size(); ++i) {
+      s = alpha * x[i] + (1.0 - alpha) * s;
+      out[i] = s;
+    }
+    return out;
+  }
+
+  std::vector<OHLCV> bars_;
+  std::vector<double> closes_;
+  std::vector<double> highs_;
+  std::vector<double> lows_;
+};
+
+TEST_F(IndicatorsTest, EmaMatchesReference) {
+  std::vector<double> out(closes_.size());
+  Ema(InputColumn::Of(closes_), 10, OutputColumn::Of(out));
+  ExpectColumn(out, ReferenceEma(closes_, 10), 1e-9);
+  EXPECT_TRUE(std::isnan(out[8]));
+  EXPECT_FALSE(std::isnan(out[9]));
+
+  // Period 1 follows the input exactly
+  Ema(InputColumn::Of(closes_), 1, OutputColumn::Of(out));
+  EXPECT_EQ(out, closes_);
+}
+
+TEST_F(IndicatorsTest, BatchMatchesSingleCalls) {
+  const std::vector<size_t> periods = {3, 50, 7, 20, 1};
+  std::vector<std::vector<double>> batch(periods.size(),
+                                         std::vector<double>(closes_.size()));
+  std::vector<OutputColumn> outs;
+  for (auto &col : batch) outs.push_back(OutputColumn::Of(col));
+  Ema(InputColumn::Of(closes_), periods, outs);
+
+  std::vector<double> single(closes_.size());
+  for (size_t p = 0; p < periods.size(); ++p) {
+    Ema(InputColumn::Of(closes_), periods[p], OutputColumn::Of(single));
+    ExpectColumn(batch[p], single, 0.0);
+  }
+
+  // RSI and percentile rank batches as well
+  Rsi(InputColumn::Of(closes_), periods, outs);
+  for (size_t p = 0; p < periods.size(); ++p) {
+    Rsi(InputColumn::Of(closes_), periods[p], OutputColumn::Of(single));
+    ExpectColumn(batch[p], single, 0.0);
+  }
+  PercentileRank(InputColumn::Of(closes_), periods, outs);
+  for (size_t p = 0; p < periods.size(); ++p) {
+    PercentileRank(InputColumn::Of(closes_), periods[p],
+                   OutputColumn::Of(single));
+    ExpectColumn(batch[p], single, 0.0);
+  }
+}
+
+TEST_F(IndicatorsTest, StridedViewsMatchContiguousColumns) {
+  const InputColumn close =
+      RowField(bars_.data(), bars_.size(), &OHLCV::close);
+  ASSERT_EQ(close.size, closes_.size());
+  EXPECT_EQ(close[42], closes_[42]);
+
+  // Write into every other element of an interleaved buffer
+  std::vector<double> interleaved(2 * closes_.size(), -1.0);
+  const OutputColumn strided{interleaved.data() + 1, closes_.size(), 2};
+  Ema(close, 12, strided);
+  std::vector<double> contiguous(closes_.size());
+  Ema(InputColumn::Of(closes_), 12, OutputColumn::Of(contiguous));
+  for (size_t i = 0; i < closes_.size(); ++i) {
+    EXPECT_EQ(interleaved[2 * i], -1.0);
+    if (i >= 11) {
+      EXPECT_EQ(interleaved[2 * i + 1], contiguous[i]);
+    }
+  }
+
+  std::vector<double> from_rows(bars_.size());
+  std::vector<double> from_columns(bars_.size());
+  Atr(RowField(bars_.data(), bars_.size(), &OHLCV::high),
+      RowField(bars_.data(), bars_.size(), &OHLCV::low), close, 14,
+      OutputColumn::Of(from_rows));
+  Atr(InputColumn::Of(highs_), InputColumn::Of(lows_),
+      InputColumn::Of(closes_), 14, OutputColumn::Of(from_columns));
+  ExpectColumn(from_rows, from_columns, 0.0);
+}
+
+TEST_F(IndicatorsTest, AtrMatchesWilderReference) {
+  const size_t period = 14;
+  std::vector<double> tr(closes_.size());
+  for (size_t i = 0; i < tr.size(); ++i) {
+    tr[i] = highs_[i] - lows_[i];
+    if (i > 0) {
+      tr[i] = std::max({tr[i], std::fabs(highs_[i] - closes_[i - 1]),
+                        std::fabs(lows_[i] - closes_[i - 1])});
+    }
+  }
+  std::vector<double> expected(tr.size(), NAN);
+  double atr = 0.0;
+  for (size_t i = 0; i < period; ++i) atr += tr[i] / period;
+  expected[period - 1] = atr;
+  for (size_t i = period; i < tr.size(); ++i) {
+    atr = (atr * (period - 1) + tr[i]) / period;
+    expected[i] = atr;
+  }
+
+  std::vector<double> out(closes_.size());
+  Atr(InputColumn::Of(highs_), InputColumn::Of(lows_),
+      InputColumn::Of(closes_), period, OutputColumn::Of(out));
+  ExpectColumn(out, expected, 1e-9);
+}
+
+TEST_F(IndicatorsTest, BollingerMatchesNaiveWindows) {
+  // A spread around 1e6 with a small range keeps its variance
+  std::vector<double> x;
+  for (double c : closes_) x.push_back(1e6 + 0.01 * c);
+
+  for (const std::vector<double> *input : {&closes_, &x}) {
+    std::vector<double> middle(input->size());
+    std::vector<double> upper(input->size());
+    std::vector<double> lower(input->size());
+    Bollinger(InputColumn::Of(*input), BollingerSpec{20, 2.5},
+              {OutputColumn::Of(middle), OutputColumn::Of(upper),
+               OutputColumn::Of(lower)});
+    EXPECT_TRUE(std::isnan(middle[18]));
+    for (size_t i = 19; i < input->size(); ++i) {
+      double mean = 0.0;
+      for (size_t k = i - 19; k <= i; ++k) mean += (*input)[k] / 20;
+      double var = 0.0;
+      for (size_t k = i - 19; k <= i; ++k) {
+        var += ((*input)[k] - mean) * ((*input)[k] - mean) / 20;
+      }
+      const double dev = std::sqrt(var);
+      ASSERT_NEAR(middle[i], mean, 1e-9 * std::fabs(mean));
+      ASSERT_NEAR(upper[i] - middle[i], 2.5 * dev, 1e-6 * dev + 1e-12);
+      ASSERT_NEAR(middle[i] - lower[i], 2.5 * dev, 1e-6 * dev + 1e-12);
+    }
+  }
+}
+
+TEST_F(IndicatorsTest, RsiMatchesWilderReference) {
+  const size_t period = 14;
+  std::vector<double> expected(closes_.size(), NAN);
+  double gain = 0.0;
+  double loss = 0.0;
+  for (size_t i = 1; i <= period; ++i) {
+    const double d = closes_[i] - closes_[i - 1];
+    gain += std::max(0.0, d) / period;
+    loss += std::max(0.0, -d) / period;
+  }
+  expected[period] = 100.0 - 100.0 / (1.0 + gain / loss);
+  for (size_t i = period + 1; i < closes_.size(); ++i) {
+    const double d = closes_[i] - closes_[i - 1];
+    gain = (gain * (period - 1) + std::max(0.0, d)) / period;
+    loss = (loss * (period - 1) + std::max(0.0, -d)) / period;
+    expected[i] = 100.0 - 100.0 / (1.0 + gain / loss);
+  }
+
+  std::vector<double> out(closes_.size());
+  Rsi(InputColumn::Of(closes_), period, OutputColumn::Of(out));
+  ExpectColumn(out, expected, 1e-9);
+
+  std::vector<double> rising(30);
+  for (size_t i = 0; i < rising.size(); ++i) rising[i] = 10.0 + i;
+  std::vector<double> flat(30, 5.0);
+  std::vector<double> rsi(30);
+  Rsi(InputColumn::Of(rising), 5, OutputColumn::Of(rsi));
+  EXPECT_EQ(rsi[29], 100.0);
+  Rsi(InputColumn::Of(flat), 5, OutputColumn::Of(rsi));
+  EXPECT_EQ(rsi[29], 50.0);
+}
+
+TEST_F(IndicatorsTest, PercentileRankMatchesBruteForce) {
+  // Coarse values so the window has ties
+  std::vector<double> x;
+  for (double c : closes_) x.push_back(std::round(c));
+  const size_t window = 25;
+
+  std::vector<double> out(x.size());
+  PercentileRank(InputColumn::Of(x), window, OutputColumn::Of(out));
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (i < window) {
+      ASSERT_TRUE(std::isnan(out[i]));
+      continue;
+    }
+    size_t at_or_below = 0;
+    for (size_t k = i - window; k < i; ++k) at_or_below += x[k] <= x[i];
+    ASSERT_EQ(out[i], 100.0 * at_or_below / window) << "row " << i;
+  }
+
+  // Gaps in the input leave the sorted window intact
+  for (size_t i = 7; i < x.size(); i += 13) x[i] = std::nan("");
+  PercentileRank(InputColumn::Of(x), window, OutputColumn::Of(out));
+  for (size_t i = window; i < x.size(); ++i) {
+    if (std::isnan(x[i])) {
+      ASSERT_TRUE(std::isnan(out[i])) << "row " << i;
+      continue;
+    }
+    size_t at_or_below = 0;
+    for (size_t k = i - window; k < i; ++k) at_or_below += x[k] <= x[i];
+    ASSERT_EQ(out[i], 100.0 * at_or_below / window) << "row " << i;
+  }
+}
+
+TEST_F(IndicatorsTest, RejectsBadArguments) {
+  std::vector<double> out(closes_.size());
+  std::vector<double> short_out(10);
+  const InputColumn in = InputColumn::Of(closes_);
+  EXPECT_THROW(Ema(in, 0, OutputColumn::Of(out)), std::invalid_argument);
+  EXPECT_THROW(Ema(in, 5, OutputColumn::Of(short_out)),
+               std::invalid_argument);
+  EXPECT_THROW(Ema(in, {5, 6}, {OutputColumn::Of(out)}),
+               std::invalid_argument);
+  EXPECT_THROW(Atr(in, InputColumn::Of(short_out), in, 5,
+                   OutputColumn::Of(out)),
+               std::invalid_argument);
+  EXPECT_THROW(PercentileRank(in, 0, OutputColumn::Of(out)),
+               std::invalid_argument);
+
+  // Empty and shorter-than-warm-up inputs are all NaN, not errors
+  std::vector<double> empty;
+  EXPECT_NO_THROW(Rsi(InputColumn::Of(empty), 5, OutputColumn::Of(empty)));
+  std::vector<double> three = {1.0, 2.0, 3.0};
+  std::vector<double> three_out(3);
+  Ema(InputColumn::Of(three), 5, OutputColumn::Of(three_out));
+  for (double v : three_out) EXPECT_TRUE(std::isnan(v));
+}
+
+TEST_F(IndicatorsTest, BatchedEmaTiming) {
+  // 20 periods over a million rows: one batched pass against 20 calls
+  std::mt19937_64 rng(23);
+  std::vector<double> x(1000000);
+  double level = 100.0;
+  for (auto &v : x) v = level += Noise(rng);
+  std::vector<size_t> periods;
+  for (size_t p = 5; p < 105; p += 5) periods.push_back(p);
+  std::vector<std::vector<double>> cols(periods.size(),
+                                        std::vector<double>(x.size()));
+  std::vector<OutputColumn> outs;
+  for (auto &col : cols) outs.push_back(OutputColumn::Of(col));
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t p = 0; p < periods.size(); ++p) {
+    Ema(InputColumn::Of(x), periods[p], outs[p]);
+  }
+  auto single = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  const double checksum = cols.back().back();
+
+  start = std::chrono::high_resolution_clock::now();
+  Ema(InputColumn::Of(x), periods, outs);
+  auto batched = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  std::cout << "20 EMAs over 1M rows: " << single.count()
+            << " ms one at a time, " << batched.count() << " ms batched"
+            << std::endl;
+  EXPECT_EQ(cols.back().back(), checksum);
+}
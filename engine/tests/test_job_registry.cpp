@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "BulkLoader.hpp"
+#include "JobRegistry.hpp"
+#include "SeasonalBootstrap.hpp"
+#include "SeasonalWindowSearch.hpp"
+
+class JobRegistryTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir = "/tmp/job_registry_test";
+    std::filesystem::create_directories(test_dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(test_dir); }
+
+  std::vector<std::string> CreateFiles(size_t files) {
+    std::vector<std::string> paths;
+    for (size_t f = 0; f < files; ++f) {
+      paths.push_back(test_dir + "/c" + std::to_string(f) + ".csv");
+      std::ofstream file(paths.back());
+      file << "timestamp,close,open,high,low,volume\n";
+      for (int i = 0; i < 10; ++i) {
+        file << "2024-01-02 10:0" << i << ":00,100.5,100,101,99,10\n";
+      }
+    }
+    return paths;
+  }
+
+  static std::vector<std::vector<double>> Paths(size_t years, size_t days) {
+    std::vector<std::vector<double>> paths(years);
+    for (size_t y = 0; y < years; ++y) {
+      for (size_t d = 0; d < days; ++d) {
+        paths[y].push_back(static_cast<double>((d * 7 + y * 3) % 11));
+      }
+    }
+    return paths;
+  }
+
+  static size_t Done(const JobStatus& status, const std::string& counter) {
+    for (const auto& c : status.progress) {
+      if (c.name == counter) return c.done;
+    }
+    return 0;
+  }
+
+  std::string test_dir;
+};
+
+TEST_F(JobRegistryTest, JobReportsProgressAndPartialResults) {
+  JobRegistry jobs;
+  const JobId id = jobs.Start("years", [](JobContext& job) {
+    job.AddWork(JobContext::kYearsComputed, 5);
+    for (int year = 2020; year < 2025; ++year) {
+      job.Checkpoint();
+      job.Publish("year", year);
+      job.Advance(JobContext::kYearsComputed);
+    }
+  });
+  EXPECT_NE(id, 0u);
+  EXPECT_EQ(jobs.Wait(id), JobState::kSucceeded);
+
+  auto status = jobs.Status(id);
+  ASSERT_TRUE(status.has_value());
+  EXPECT_EQ(status->name, "years");
+  ASSERT_EQ(status->progress.size(), 1u);
+  EXPECT_EQ(status->progress[0].name, JobContext::kYearsComputed);
+  EXPECT_EQ(status->progress[0].done, 5u);
+  EXPECT_EQ(status->progress[0].total, 5u);
+
+  auto partials = jobs.TakePartials(id);
+  ASSERT_EQ(partials.size(), 5u);
+  for (size_t i = 0; i < partials.size(); ++i) {
+    EXPECT_EQ(partials[i].sequence, i);
+    EXPECT_EQ(partials[i].kind, "year");
+    EXPECT_EQ(std::any_cast<int>(partials[i].value), 2020 + int(i));
+  }
+  EXPECT_TRUE(jobs.TakePartials(id).empty());
+  EXPECT_STREQ(JobStateToString(status->state), "succeeded");
+}
+
+TEST_F(JobRegistryTest, CancelStopsRunningJobAtCheckpoint) {
+  JobRegistry jobs;
+  std::atomic<bool> started{false};
+  std::atomic<size_t> iterations{0};
+  const JobId id = jobs.Start("spin", [&](JobContext& job) {
+    started = true;
+    for (;;) {
+      job.Checkpoint();
+      ++iterations;
+      std::this_thread::yield();
+    }
+  });
+  while (!started) std::this_thread::yield();
+  EXPECT_EQ(jobs.Status(id)->state, JobState::kRunning);
+  EXPECT_TRUE(jobs.Cancel(id));
+  EXPECT_EQ(jobs.Wait(id), JobState::kCancelled);
+  EXPECT_GT(iterations.load(), 0u);
+  EXPECT_FALSE(jobs.Cancel(id));  // Already finished
+}
+
+TEST_F(JobRegistryTest, CancelledQueuedJobNeverRuns) {
+  TaskScheduler scheduler(SchedulerOptions{1, false});
+  JobRegistry jobs(scheduler);
+  std::atomic<bool> release{false};
+  std::atomic<bool> started{false};
+  const JobId blocker = jobs.Start("blocker", [&](JobContext&) {
+    started = true;
+    while (!release) std::this_thread::yield();
+  });
+  while (!started) std::this_thread::yield();
+
+  std::atomic<bool> ran{false};
+  const JobId queued = jobs.Start("queued", [&](JobContext&) { ran = true; });
+  EXPECT_EQ(jobs.Status(queued)->state, JobState::kQueued);
+  EXPECT_TRUE(jobs.Cancel(queued));
+  release = true;
+  EXPECT_EQ(jobs.Wait(blocker), JobState::kSucceeded);
+  EXPECT_EQ(jobs.Wait(queued), JobState::kCancelled);
+  EXPECT_FALSE(ran.load());
+}
+
+TEST_F(JobRegistryTest, FailureIsReportedAndJobsCanBeRemoved) {
+  JobRegistry jobs;
+  const JobId id = jobs.Start("bad", [](JobContext&) {
+    throw std::runtime_error("missing contract");
+  });
+  EXPECT_EQ(jobs.Wait(id), JobState::kFailed);
+  EXPECT_EQ(jobs.Status(id)->error, "missing contract");
+  EXPECT_EQ(jobs.Jobs(), std::vector<JobId>{id});
+
+  EXPECT_TRUE(jobs.Remove(id));
+  EXPECT_FALSE(jobs.Remove(id));
+  EXPECT_FALSE(jobs.Status(id).has_value());
+  EXPECT_FALSE(jobs.Cancel(id));
+  EXPECT_THROW(jobs.Wait(id), std::out_of_range);
+}
+
+TEST_F(JobRegistryTest, KernelsCountProgressAndHonorCancellation) {
+  JobContext job;
+  BootstrapConfig bootstrap;
+  bootstrap.resamples = 2000;
+  bootstrap.job = &job;
+  RunSeasonalBootstrap(Paths(15, 40), bootstrap);
+
+  WindowSearchConfig search;
+  search.job = &job;
+  const auto matrix = SeasonalMatrix::FromYears(Paths(10, 100));
+  SearchSeasonalWindows(matrix, search);
+
+  const auto progress = job.Progress();
+  ASSERT_EQ(progress.size(), 2u);
+  EXPECT_EQ(progress[0].name, JobContext::kResamples);
+  EXPECT_EQ(progress[0].done, 2000u);
+  EXPECT_EQ(progress[1].name, JobContext::kWindowTiles);
+  EXPECT_EQ(progress[1].done, progress[1].total);
+  EXPECT_GT(progress[1].total, 0u);
+
+  job.Cancel();
+  EXPECT_THROW(RunSeasonalBootstrap(Paths(15, 40), bootstrap), JobCancelled);
+  EXPECT_THROW(SearchSeasonalWindows(matrix, search), JobCancelled);
+}
+
+TEST_F(JobRegistryTest, BulkLoadCountsContractsAndStopsWhenCancelled) {
+  const auto paths = CreateFiles(6);
+  BulkLoader loader;
+
+  JobContext job;
+  auto results = loader.Load(paths, &job);
+  for (const auto& r : results) EXPECT_TRUE(r.ok) << r.path;
+  ASSERT_EQ(job.Progress().size(), 1u);
+  EXPECT_EQ(job.Progress()[0].done, 6u);
+  EXPECT_EQ(job.Progress()[0].total, 6u);
+
+  JobContext cancelled;
+  cancelled.Cancel();
+  results = loader.Load(paths, &cancelled);
+  for (const auto& r : results) EXPECT_FALSE(r.ok) << r.path;
+  EXPECT_EQ(cancelled.Progress()[0].done, 0u);
+
+  // Cancelled mid-load on io_uring. Reads show up as updated access times:
+  // each file's atime is set before its mtime, so the first read moves it.
+  if (!BulkLoader::IoUringAvailable()) return;
+  const auto history = CreateFiles(1000);
+  for (const auto& path : history) {
+    const timespec times[2] = {{0, 0}, {86400, 0}};  // atime, mtime
+    ASSERT_EQ(utimensat(AT_FDCWD, path.c_str(), times, 0), 0);
+  }
+  auto read_files = [&] {
+    std::vector<bool> read(history.size());
+    for (size_t i = 0; i < history.size(); ++i) {
+      struct stat sb;
+      read[i] = stat(history[i].c_str(), &sb) == 0 && sb.st_atime != 0;
+    }
+    return read;
+  };
+
+  BulkLoadOptions options;
+  options.backend = BulkLoadBackend::kIoUring;
+  options.queue_depth = 4;  // At most four files have I/O in flight
+  BulkLoader uring(options);
+  JobContext midway;
+  std::vector<bool> before_cancel;
+  std::thread canceller([&] {
+    while (!read_files()[0]) std::this_thread::yield();
+    midway.Cancel();
+    before_cancel = read_files();
+  });
+  results = uring.Load(history, &midway);
+  canceller.join();
+  EXPECT_EQ(uring.LastBackend(), BulkLoadBackend::kIoUring);
+
+  // Only reads already queued at the cancel, at most one per ring entry,
+  // may land after it; no file behind them is opened
+  const auto read = read_files();
+  size_t total = 0;
+  size_t late = 0;
+  for (size_t i = 0; i < history.size(); ++i) {
+    total += read[i];
+    late += read[i] && !before_cancel[i];
+    EXPECT_EQ(results[i].error, 0) << history[i];
+    if (!read[i]) EXPECT_FALSE(results[i].ok) << history[i];
+  }
+  EXPECT_LE(late, 4u);
+  EXPECT_LT(total, history.size());
+  EXPECT_LE(midway.Progress()[0].done, total);
+}
+
+TEST_F(JobRegistryTest, CancellingLongBootstrapJob) {
+  JobRegistry jobs;
+  const JobId id = jobs.Start("bootstrap", [](JobContext& job) {
+    BootstrapConfig config;
+    config.resamples = 2000000;  // Far longer than the test waits
+    config.num_threads = 1000;   // Small chunks, frequent progress
+    config.job = &job;
+    job.Publish("result", RunSeasonalBootstrap(Paths(15, 40), config));
+  });
+  while (Done(*jobs.Status(id), JobContext::kResamples) == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto start = std::chrono::steady_clock::now();
+  jobs.Cancel(id);
+  EXPECT_EQ(jobs.Wait(id), JobState::kCancelled);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  EXPECT_TRUE(jobs.TakePartials(id).empty());
+}
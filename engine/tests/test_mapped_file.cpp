@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "ContractCsvReader.hpp"
+#include "DataManager.hpp"
+#include "FilePrefetcher.hpp"
+#include "MappedFile.hpp"
+
+class MappedFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir = "/tmp/mapped_file_test";
+    std::filesystem::create_directories(test_dir);
+  }
+
+  void TearDown() override {
+    DataManager::configureDataRoots({});
+    std::filesystem::remove_all(test_dir);
+  }
+
+  std::string CreateCsv(const std::string& name, size_t rows) {
+    const std::string path = test_dir + "/" + name;
+    std::filesystem::create_directories(
+        std::filesystem::path(path).parent_path());
+    std::ofstream file(path);
+    file << "timestamp,close,open,high,low,volume\n";
+    for (size_t i = 0; i < rows; ++i) {
+      file << "2024-01-02 " << (10 + i / 60 % 10) << ":"
+           << (i % 60 < 10 ? "0" : "") << i % 60 << ":00,"
+           << 100.25 + i % 7 << ",100.0,101.5,99.75," << i << "\n";
+    }
+    return path;
+  }
+
+  std::string test_dir;
+};
+
+TEST_F(MappedFileTest, AutoPolicyBySize) {
+  EXPECT_EQ(MappedFile::Resolve(ReadaheadPolicy::kAuto, 4096),
+            ReadaheadPolicy::kPopulate);
+  EXPECT_EQ(MappedFile::Resolve(ReadaheadPolicy::kAuto,
+                                MappedFile::kPopulateThreshold + 1),
+            ReadaheadPolicy::kWillNeed);
+  EXPECT_EQ(MappedFile::Resolve(ReadaheadPolicy::kSequential, 4096),
+            ReadaheadPolicy::kSequential);
+}
+
+TEST_F(MappedFileTest, MapsContentsUnderEveryPolicy) {
+  const std::string path = CreateCsv("a.csv", 500);
+  std::ifstream in(path, std::ios::binary);
+  const std::string expected((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+
+  for (auto policy : {ReadaheadPolicy::kNone, ReadaheadPolicy::kSequential,
+                      ReadaheadPolicy::kWillNeed, ReadaheadPolicy::kPopulate,
+                      ReadaheadPolicy::kAuto}) {
+    MappedFile file;
+    ASSERT_TRUE(file.Open(path, policy));
+    ASSERT_EQ(file.Size(), expected.size());
+    EXPECT_EQ(std::memcmp(file.Data(), expected.data(), expected.size()), 0);
+  }
+}
+
+TEST_F(MappedFileTest, MoveAndCloseReleaseMapping) {
+  const std::string path = CreateCsv("b.csv", 10);
+  MappedFile a;
+  ASSERT_TRUE(a.Open(path));
+  MappedFile b = std::move(a);
+  EXPECT_FALSE(a.IsOpen());
+  EXPECT_TRUE(b.IsOpen());
+  b.Close();
+  EXPECT_FALSE(b.IsOpen());
+  EXPECT_EQ(b.Size(), 0u);
+}
+
+TEST_F(MappedFileTest, OpenFailures) {
+  MappedFile file;
+  EXPECT_FALSE(file.Open(test_dir + "/missing.csv"));
+  std::ofstream(test_dir + "/empty.csv").close();
+  EXPECT_FALSE(file.Open(test_dir + "/empty.csv"));
+  EXPECT_FALSE(file.IsOpen());
+}
+
+TEST_F(MappedFileTest, ReaderPoliciesProduceSameSeries) {
+  const std::string path = CreateCsv("c.csv", 2000);
+  ContractCsvReader reader;
+  TimeSeries reference;
+  ASSERT_TRUE(reader.read_csv_mmap(path, reference, true,
+                                   ReadaheadPolicy::kNone));
+  ASSERT_EQ(reference.Timestamps().size(), 2000u);
+
+  for (auto policy : {ReadaheadPolicy::kSequential, ReadaheadPolicy::kWillNeed,
+                      ReadaheadPolicy::kPopulate}) {
+    TimeSeries data;
+    ASSERT_TRUE(reader.read_csv_mmap(path, data, true, policy));
+    EXPECT_EQ(data.Timestamps(), reference.Timestamps());
+    EXPECT_EQ(data.Closes(), reference.Closes());
+    EXPECT_EQ(data.Volumes(), reference.Volumes());
+  }
+}
+
+TEST_F(MappedFileTest, PrefetcherWarmsEachFileOnce) {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 8; ++i) {
+    paths.push_back(CreateCsv("p" + std::to_string(i) + ".csv", 100));
+  }
+  paths.push_back(test_dir + "/missing.csv");
+
+  FilePrefetcher prefetcher(3);
+  prefetcher.Enqueue(paths);
+  prefetcher.Wait();
+  EXPECT_EQ(prefetcher.Pending(), 0u);
+  EXPECT_EQ(prefetcher.Warmed(), 8u);
+
+  prefetcher.Enqueue(paths);
+  prefetcher.Wait();
+  EXPECT_EQ(prefetcher.Warmed(), 8u);
+
+  prefetcher.Forget();
+  prefetcher.Enqueue({paths[0]});
+  prefetcher.Wait();
+  EXPECT_EQ(prefetcher.Warmed(), 9u);
+}
+
+TEST_F(MappedFileTest, DestructorDropsQueuedWork) {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 50; ++i) {
+    paths.push_back(CreateCsv("d" + std::to_string(i) + ".csv", 1000));
+  }
+  {
+    FilePrefetcher prefetcher(1);
+    prefetcher.Enqueue(paths);
+  }
+  SUCCEED();
+}
+
+TEST_F(MappedFileTest, DataManagerPrefetchesCatalogContracts) {
+  CreateCsv("root/ZC/H/2024.csv", 50);
+  CreateCsv("root/ZC/K/2024.csv", 50);
+  DataManager::configureDataRoots({test_dir + "/root"});
+
+  EXPECT_EQ(DataManager::prefetchContracts({{"ZC", ExpirationMonth::H, 2024},
+                                            {"ZC", ExpirationMonth::K, 2024},
+                                            {"ZC", ExpirationMonth::N, 2024}}),
+            2u);
+  DataManager::waitForPrefetch();
+  TimeSeries data =
+      DataManager::loadContractData({"ZC", ExpirationMonth::H, 2024});
+  EXPECT_EQ(data.Timestamps().size(), 50u);
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "JobRegistry.hpp"
+#include "PairScreener.hpp"
+
+class PairScreenerTest : public ::testing::Test {
+ protected:
+  // Uniform noise in [-1, 1), independent of the standard library's
+  // distribution implementations
+  static double Noise(std::mt19937_64 &rng) {
+    return static_cast<double>(rng() >> 11) * 0x1.0p-52 - 1.0;
+  }
+
+  static std::vector<double> RandomWalk(std::mt19937_64 &rng, size_t rows,
+                                        double start) {
+    std::vector<double> path(rows);
+    double level = start;
+    for (auto &v : path) v = level += Noise(rng);
+    return path;
+  }
+
+  static AlignedMatrix Matrix(const std::vector<std::vector<double>> &cols) {
+    const size_t rows = cols[0].size();
+    AlignedMatrix m(cols.size(), rows);
+    for (size_t t = 0; t < rows; ++t) {
+      m.PushRow(1000 + t);
+      for (size_t k = 0; k < cols.size(); ++k) m.Leg(k)[t] = cols[k][t];
+    }
+    return m;
+  }
+
+  // Textbook OLS of the residual ADF regression, explicit design matrix
+  static double ReferenceAdf(const std::vector<double> &y,
+                             const std::vector<double> &x, size_t lags) {
+    const size_t rows = y.size();
+    double mx = 0.0;
+    double my = 0.0;
+    for (size_t t = 0; t < rows; ++t) {
+      mx += x[t] / rows;
+      my += y[t] / rows;
+    }
+    double sxy = 0.0;
+    double sxx = 0.0;
+    for (size_t t = 0; t < rows; ++t) {
+      sxy += (x[t] - mx) * (y[t] - my);
+      sxx += (x[t] - mx) * (x[t] - mx);
+    }
+    const double b = sxy / sxx;
+    std::vector<double> e(rows);
+    for (size_t t = 0; t < rows; ++t) e[t] = y[t] - (my - b * mx) - b * x[t];
+
+    const size_t k = lags + 1;
+    std::vector<std::vector<double>> design;
+    std::vector<double> target;
+    for (size_t t = lags + 1; t < rows; ++t) {
+      std::vector<double> row = {e[t - 1]};
+      for (size_t l = 1; l <= lags; ++l) row.push_back(e[t - l] - e[t - l - 1]);
+      design.push_back(row);
+      target.push_back(e[t] - e[t - 1]);
+    }
+    // Normal equations augmented with the identity, Gauss-Jordan
+    std::vector<std::vector<double>> a(k, std::vector<double>(2 * k + 1));
+    for (size_t i = 0; i < k; ++i) {
+      for (size_t j = 0; j < k; ++j) {
+        for (size_t r = 0; r < design.size(); ++r) {
+          a[i][j] += design[r][i] * design[r][j];
+        }
+      }
+      for (size_t r = 0; r < design.size(); ++r) {
+        a[i][2 * k] += design[r][i] * target[r];
+      }
+      a[i][k + i] = 1.0;
+    }
+    for (size_t i = 0; i < k; ++i) {
+      const double pivot = a[i][i];
+      for (auto &v : a[i]) v /= pivot;
+      for (size_t r = 0; r < k; ++r) {
+        if (r == i) continue;
+        const double f = a[r][i];
+        for (size_t c = 0; c < 2 * k + 1; ++c) a[r][c] -= f * a[i][c];
+      }
+    }
+    double ssr = 0.0;
+    for (size_t r = 0; r < design.size(); ++r) {
+      double fit = 0.0;
+      for (size_t j = 0; j < k; ++j) fit += design[r][j] * a[j][2 * k];
+      ssr += (target[r] - fit) * (target[r] - fit);
+    }
+    const double variance = ssr / (design.size() - k);
+    return a[0][2 * k] / std::sqrt(variance * a[0][k]);
+  }
+};
+
+TEST_F(PairScreenerTest, CorrelationMatchesDirectComputation) {
+  // 37 columns: full and partial register blocks, two tiles per side
+  std::mt19937_64 rng(7);
+  std::vector<std::vector<double>> cols;
+  const std::vector<double> common = RandomWalk(rng, 600, 100.0);
+  for (size_t k = 0; k < 37; ++k) {
+    std::vector<double> col = RandomWalk(rng, 600, 50.0);
+    for (size_t t = 0; t < col.size(); ++t) col[t] += common[t] * (k % 3);
+    cols.push_back(col);
+  }
+  cols[5].assign(600, 42.0);  // No variation
+  const AlignedMatrix m = Matrix(cols);
+
+  const std::vector<double> corr = ReturnCorrelationMatrix(m, 1);
+  ASSERT_EQ(corr.size(), 37u * 37u);
+  for (size_t i = 0; i < 37; ++i) {
+    EXPECT_EQ(corr[i * 37 + i], 1.0);
+    for (size_t j = 0; j < 37; ++j) {
+      ASSERT_EQ(corr[i * 37 + j], corr[j * 37 + i]);
+      if (i == j) continue;
+      if (i == 5 || j == 5) {
+        ASSERT_EQ(corr[i * 37 + j], 0.0);
+        continue;
+      }
+      double mi = 0.0;
+      double mj = 0.0;
+      for (size_t t = 1; t < 600; ++t) {
+        mi += cols[i][t] - cols[i][t - 1];
+        mj += cols[j][t] - cols[j][t - 1];
+      }
+      mi /= 599;
+      mj /= 599;
+      double sij = 0.0;
+      double sii = 0.0;
+      double sjj = 0.0;
+      for (size_t t = 1; t < 600; ++t) {
+        const double di = cols[i][t] - cols[i][t - 1] - mi;
+        const double dj = cols[j][t] - cols[j][t - 1] - mj;
+        sij += di * dj;
+        sii += di * di;
+        sjj += dj * dj;
+      }
+      ASSERT_NEAR(corr[i * 37 + j], sij / std::sqrt(sii * sjj), 1e-12);
+    }
+  }
+  EXPECT_EQ(ReturnCorrelationMatrix(m, 4), corr);
+  EXPECT_THROW(ReturnCorrelationMatrix(Matrix({{1.0, 2.0}})),
+               std::invalid_argument);
+}
+
+TEST_F(PairScreenerTest, AdfMatchesReferenceRegression) {
+  std::mt19937_64 rng(11);
+  const std::vector<double> x = RandomWalk(rng, 400, 300.0);
+  std::vector<double> y(400);
+  double ar = 0.0;
+  for (size_t t = 0; t < 400; ++t) {
+    ar = 0.8 * ar + Noise(rng);
+    y[t] = 1.5 * x[t] + 20.0 + ar;
+  }
+
+  for (size_t lags : {0, 1, 3}) {
+    PairScreenConfig config;
+    config.adf_lags = lags;
+    const PairScreenResult result = ScreenPairs(Matrix({y, x}), config);
+    ASSERT_EQ(result.by_cointegration.size(), 1u);
+    const PairStatistics &s = result.by_cointegration[0];
+    const double expected =
+        s.dependent == 0 ? ReferenceAdf(y, x, lags) : ReferenceAdf(x, y, lags);
+    EXPECT_NEAR(s.adf_statistic, expected, 1e-8 * std::fabs(expected));
+    EXPECT_LE(s.adf_statistic,
+              std::min(ReferenceAdf(y, x, lags), ReferenceAdf(x, y, lags)) +
+                  1e-8 * std::fabs(expected));
+  }
+}
+
+TEST_F(PairScreenerTest, RanksPlantedCointegratedPairFirst) {
+  std::mt19937_64 rng(3);
+  const size_t rows = 1500;
+  std::vector<std::vector<double>> cols;
+  for (size_t k = 0; k < 12; ++k) {
+    cols.push_back(RandomWalk(rng, rows, 100.0 + 10 * k));
+  }
+  // Column 9 tracks 2 x column 4 up to a mean-reverting error
+  double ar = 0.0;
+  for (size_t t = 0; t < rows; ++t) {
+    ar = 0.7 * ar + Noise(rng);
+    cols[9][t] = 2.0 * cols[4][t] + 5.0 + ar;
+  }
+
+  PairScreenConfig config;
+  config.top_k = 5;
+  JobContext job;
+  config.job = &job;
+  const PairScreenResult result = ScreenPairs(Matrix(cols), config);
+  ASSERT_EQ(result.by_cointegration.size(), 5u);
+  ASSERT_EQ(result.by_correlation.size(), 5u);
+
+  const PairStatistics &best = result.by_cointegration[0];
+  EXPECT_EQ(std::min(best.dependent, best.independent), 4u);
+  EXPECT_EQ(std::max(best.dependent, best.independent), 9u);
+  EXPECT_TRUE(best.cointegrated);
+  EXPECT_LT(best.adf_statistic, -10.0);
+  EXPECT_LT(best.half_life, 5.0);
+  if (best.dependent == 9) {
+    EXPECT_NEAR(best.hedge_ratio, 2.0, 0.01);
+  } else {
+    EXPECT_NEAR(best.hedge_ratio, 0.5, 0.01);
+  }
+  EXPECT_GT(result.by_cointegration[1].adf_statistic, -6.0);
+  for (size_t r = 1; r < 5; ++r) {
+    EXPECT_LE(result.by_cointegration[r - 1].adf_statistic,
+              result.by_cointegration[r].adf_statistic);
+    EXPECT_GE(result.by_correlation[r - 1].correlation,
+              result.by_correlation[r].correlation);
+  }
+  EXPECT_EQ(std::min(result.by_correlation[0].dependent,
+                     result.by_correlation[0].independent),
+            4u);
+  for (const auto &counter : job.Progress()) {
+    if (counter.name == JobContext::kPairsTested) {
+      EXPECT_EQ(counter.done, 66u);
+    }
+  }
+
+  // The prefilter skips the ADF test of weakly correlated pairs
+  config.min_correlation = 0.5;
+  config.top_k = 0;
+  config.job = nullptr;
+  const PairScreenResult filtered = ScreenPairs(Matrix(cols), config);
+  ASSERT_EQ(filtered.by_cointegration.size(), 1u);
+  EXPECT_EQ(filtered.by_correlation.size(), 66u);
+}
+
+TEST_F(PairScreenerTest, CriticalValuesAndArguments) {
+  EXPECT_NEAR(EngleGrangerCriticalValue(0.05, 1000000), -3.33613, 1e-4);
+  EXPECT_NEAR(EngleGrangerCriticalValue(0.01, 100), -4.0081, 1e-3);
+  EXPECT_LT(EngleGrangerCriticalValue(0.01, 500),
+            EngleGrangerCriticalValue(0.10, 500));
+  EXPECT_THROW(EngleGrangerCriticalValue(0.2, 500), std::invalid_argument);
+
+  std::mt19937_64 rng(5);
+  const auto a = RandomWalk(rng, 50, 1.0);
+  const auto b = RandomWalk(rng, 50, 1.0);
+  EXPECT_THROW(ScreenPairs(Matrix({a})), std::invalid_argument);
+  PairScreenConfig config;
+  config.adf_lags = 9;
+  EXPECT_THROW(ScreenPairs(Matrix({a, b}), config), std::invalid_argument);
+  config.adf_lags = 30;
+  EXPECT_THROW(ScreenPairs(Matrix({a, b}), config), std::invalid_argument);
+}
+
+TEST_F(PairScreenerTest, ScreenTiming) {
+  // 120 contracts over ten years of daily bars: 7140 pairs
+  std::mt19937_64 rng(13);
+  std::vector<std::vector<double>> cols;
+  for (size_t k = 0; k < 120; ++k) {
+    cols.push_back(RandomWalk(rng, 2500, 100.0 + k));
+  }
+  const AlignedMatrix m = Matrix(cols);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  const PairScreenResult result = ScreenPairs(m);
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  std::cout << "Screen of 7140 pairs x 2500 rows: " << elapsed.count()
+            << " ms" << std::endl;
+  EXPECT_EQ(result.by_cointegration.size(), 50u);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "Resampler.hpp"
+#include "TimeSeries.hpp"
+
+class ResamplerTest : public ::testing::Test {
+ protected:
+  // 2025-06-15 00:00:00 UTC (a Sunday)
+  static constexpr uint64_t kSunday = 1749945600000ULL;
+  static constexpr uint64_t kHour = BarBucket::kHourMs;
+  static constexpr uint64_t kMinute = BarBucket::kMinuteMs;
+  static constexpr uint64_t kDay = BarBucket::kDayMs;
+
+  void AddBar(TimeSeries& ts, uint64_t timestamp, double open, double high,
+              double low, double close, double volume) {
+    ts.Timestamps().push_back(timestamp);
+    ts.Opens().push_back(open);
+    ts.Highs().push_back(high);
+    ts.Lows().push_back(low);
+    ts.Closes().push_back(close);
+    ts.Volumes().push_back(volume);
+  }
+};
+
+TEST_F(ResamplerTest, HourlyBarsAggregateOhlcv) {
+  TimeSeries minutes;
+  AddBar(minutes, kSunday + 10 * kHour, 100.0, 101.0, 99.5, 100.5, 10);
+  AddBar(minutes, kSunday + 10 * kHour + 1 * kMinute, 100.5, 103.0, 100.0,
+         102.0, 20);
+  AddBar(minutes, kSunday + 10 * kHour + 59 * kMinute, 102.0, 102.5, 98.0,
+         99.0, 30);
+  AddBar(minutes, kSunday + 11 * kHour, 99.0, 99.5, 98.5, 99.25, 5);
+
+  TimeSeries bars = Resample(minutes, BarBucket::Hours(1));
+
+  ASSERT_EQ(bars.Timestamps().size(), 2);
+  EXPECT_EQ(bars.Timestamps()[0], kSunday + 10 * kHour);
+  EXPECT_EQ(bars.Opens()[0], 100.0);
+  EXPECT_EQ(bars.Highs()[0], 103.0);
+  EXPECT_EQ(bars.Lows()[0], 98.0);
+  EXPECT_EQ(bars.Closes()[0], 99.0);
+  EXPECT_EQ(bars.Volumes()[0], 60.0);
+
+  EXPECT_EQ(bars.Timestamps()[1], kSunday + 11 * kHour);
+  EXPECT_EQ(bars.Opens()[1], 99.0);
+  EXPECT_EQ(bars.Volumes()[1], 5.0);
+}
+
+TEST_F(ResamplerTest, DailyBarsRespectSessionBoundary) {
+  TimeSeries minutes;
+  // Sunday evening session belongs to Monday's trading day
+  AddBar(minutes, kSunday + 18 * kHour, 10.0, 11.0, 9.0, 10.5, 1);
+  AddBar(minutes, kSunday + 19 * kHour, 10.5, 12.0, 10.0, 11.0, 2);
+  AddBar(minutes, kSunday + kDay + 9 * kHour, 11.0, 11.5, 8.0, 9.0, 3);
+  AddBar(minutes, kSunday + kDay + 17 * kHour, 9.0, 9.5, 8.5, 9.25, 4);
+  // Monday evening opens Tuesday's session
+  AddBar(minutes, kSunday + kDay + 18 * kHour, 9.25, 9.5, 9.0, 9.5, 5);
+
+  TimeSeries bars = Resample(minutes, BarBucket::Days(1, 18 * kHour));
+
+  ASSERT_EQ(bars.Timestamps().size(), 2);
+  EXPECT_EQ(bars.Timestamps()[0], kSunday + kDay);
+  EXPECT_EQ(bars.Opens()[0], 10.0);
+  EXPECT_EQ(bars.Highs()[0], 12.0);
+  EXPECT_EQ(bars.Lows()[0], 8.0);
+  EXPECT_EQ(bars.Closes()[0], 9.25);
+  EXPECT_EQ(bars.Volumes()[0], 10.0);
+  EXPECT_EQ(bars.Timestamps()[1], kSunday + 2 * kDay);
+  EXPECT_EQ(bars.Volumes()[1], 5.0);
+}
+
+TEST_F(ResamplerTest, CalendarDayWithoutSessionOffset) {
+  TimeSeries minutes;
+  AddBar(minutes, kSunday + 23 * kHour, 1.0, 1.0, 1.0, 1.0, 1);
+  AddBar(minutes, kSunday + kDay + 1 * kHour, 2.0, 2.0, 2.0, 2.0, 1);
+
+  TimeSeries bars = Resample(minutes, BarBucket::Days(1));
+
+  ASSERT_EQ(bars.Timestamps().size(), 2);
+  EXPECT_EQ(bars.Timestamps()[0], kSunday);
+  EXPECT_EQ(bars.Timestamps()[1], kSunday + kDay);
+}
+
+TEST_F(ResamplerTest, WeeklyBarsStartOnMonday) {
+  TimeSeries daily;
+  // Friday 2025-06-13 belongs to the week of Monday 2025-06-09
+  AddBar(daily, kSunday - 2 * kDay, 1.0, 2.0, 0.5, 1.5, 1);
+  AddBar(daily, kSunday + kDay, 1.5, 3.0, 1.0, 2.5, 1);
+  AddBar(daily, kSunday + 5 * kDay, 2.5, 2.75, 2.0, 2.25, 1);
+
+  TimeSeries bars = Resample(daily, BarBucket::Weeks(1));
+
+  ASSERT_EQ(bars.Timestamps().size(), 2);
+  EXPECT_EQ(bars.Timestamps()[0], kSunday - 6 * kDay);
+  EXPECT_EQ(bars.Timestamps()[1], kSunday + kDay);
+  EXPECT_EQ(bars.Opens()[1], 1.5);
+  EXPECT_EQ(bars.Highs()[1], 3.0);
+  EXPECT_EQ(bars.Closes()[1], 2.25);
+  EXPECT_EQ(bars.Volumes()[1], 2.0);
+}
+
+TEST_F(ResamplerTest, EmptySeries) {
+  TimeSeries empty;
+  TimeSeries bars = Resample(empty, BarBucket::Days(1));
+  EXPECT_EQ(bars.Timestamps().size(), 0);
+}
+
+TEST_F(ResamplerTest, ZeroWidthThrows) {
+  TimeSeries minutes;
+  AddBar(minutes, kSunday, 1.0, 1.0, 1.0, 1.0, 1);
+  EXPECT_THROW(Resample(minutes, BarBucket::Minutes(0)),
+               std::invalid_argument);
+}
+
+TEST_F(ResamplerTest, OptionalColumnsTakeLastValue) {
+  TimeSeries minutes;
+  AddBar(minutes, kSunday + 10 * kHour, 100.0, 101.0, 99.5, 100.5, 10);
+  AddBar(minutes, kSunday + 10 * kHour + 30 * kMinute, 100.5, 103.0, 100.0,
+         102.0, 20);
+  AddBar(minutes, kSunday + 11 * kHour, 99.0, 99.5, 98.5, 99.25, 5);
+  minutes.AddColumn(TimeSeries::kOpenInterest) = {5000.0, 5100.0, 5200.0};
+
+  TimeSeries bars = Resample(minutes, BarBucket::Hours(1));
+  ASSERT_TRUE(bars.HasColumn(TimeSeries::kOpenInterest));
+  EXPECT_FALSE(bars.HasColumn(TimeSeries::kSettlement));
+  EXPECT_EQ(bars.OpenInterest(), (std::vector<double>{5100.0, 5200.0}));
+}
+
+TEST_F(ResamplerTest, ParallelMatchesSerial) {
+  TimeSeries minutes;
+  const size_t rows = 300000;
+  minutes.reserve(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    double p = 100.0 + static_cast<double>((i * 37) % 101) * 0.25;
+    AddBar(minutes, kSunday + i * kMinute, p, p + 1.0, p - 1.0, p + 0.5,
+           static_cast<double>(i % 17));
+  }
+  auto& oi = minutes.AddColumn(TimeSeries::kOpenInterest);
+  for (size_t i = 0; i < rows; ++i) oi[i] = static_cast<double>(i);
+
+  BarBucket daily = BarBucket::Days(1, 17 * kHour);
+  TimeSeries serial = Resample(minutes, daily, 1);
+  TimeSeries parallel = Resample(minutes, daily, 4);
+
+  ASSERT_EQ(serial.Timestamps().size(), parallel.Timestamps().size());
+  EXPECT_EQ(serial.Timestamps(), parallel.Timestamps());
+  EXPECT_EQ(serial.Opens(), parallel.Opens());
+  EXPECT_EQ(serial.Highs(), parallel.Highs());
+  EXPECT_EQ(serial.Lows(), parallel.Lows());
+  EXPECT_EQ(serial.Closes(), parallel.Closes());
+  EXPECT_EQ(serial.Volumes(), parallel.Volumes());
+  EXPECT_EQ(serial.OpenInterest(), parallel.OpenInterest());
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "Philox.hpp"
+#include "SeasonalBootstrap.hpp"
+
+class SeasonalBootstrapTest : public ::testing::Test {
+ protected:
+  // Fifteen years of 60-day paths drifting by `drift` per day
+  std::vector<std::vector<double>> MakePaths(double drift) {
+    std::vector<std::vector<double>> paths(15);
+    Philox4x32 rng(42, 0);
+    for (auto &path : paths) {
+      double level = 0.0;
+      for (int d = 0; d < 60; ++d) {
+        path.push_back(level);
+        level += drift + (rng.NextDouble() - 0.5);
+      }
+    }
+    return paths;
+  }
+};
+
+TEST_F(SeasonalBootstrapTest, PhiloxKnownAnswers) {
+  // Known-answer vectors of the Random123 reference implementation
+  auto zero = Philox4x32::Generate({0, 0, 0, 0}, {0, 0});
+  EXPECT_EQ(zero, (Philox4x32::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+                                     0x9b00dbd8}));
+
+  auto ones = Philox4x32::Generate(
+      {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+      {0xffffffff, 0xffffffff});
+  EXPECT_EQ(ones, (Philox4x32::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6,
+                                     0x6d5451fd}));
+
+  auto pi = Philox4x32::Generate(
+      {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+      {0xa4093822, 0x299f31d0});
+  EXPECT_EQ(pi, (Philox4x32::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420,
+                                   0x24126ea1}));
+}
+
+TEST_F(SeasonalBootstrapTest, PhiloxStreamsAreIndependent) {
+  Philox4x32 a(7, 0);
+  Philox4x32 b(7, 1);
+  Philox4x32 a_again(7, 0);
+  int equal = 0;
+  for (int i = 0; i < 64; ++i) {
+    uint32_t x = a.NextU32();
+    equal += x == b.NextU32();
+    EXPECT_EQ(x, a_again.NextU32());
+  }
+  EXPECT_LT(equal, 2);
+
+  for (int i = 0; i < 1000; ++i) {
+    double u = a.NextDouble();
+    EXPECT_GE(u, 0.0);
+    EXPECT_LT(u, 1.0);
+    EXPECT_LT(a.Uniform(15), 15u);
+  }
+}
+
+TEST_F(SeasonalBootstrapTest, StrongEdgeIsSignificant) {
+  BootstrapResult r = RunSeasonalBootstrap(MakePaths(0.5));
+
+  EXPECT_GT(r.mean_pnl, 20.0);
+  EXPECT_LT(r.p_value, 0.01);
+  EXPECT_LT(r.mean_pnl_ci.lower, r.mean_pnl);
+  EXPECT_GT(r.mean_pnl_ci.upper, r.mean_pnl);
+  EXPECT_GT(r.pnl_ci.lower, 0.0);
+  EXPECT_LE(r.drawdown_ci.upper, 0.0);
+  EXPECT_LE(r.drawdown_ci.lower, r.drawdown_ci.upper);
+}
+
+TEST_F(SeasonalBootstrapTest, NoEdgeIsNotSignificant) {
+  std::vector<std::vector<double>> paths;
+  for (int y = 0; y < 16; ++y) {
+    double pnl = (y % 2 ? 1.0 : -1.0) * (1.0 + 0.1 * y);
+    paths.push_back({0.0, pnl / 2, pnl});
+  }
+  BootstrapResult r = RunSeasonalBootstrap(paths);
+  EXPECT_GT(r.p_value, 0.3);
+  EXPECT_LT(r.mean_pnl_ci.lower, 0.0);
+  EXPECT_GT(r.mean_pnl_ci.upper, 0.0);
+}
+
+TEST_F(SeasonalBootstrapTest, ReproducibleAcrossThreadCounts) {
+  auto paths = MakePaths(0.05);
+  BootstrapConfig one;
+  one.num_threads = 1;
+  one.seed = 99;
+  BootstrapConfig many = one;
+  many.num_threads = 7;
+
+  BootstrapResult a = RunSeasonalBootstrap(paths, one);
+  BootstrapResult b = RunSeasonalBootstrap(paths, many);
+  EXPECT_EQ(a.p_value, b.p_value);
+  EXPECT_EQ(a.mean_pnl_ci.lower, b.mean_pnl_ci.lower);
+  EXPECT_EQ(a.pnl_ci.upper, b.pnl_ci.upper);
+  EXPECT_EQ(a.drawdown_ci.lower, b.drawdown_ci.lower);
+}
+
+TEST_F(SeasonalBootstrapTest, TensOfThousandsOfResamplesAreFast) {
+  auto paths = MakePaths(0.1);
+  BootstrapConfig config;
+  config.resamples = 50000;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  BootstrapResult r = RunSeasonalBootstrap(paths, config);
+  auto end = std::chrono::high_resolution_clock::now();
+  auto ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+  EXPECT_EQ(r.resamples, 50000);
+  std::cout << "50000 resamples took: " << ms.count() << " ms" << std::endl;
+}
+
+TEST_F(SeasonalBootstrapTest, RejectsEmptyInput) {
+  EXPECT_THROW(RunSeasonalBootstrap({}), std::invalid_argument);
+  EXPECT_THROW(RunSeasonalBootstrap({{1.0}}), std::invalid_argument);
+
+  // Confidence levels outside (0, 1) would index past the samples
+  BootstrapConfig config;
+  config.resamples = 100;
+  for (double confidence : {0.0, 1.0, -0.5, 1.5, std::nan("")}) {
+    config.confidence = confidence;
+    EXPECT_THROW(RunSeasonalBootstrap({{1.0, 2.0}}, config),
+                 std::invalid_argument);
+  }
+}
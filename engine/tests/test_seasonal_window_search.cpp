@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "Philox.hpp"
+#include "SeasonalWindowSearch.hpp"
+
+class SeasonalWindowSearchTest : public ::testing::Test {
+ protected:
+  std::vector<std::vector<double>> RandomYears(size_t years, size_t days,
+                                               uint64_t seed) {
+    std::vector<std::vector<double>> levels(years);
+    for (size_t y = 0; y < years; ++y) {
+      Philox4x32 rng(seed, y);
+      double level = 0.0;
+      for (size_t d = 0; d < days; ++d) {
+        level += rng.NextDouble() - 0.5;
+        levels[y].push_back(level);
+      }
+    }
+    return levels;
+  }
+
+  // Straightforward per-window evaluation used as the reference
+  SeasonalWindow Evaluate(const SeasonalMatrix& m, size_t e, size_t x) {
+    SeasonalWindow w;
+    w.entry_day = e;
+    w.exit_day = x;
+    double sum = 0.0;
+    size_t wins = 0;
+    for (size_t y = 0; y < m.Years(); ++y) {
+      double peak = m.At(e, y);
+      for (size_t d = e; d <= x; ++d) {
+        peak = std::max(peak, m.At(d, y));
+        w.worst_drawdown = std::min(w.worst_drawdown, m.At(d, y) - peak);
+      }
+      double pnl = m.At(x, y) - m.At(e, y);
+      sum += pnl;
+      wins += pnl > 0.0;
+    }
+    w.average_pnl = sum / m.Years();
+    w.win_rate = static_cast<double>(wins) / m.Years();
+    return w;
+  }
+};
+
+TEST_F(SeasonalWindowSearchTest, MatrixFromYearsForwardFills) {
+  SeasonalMatrix m = SeasonalMatrix::FromYears(
+      {{1.0, NAN, 3.0, 4.0}, {10.0, 20.0, 30.0}});
+  ASSERT_EQ(m.Days(), 3);
+  ASSERT_EQ(m.Years(), 2);
+  EXPECT_EQ(m.At(1, 0), 1.0);
+  EXPECT_EQ(m.At(2, 1), 30.0);
+  EXPECT_EQ(m.Row(1)[1], 20.0);
+}
+
+TEST_F(SeasonalWindowSearchTest, MatchesBruteForce) {
+  SeasonalMatrix m = SeasonalMatrix::FromYears(RandomYears(7, 40, 3));
+  WindowSearchConfig config;
+  config.top_k = 5;
+  config.min_hold_days = 3;
+  config.max_hold_days = 20;
+  config.allow_short = false;
+
+  WindowSearchResult r = SearchSeasonalWindows(m, config);
+
+  std::vector<SeasonalWindow> all;
+  for (size_t e = 0; e < m.Days(); ++e) {
+    for (size_t x = e + 3; x < m.Days() && x - e <= 20; ++x) {
+      all.push_back(Evaluate(m, e, x));
+    }
+  }
+  std::sort(all.begin(), all.end(), [](const auto& a, const auto& b) {
+    return a.average_pnl > b.average_pnl;
+  });
+
+  ASSERT_EQ(r.by_average_pnl.size(), 5);
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(r.by_average_pnl[i].entry_day, all[i].entry_day);
+    EXPECT_EQ(r.by_average_pnl[i].exit_day, all[i].exit_day);
+    EXPECT_DOUBLE_EQ(r.by_average_pnl[i].average_pnl, all[i].average_pnl);
+    EXPECT_DOUBLE_EQ(r.by_average_pnl[i].worst_drawdown,
+                     all[i].worst_drawdown);
+    EXPECT_DOUBLE_EQ(r.by_average_pnl[i].win_rate, all[i].win_rate);
+  }
+  for (size_t i = 1; i < r.by_win_rate.size(); ++i) {
+    EXPECT_GE(r.by_win_rate[i - 1].win_rate, r.by_win_rate[i].win_rate);
+  }
+  for (const auto& w : r.by_worst_drawdown) EXPECT_GT(w.average_pnl, 0.0);
+}
+
+TEST_F(SeasonalWindowSearchTest, FindsPlantedSeasonalRally) {
+  auto levels = RandomYears(15, 250, 11);
+  // Every year rallies between day 100 and day 140
+  for (auto& year : levels) {
+    for (size_t d = 100; d < year.size(); ++d) {
+      year[d] += 2.0 * std::min<size_t>(d - 100, 40);
+    }
+  }
+  WindowSearchConfig config;
+  config.min_hold_days = 10;
+  WindowSearchResult r = SearchSeasonalWindows(
+      SeasonalMatrix::FromYears(levels), config);
+
+  ASSERT_FALSE(r.by_average_pnl.empty());
+  const SeasonalWindow& best = r.by_average_pnl.front();
+  EXPECT_EQ(best.direction, 1);
+  EXPECT_LE(best.entry_day, 100);
+  EXPECT_GE(best.exit_day, 140);
+  EXPECT_NEAR(best.average_pnl, 80.0, 5.0);
+  EXPECT_EQ(r.by_win_rate.front().win_rate, 1.0);
+}
+
+TEST_F(SeasonalWindowSearchTest, ShortSideMirrorsLong) {
+  SeasonalMatrix m = SeasonalMatrix::FromYears({{0, -1, -2, -3, -4, -5}});
+  WindowSearchConfig config;
+  config.min_hold_days = 1;
+  config.top_k = 1;
+  WindowSearchResult r = SearchSeasonalWindows(m, config);
+
+  ASSERT_EQ(r.by_average_pnl.size(), 1);
+  EXPECT_EQ(r.by_average_pnl[0].direction, -1);
+  EXPECT_EQ(r.by_average_pnl[0].entry_day, 0);
+  EXPECT_EQ(r.by_average_pnl[0].exit_day, 5);
+  EXPECT_EQ(r.by_average_pnl[0].average_pnl, 5.0);
+  EXPECT_EQ(r.by_average_pnl[0].worst_drawdown, 0.0);
+}
+
+TEST_F(SeasonalWindowSearchTest, DeterministicAcrossThreads) {
+  SeasonalMatrix m = SeasonalMatrix::FromYears(RandomYears(15, 120, 5));
+  WindowSearchConfig one;
+  one.num_threads = 1;
+  WindowSearchConfig many = one;
+  many.num_threads = 5;
+
+  WindowSearchResult a = SearchSeasonalWindows(m, one);
+  WindowSearchResult b = SearchSeasonalWindows(m, many);
+  ASSERT_EQ(a.by_win_rate.size(), b.by_win_rate.size());
+  for (size_t i = 0; i < a.by_win_rate.size(); ++i) {
+    EXPECT_EQ(a.by_win_rate[i].entry_day, b.by_win_rate[i].entry_day);
+    EXPECT_EQ(a.by_win_rate[i].exit_day, b.by_win_rate[i].exit_day);
+    EXPECT_EQ(a.by_worst_drawdown[i].exit_day,
+              b.by_worst_drawdown[i].exit_day);
+  }
+}
+
+TEST_F(SeasonalWindowSearchTest, FullCalendarTiming) {
+  SeasonalMatrix m = SeasonalMatrix::FromYears(RandomYears(15, 250, 8));
+
+  auto start = std::chrono::high_resolution_clock::now();
+  WindowSearchResult r = SearchSeasonalWindows(m);
+  auto end = std::chrono::high_resolution_clock::now();
+  auto ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+  EXPECT_EQ(r.by_average_pnl.size(), 10);
+  std::cout << "250 x 250 x 15 window search took: " << ms.count() << " ms"
+            << std::endl;
+}
+
+TEST_F(SeasonalWindowSearchTest, EmptyMatrix) {
+  WindowSearchResult r = SearchSeasonalWindows(SeasonalMatrix());
+  EXPECT_TRUE(r.by_win_rate.empty());
+}
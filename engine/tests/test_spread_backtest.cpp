@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "JobRegistry.hpp"
+#include "SpreadBacktest.hpp"
+
+class SpreadBacktestTest : public ::testing::Test {
+ protected:
+  static constexpr uint64_t kDay = 86400000ULL;
+  static constexpr uint64_t kJan2015 = 1420070400000ULL;
+
+  // Uniform noise in [-1, 1), independent of the standard library's
+  // distribution implementations
+  static double Noise(std::mt19937_64 &rng) {
+    return static_cast<double>(rng() >> 11) * 0x1.0p-52 - 1.0;
+  }
+
+  // Daily rows from 2015-01-01
+  static SpreadSeries Daily(const std::vector<double> &values) {
+    SpreadSeries s;
+    s.values = values;
+    for (size_t i = 0; i < values.size(); ++i) {
+      s.timestamps.push_back(kJan2015 + i * kDay);
+    }
+    return s;
+  }
+
+  // A mean-reverting spread: AR(1) deviations from 50
+  static SpreadSeries Reverting(size_t rows, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<double> v(rows);
+    double ar = 0.0;
+    for (auto &x : v) x = 50.0 + (ar = 0.5 * ar + Noise(rng));
+    return Daily(v);
+  }
+
+  // Population z-score of row `i` over `lookback` rows
+  static double ZScore(const std::vector<double> &v, size_t i,
+                       size_t lookback) {
+    double mean = 0.0;
+    for (size_t k = i + 1 - lookback; k <= i; ++k) mean += v[k] / lookback;
+    double var = 0.0;
+    for (size_t k = i + 1 - lookback; k <= i; ++k) {
+      var += (v[k] - mean) * (v[k] - mean) / lookback;
+    }
+    return (v[i] - mean) / std::sqrt(var);
+  }
+};
+
+TEST_F(SpreadBacktestTest, TradesFollowZScoreThresholds) {
+  const SpreadSeries spread = Reverting(1000, 1);
+  BacktestRule rule;
+  rule.lookback = 15;
+  rule.entry_z = 1.5;
+  rule.exit_z = 0.25;
+  BacktestConfig config;
+  config.costs = {0.05, 0.01, 2.0};
+
+  const BacktestResult result = RunBacktest(spread, rule, config);
+  ASSERT_GT(result.trades.size(), 10u);
+  EXPECT_EQ(result.trade_count, result.trades.size());
+
+  const std::vector<double> &v = spread.values;
+  double net = 0.0;
+  size_t last_exit = 0;
+  for (const auto &t : result.trades) {
+    EXPECT_GE(t.entry_row, last_exit);
+    EXPECT_LT(t.entry_row, t.exit_row);
+    const double entry_z = ZScore(v, t.entry_row, 15);
+    if (t.direction > 0) {
+      EXPECT_LE(entry_z, -1.5 + 1e-9);
+    } else {
+      EXPECT_GE(entry_z, 1.5 - 1e-9);
+    }
+    if (t.reason == ExitReason::kSignal) {
+      const double exit_z = ZScore(v, t.exit_row, 15);
+      if (t.direction > 0) {
+        EXPECT_GE(exit_z, -0.25 - 1e-9);
+      } else {
+        EXPECT_LE(exit_z, 0.25 + 1e-9);
+      }
+      // The previous row did not yet revert
+      const double before = ZScore(v, t.exit_row - 1, 15);
+      if (t.exit_row - 1 > t.entry_row) {
+        EXPECT_TRUE(t.direction > 0 ? before < -0.25 : before > 0.25);
+      }
+    } else {
+      EXPECT_EQ(t.reason, ExitReason::kEndOfData);
+      EXPECT_EQ(t.exit_row, v.size() - 1);
+    }
+
+    // Fills carry two ticks of slippage against the trade
+    EXPECT_NEAR(t.entry_price, v[t.entry_row] + t.direction * 0.02, 1e-12);
+    EXPECT_NEAR(t.exit_price, v[t.exit_row] - t.direction * 0.02, 1e-12);
+    EXPECT_NEAR(t.profit_loss,
+                t.direction * (t.exit_price - t.entry_price) - 0.1, 1e-12);
+    EXPECT_NEAR(t.costs, 0.14, 1e-12);
+    EXPECT_EQ(t.entry_time, spread.timestamps[t.entry_row]);
+    net += t.profit_loss;
+    last_exit = t.exit_row;
+  }
+  EXPECT_GT(net, 0.0);
+
+  // Flat at the end, so the equity curve ends at the summed trade profits;
+  // the yearly profits add up to the same total
+  EXPECT_NEAR(result.total.profit_loss, net, 1e-9);
+  EXPECT_EQ(result.total.year, 0);
+  EXPECT_EQ(result.total.rows, v.size() + 1);
+  ASSERT_EQ(result.yearly.size(), 3u);
+  EXPECT_EQ(result.yearly[0].year, 2015);
+  EXPECT_EQ(result.yearly[2].year, 2017);
+  double yearly = 0.0;
+  for (const auto &m : result.yearly) yearly += m.profit_loss;
+  EXPECT_NEAR(yearly, net, 1e-9);
+  EXPECT_LE(result.total.max_drawdown, 0.0);
+}
+
+TEST_F(SpreadBacktestTest, StopsTargetsAndTimeStops) {
+  // Noise around 100, then a fall that keeps going
+  std::mt19937_64 rng(2);
+  std::vector<double> v;
+  for (size_t i = 0; i < 40; ++i) v.push_back(100.0 + 0.1 * Noise(rng));
+  for (size_t i = 0; i < 20; ++i) v.push_back(99.0 - 0.5 * i);
+  const SpreadSeries spread = Daily(v);
+
+  BacktestRule rule;
+  rule.lookback = 20;
+  rule.entry_z = 2.0;
+  rule.allow_short = false;
+  rule.stop_loss = 1.2;
+  BacktestResult result = RunBacktest(spread, rule);
+  ASSERT_GE(result.trades.size(), 1u);
+  const BacktestTrade &stopped = result.trades[0];
+  EXPECT_EQ(stopped.entry_row, 40u);
+  EXPECT_EQ(stopped.direction, 1);
+  EXPECT_EQ(stopped.reason, ExitReason::kStopLoss);
+  // 99 -> 98.5 -> 98 -> 97.5: the first mark at least 1.2 below
+  EXPECT_EQ(stopped.exit_row, 43u);
+  EXPECT_DOUBLE_EQ(stopped.profit_loss, -1.5);
+
+  rule.stop_loss = std::numeric_limits<double>::infinity();
+  rule.max_holding = 5;
+  result = RunBacktest(spread, rule);
+  ASSERT_GE(result.trades.size(), 1u);
+  EXPECT_EQ(result.trades[0].reason, ExitReason::kTimeStop);
+  EXPECT_EQ(result.trades[0].exit_row, 45u);
+
+  // A bounce reaches the target of a long held past the mean, and the
+  // mirrored spike that of a short
+  for (size_t i = 0; i < 20; ++i) v[40 + i] = 99.0 + 0.5 * i;
+  rule.max_holding = 0;
+  rule.exit_z = -5.0;
+  rule.profit_target = 1.2;
+  result = RunBacktest(Daily(v), rule);
+  ASSERT_GE(result.trades.size(), 1u);
+  EXPECT_EQ(result.trades[0].reason, ExitReason::kProfitTarget);
+  EXPECT_EQ(result.trades[0].exit_row, 43u);
+  EXPECT_DOUBLE_EQ(result.trades[0].profit_loss, 1.5);
+
+  std::vector<double> mirrored;
+  for (double x : v) mirrored.push_back(200.0 - x);
+  rule.allow_short = true;
+  rule.allow_long = false;
+  result = RunBacktest(Daily(mirrored), rule);
+  ASSERT_GE(result.trades.size(), 1u);
+  EXPECT_EQ(result.trades[0].direction, -1);
+  EXPECT_EQ(result.trades[0].reason, ExitReason::kProfitTarget);
+  EXPECT_EQ(result.trades[0].exit_row, 43u);
+  EXPECT_DOUBLE_EQ(result.trades[0].profit_loss, 1.5);
+}
+
+TEST_F(SpreadBacktestTest, ParallelVariantsMatchSingleRuns) {
+  const SpreadSeries spread = Reverting(1500, 3);
+  std::vector<BacktestRule> rules;
+  for (size_t lookback : {10, 20, 30}) {
+    for (double entry : {1.0, 1.5, 2.0}) {
+      for (double stop : {1.0, 4.0}) {
+        BacktestRule r;
+        r.lookback = lookback;
+        r.entry_z = entry;
+        r.stop_loss = stop;
+        r.max_holding = lookback;
+        rules.push_back(r);
+      }
+    }
+  }
+  BacktestConfig config;
+  config.costs.commission = 0.02;
+  config.num_threads = 4;
+  JobContext job;
+  config.job = &job;
+  const std::vector<BacktestResult> results =
+      RunBacktests(spread, rules, config);
+  ASSERT_EQ(results.size(), rules.size());
+
+  config.job = nullptr;
+  config.num_threads = 1;
+  for (size_t r = 0; r < rules.size(); ++r) {
+    const BacktestResult single = RunBacktest(spread, rules[r], config);
+    EXPECT_EQ(results[r].rule, r);
+    ASSERT_EQ(results[r].trades.size(), single.trades.size());
+    for (size_t t = 0; t < single.trades.size(); ++t) {
+      EXPECT_EQ(results[r].trades[t].exit_row, single.trades[t].exit_row);
+      EXPECT_EQ(results[r].trades[t].profit_loss,
+                single.trades[t].profit_loss);
+    }
+    EXPECT_EQ(results[r].total.profit_loss, single.total.profit_loss);
+    EXPECT_EQ(results[r].total.sharpe_ratio, single.total.sharpe_ratio);
+  }
+  for (const auto &counter : job.Progress()) {
+    if (counter.name == JobContext::kBacktestsRun) {
+      EXPECT_EQ(counter.done, rules.size());
+    }
+  }
+
+  // Without trades the counts and metrics are unchanged
+  config.keep_trades = false;
+  const BacktestResult lean = RunBacktest(spread, rules[0], config);
+  EXPECT_TRUE(lean.trades.empty());
+  EXPECT_EQ(lean.trade_count, results[0].trade_count);
+  EXPECT_EQ(lean.total.profit_loss, results[0].total.profit_loss);
+}
+
+TEST_F(SpreadBacktestTest, RejectsBadArguments) {
+  SpreadSeries spread = Reverting(100, 4);
+  BacktestRule rule;
+  rule.lookback = 1;
+  EXPECT_THROW(RunBacktest(spread, rule), std::invalid_argument);
+  rule.lookback = 10;
+  rule.entry_z = 0.0;
+  EXPECT_THROW(RunBacktest(spread, rule), std::invalid_argument);
+  rule.entry_z = 2.0;
+  spread.timestamps.pop_back();
+  EXPECT_THROW(RunBacktest(spread, rule), std::invalid_argument);
+
+  // A flat spread never trades, and an empty one has no years
+  const BacktestResult flat =
+      RunBacktest(Daily(std::vector<double>(100, 7.0)), rule);
+  EXPECT_EQ(flat.trade_count, 0u);
+  EXPECT_EQ(flat.total.profit_loss, 0.0);
+  const BacktestResult empty = RunBacktest(SpreadSeries{}, rule);
+  EXPECT_TRUE(empty.yearly.empty());
+  EXPECT_EQ(empty.total.rows, 1u);
+}
+
+TEST_F(SpreadBacktestTest, VariantSweepTiming) {
+  // 2000 variants over ten years of daily rows
+  const SpreadSeries spread = Reverting(2500, 5);
+  std::vector<BacktestRule> rules;
+  for (size_t lookback = 10; lookback < 60; lookback += 5) {
+    for (size_t e = 0; e < 10; ++e) {
+      for (size_t s = 0; s < 4; ++s) {
+        for (size_t h = 0; h < 5; ++h) {
+          BacktestRule r;
+          r.lookback = lookback;
+          r.entry_z = 1.0 + 0.2 * e;
+          r.stop_loss = 1.0 + s;
+          r.max_holding = 10 * h;
+          rules.push_back(r);
+        }
+      }
+    }
+  }
+  BacktestConfig config;
+  config.keep_trades = false;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  const std::vector<BacktestResult> results =
+      RunBacktests(spread, rules, config);
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  std::cout << "Backtest of 2000 variants x 2500 rows: " << elapsed.count()
+            << " ms" << std::endl;
+  EXPECT_EQ(results.size(), 2000u);
+}
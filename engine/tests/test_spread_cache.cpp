@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "DataManager.hpp"
+#include "SpreadCache.hpp"
+
+class SpreadCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir = "/tmp/spread_cache_test";
+    std::filesystem::remove_all(test_dir);
+    std::filesystem::create_directories(test_dir + "/data");
+    WriteContract("H", 400.0);
+    WriteContract("K", 410.0);
+    WriteContract("N", 420.0);
+    DataManager::configureDataRoots({test_dir + "/data"});
+  }
+
+  void TearDown() override {
+    DataManager::configureDataRoots({});
+    std::filesystem::remove_all(test_dir);
+  }
+
+  // Hourly bars over 30 days, prices in quarter-cent ticks
+  std::string WriteContract(const std::string& month, double base) {
+    const std::string dir = test_dir + "/data/ZC/" + month;
+    std::filesystem::create_directories(dir);
+    const std::string path = dir + "/2025.csv";
+    std::ofstream file(path);
+    file << "timestamp,close,open,high,low,volume\n";
+    for (int day = 1; day <= 30; ++day) {
+      for (int hour = 9; hour < 14; ++hour) {
+        const double close = base + ((day * 7 + hour) % 13) * 0.25;
+        file << "2025-01-" << (day < 10 ? "0" : "") << day << " " << hour
+             << ":00:00," << close << "," << close << "," << close + 1 << ","
+             << close - 1 << ",100\n";
+      }
+    }
+    return path;
+  }
+
+  static SpreadQuery Calendar(ExpirationMonth near, ExpirationMonth far) {
+    SpreadQuery query;
+    query.definition = SpreadDefinition::Calendar("ZC", near, far, 2025);
+    query.bucket = BarBucket::Days(1);
+    return query;
+  }
+
+  std::string test_dir;
+};
+
+TEST_F(SpreadCacheTest, EncodingRoundTrips) {
+  SpreadSeries ticks;
+  SpreadSeries arbitrary;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    ticks.timestamps.push_back(1735689600000ULL + i * 86400000ULL);
+    ticks.values.push_back(-12.5 + (i % 17) * 0.25);
+    arbitrary.timestamps.push_back(1735689600000ULL + i * i);
+    arbitrary.values.push_back(1.0 / (i + 3));
+  }
+  for (const auto* series : {&ticks, &arbitrary}) {
+    const auto blob = SpreadCache::Encode(*series);
+    SpreadSeries decoded;
+    ASSERT_TRUE(SpreadCache::Decode(blob.data(), blob.size(), decoded));
+    EXPECT_EQ(decoded.timestamps, series->timestamps);
+    EXPECT_EQ(decoded.values, series->values);
+  }
+  // Regular daily tick data compresses far below 16 bytes per row
+  EXPECT_LT(SpreadCache::Encode(ticks).size(), 3000u);
+
+  SpreadSeries empty;
+  const auto blob = SpreadCache::Encode(empty);
+  SpreadSeries decoded{{1}, {1.0}};
+  ASSERT_TRUE(SpreadCache::Decode(blob.data(), blob.size(), decoded));
+  EXPECT_TRUE(decoded.timestamps.empty());
+  EXPECT_FALSE(SpreadCache::Decode(blob.data(), 3, decoded));
+}
+
+TEST_F(SpreadCacheTest, EquivalentQueriesShareKey) {
+  SpreadQuery hk = Calendar(H, K);
+
+  SpreadQuery reordered = hk;
+  reordered.definition = SpreadDefinition(
+      {{{"ZC", K, 2025}, -2.0, 0.5}, {{"ZC", H, 2025}, 1.0, 1.0}});
+  EXPECT_EQ(SpreadCache::CanonicalKey(hk),
+            SpreadCache::CanonicalKey(reordered));
+
+  SpreadQuery split = hk;
+  split.definition = SpreadDefinition({{{"ZC", H, 2025}, 0.5, 1.0},
+                                       {{"ZC", K, 2025}, -1.0, 1.0},
+                                       {{"ZC", H, 2025}, 0.5, 1.0}});
+  EXPECT_EQ(SpreadCache::CanonicalKey(hk), SpreadCache::CanonicalKey(split));
+
+  SpreadQuery window = hk;
+  window.start_ms = 1736000000000ULL;
+  EXPECT_NE(SpreadCache::CanonicalKey(hk), SpreadCache::CanonicalKey(window));
+
+  // The anchor leg of an as-of join keeps its place
+  SpreadQuery asof = reordered;
+  asof.mode = JoinMode::kAsof;
+  EXPECT_EQ(SpreadCache::Canonicalize(asof).Legs()[0].contract.expirationMonth,
+            ExpirationMonth::K);
+}
+
+TEST_F(SpreadCacheTest, RepeatedQueryIsServedFromMemory) {
+  SpreadCache cache;
+  SpreadQuery query = Calendar(H, K);
+  query.start_ms = 1736121600000ULL;  // 2025-01-06
+  query.end_ms = 1736985600000ULL;    // 2025-01-16
+
+  const SpreadSeries first = cache.Load(query);
+  const SpreadSeries full = LoadSpread(query.definition, query.bucket);
+  ASSERT_EQ(first.timestamps.size(), 11u);
+  EXPECT_EQ(first.timestamps.front(), query.start_ms);
+  EXPECT_EQ(first.timestamps.back(), query.end_ms);
+  for (size_t i = 0; i < first.timestamps.size(); ++i) {
+    EXPECT_DOUBLE_EQ(first.values[i], full.values[i + 5]);
+  }
+
+  const SpreadSeries second = cache.Load(query);
+  EXPECT_EQ(second.timestamps, first.timestamps);
+  EXPECT_EQ(second.values, first.values);
+  ASSERT_TRUE(cache.Find(query).has_value());
+  EXPECT_FALSE(cache.Find(Calendar(H, N)).has_value());
+
+  const auto stats = cache.Stats();
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.hits, 2u);
+  EXPECT_EQ(stats.entries, 1u);
+  EXPECT_GT(stats.memory_bytes, 0u);
+}
+
+TEST_F(SpreadCacheTest, ChangedContractFileInvalidatesEntry) {
+  SpreadCache cache;
+  const SpreadQuery query = Calendar(H, K);
+  const SpreadSeries before = cache.Load(query);
+
+  const std::string path = WriteContract("K", 300.0);
+  std::filesystem::last_write_time(
+      path, std::filesystem::last_write_time(path) + std::chrono::seconds(5));
+  DataManager::catalog()->Rescan();  // Versions come from the catalog
+  EXPECT_FALSE(cache.Find(query).has_value());
+  EXPECT_EQ(cache.Stats().invalidated, 1u);
+
+  const SpreadSeries after = cache.Load(query);
+  ASSERT_EQ(after.values.size(), before.values.size());
+  EXPECT_DOUBLE_EQ(after.values[0], before.values[0] + 110.0);
+  EXPECT_EQ(cache.Stats().misses, 2u);
+}
+
+TEST_F(SpreadCacheTest, MemoryBoundSpillsToDisk) {
+  SpreadCacheOptions options;
+  options.max_memory_bytes = 250;  // Room for one entry
+  options.spill_dir = test_dir + "/spill";
+  SpreadCache cache(options);
+
+  const SpreadSeries hk = cache.Load(Calendar(H, K));
+  const SpreadSeries kn = cache.Load(Calendar(K, N));
+  auto stats = cache.Stats();
+  EXPECT_EQ(stats.entries, 1u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.spills, 1u);
+  EXPECT_LE(stats.memory_bytes, options.max_memory_bytes);
+
+  const SpreadSeries reloaded = cache.Load(Calendar(H, K));
+  EXPECT_EQ(reloaded.values, hk.values);
+  EXPECT_EQ(cache.Stats().disk_hits, 1u);
+  EXPECT_EQ(cache.Stats().misses, 2u);
+
+  // Spill files outlive the cache that wrote them
+  SpreadCache restarted(options);
+  cache.Clear();
+  const auto found = restarted.Find(Calendar(K, N));
+  ASSERT_TRUE(found.has_value());
+  EXPECT_EQ(found->values, kn.values);
+}
+
+TEST_F(SpreadCacheTest, HitTiming) {
+  SpreadCache cache;
+  const SpreadQuery query = Calendar(H, N);
+  DataManager::clearCache();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  cache.Load(query);
+  auto miss = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < 100; ++i) cache.Load(query);
+  auto hit = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  std::cout << "Spread miss: " << miss.count() << " us, hit: "
+            << hit.count() / 100 << " us" << std::endl;
+  EXPECT_EQ(cache.Stats().hits, 100u);
+}
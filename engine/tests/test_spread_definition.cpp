@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "SpreadDefinition.hpp"
+
+class SpreadDefinitionTest : public ::testing::Test {
+ protected:
+  AlignedMatrix MakeMatrix(size_t legs, size_t rows) {
+    std::vector<std::vector<uint64_t>> ts(legs);
+    std::vector<std::vector<double>> px(legs);
+    std::vector<JoinColumn> columns;
+    for (size_t k = 0; k < legs; ++k) {
+      for (size_t i = 0; i < rows; ++i) {
+        ts[k].push_back(i);
+        px[k].push_back(static_cast<double>((k + 1) * 100 + i));
+      }
+      columns.push_back({ts[k].data(), px[k].data(), rows});
+    }
+    return JoinTimestamps(columns, JoinMode::kInner);
+  }
+};
+
+TEST_F(SpreadDefinitionTest, CalendarLegs) {
+  SpreadDefinition hk = SpreadDefinition::Calendar("ZC", H, K, 2025);
+
+  ASSERT_EQ(hk.Legs().size(), 2);
+  EXPECT_EQ(hk.Legs()[0].contract.expirationMonth, ExpirationMonth::H);
+  EXPECT_EQ(hk.Legs()[1].contract.expirationMonth, ExpirationMonth::K);
+  EXPECT_EQ(hk.Coefficients(), (std::vector<double>{1.0, -1.0}));
+}
+
+TEST_F(SpreadDefinitionTest, ButterflyWeights) {
+  SpreadDefinition fly = SpreadDefinition::Butterfly("ZC", H, K, N, 2025);
+  EXPECT_EQ(fly.Coefficients(), (std::vector<double>{1.0, -2.0, 1.0}));
+}
+
+TEST_F(SpreadDefinitionTest, CrushConvertsUnits) {
+  SpreadDefinition crush = SpreadDefinition::SoybeanCrush(N, 2025);
+  ASSERT_EQ(crush.Legs().size(), 3);
+  EXPECT_EQ(crush.Legs()[0].contract.symbol, "ZM");
+  EXPECT_EQ(crush.Legs()[1].contract.symbol, "ZL");
+  EXPECT_EQ(crush.Legs()[2].contract.symbol, "ZS");
+
+  // Meal 300 $/st, oil 45 c/lb, beans 1000 c/bu
+  AlignedMatrix m(3, 1);
+  m.PushRow(0);
+  m.Leg(0)[0] = 300.0;
+  m.Leg(1)[0] = 45.0;
+  m.Leg(2)[0] = 1000.0;
+  double value = 0.0;
+  EvaluateSpread(crush, m, &value);
+  EXPECT_NEAR(value, 300.0 * 0.022 + 45.0 * 0.11 - 10.0, 1e-12);
+}
+
+TEST_F(SpreadDefinitionTest, ShiftedYears) {
+  SpreadDefinition hk = SpreadDefinition::Calendar("ZC", H, K, 2025);
+  SpreadDefinition earlier = hk.ShiftedYears(-3);
+  EXPECT_EQ(earlier.Legs()[0].contract.expirationYear, 2022);
+  EXPECT_EQ(earlier.Legs()[1].contract.expirationYear, 2022);
+  EXPECT_EQ(hk.Legs()[0].contract.expirationYear, 2025);
+}
+
+TEST_F(SpreadDefinitionTest, CrossYearLegs) {
+  // December/March: the short leg expires in the following year
+  SpreadDefinition zh = SpreadDefinition::Calendar("ZC", Z, H, 2024, 1);
+  EXPECT_EQ(zh.Legs()[0].contract.expirationYear, 2024);
+  EXPECT_EQ(zh.Legs()[1].contract.expirationYear, 2025);
+  EXPECT_EQ(zh.Legs()[1].year_offset, 1);
+
+  // Shifting keeps the offsets; rebasing applies them to any year
+  SpreadDefinition earlier = zh.ShiftedYears(-4);
+  EXPECT_EQ(earlier.Legs()[0].contract.expirationYear, 2020);
+  EXPECT_EQ(earlier.Legs()[1].contract.expirationYear, 2021);
+  SpreadDefinition rebased = earlier.ForYear(2010);
+  EXPECT_EQ(rebased.Legs()[0].contract.expirationYear, 2010);
+  EXPECT_EQ(rebased.Legs()[1].contract.expirationYear, 2011);
+
+  // Leg templates whose years are set only by ForYear
+  SpreadDefinition fly({{{"ZC", Z, 0}, 1.0, 1.0, 0},
+                        {{"ZC", H, 0}, -2.0, 1.0, 1},
+                        {{"ZC", K, 0}, 1.0, 1.0, 1}});
+  SpreadDefinition fly2025 = fly.ForYear(2025);
+  EXPECT_EQ(fly2025.Legs()[0].contract.expirationYear, 2025);
+  EXPECT_EQ(fly2025.Legs()[2].contract.expirationYear, 2026);
+}
+
+TEST_F(SpreadDefinitionTest, FusedKernelsMatchReference) {
+  for (size_t legs = 1; legs <= 6; ++legs) {
+    std::vector<SpreadLeg> spec;
+    for (size_t k = 0; k < legs; ++k) {
+      spec.push_back({{"ZC", H, 2025}, (k % 2 ? -1.0 : 1.0) * (k + 1), 0.5});
+    }
+    SpreadDefinition def(spec);
+    AlignedMatrix m = MakeMatrix(legs, 1500);
+
+    std::vector<double> out(m.Rows());
+    EvaluateSpread(def, m, out.data());
+
+    std::vector<double> coeff = def.Coefficients();
+    for (size_t i = 0; i < m.Rows(); ++i) {
+      double expected = 0.0;
+      for (size_t k = 0; k < legs; ++k) expected += coeff[k] * m.Leg(k)[i];
+      ASSERT_DOUBLE_EQ(out[i], expected) << "legs=" << legs << " row=" << i;
+    }
+  }
+}
+
+TEST_F(SpreadDefinitionTest, LegCountMismatchThrows) {
+  SpreadDefinition hk = SpreadDefinition::Calendar("ZC", H, K, 2025);
+  AlignedMatrix m = MakeMatrix(3, 4);
+  std::vector<double> out(m.Rows());
+  EXPECT_THROW(EvaluateSpread(hk, m, out.data()), std::invalid_argument);
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "SpreadMetrics.hpp"
+
+class SpreadMetricsTest : public ::testing::Test {
+ protected:
+  // Deterministic wandering path of `rows` daily values
+  static SpreadYear MakeYear(int year, size_t rows) {
+    SpreadYear y;
+    y.year = year;
+    double value = 10.0 + year % 7;
+    for (size_t i = 0; i < rows; ++i) {
+      y.series.timestamps.push_back(1735689600000ULL + i * 86400000ULL);
+      value += std::sin(i * 0.37 + year) * 1.5 + ((i * 31 + year) % 5) * 0.1 -
+               0.2;
+      y.series.values.push_back(value);
+    }
+    return y;
+  }
+
+  static std::vector<SpreadYear> MakeHistory(int first, int last,
+                                             size_t rows) {
+    std::vector<SpreadYear> history;
+    for (int year = first; year <= last; ++year) {
+      history.push_back(MakeYear(year, rows + year % 3));
+    }
+    return history;
+  }
+
+  static SpreadSeries Slice(const SpreadSeries &s, size_t from, size_t to) {
+    SpreadSeries out;
+    out.timestamps.assign(s.timestamps.begin() + from,
+                          s.timestamps.begin() + to);
+    out.values.assign(s.values.begin() + from, s.values.begin() + to);
+    return out;
+  }
+
+  // Direct two-pass computation of the metric definitions
+  static YearlyMetrics Reference(int year, const std::vector<double> &v) {
+    YearlyMetrics m;
+    m.year = year;
+    m.rows = v.size();
+    if (v.empty()) return m;
+    m.profit_loss = v.back() - v.front();
+    m.total_return = m.profit_loss;
+    double peak = v[0];
+    double trough = v[0];
+    for (double x : v) {
+      peak = std::max(peak, x);
+      trough = std::min(trough, x);
+      m.max_drawdown = std::min(m.max_drawdown, x - peak);
+      m.max_profit = std::max(m.max_profit, x - trough);
+    }
+    std::vector<double> returns;
+    for (size_t i = 1; i < v.size(); ++i) returns.push_back(v[i] - v[i - 1]);
+    if (returns.empty()) return m;
+    double mean = 0.0;
+    for (double r : returns) mean += r;
+    mean /= returns.size();
+    double var = 0.0;
+    for (double r : returns) var += (r - mean) * (r - mean);
+    m.standard_deviation = std::sqrt(var / returns.size());
+    m.sharpe_ratio =
+        m.standard_deviation > 0.0 ? mean / m.standard_deviation : 0.0;
+    size_t wins = 0;
+    size_t losses = 0;
+    double win_sum = 0.0;
+    double loss_sum = 0.0;
+    for (double r : returns) {
+      if (r > 0.0) {
+        ++wins;
+        win_sum += r;
+      } else if (r < 0.0) {
+        ++losses;
+        loss_sum += r;
+      }
+    }
+    m.win_rate = static_cast<double>(wins) / returns.size();
+    if (wins > 0) m.avg_win = win_sum / wins;
+    if (losses > 0) m.avg_loss = loss_sum / losses;
+    return m;
+  }
+
+  static void ExpectNear(const YearlyMetrics &a, const YearlyMetrics &b) {
+    EXPECT_EQ(a.year, b.year);
+    EXPECT_EQ(a.rows, b.rows);
+    EXPECT_NEAR(a.profit_loss, b.profit_loss, 1e-9);
+    EXPECT_NEAR(a.max_drawdown, b.max_drawdown, 1e-9);
+    EXPECT_NEAR(a.max_profit, b.max_profit, 1e-9);
+    EXPECT_NEAR(a.standard_deviation, b.standard_deviation, 1e-9);
+    EXPECT_NEAR(a.sharpe_ratio, b.sharpe_ratio, 1e-9);
+    EXPECT_NEAR(a.total_return, b.total_return, 1e-9);
+    EXPECT_NEAR(a.win_rate, b.win_rate, 1e-12);
+    EXPECT_NEAR(a.avg_win, b.avg_win, 1e-9);
+    EXPECT_NEAR(a.avg_loss, b.avg_loss, 1e-9);
+  }
+};
+
+TEST_F(SpreadMetricsTest, AccumulatorMatchesReference) {
+  const SpreadYear year = MakeYear(2020, 250);
+  MetricsAccumulator acc;
+  EXPECT_EQ(acc.Metrics(2020).rows, 0u);
+  acc.Push(year.series.values.data(), year.series.values.size());
+  ExpectNear(acc.Metrics(2020), Reference(2020, year.series.values));
+
+  // Drawdown is measured from the running peak, not the overall maximum
+  MetricsAccumulator path;
+  for (double v : {1.0, 3.0, 2.0, 5.0, 4.5, 0.0, 1.0}) path.Push(v);
+  EXPECT_DOUBLE_EQ(path.Metrics(0).max_drawdown, -5.0);
+  EXPECT_DOUBLE_EQ(path.Metrics(0).max_profit, 4.0);
+  EXPECT_DOUBLE_EQ(path.Metrics(0).profit_loss, 0.0);
+
+  // Welford stays accurate far from zero
+  MetricsAccumulator offset;
+  for (size_t i = 0; i < 1000; ++i) offset.Push(1e9 + (i % 2 ? 1.0 : 0.0));
+  EXPECT_NEAR(offset.Metrics(0).standard_deviation, 1.0, 1e-6);
+}
+
+TEST_F(SpreadMetricsTest, MetricsByCalendarYear) {
+  // Three daily years concatenated; 2024 is a leap year
+  SpreadSeries spread;
+  std::vector<std::vector<double>> years(3);
+  const uint64_t start = 1672531200000ULL;  // 2023-01-01
+  for (size_t day = 0; day < 365 + 366 + 365; ++day) {
+    const double value = std::sin(day * 0.11) * 4.0 + day * 0.01;
+    spread.timestamps.push_back(start + day * 86400000ULL + 3600000ULL);
+    spread.values.push_back(value);
+    years[day < 365 ? 0 : day < 731 ? 1 : 2].push_back(value);
+  }
+
+  const auto slices = SliceByYear(spread.timestamps.data(), 1096);
+  ASSERT_EQ(slices.size(), 3u);
+  EXPECT_EQ(slices[1].year, 2024);
+  EXPECT_EQ(slices[1].begin, 365u);
+  EXPECT_EQ(slices[1].end, 731u);
+
+  const auto metrics = MetricsByYear(spread.timestamps.data(),
+                                     spread.values.data(), 1096);
+  ASSERT_EQ(metrics.size(), 3u);
+  for (size_t y = 0; y < 3; ++y) {
+    ExpectNear(metrics[y], Reference(2023 + static_cast<int>(y), years[y]));
+  }
+  EXPECT_TRUE(SliceByYear(nullptr, 0).empty());
+}
+
+TEST_F(SpreadMetricsTest, AppendMatchesBatchRecomputation) {
+  const SpreadYear full = MakeYear(2025, 200);
+  SpreadYear current{2025, Slice(full.series, 0, 50)};
+  IncrementalSpreadAnalysis study(MakeHistory(2010, 2024, 250), current);
+  ExpectNear(study.CurrentMetrics(),
+             Reference(2025, Slice(full.series, 0, 50).values));
+
+  for (size_t from = 50; from < 200; from += 30) {
+    const size_t to = std::min<size_t>(from + 30, 200);
+    EXPECT_EQ(study.Append(Slice(full.series, from, to)), to - from);
+    ExpectNear(study.CurrentMetrics(),
+               Reference(2025, Slice(full.series, 0, to).values));
+  }
+  EXPECT_EQ(study.CurrentYear().values, full.series.values);
+  EXPECT_EQ(study.CurrentYear().timestamps, full.series.timestamps);
+}
+
+TEST_F(SpreadMetricsTest, FormingBarReplacesLastRow) {
+  const SpreadYear full = MakeYear(2025, 40);
+  IncrementalSpreadAnalysis study({}, {2025, Slice(full.series, 0, 40)});
+
+  // The last bar updates twice, then an old bar arrives late
+  SpreadSeries update;
+  update.timestamps = {full.series.timestamps[39], full.series.timestamps[39],
+                       full.series.timestamps[10]};
+  update.values = {-50.0, 7.25, 99.0};
+  EXPECT_EQ(study.Append(update), 2u);
+
+  std::vector<double> expected = full.series.values;
+  expected.back() = 7.25;
+  EXPECT_EQ(study.CurrentYear().values, expected);
+  ExpectNear(study.CurrentMetrics(), Reference(2025, expected));
+
+  // Replacing the only row of an empty start
+  IncrementalSpreadAnalysis fresh({}, {2026, {}});
+  EXPECT_EQ(fresh.Append({{100}, {1.0}}), 1u);
+  EXPECT_EQ(fresh.Append({{100, 200}, {4.0, 6.0}}), 2u);
+  ExpectNear(fresh.CurrentMetrics(), Reference(2026, {4.0, 6.0}));
+}
+
+TEST_F(SpreadMetricsTest, HistoryIsComputedOnceAndStaysStatic) {
+  auto history = MakeHistory(2010, 2024, 250);
+  std::reverse(history.begin(), history.end());
+  IncrementalSpreadAnalysis study(history, {2025, {}});
+
+  const auto &metrics = study.HistoricalMetrics();
+  ASSERT_EQ(metrics.size(), 15u);
+  EXPECT_EQ(metrics.front().year, 2010);
+  EXPECT_EQ(metrics.back().year, 2024);
+  for (const auto &m : metrics) {
+    const auto &values = history[2024 - m.year].series.values;
+    ExpectNear(m, Reference(m.year, values));
+  }
+
+  for (size_t years : {3u, 5u, 10u, 15u}) {
+    const auto &average = study.Average(years);
+    size_t longest = 0;
+    for (size_t y = 0; y < years; ++y) {
+      longest = std::max(longest, history[y].series.values.size());
+    }
+    ASSERT_EQ(average.size(), longest) << years;
+    for (size_t i = 0; i < average.size(); i += 17) {
+      double sum = 0.0;
+      size_t count = 0;
+      for (size_t y = 0; y < years; ++y) {
+        const auto &values = history[y].series.values;
+        if (i < values.size()) {
+          sum += values[i];
+          ++count;
+        }
+      }
+      EXPECT_NEAR(average[i], sum / count, 1e-9);
+    }
+  }
+  EXPECT_THROW(study.Average(7), std::out_of_range);
+
+  const std::vector<double> before = study.Average(5);
+  const SpreadYear current = MakeYear(2025, 100);
+  study.Append(current.series);
+  EXPECT_EQ(study.Average(5), before);
+  EXPECT_EQ(study.HistoricalMetrics().size(), 15u);
+
+  // Fewer years than a window: averaged over what there is
+  IncrementalSpreadAnalysis short_history(MakeHistory(2022, 2024, 10),
+                                          {2025, {}});
+  EXPECT_EQ(short_history.Average(15), short_history.Average(3));
+}
+
+TEST_F(SpreadMetricsTest, RefreshTiming) {
+  const size_t rows = 24 * 250;  // Hourly bars
+  SpreadYear current = MakeYear(2025, rows);
+  IncrementalSpreadAnalysis study(MakeHistory(2010, 2024, rows),
+                                  {2025, Slice(current.series, 0, rows - 10)});
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = rows - 10; i < rows; ++i) {
+    study.Append(Slice(current.series, i, i + 1));
+  }
+  auto incremental = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+
+  start = std::chrono::high_resolution_clock::now();
+  IncrementalSpreadAnalysis rebuilt(MakeHistory(2010, 2024, rows), current);
+  auto full = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  std::cout << "10 refreshes: " << incremental.count()
+            << " us, one rebuild: " << full.count() << " us" << std::endl;
+  ExpectNear(study.CurrentMetrics(), rebuilt.CurrentMetrics());
+}
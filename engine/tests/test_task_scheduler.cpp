@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "TaskScheduler.hpp"
+
+class TaskSchedulerTest : public ::testing::Test {
+ protected:
+  static SchedulerOptions Options(size_t threads, bool numa = false) {
+    SchedulerOptions options;
+    options.num_threads = threads;
+    options.numa_aware = numa;
+    return options;
+  }
+};
+
+TEST_F(TaskSchedulerTest, GroupRunsEveryTask) {
+  TaskScheduler scheduler(Options(4));
+  std::atomic<int> sum{0};
+  TaskGroup group(scheduler);
+  for (int i = 1; i <= 1000; ++i) {
+    group.Run([&sum, i] { sum += i; });
+  }
+  group.Wait();
+  EXPECT_EQ(sum.load(), 500500);
+  EXPECT_EQ(scheduler.NumWorkers(), 4u);
+}
+
+TEST_F(TaskSchedulerTest, ParallelForCoversRangeExactlyOnce) {
+  TaskScheduler scheduler(Options(3));
+  for (size_t grain : {0u, 1u, 7u, 5000u}) {
+    std::vector<std::atomic<int>> hits(10007);
+    ParallelFor(
+        0, hits.size(),
+        [&](size_t lo, size_t hi) {
+          for (size_t i = lo; i < hi; ++i) ++hits[i];
+        },
+        grain, scheduler);
+    for (const auto& h : hits) ASSERT_EQ(h.load(), 1) << "grain " << grain;
+  }
+
+  // Empty and offset ranges
+  int calls = 0;
+  ParallelFor(5, 5, [&](size_t, size_t) { ++calls; }, 0, scheduler);
+  EXPECT_EQ(calls, 0);
+  std::atomic<size_t> total{0};
+  ParallelFor(
+      100, 200, [&](size_t lo, size_t hi) { total += hi - lo; }, 3,
+      scheduler);
+  EXPECT_EQ(total.load(), 100u);
+}
+
+TEST_F(TaskSchedulerTest, AutomaticGrainGivesEveryWorkerSeveralChunks) {
+  TaskScheduler scheduler(Options(4));
+  TaskGroup group(scheduler);
+  EXPECT_EQ(group.GrainFor(3200, 0), 100u);
+  EXPECT_EQ(group.GrainFor(3, 0), 1u);
+  EXPECT_EQ(group.GrainFor(3200, 64), 64u);
+}
+
+TEST_F(TaskSchedulerTest, TaskCountSplitsRangeIntoEqualChunks) {
+  TaskScheduler scheduler(Options(4));
+  std::mutex mutex;
+  std::vector<size_t> sizes;
+  auto record = [&](size_t lo, size_t hi) {
+    std::lock_guard<std::mutex> lock(mutex);
+    sizes.push_back(hi - lo);
+  };
+  ParallelFor(0, 10, record, TaskCount{3}, scheduler);
+  std::sort(sizes.begin(), sizes.end());
+  EXPECT_EQ(sizes, (std::vector<size_t>{2, 4, 4}));
+
+  // One task runs the whole range on the caller
+  sizes.clear();
+  ParallelFor(0, 10, record, TaskCount{1}, scheduler);
+  EXPECT_EQ(sizes, std::vector<size_t>{10});
+}
+
+TEST_F(TaskSchedulerTest, NestedParallelismDoesNotDeadlock) {
+  // More outer tasks than workers, each waiting on an inner loop
+  TaskScheduler scheduler(Options(2));
+  std::atomic<size_t> total{0};
+  ParallelFor(
+      0, 16,
+      [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+          ParallelFor(
+              0, 1000, [&](size_t a, size_t b) { total += b - a; }, 10,
+              scheduler);
+        }
+      },
+      1, scheduler);
+  EXPECT_EQ(total.load(), 16000u);
+}
+
+TEST_F(TaskSchedulerTest, ExceptionPropagatesAndCancelsGroup) {
+  TaskScheduler scheduler(Options(2));
+  TaskGroup group(scheduler);
+  group.Run([] { throw std::runtime_error("boom"); });
+  while (!group.IsCancelled()) std::this_thread::yield();
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 100; ++i) group.Run([&ran] { ++ran; });
+  EXPECT_THROW(group.Wait(), std::runtime_error);
+  EXPECT_EQ(ran.load(), 0);
+
+  EXPECT_THROW(ParallelFor(
+                   0, 100,
+                   [](size_t lo, size_t) {
+                     if (lo == 50) throw std::invalid_argument("bad chunk");
+                   },
+                   10, scheduler),
+               std::invalid_argument);
+}
+
+TEST_F(TaskSchedulerTest, CancelSkipsPendingTasks) {
+  TaskScheduler scheduler(Options(1));
+  TaskGroup group(scheduler);
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+  std::atomic<int> ran{0};
+  group.Run([&] {
+    started = true;
+    while (!release) std::this_thread::yield();
+  });
+  while (!started) std::this_thread::yield();
+  for (int i = 0; i < 50; ++i) group.Run([&ran] { ++ran; });
+  group.Cancel();
+  release = true;
+  group.Wait();
+  EXPECT_EQ(ran.load(), 0);
+
+  // Running tasks observe cancellation at their own checkpoints
+  TaskGroup polling(scheduler);
+  std::atomic<bool> stopped{false};
+  started = false;
+  polling.Run([&] {
+    started = true;
+    while (!polling.IsCancelled()) std::this_thread::yield();
+    stopped = true;
+  });
+  while (!started) std::this_thread::yield();
+  polling.Cancel();
+  polling.Wait();
+  EXPECT_TRUE(stopped.load());
+}
+
+TEST_F(TaskSchedulerTest, IdleWorkersStealWork) {
+  // Every task is spawned by one worker, so the others only get work by
+  // stealing from its deque
+  TaskScheduler scheduler(Options(4));
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  TaskGroup outer(scheduler);
+  outer.Run([&] {
+    TaskGroup inner(scheduler);
+    for (int i = 0; i < 64; ++i) {
+      inner.Run([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+      });
+    }
+    inner.Wait();
+  });
+  outer.Wait();
+  EXPECT_GT(threads.size(), 1u);
+}
+
+TEST_F(TaskSchedulerTest, NumaTopologyAndPlacement) {
+  const auto nodes = TaskScheduler::NumaTopology();
+  ASSERT_FALSE(nodes.empty());
+  for (const auto& cpus : nodes) EXPECT_FALSE(cpus.empty());
+
+  TaskScheduler scheduler(Options(4, true));
+  for (size_t w = 0; w < scheduler.NumWorkers(); ++w) {
+    EXPECT_GE(scheduler.WorkerNode(w), 0);
+    EXPECT_LT(scheduler.WorkerNode(w), static_cast<int>(nodes.size()));
+  }
+  std::atomic<int> count{0};
+  ParallelFor(
+      0, 100, [&](size_t lo, size_t hi) { count += hi - lo; }, 1, scheduler);
+  EXPECT_EQ(count.load(), 100);
+}
+
+TEST_F(TaskSchedulerTest, SubmittedTasksRunOnWorkers) {
+  TaskScheduler scheduler(Options(2));
+  EXPECT_FALSE(scheduler.OnWorkerThread());
+  std::atomic<int> on_worker{0};
+  for (int i = 0; i < 10; ++i) {
+    scheduler.Submit([&] { on_worker += scheduler.OnWorkerThread(); });
+  }
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (on_worker < 10 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(on_worker.load(), 10);
+  EXPECT_FALSE(scheduler.RunOne());
+  EXPECT_GE(TaskScheduler::Instance().NumWorkers(), 1u);
+}
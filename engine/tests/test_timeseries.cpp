@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
 #include "TimeSeries.hpp"
 
 class TimeSeriesTest : public ::testing::Test {
@@ -160,4 +164,145 @@ TEST_F(TimeSeriesTest, OutOfBoundsAccess) {
       // Expected behavior for out of bounds
     }
   });
-}
\ No newline at end of file
+}
+
+TEST_F(TimeSeriesTest, OptionalColumnsAllocatedOnDemand) {
+  TimeSeries ts(timestamps, opens, highs, lows, closes, volumes);
+  EXPECT_FALSE(ts.HasColumn(TimeSeries::kOpenInterest));
+  EXPECT_EQ(ts.FindColumn(TimeSeries::kOpenInterest), nullptr);
+  EXPECT_TRUE(ts.OptionalColumns().empty());
+  EXPECT_THROW(ts.OpenInterest(), std::out_of_range);
+
+  auto& oi = ts.AddColumn(TimeSeries::kOpenInterest);
+  ASSERT_EQ(oi.size(), 4u);  // Sized to the existing rows
+  oi[2] = 52000.0;
+  EXPECT_TRUE(ts.HasColumn(TimeSeries::kOpenInterest));
+  EXPECT_DOUBLE_EQ(ts.OpenInterest()[2], 52000.0);
+  EXPECT_EQ(&ts.AddColumn(TimeSeries::kOpenInterest), &ts.OpenInterest());
+
+  ts.AddColumn(TimeSeries::kSettlement);
+  ASSERT_EQ(ts.OptionalColumns().size(), 2u);
+  EXPECT_EQ(ts.OptionalColumns()[1], TimeSeries::kSettlement);
+  EXPECT_EQ(ts.Settlements().size(), 4u);
+
+  ts.DropColumn(TimeSeries::kOpenInterest);
+  EXPECT_FALSE(ts.HasColumn(TimeSeries::kOpenInterest));
+  EXPECT_TRUE(ts.HasColumn(TimeSeries::kSettlement));
+
+  ts.clear();
+  EXPECT_TRUE(ts.OptionalColumns().empty());
+}
+
+TEST_F(TimeSeriesTest, CoreColumnsByName) {
+  TimeSeries ts(timestamps, opens, highs, lows, closes, volumes);
+  EXPECT_EQ(ts.FindColumn("close"), &ts.Closes());
+  EXPECT_EQ(ts.FindColumn("volume"), &ts.Volumes());
+  EXPECT_EQ(ts.FindColumn("bid"), nullptr);
+  EXPECT_FALSE(ts.HasColumn("close"));  // Core columns are not optional
+  EXPECT_THROW(ts.AddColumn("close"), std::invalid_argument);
+}
+
+TEST_F(TimeSeriesTest, BulkRowExportMatchesDataPoint) {
+  // Odd row count exercises the scalar tail of the paired kernel
+  TimeSeries ts;
+  for (uint64_t i = 0; i < 101; ++i) {
+    ts.Timestamps().push_back(1609459200000 + i * 60000 + (1ULL << 62));
+    ts.Opens().push_back(100.0 + i);
+    ts.Highs().push_back(101.5 + i);
+    ts.Lows().push_back(99.25 + i);
+    ts.Closes().push_back(100.75 + i);
+    ts.Volumes().push_back(1000.0 * i);
+  }
+
+  std::vector<OHLCV> rows(96);
+  ts.ToRows(5, 101, rows.data());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const OHLCV expected = ts.DataPoint(i + 5);
+    EXPECT_EQ(rows[i].timestamp, expected.timestamp);
+    EXPECT_EQ(rows[i].open, expected.open);
+    EXPECT_EQ(rows[i].high, expected.high);
+    EXPECT_EQ(rows[i].low, expected.low);
+    EXPECT_EQ(rows[i].close, expected.close);
+    EXPECT_EQ(rows[i].volume, expected.volume);
+  }
+  ts.ToRows(101, 101, nullptr);
+  EXPECT_THROW(ts.ToRows(0, 102, rows.data()), std::out_of_range);
+  EXPECT_THROW(ts.ToRows(7, 6, rows.data()), std::out_of_range);
+
+  TimeSeries back = TimeSeries::FromRows(rows.data(), rows.size());
+  ASSERT_EQ(back.Timestamps().size(), 96u);
+  EXPECT_TRUE(std::equal(back.Timestamps().begin(), back.Timestamps().end(),
+                         ts.Timestamps().begin() + 5));
+  EXPECT_TRUE(std::equal(back.Volumes().begin(), back.Volumes().end(),
+                         ts.Volumes().begin() + 5));
+  EXPECT_TRUE(std::equal(back.Lows().begin(), back.Lows().end(),
+                         ts.Lows().begin() + 5));
+}
+
+TEST_F(TimeSeriesTest, AppendRowsExtendsOptionalColumns) {
+  TimeSeries ts(timestamps, opens, highs, lows, closes, volumes);
+  ts.AddColumn(TimeSeries::kOpenInterest)[3] = 7.0;
+  const OHLCV extra[3] = {{1609473600000, 1, 2, 0.5, 1.5, 10},
+                          {1609477200000, 2, 3, 1.5, 2.5, 20},
+                          {1609480800000, 3, 4, 2.5, 3.5, 30}};
+  ts.AppendRows(extra, 3);
+  ASSERT_EQ(ts.Timestamps().size(), 7u);
+  EXPECT_EQ(ts.DataPoint(3).close, 107.0);
+  EXPECT_EQ(ts.DataPoint(6).timestamp, 1609480800000u);
+  EXPECT_EQ(ts.DataPoint(5).high, 3.0);
+  ASSERT_EQ(ts.OpenInterest().size(), 7u);
+  EXPECT_EQ(ts.OpenInterest()[3], 7.0);
+  EXPECT_EQ(ts.OpenInterest()[6], 0.0);
+}
+
+TEST_F(TimeSeriesTest, LazyRowRange) {
+  TimeSeries ts(timestamps, opens, highs, lows, closes, volumes);
+  size_t i = 0;
+  for (const OHLCV bar : ts.Rows()) {
+    EXPECT_EQ(bar.timestamp, timestamps[i]);
+    EXPECT_EQ(bar.close, closes[i]);
+    ++i;
+  }
+  EXPECT_EQ(i, 4u);
+
+  const auto middle = ts.Rows(1, 3);
+  ASSERT_EQ(middle.size(), 2u);
+  EXPECT_EQ(middle[0].open, 101.0);
+  EXPECT_EQ(middle[1].volume, 1200.0);
+  EXPECT_EQ(middle.end() - middle.begin(), 2);
+  EXPECT_EQ((*(middle.begin() + 1)).high, 107.0);
+  EXPECT_TRUE(ts.Rows(4).empty());
+  EXPECT_THROW(ts.Rows(0, 5), std::out_of_range);
+
+  const auto last = std::max_element(
+      ts.Rows().begin(), ts.Rows().end(),
+      [](const OHLCV &a, const OHLCV &b) { return a.volume < b.volume; });
+  EXPECT_EQ((*last).timestamp, 1609470000000u);
+}
+
+TEST_F(TimeSeriesTest, RowExportTiming) {
+  const size_t rows = 1000000;
+  TimeSeries ts;
+  ts.reserve(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    ts.Timestamps().push_back(i);
+    ts.Opens().push_back(i * 0.5);
+    ts.Highs().push_back(i * 0.5 + 1);
+    ts.Lows().push_back(i * 0.5 - 1);
+    ts.Closes().push_back(i * 0.5);
+    ts.Volumes().push_back(i);
+  }
+  std::vector<OHLCV> out(rows);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < rows; ++i) out[i] = ts.DataPoint(i);
+  auto single = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  start = std::chrono::high_resolution_clock::now();
+  ts.ToRows(0, rows, out.data());
+  auto bulk = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  std::cout << "1M rows via DataPoint: " << single.count()
+            << " us, ToRows: " << bulk.count() << " us" << std::endl;
+  EXPECT_EQ(out[rows - 1].timestamp, rows - 1);
+}
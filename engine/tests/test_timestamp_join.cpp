@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <vector>
+
+#include "TimestampJoin.hpp"
+
+class TimestampJoinTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ts_a = {1, 2, 3, 5, 8, 13};
+    px_a = {10, 20, 30, 50, 80, 130};
+    ts_b = {2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+    px_b = {2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+    ts_c = {0, 5, 13};
+    px_c = {-1, -5, -13};
+  }
+
+  JoinColumn A() const { return {ts_a.data(), px_a.data(), ts_a.size()}; }
+  JoinColumn B() const { return {ts_b.data(), px_b.data(), ts_b.size()}; }
+  JoinColumn C() const { return {ts_c.data(), px_c.data(), ts_c.size()}; }
+
+  std::vector<uint64_t> ts_a, ts_b, ts_c;
+  std::vector<double> px_a, px_b, px_c;
+};
+
+TEST_F(TimestampJoinTest, InnerJoinKeepsCommonTimestamps) {
+  AlignedMatrix m = JoinTimestamps({A(), B(), C()}, JoinMode::kInner);
+
+  ASSERT_EQ(m.Legs(), 3);
+  ASSERT_EQ(m.Rows(), 2);
+  EXPECT_EQ(m.Timestamps(), (std::pmr::vector<uint64_t>{5, 13}));
+  EXPECT_EQ(m.Leg(0)[0], 50);
+  EXPECT_EQ(m.Leg(1)[0], 5);
+  EXPECT_EQ(m.Leg(2)[0], -5);
+  EXPECT_EQ(m.Leg(0)[1], 130);
+  EXPECT_EQ(m.Leg(1)[1], 13);
+  EXPECT_EQ(m.Leg(2)[1], -13);
+}
+
+TEST_F(TimestampJoinTest, InnerJoinTwoLegs) {
+  AlignedMatrix m = JoinTimestamps({A(), B()}, JoinMode::kInner);
+  EXPECT_EQ(m.Timestamps(), (std::pmr::vector<uint64_t>{2, 3, 5, 8, 13}));
+  for (size_t i = 0; i < m.Rows(); ++i) {
+    EXPECT_EQ(m.Leg(0)[i], 10.0 * m.Timestamps()[i]);
+    EXPECT_EQ(m.Leg(1)[i], static_cast<double>(m.Timestamps()[i]));
+  }
+}
+
+TEST_F(TimestampJoinTest, OuterJoinForwardFills) {
+  AlignedMatrix m = JoinTimestamps({A(), C()}, JoinMode::kOuterForwardFill);
+
+  // Starts once both legs have a value (t = 1), union of the rest
+  EXPECT_EQ(m.Timestamps(), (std::pmr::vector<uint64_t>{1, 2, 3, 5, 8, 13}));
+  EXPECT_EQ(m.Leg(0)[0], 10);
+  EXPECT_EQ(m.Leg(1)[0], -1);
+  EXPECT_EQ(m.Leg(1)[2], -1);
+  EXPECT_EQ(m.Leg(1)[3], -5);
+  EXPECT_EQ(m.Leg(1)[4], -5);
+  EXPECT_EQ(m.Leg(0)[5], 130);
+  EXPECT_EQ(m.Leg(1)[5], -13);
+}
+
+TEST_F(TimestampJoinTest, AsofJoinUsesLastValueAtOrBefore) {
+  AlignedMatrix m = JoinTimestamps({C(), A()}, JoinMode::kAsof);
+
+  // t = 0 has no prior value in A and is dropped
+  EXPECT_EQ(m.Timestamps(), (std::pmr::vector<uint64_t>{5, 13}));
+  EXPECT_EQ(m.Leg(1)[0], 50);
+  EXPECT_EQ(m.Leg(1)[1], 130);
+}
+
+TEST_F(TimestampJoinTest, AsofJoinHonoursTolerance) {
+  std::vector<uint64_t> ts = {4, 12};
+  std::vector<double> px = {1, 2};
+  JoinColumn ref{ts.data(), px.data(), ts.size()};
+
+  AlignedMatrix m = JoinTimestamps({ref, A()}, JoinMode::kAsof, 2);
+  // 4 matches A@3, 12 would match A@8 which is too old
+  ASSERT_EQ(m.Rows(), 1);
+  EXPECT_EQ(m.Timestamps()[0], 4);
+  EXPECT_EQ(m.Leg(1)[0], 30);
+}
+
+TEST_F(TimestampJoinTest, SparseAgainstDenseLeg) {
+  std::vector<uint64_t> dense_ts(100000);
+  std::vector<double> dense_px(dense_ts.size());
+  for (size_t i = 0; i < dense_ts.size(); ++i) {
+    dense_ts[i] = i;
+    dense_px[i] = static_cast<double>(i) * 0.5;
+  }
+  std::vector<uint64_t> sparse_ts = {10, 50000, 99999, 200000};
+  std::vector<double> sparse_px = {1, 2, 3, 4};
+
+  AlignedMatrix m = JoinTimestamps(
+      {{sparse_ts.data(), sparse_px.data(), sparse_ts.size()},
+       {dense_ts.data(), dense_px.data(), dense_ts.size()}},
+      JoinMode::kInner);
+
+  EXPECT_EQ(m.Timestamps(), (std::pmr::vector<uint64_t>{10, 50000, 99999}));
+  EXPECT_EQ(m.Leg(1)[1], 25000.0);
+}
+
+TEST_F(TimestampJoinTest, EmptyInputs) {
+  EXPECT_THROW(JoinTimestamps({}, JoinMode::kInner), std::invalid_argument);
+
+  JoinColumn empty{nullptr, nullptr, 0};
+  EXPECT_EQ(JoinTimestamps({A(), empty}, JoinMode::kInner).Rows(), 0);
+  EXPECT_EQ(JoinTimestamps({A(), empty}, JoinMode::kOuterForwardFill).Rows(),
+            0);
+  EXPECT_EQ(JoinTimestamps({A(), empty}, JoinMode::kAsof).Rows(), 0);
+}
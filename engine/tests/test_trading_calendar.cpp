@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "CivilDate.hpp"
+#include "TradingCalendar.hpp"
+
+class TradingCalendarTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir = "/tmp/trading_calendar_test";
+    std::filesystem::remove_all(test_dir);
+    std::filesystem::create_directories(test_dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(test_dir); }
+
+  // CME Group 2025 full-day closures, shared by CBOT, CME and NYMEX
+  std::string WriteHolidays() {
+    const std::string path = test_dir + "/holidays.csv";
+    std::ofstream file(path);
+    file << "exchange,date,description\n"
+         << "# 2025\n";
+    for (const char *exchange : {"CBOT", "CME", "NYMEX"}) {
+      for (const char *date :
+           {"2025-01-01", "2025-01-20", "2025-02-17", "2025-04-18",
+            "2025-05-26", "2025-06-19", "2025-07-04", "2025-09-01",
+            "2025-11-27", "2025-12-25"}) {
+        file << exchange << "," << date << ",closed\r\n";
+      }
+    }
+    file << "CBOT,2025-02-30,not a date\n"
+         << "CBOT\n"
+         << "\n";
+    return path;
+  }
+
+  static int64_t Day(int y, unsigned m, unsigned d) {
+    return DaysFromCivil(y, m, d);
+  }
+
+  std::string test_dir;
+};
+
+TEST_F(TradingCalendarTest, CivilDateConversions) {
+  EXPECT_EQ(DaysFromCivil(1970, 1, 1), 0);
+  EXPECT_EQ(Weekday(0), 4u);   // Thursday
+  EXPECT_EQ(Weekday(-1), 3u);  // Wednesday
+  EXPECT_EQ(Weekday(Day(2025, 3, 15)), 6u);
+  EXPECT_EQ(DaysInMonth(2024, 2), 29u);
+  EXPECT_EQ(DaysInMonth(2100, 2), 28u);
+  EXPECT_EQ(DayFromTimestamp(1735689600000ULL + 1000), Day(2025, 1, 1));
+
+  for (int64_t day = -800000; day <= 800000; day += 37) {
+    const CivilDate date = CivilFromDays(day);
+    ASSERT_EQ(DaysFromCivil(date.year, date.month, date.day), day);
+    ASSERT_GE(date.day, 1u);
+    ASSERT_LE(date.day, DaysInMonth(date.year, date.month));
+  }
+  static_assert(CivilFromDays(19782).month == 2, "2024-02-29");
+  static_assert(CivilFromDays(19782).day == 29, "2024-02-29");
+}
+
+TEST_F(TradingCalendarTest, WeekdayCalendarArithmetic) {
+  const TradingCalendar calendar("TEST", 2024, 2026, {});
+  EXPECT_EQ(calendar.FirstDay(), Day(2024, 1, 1));
+  EXPECT_EQ(calendar.EndDay(), Day(2027, 1, 1));
+  EXPECT_EQ(calendar.TradingDaysInYear(2024), 262);
+  EXPECT_EQ(calendar.TradingDaysInYear(2025), 261);
+
+  const int64_t friday = Day(2025, 3, 14);
+  const int64_t saturday = friday + 1;
+  const int64_t monday = friday + 3;
+  EXPECT_TRUE(calendar.IsTradingDay(friday));
+  EXPECT_FALSE(calendar.IsTradingDay(saturday));
+  EXPECT_EQ(calendar.AddBusinessDays(friday, 1), monday);
+  EXPECT_EQ(calendar.AddBusinessDays(saturday, 1), monday);
+  EXPECT_EQ(calendar.AddBusinessDays(saturday, 0), monday);
+  EXPECT_EQ(calendar.AddBusinessDays(saturday, -1), friday);
+  EXPECT_EQ(calendar.AddBusinessDays(monday, -1), friday);
+  EXPECT_EQ(calendar.AddBusinessDays(friday, 10), friday + 14);
+  EXPECT_EQ(calendar.BusinessDaysBetween(monday, monday + 7), 5);
+  EXPECT_EQ(calendar.BusinessDaysBetween(monday + 7, monday), -5);
+  EXPECT_EQ(calendar.TradingDayOfYear(Day(2025, 1, 1)), 0);
+  EXPECT_EQ(calendar.TradingDayOfYear(Day(2025, 1, 6)), 3);
+
+  int bits = 0;
+  const uint64_t *words = calendar.YearBits(2025);
+  for (size_t w = 0; w < TradingCalendar::kWordsPerYear; ++w) {
+    bits += __builtin_popcountll(words[w]);
+  }
+  EXPECT_EQ(bits, 261);
+
+  EXPECT_FALSE(calendar.IsTradingDay(Day(2023, 12, 29)));
+  EXPECT_THROW(calendar.TradingDayIndex(Day(2023, 12, 29)), std::out_of_range);
+  EXPECT_THROW(calendar.AddBusinessDays(Day(2026, 12, 31), 1),
+               std::out_of_range);
+  EXPECT_THROW(calendar.YearBits(2027), std::out_of_range);
+  EXPECT_THROW(TradingCalendar("TEST", 2025, 2024, {}), std::invalid_argument);
+}
+
+TEST_F(TradingCalendarTest, TablesMatchDayByDayWalk) {
+  std::vector<int64_t> holidays;
+  for (int64_t day = Day(2000, 1, 1); day < Day(2010, 1, 1); day += 23) {
+    holidays.push_back(day);
+  }
+  const TradingCalendar calendar("TEST", 2000, 2009, holidays);
+
+  std::vector<int64_t> open;
+  for (int64_t day = calendar.FirstDay(); day < calendar.EndDay(); ++day) {
+    const unsigned weekday = Weekday(day);
+    const bool holiday = (day - Day(2000, 1, 1)) % 23 == 0;
+    const bool trading = weekday != 0 && weekday != 6 && !holiday;
+    ASSERT_EQ(calendar.IsTradingDay(day), trading) << day;
+    ASSERT_EQ(calendar.TradingDayIndex(day),
+              static_cast<int64_t>(open.size()));
+    if (trading) open.push_back(day);
+  }
+  ASSERT_EQ(calendar.TradingDays(), static_cast<int64_t>(open.size()));
+  for (size_t i = 0; i < open.size(); i += 7) {
+    ASSERT_EQ(calendar.TradingDay(i), open[i]);
+  }
+
+  for (int64_t day = Day(2004, 6, 1); day < Day(2004, 9, 1); ++day) {
+    for (int64_t n = -6; n <= 6; ++n) {
+      int64_t expected = day;
+      if (n == 0) {
+        while (!calendar.IsTradingDay(expected)) ++expected;
+      }
+      for (int64_t k = 0; k < n; ++k) {
+        do ++expected; while (!calendar.IsTradingDay(expected));
+      }
+      for (int64_t k = 0; k > n; --k) {
+        do --expected; while (!calendar.IsTradingDay(expected));
+      }
+      ASSERT_EQ(calendar.AddBusinessDays(day, n), expected) << day << n;
+    }
+  }
+}
+
+TEST_F(TradingCalendarTest, HolidayFileAndLastTradeDates) {
+  ExchangeCalendars calendars(2020, 2030);
+  EXPECT_FALSE(calendars.LoadHolidays(test_dir + "/missing.csv"));
+  const auto before = calendars.Calendar("CBOT");
+  EXPECT_EQ(before->TradingDaysInYear(2025), 261);
+
+  ASSERT_TRUE(calendars.LoadHolidays(WriteHolidays()));
+  const auto cbot = calendars.Calendar("CBOT");
+  EXPECT_EQ(cbot->TradingDaysInYear(2025), 251);
+  EXPECT_FALSE(cbot->IsTradingDay(Day(2025, 4, 18)));
+  EXPECT_TRUE(before->IsTradingDay(Day(2025, 4, 18)));  // Old snapshot
+  EXPECT_EQ(cbot->TradingDayOfYear(Day(2025, 1, 2)), 0);
+  EXPECT_EQ(calendars.Calendar("EUREX")->TradingDaysInYear(2025), 261);
+
+  EXPECT_EQ(calendars.LastTradeDate({"ZC", H, 2025}), Day(2025, 3, 14));
+  EXPECT_EQ(calendars.LastTradeDate({"ZC", N, 2025}), Day(2025, 7, 14));
+  EXPECT_EQ(calendars.LastTradeDate({"ZS", F, 2025}), Day(2025, 1, 14));
+  // The 25th of the prior month falls on Christmas: four days before
+  EXPECT_EQ(calendars.LastTradeDate({"CL", F, 2026}), Day(2025, 12, 19));
+  EXPECT_EQ(calendars.LastTradeDate({"CL", Z, 2025}), Day(2025, 11, 20));
+  EXPECT_EQ(calendars.LastTradeDate({"HE", J, 2025}), Day(2025, 4, 14));
+  EXPECT_EQ(calendars.LastTradeDate({"LE", M, 2025}), Day(2025, 6, 30));
+  EXPECT_EQ(calendars.LastTradeDate({"NG", F, 2026}), Day(2025, 12, 29));
+
+  EXPECT_THROW(calendars.LastTradeDate({"XX", H, 2025}), std::out_of_range);
+  calendars.SetRule("XX", ExpiryRule{"CBOT", 0, 1, 0, 0});
+  EXPECT_EQ(calendars.LastTradeDate({"XX", F, 2025}), Day(2025, 1, 2));
+  EXPECT_THROW(calendars.LastTradeDate({"ZC", H, 2031}), std::out_of_range);
+}
+
+TEST_F(TradingCalendarTest, LookupTiming) {
+  const TradingCalendar calendar("TEST", 1970, 2069, {});
+  const int64_t first = Day(2000, 1, 1);
+  int64_t checksum = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int64_t i = 0; i < 1000000; ++i) {
+    checksum += calendar.AddBusinessDays(first + i % 9000, 5);
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  std::cout << "1M business-day offsets: " << elapsed.count() << " us"
+            << std::endl;
+  EXPECT_GT(checksum, 0);
+}
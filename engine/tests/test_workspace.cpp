@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "DataManager.hpp"
+#include "SpreadCache.hpp"
+#include "Workspace.hpp"
+
+class WorkspaceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir = "/tmp/workspace_test";
+    std::filesystem::remove_all(test_dir);
+    std::filesystem::create_directories(test_dir + "/data");
+    path = test_dir + "/workspace.aws";
+    DataManager::clearCache();
+  }
+
+  void TearDown() override {
+    DataManager::attachWorkspace(nullptr);
+    DataManager::configureDataRoots({});
+    DataManager::clearCache();
+    std::filesystem::remove_all(test_dir);
+  }
+
+  // Hourly bars over 20 days
+  std::string WriteContract(const std::string& month, double base) {
+    const std::string dir = test_dir + "/data/ZC/" + month;
+    std::filesystem::create_directories(dir);
+    const std::string file_path = dir + "/2025.csv";
+    std::ofstream file(file_path);
+    file << "timestamp,close,open,high,low,volume\n";
+    for (int day = 10; day < 30; ++day) {
+      for (int hour = 9; hour < 14; ++hour) {
+        const double close = base + ((day * 7 + hour) % 13) * 0.25;
+        file << "2025-01-" << day << " " << hour << ":00:00," << close << ","
+             << close << "," << close + 1 << "," << close - 1 << ",100\n";
+      }
+    }
+    return file_path;
+  }
+
+  static TimeSeries SampleSeries(size_t rows) {
+    TimeSeries series;
+    for (size_t i = 0; i < rows; ++i) {
+      series.Timestamps().push_back(1735689600000ULL + i * 60000);
+      series.Opens().push_back(100.0 + i);
+      series.Highs().push_back(101.0 + i);
+      series.Lows().push_back(99.0 + i);
+      series.Closes().push_back(100.5 + i);
+      series.Volumes().push_back(10.0 * i);
+    }
+    series.AddColumn(TimeSeries::kOpenInterest)[rows / 2] = 4242.0;
+    return series;
+  }
+
+  std::string test_dir;
+  std::string path;
+};
+
+TEST_F(WorkspaceTest, EntriesRoundTrip) {
+  const TimeSeries series = SampleSeries(37);
+  const std::vector<double> matrix = {1, 2, 3, 4, 5, 6};
+  const std::vector<uint8_t> blob = {9, 8, 7};
+  {
+    WorkspaceWriter writer(path);
+    EXPECT_TRUE(writer.AddSeries("series", 11, series));
+    EXPECT_TRUE(writer.AddSeries("empty", 1, TimeSeries()));
+    EXPECT_TRUE(writer.AddMatrix("matrix", 12, 2, 3, matrix.data()));
+    EXPECT_TRUE(writer.AddBlob("blob", 13, blob.data(), blob.size()));
+    EXPECT_FALSE(writer.AddBlob("blob", 14, blob.data(), 1));
+    ASSERT_TRUE(writer.Commit());
+  }
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+  Workspace workspace;
+  ASSERT_TRUE(workspace.Open(path));
+  EXPECT_EQ(workspace.Entries(), 4u);
+  EXPECT_EQ(workspace.Keys(),
+            (std::vector<std::string>{"series", "empty", "matrix", "blob"}));
+
+  TimeSeries read;
+  ASSERT_TRUE(workspace.ReadSeries("series", 11, read));
+  EXPECT_EQ(read.Timestamps(), series.Timestamps());
+  EXPECT_EQ(read.Lows(), series.Lows());
+  EXPECT_EQ(read.Volumes(), series.Volumes());
+  EXPECT_EQ(read.OpenInterest(), series.OpenInterest());
+  ASSERT_TRUE(workspace.ReadSeries("empty", 1, read));
+  EXPECT_TRUE(read.Timestamps().empty());
+
+  size_t rows = 0;
+  size_t cols = 0;
+  std::vector<double> values;
+  ASSERT_TRUE(workspace.ReadMatrix("matrix", 12, rows, cols, values));
+  EXPECT_EQ(rows, 2u);
+  EXPECT_EQ(cols, 3u);
+  EXPECT_EQ(values, matrix);
+
+  std::vector<uint8_t> bytes;
+  ASSERT_TRUE(workspace.ReadBlob("blob", 13, bytes));
+  EXPECT_EQ(bytes, blob);
+
+  // Stale versions, wrong kinds and unknown keys miss
+  EXPECT_FALSE(workspace.ReadSeries("series", 12, read));
+  EXPECT_FALSE(workspace.ReadBlob("matrix", 12, bytes));
+  EXPECT_FALSE(workspace.ReadBlob("missing", 13, bytes));
+}
+
+TEST_F(WorkspaceTest, RejectsForeignAndDamagedFiles) {
+  Workspace workspace;
+  EXPECT_FALSE(workspace.Open(path));
+
+  {
+    WorkspaceWriter writer(path);
+    writer.AddSeries("series", 1, SampleSeries(100));
+    ASSERT_TRUE(writer.Commit());
+  }
+  const auto size = std::filesystem::file_size(path);
+
+  // Another format version
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(8);
+    const uint32_t format = Workspace::kFormatVersion + 1;
+    file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+  }
+  EXPECT_FALSE(workspace.Open(path));
+
+  // Truncated
+  {
+    WorkspaceWriter writer(path);
+    writer.AddSeries("series", 1, SampleSeries(100));
+    ASSERT_TRUE(writer.Commit());
+  }
+  std::filesystem::resize_file(path, size - 16);
+  EXPECT_FALSE(workspace.Open(path));
+  EXPECT_EQ(workspace.Entries(), 0u);
+
+  // An uncommitted writer leaves the previous file in place
+  {
+    WorkspaceWriter writer(path);
+    writer.AddSeries("series", 1, SampleSeries(100));
+    ASSERT_TRUE(writer.Commit());
+  }
+  {
+    WorkspaceWriter writer(path);
+    writer.AddBlob("partial", 1, "x", 1);
+  }
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+  ASSERT_TRUE(workspace.Open(path));
+  EXPECT_TRUE(workspace.Contains("series"));
+  EXPECT_FALSE(workspace.Contains("partial"));
+}
+
+TEST_F(WorkspaceTest, RejectsForgedSeriesEntries) {
+  // Offsets of the header's directory offset, and of the directory record's
+  // row count and payload offset
+  constexpr std::streamoff kDirectoryOffset = 24;
+  constexpr std::streamoff kRecordRows = 16;
+  constexpr std::streamoff kRecordOffset = 32;
+
+  auto write_series = [&] {
+    WorkspaceWriter writer(path);
+    writer.AddSeries("series", 1, SampleSeries(100));
+    ASSERT_TRUE(writer.Commit());
+  };
+  auto read_u64 = [&](std::streamoff at) {
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(at);
+    uint64_t value = 0;
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+  };
+  auto write_u64 = [&](std::streamoff at, uint64_t value) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(at);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  Workspace workspace;
+  TimeSeries series;
+
+  // A column name length that wraps `offset + length` back into the file
+  write_series();
+  const std::streamoff record = read_u64(kDirectoryOffset);
+  const std::streamoff payload = read_u64(record + kRecordOffset);
+  write_u64(payload + 8, ~uint64_t{0} - 7);
+  ASSERT_TRUE(workspace.Open(path));
+  EXPECT_FALSE(workspace.ReadSeries("series", 1, series));
+
+  // A row count whose byte size wraps to a small column stride
+  write_series();
+  write_u64(record + kRecordRows, (uint64_t{1} << 61) + 1);
+  ASSERT_TRUE(workspace.Open(path));
+  EXPECT_FALSE(workspace.ReadSeries("series", 1, series));
+
+  // A row count larger than the payload
+  write_series();
+  write_u64(record + kRecordRows, 100000);
+  ASSERT_TRUE(workspace.Open(path));
+  EXPECT_FALSE(workspace.ReadSeries("series", 1, series));
+
+  // The untouched file still reads
+  write_series();
+  ASSERT_TRUE(workspace.Open(path));
+  ASSERT_TRUE(workspace.ReadSeries("series", 1, series));
+  EXPECT_EQ(series.Timestamps().size(), 100u);
+}
+
+TEST_F(WorkspaceTest, CarryOverKeepsUntouchedEntries) {
+  {
+    WorkspaceWriter writer(path);
+    writer.AddBlob("old", 1, "old", 3);
+    writer.AddBlob("kept", 2, "kept", 4);
+    ASSERT_TRUE(writer.Commit());
+  }
+  Workspace previous;
+  ASSERT_TRUE(previous.Open(path));
+
+  // Replacing the file under the mapping is safe
+  WorkspaceWriter writer(path);
+  writer.AddBlob("old", 3, "new", 3);
+  EXPECT_EQ(writer.CarryOver(previous), 1u);
+  ASSERT_TRUE(writer.Commit());
+
+  Workspace current;
+  ASSERT_TRUE(current.Open(path));
+  std::vector<uint8_t> bytes;
+  ASSERT_TRUE(current.ReadBlob("old", 3, bytes));
+  EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "new");
+  ASSERT_TRUE(current.ReadBlob("kept", 2, bytes));
+  EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "kept");
+  ASSERT_TRUE(previous.ReadBlob("old", 1, bytes));
+  EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "old");
+}
+
+TEST_F(WorkspaceTest, RestartServesResampledBarsAndSpreads) {
+  WriteContract("H", 400.0);
+  const std::string k_path = WriteContract("K", 410.0);
+  DataManager::configureDataRoots({test_dir + "/data"});
+  const Contract h{"ZC", H, 2025};
+  const BarBucket daily = BarBucket::Days(1);
+
+  SpreadQuery query;
+  query.definition = SpreadDefinition::Calendar("ZC", H, K, 2025);
+  query.bucket = daily;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  const TimeSeries bars = DataManager::loadResampledData(h, daily);
+  auto cold = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  SpreadCache cache;
+  const SpreadSeries spread = cache.Load(query);
+  {
+    WorkspaceWriter writer(path);
+    EXPECT_EQ(DataManager::snapshotWorkspace(writer), 2u);  // H and K
+    EXPECT_EQ(cache.Snapshot(writer), 1u);
+    ASSERT_TRUE(writer.Commit());
+  }
+
+  // "Restart": drop the in-memory state and map the snapshot
+  DataManager::clearCache();
+  auto workspace = std::make_shared<Workspace>();
+  start = std::chrono::high_resolution_clock::now();
+  ASSERT_TRUE(workspace->Open(path));
+  DataManager::attachWorkspace(workspace);
+  const TimeSeries restored = DataManager::loadResampledData(h, daily);
+  auto warm = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  std::cout << "First daily-bar request: cold " << cold.count()
+            << " us, from workspace " << warm.count() << " us" << std::endl;
+  EXPECT_EQ(restored.Timestamps(), bars.Timestamps());
+  EXPECT_EQ(restored.Closes(), bars.Closes());
+
+  SpreadCache restarted;
+  restarted.Attach(workspace);
+  const auto found = restarted.Find(query);
+  ASSERT_TRUE(found.has_value());
+  EXPECT_EQ(found->values, spread.values);
+  EXPECT_EQ(restarted.Stats().workspace_hits, 1u);
+
+  // Rewriting a contract file retires its snapshot entries
+  DataManager::clearCache();
+  WriteContract("K", 300.0);
+  std::filesystem::last_write_time(
+      k_path, std::filesystem::last_write_time(k_path) +
+                  std::chrono::seconds(5));
+  DataManager::catalog()->Rescan();  // Versions come from the catalog
+  const TimeSeries reloaded =
+      DataManager::loadResampledData({"ZC", K, 2025}, daily);
+  EXPECT_LT(reloaded.Closes()[0], 400.0);
+  SpreadCache after_change;
+  after_change.Attach(workspace);
+  EXPECT_FALSE(after_change.Find(query).has_value());
+}
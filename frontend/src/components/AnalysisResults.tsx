@@ -3,11 +3,31 @@ import { useState } from 'react';
 import { Card, CardContent, CardHeader, CardTitle } from '@/components/ui/card';
 import { Tabs, TabsContent, TabsList, TabsTrigger } from '@/components/ui/tabs';
 import { Button } from '@/components/ui/button';
-import { AnalysisData } from '@/types/analysis';
+import { AnalysisData, SpreadAnalysisParams } from '@/types/analysis';
 import { SpreadChart } from './SpreadChart';
 import { MetricsTable } from './MetricsTable';
 import { YearlyChartsGrid } from './YearlyChartsGrid';
 
+// Same format as the backend's _describe_legs, e.g.
+// "+1 ZC December -1 ZC March +1y"
+const describeSpread = (params: SpreadAnalysisParams): string => {
+  if (!params.legs || params.legs.length === 0) {
+    return `${params.month1 ?? ''} - ${params.month2 ?? ''}`;
+  }
+  return params.legs
+    .map((leg) => {
+      const coefficient = Number(
+        ((leg.weight ?? 1) * (leg.multiplier ?? 1)).toPrecision(6)
+      );
+      const sign = coefficient >= 0 ? '+' : '';
+      const offset = leg.yearOffset
+        ? ` ${leg.yearOffset > 0 ? '+' : ''}${leg.yearOffset}y`
+        : '';
+      return `${sign}${coefficient} ${leg.commodity} ${leg.month}${offset}`;
+    })
+    .join(' ');
+};
+
 interface AnalysisResultsProps {
   data: AnalysisData;
   onNewAnalysis: () => void;
@@ -23,7 +43,7 @@ export const AnalysisResults = ({ data, onNewAnalysis }: AnalysisResultsProps) =
           <div>
             <CardTitle className="text-white text-xl">Analysis Results</CardTitle>
             <p className="text-slate-300 mt-1">
-              {data.params.commodity} • {data.params.month1} - {data.params.month2} • 
+              {data.params.commodity} • {describeSpread(data.params)} • 
               {data.params.startDate} to {data.params.endDate}
             </p>
           </div>
@@ -23,12 +23,21 @@ export interface YearlyMetrics {
   avgLoss: number;        // Frontend camelCase
 }
 
+export interface SpreadLeg {
+  commodity: string;
+  month: string;
+  yearOffset?: number;    // Expiry year relative to the analysis year
+  weight?: number;        // Signed ratio weight, default 1
+  multiplier?: number;    // Quote-to-spread unit conversion, default 1
+}
+
 export interface SpreadAnalysisParams {
   commodity: string;
-  month1: string;
-  month2: string;
+  month1?: string;        // With month2, a +1/-1 calendar spread
+  month2?: string;
   startDate: string;      // Frontend camelCase
   endDate: string;        // Frontend camelCase
+  legs?: SpreadLeg[];     // Alternative to month1/month2, never both
 }
 
 export interface AnalysisData {